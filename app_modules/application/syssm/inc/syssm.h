@@ -25,7 +25,15 @@ extern "C" {
 /* INCLUDES                                                                   */
 /******************************************************************************/
 #include <assert.h>
+#include <stdbool.h>
 #include "stdint.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "hsm.h"
+#include "ir_switch.h"
+#include "led.h"
+#include "period.h"
 
 /******************************************************************************/
 /* PUBLIC DEFINITIONS                                                         */
@@ -42,6 +50,32 @@ typedef enum SYSSM_BLE_DATA
 	BLE_CLEAN_TIMER
 }SYSSM_BLE_DATA;
 
+#define SYSSM_TIMERS              (BLE_CLEAN_TIMER + 1)   // reminder timers
+
+/*
+ * @brief one system state machine with its event queue, timers, IR switch
+ *        debounce and LED. The application runs one, the fleet simulator
+ *        one per simulated device.
+ */
+typedef struct SysSm_t
+{
+	Hsm_t st_Hsm;
+	QueueHandle_t x_Events;
+	TimerHandle_t x_IrTimer;
+	TimerHandle_t x_StandbyTimer;
+	TimerHandle_t ax_Reminder[SYSSM_TIMERS];
+	IR_Switch_t st_Ir;
+	Led_t st_Led;
+	Period_Mon_t st_IrPeriod;      // IR poll interval, the debounce and u32_IrQuiet count the measured time
+	IRSwitch_State e_IrPrev;
+	bool b_CleanDue;               // clean timer expired while no bottle was there
+	/* light sleep, only touched in the timer task */
+	bool b_SleepAllowed;           // IDLE or STANDBY
+	bool b_IrSleeping;             // IR sampling stopped, woken by the IR switch
+	uint32_t u32_IrQuiet;          // ms without a bottle
+	bool b_Resumed;                // started from the deep sleep snapshot
+}SysSm_t;
+
 /******************************************************************************/
 /* PUBLIC DATA DECLARATIONS                                                   */
 /******************************************************************************/
@@ -53,6 +87,8 @@ typedef enum SYSSM_BLE_DATA
 void SysSm_Init (void);
 void SysSm_Process (void);
 void SysSm_Update_Flash(SYSSM_BLE_DATA dataId, int32_t data);
+void SysSm_Setup(SysSm_t *pst_Sm);
+bool SysSm_Run(SysSm_t *pst_Sm, TickType_t x_Wait);
 
 #ifdef __cplusplus
 }
@@ -19,11 +19,25 @@
 /* INCLUDES                                                                   */
 /******************************************************************************/
 
+#define DLOG_FILE_ID              1
+
 #include "stdbool.h"
 #include <stdio.h>
-#include "esp_log.h"
-#include "ir_switch.h"
-#include "led.h"
+#include <string.h>
+#include <time.h>
+#include "dlog.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "audio.h"
+#include "boot.h"
+#include "hsm.h"
+#include "journal.h"
+#include "power.h"
+#include "prof.h"
+#include "resume.h"
+#include "settings.h"
 #include "syssm.h"
 
 
@@ -35,22 +49,72 @@ typedef enum sysSM_States
 	INIT = 0,
 	IDLE,
 	BOTTLE_PRESENT,
-	REMINDER_DRINK,
-	REMINDER_CLEAN,
-	STANDBY
+	REMINDER_DRINK,     // inside BOTTLE_PRESENT
+	REMINDER_CLEAN,     // inside BOTTLE_PRESENT
+	STANDBY,
+	SYSSM_STATE_MAX
 }sysSM_States;
 
+typedef enum sysSM_Events
+{
+	EV_START = 0,
+	EV_BOTTLE_PLACED,
+	EV_BOTTLE_REMOVED,
+	EV_DRINK_TIMEOUT,
+	EV_PLACE_TIMEOUT,
+	EV_CLEAN_TIMEOUT,
+	EV_SLEEP_TIMEOUT,
+	SYSSM_EVENT_MAX
+}sysSM_Events;
+
+#define SYSSM_QUEUE_LEN           8U
+#define SYSSM_IR_POLL_MS          IR_SWITCH_SAMPLE_MS   // IR sampling period
+#define SYSSM_IR_LATE_US          (SYSSM_IR_POLL_MS * 1500U)   // a poll later than 1.5 periods is a deadline miss
+#define SYSSM_LED_BLINK_MS        5000U
+#define SYSSM_IR_SETTLE_MS        300U      // time without a bottle before sampling stops for light sleep
+#define SYSSM_DEEP_SLEEP_S        600U      // time in STANDBY before deep sleep
+#define SYSSM_SNAPSHOT_VERSION    1U        // layout of SysSm_Snapshot_t
 
 /******************************************************************************/
 /* PRIVATE TYPE DEFINITIONS                                                   */
 /******************************************************************************/
-
-const static char *TAG = "sysSM";
+/* what is kept in RTC memory over deep sleep */
+typedef struct SysSm_Snapshot_t
+{
+	int64_t s64_SleptAt;                              // time(NULL) when going to sleep
+	uint32_t au32_RemainMs[SYSSM_TIMERS];             // reminder timers, 0: not running
+	uint8_t u8_State;
+	uint8_t u8_IrPrev;
+	uint8_t u8_CleanDue;
+}SysSm_Snapshot_t;
 
 
 /******************************************************************************/
 /* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
 /******************************************************************************/
+static void SysSm_Post(SysSm_t *pst_Sm, sysSM_Events e_Event);
+static void SysSm_IrPoll(TimerHandle_t timer);
+static void SysSm_IrWake(void *pv_Sm);
+static void SysSm_SleepPolicy(void *pv_Sm, uint32_t u32_Allow);
+static void SysSm_TimerExpired(TimerHandle_t timer);
+static void SysSm_StandbyExpired(TimerHandle_t timer);
+static bool SysSm_Resume(SysSm_t *pst_Sm);
+static void SysSm_TimerArm(SysSm_t *pst_Sm, SYSSM_BLE_DATA e_Timer);
+static void SysSm_EnterIdle(void *pv_Ctx);
+static void SysSm_ExitIdle(void *pv_Ctx);
+static void SysSm_EnterStandby(void *pv_Ctx);
+static void SysSm_ExitStandby(void *pv_Ctx);
+static void SysSm_EnterPresent(void *pv_Ctx);
+static void SysSm_ExitPresent(void *pv_Ctx);
+static void SysSm_EnterDrink(void *pv_Ctx);
+static void SysSm_EnterClean(void *pv_Ctx);
+static void SysSm_ExitClean(void *pv_Ctx);
+static void SysSm_ArmClean(void *pv_Ctx);
+static void SysSm_CleanDue(void *pv_Ctx);
+static bool SysSm_DrinkExpired(void *pv_Ctx);
+static bool SysSm_PlaceExpired(void *pv_Ctx);
+static bool SysSm_SleepExpired(void *pv_Ctx);
+static void SysSm_DeepSleep(void *pv_Ctx);
 
 
 /******************************************************************************/
@@ -60,27 +124,516 @@ const static char *TAG = "sysSM";
 /******************************************************************************/
 /* PRIVATE DATA DEFINTIONS                                                    */
 /******************************************************************************/
+static const Hsm_State_t sysSM_StateDef[SYSSM_STATE_MAX] = {
+	[INIT]           = { HSM_NO_PARENT,  NULL,               NULL,              "INIT" },
+	[IDLE]           = { HSM_NO_PARENT,  SysSm_EnterIdle,    SysSm_ExitIdle,    "IDLE" },
+	[BOTTLE_PRESENT] = { HSM_NO_PARENT,  SysSm_EnterPresent, SysSm_ExitPresent, "BOTTLE_PRESENT" },
+	[REMINDER_DRINK] = { BOTTLE_PRESENT, SysSm_EnterDrink,   NULL,              "REMINDER_DRINK" },
+	[REMINDER_CLEAN] = { BOTTLE_PRESENT, SysSm_EnterClean,   SysSm_ExitClean,   "REMINDER_CLEAN" },
+	[STANDBY]        = { HSM_NO_PARENT,  SysSm_EnterStandby, SysSm_ExitStandby, "STANDBY" },
+};
+
+/* state x event, empty cells pass the event to the parent. Timer events are
+ * guarded against expiries that were queued before the timer was re-armed.
+ * The hooks get the SysSm_t as context. */
+static const Hsm_Trans_t sysSM_TransDef[SYSSM_STATE_MAX][SYSSM_EVENT_MAX] = {
+	[INIT] = {
+		[EV_START]          = HSM_GOTO(IDLE, NULL, SysSm_ArmClean),
+	},
+	[IDLE] = {
+		[EV_BOTTLE_PLACED]  = HSM_GOTO(BOTTLE_PRESENT, NULL, NULL),
+		[EV_PLACE_TIMEOUT]  = HSM_GOTO(STANDBY, SysSm_PlaceExpired, NULL),
+		[EV_CLEAN_TIMEOUT]  = HSM_STAY(NULL, SysSm_CleanDue),
+	},
+	[BOTTLE_PRESENT] = {
+		[EV_BOTTLE_REMOVED] = HSM_GOTO(IDLE, NULL, NULL),
+		[EV_DRINK_TIMEOUT]  = HSM_GOTO(REMINDER_DRINK, SysSm_DrinkExpired, NULL),
+		[EV_CLEAN_TIMEOUT]  = HSM_GOTO(REMINDER_CLEAN, NULL, NULL),
+	},
+	[REMINDER_DRINK] = {
+		[EV_DRINK_TIMEOUT]  = HSM_STAY(NULL, NULL),
+	},
+	[REMINDER_CLEAN] = {
+		[EV_DRINK_TIMEOUT]  = HSM_STAY(NULL, NULL),
+		[EV_CLEAN_TIMEOUT]  = HSM_STAY(NULL, NULL),
+	},
+	[STANDBY] = {
+		[EV_BOTTLE_PLACED]  = HSM_GOTO(BOTTLE_PRESENT, NULL, NULL),
+		[EV_CLEAN_TIMEOUT]  = HSM_STAY(NULL, SysSm_CleanDue),
+		[EV_SLEEP_TIMEOUT]  = HSM_STAY(SysSm_SleepExpired, SysSm_DeepSleep),
+	},
+};
+
+static const Hsm_Def_t sysSM_Def = {
+	.pst_States = sysSM_StateDef,
+	.pst_Trans = &sysSM_TransDef[0][0],
+	.u8_States = SYSSM_STATE_MAX,
+	.u8_Events = SYSSM_EVENT_MAX,
+	.u8_Initial = INIT,
+};
+
+static SysSm_t sysSM;                    // the application instance
+/* reminder timer lengths in seconds, 0 disables a timer */
+static const Settings_Id_t timer_setting[SYSSM_TIMERS] = {
+	[BLE_DRINK_TIMER] = SETTINGS_DRINK_TIMER_S,
+	[BLE_PLACE_TIMER] = SETTINGS_PLACE_TIMER_S,
+	[BLE_CLEAN_TIMER] = SETTINGS_CLEAN_TIMER_S,
+};
+static const sysSM_Events timer_event[SYSSM_TIMERS] = {
+	[BLE_DRINK_TIMER] = EV_DRINK_TIMEOUT,
+	[BLE_PLACE_TIMER] = EV_PLACE_TIMEOUT,
+	[BLE_CLEAN_TIMER] = EV_CLEAN_TIMEOUT,
+};
 
 /******************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /******************************************************************************/
 /**
- * @brief system state machine initialization function
+ * @brief system state machine initialization function. The IR switch is
+ *        sampled by a timer, the state machine itself only runs on events.
  *
  */
 void SysSm_Init(void)
 {
-  ESP_LOGI(TAG, "Hello from System \n");
+  DLOG_I("Hello from System");
   Led_Init();
+  SysSm_Setup(&sysSM);
 }
 
 /**
- * @brief system state machine process
+ * @brief system state machine process, sleeps until an event arrives and
+ *        dispatches it
  *
  */
 void SysSm_Process (void)
-{ 
-	Led_Blink(5000);
-	IRSwitch_State status = GetIRswitchStatus();
-	ESP_LOGI(TAG, "IR:%d\n", status);
+{
+	(void)SysSm_Run(&sysSM, portMAX_DELAY);
+}
+
+/**
+ * @brief Set a reminder timer, used when it is armed the next time. The
+ *        value is stored in flash after the BLE updates have settled.
+ * @param dataId : timer
+ * @param data : time in seconds, 0 disables the timer
+ */
+void SysSm_Update_Flash(SYSSM_BLE_DATA dataId, int32_t data)
+{
+	if ((dataId <= BLE_CLEAN_TIMER) && (data >= 0))
+	{
+		Settings_Set(timer_setting[dataId], data);
+	}
+}
+
+/**
+ * @brief Set up a state machine instance: its queue and timers, the IR
+ *        switch debounce and the LED, then resume from the deep sleep
+ *        snapshot or start in INIT. The timers carry the instance as id.
+ * @param pst_Sm : instance, static
+ */
+void SysSm_Setup(SysSm_t *pst_Sm)
+{
+  pst_Sm->b_CleanDue = false;
+  pst_Sm->e_IrPrev = IR_SWITCH_RESET;
+  pst_Sm->b_SleepAllowed = false;
+  pst_Sm->b_IrSleeping = false;
+  pst_Sm->u32_IrQuiet = 0;
+  IR_Switch_Setup(&pst_Sm->st_Ir);
+  Led_Setup(&pst_Sm->st_Led);
+
+  pst_Sm->x_Events = xQueueCreate(SYSSM_QUEUE_LEN, sizeof(uint8_t));
+  assert(pst_Sm->x_Events);
+  for (uint32_t i = 0; i < SYSSM_TIMERS; i++) {
+    pst_Sm->ax_Reminder[i] = xTimerCreate("sysSM", 1, pdFALSE, pst_Sm, SysSm_TimerExpired);
+    assert(pst_Sm->ax_Reminder[i]);
+  }
+  Period_Register(&pst_Sm->st_IrPeriod, "ir_poll", SYSSM_IR_POLL_MS * 1000U, SYSSM_IR_LATE_US);
+  pst_Sm->x_IrTimer = xTimerCreate("sysSM_IR", pdMS_TO_TICKS(SYSSM_IR_POLL_MS), pdTRUE, pst_Sm, SysSm_IrPoll);
+  assert(pst_Sm->x_IrTimer);
+  pst_Sm->x_StandbyTimer = xTimerCreate("sysSM_SB", pdMS_TO_TICKS(SYSSM_DEEP_SLEEP_S * 1000U), pdFALSE, pst_Sm,
+                                        SysSm_StandbyExpired);
+  assert(pst_Sm->x_StandbyTimer);
+
+  pst_Sm->b_Resumed = SysSm_Resume(pst_Sm);
+  if (pst_Sm->b_Resumed == false)
+  {
+    Hsm_Init(&pst_Sm->st_Hsm, &sysSM_Def, pst_Sm);
+    SysSm_Post(pst_Sm, EV_START);
+  }
+  Power_Hold(POWER_CLIENT_SYSSM);
+  (void)xTimerStart(pst_Sm->x_IrTimer, portMAX_DELAY);
+}
+
+/**
+ * @brief Wait for the next event of an instance and dispatch it
+ * @param pst_Sm : instance
+ * @param x_Wait : ticks to wait, portMAX_DELAY in the state machine task
+ * @return false when no event came
+ */
+bool SysSm_Run(SysSm_t *pst_Sm, TickType_t x_Wait)
+{
+	uint8_t event;
+
+	if (pst_Sm->b_Resumed != false)
+	{
+		pst_Sm->b_Resumed = false;
+		DLOG_I("resumed: wake to first process %d us", (int32_t)Resume_GetWakeUs());
+	}
+
+	if (xQueueReceive(pst_Sm->x_Events, &event, x_Wait) != pdTRUE)
+	{
+		return false;
+	}
+
+	PROF_SCOPE("SysSm_Process");
+	const uint8_t from = Hsm_GetState(&pst_Sm->st_Hsm);
+	const bool handled = Hsm_Dispatch(&pst_Sm->st_Hsm, event);
+
+	DLOG_I("ev %d: state %d -> %d, handled %d", event, from, Hsm_GetState(&pst_Sm->st_Hsm), handled);
+	if ((event == EV_BOTTLE_PLACED) || (event == EV_BOTTLE_REMOVED))
+	{
+		(void)Journal_Append((event == EV_BOTTLE_PLACED) ? JOURNAL_BOTTLE_PLACED : JOURNAL_BOTTLE_REMOVED,
+		                     (uint32_t)time(NULL), from, 0);
+	}
+	if (event == EV_BOTTLE_PLACED)
+	{
+		Power_Handled();
+	}
+	Boot_Done(); // the first event handled ends the boot
+	return true;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Queue an event, never blocks. A full queue drops the event.
+ * @param pst_Sm : instance
+ * @param e_Event : event
+ */
+static void SysSm_Post(SysSm_t *pst_Sm, sysSM_Events e_Event)
+{
+	const uint8_t event = (uint8_t)e_Event;
+
+	if (xQueueSend(pst_Sm->x_Events, &event, 0) != pdTRUE)
+	{
+		DLOG_W("event %d dropped", event);
+	}
+}
+
+/**
+ * @brief IR sampling, timer callback. Turns debounced edges into events.
+ * @param timer : id is the instance
+ */
+static void SysSm_IrPoll(TimerHandle_t timer)
+{
+	SysSm_t *sm = pvTimerGetTimerID(timer);
+	const uint32_t dt = Period_Begin(&sm->st_IrPeriod);
+	Led_Blink(&sm->st_Led, SYSSM_LED_BLINK_MS);
+
+	IRSwitch_State status = GetIRswitchStatus(&sm->st_Ir, dt);
+	if (status != sm->e_IrPrev)
+	{
+		SysSm_Post(sm, (status == IR_SWITCH_SET) ? EV_BOTTLE_PLACED : EV_BOTTLE_REMOVED);
+		sm->u32_IrQuiet = 0;
+	}
+	else if ((sm->b_SleepAllowed != false) && (status == IR_SWITCH_RESET) &&
+	         ((sm->u32_IrQuiet += dt) >= SYSSM_IR_SETTLE_MS))
+	{
+		/* no bottle and nothing to time but reminders: sleep until the IR switch wakes us */
+		(void)xTimerStop(sm->x_IrTimer, 0);
+		Period_Pause(&sm->st_IrPeriod);
+		sm->b_IrSleeping = true;
+		Power_ArmIrWake(SysSm_IrWake, sm);
+		Power_Release(POWER_CLIENT_SYSSM);
+	}
+	else
+	{
+		/* keep sampling */
+	}
+	sm->e_IrPrev = status;
+	Period_End(&sm->st_IrPeriod);
+}
+
+/**
+ * @brief The IR switch woke the device, runs in the timer task with the
+ *        device held. Sampling decides if a bottle was really placed.
+ * @param pv_Sm : instance
+ */
+static void SysSm_IrWake(void *pv_Sm)
+{
+	SysSm_t *sm = pv_Sm;
+
+	sm->b_IrSleeping = false;
+	sm->u32_IrQuiet = 0;
+	(void)xTimerStart(sm->x_IrTimer, 0);
+}
+
+/**
+ * @brief Light sleep allowed or not in the current state, runs in the timer
+ *        task like the IR sampling
+ * @param pv_Sm : instance
+ * @param u32_Allow : 1 in IDLE and STANDBY
+ */
+static void SysSm_SleepPolicy(void *pv_Sm, uint32_t u32_Allow)
+{
+	SysSm_t *sm = pv_Sm;
+
+	sm->b_SleepAllowed = (u32_Allow != 0U);
+	sm->u32_IrQuiet = 0;
+	if ((sm->b_SleepAllowed == false) && (sm->b_IrSleeping != false))
+	{
+		Power_Hold(POWER_CLIENT_SYSSM);
+		SysSm_IrWake(sm);
+	}
+}
+
+/**
+ * @brief Reminder timer callback, the timer is found in the instance given
+ *        as id, its index is the SYSSM_BLE_DATA
+ * @param timer
+ */
+static void SysSm_TimerExpired(TimerHandle_t timer)
+{
+	SysSm_t *sm = pvTimerGetTimerID(timer);
+
+	for (uint32_t i = 0; i < SYSSM_TIMERS; i++)
+	{
+		if (sm->ax_Reminder[i] == timer)
+		{
+			SysSm_Post(sm, timer_event[i]);
+		}
+	}
+}
+
+/**
+ * @brief STANDBY lasted SYSSM_DEEP_SLEEP_S, timer callback
+ * @param timer : id is the instance
+ */
+static void SysSm_StandbyExpired(TimerHandle_t timer)
+{
+	SysSm_Post(pvTimerGetTimerID(timer), EV_SLEEP_TIMEOUT);
+}
+
+/**
+ * @brief Continue in the state saved before deep sleep. Only STANDBY is
+ *        saved, its timers are re-armed with what is left after the sleep.
+ * @param pst_Sm : instance
+ * @return false for a cold start
+ */
+static bool SysSm_Resume(SysSm_t *pst_Sm)
+{
+	SysSm_Snapshot_t snap;
+
+	if ((Resume_Load(SYSSM_SNAPSHOT_VERSION, &snap, sizeof(snap)) == false) || (snap.u8_State != STANDBY))
+	{
+		return false;
+	}
+
+	const int64_t now = (int64_t)time(NULL);
+	const int64_t slept_ms = (now > snap.s64_SleptAt) ? ((now - snap.s64_SleptAt) * 1000) : 0;
+
+	Hsm_Restore(&pst_Sm->st_Hsm, &sysSM_Def, pst_Sm, snap.u8_State);
+	pst_Sm->b_CleanDue = (snap.u8_CleanDue != 0U);
+	pst_Sm->e_IrPrev = (IRSwitch_State)snap.u8_IrPrev;
+	IR_Switch_Restore(&pst_Sm->st_Ir, snap.u8_IrPrev);
+	for (uint32_t i = 0; i < SYSSM_TIMERS; i++)
+	{
+		if (snap.au32_RemainMs[i] == 0U)
+		{
+			continue;
+		}
+		if ((int64_t)snap.au32_RemainMs[i] > slept_ms)
+		{
+			const TickType_t ticks = pdMS_TO_TICKS((uint32_t)((int64_t)snap.au32_RemainMs[i] - slept_ms));
+			(void)xTimerChangePeriod(pst_Sm->ax_Reminder[i], (ticks > 0U) ? ticks : 1U, portMAX_DELAY);
+		}
+		else
+		{
+			SysSm_Post(pst_Sm, timer_event[i]);
+		}
+	}
+	SysSm_EnterStandby(pst_Sm);
+	return true;
+}
+
+/**
+ * @brief (Re)start a reminder timer with its configured time
+ * @param pst_Sm : instance
+ * @param e_Timer : timer
+ */
+static void SysSm_TimerArm(SysSm_t *pst_Sm, SYSSM_BLE_DATA e_Timer)
+{
+	const int32_t seconds = Settings_Get(timer_setting[e_Timer]);
+
+	if (seconds > 0)
+	{
+		(void)xTimerChangePeriod(pst_Sm->ax_Reminder[e_Timer], (TickType_t)seconds * configTICK_RATE_HZ,
+		                         portMAX_DELAY);
+	}
+	else
+	{
+		(void)xTimerStop(pst_Sm->ax_Reminder[e_Timer], portMAX_DELAY);
+	}
+}
+
+static void SysSm_EnterIdle(void *pv_Ctx)
+{
+	SysSm_TimerArm(pv_Ctx, BLE_PLACE_TIMER);
+	(void)xTimerPendFunctionCall(SysSm_SleepPolicy, pv_Ctx, 1U, portMAX_DELAY);
+}
+
+static void SysSm_ExitIdle(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	(void)xTimerStop(sm->ax_Reminder[BLE_PLACE_TIMER], portMAX_DELAY);
+	(void)xTimerPendFunctionCall(SysSm_SleepPolicy, sm, 0U, portMAX_DELAY);
+}
+
+static void SysSm_EnterStandby(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	(void)xTimerReset(sm->x_StandbyTimer, portMAX_DELAY);
+	(void)xTimerPendFunctionCall(SysSm_SleepPolicy, sm, 1U, portMAX_DELAY);
+}
+
+static void SysSm_ExitStandby(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	(void)xTimerStop(sm->x_StandbyTimer, portMAX_DELAY);
+	(void)xTimerPendFunctionCall(SysSm_SleepPolicy, sm, 0U, portMAX_DELAY);
+}
+
+static void SysSm_EnterPresent(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	(void)Audio_Play(AUDIO_SOUND_CONFIRM); // bottle placed
+	SysSm_TimerArm(sm, BLE_DRINK_TIMER);
+	if (sm->b_CleanDue != false)
+	{
+		SysSm_Post(sm, EV_CLEAN_TIMEOUT);
+	}
+}
+
+static void SysSm_ExitPresent(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	(void)xTimerStop(sm->ax_Reminder[BLE_DRINK_TIMER], portMAX_DELAY);
+}
+
+static void SysSm_EnterDrink(void *pv_Ctx)
+{
+	(void)pv_Ctx;
+	(void)Audio_Play(AUDIO_SOUND_DRINK_REMINDER);
+}
+
+static void SysSm_EnterClean(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	sm->b_CleanDue = false;
+	(void)Audio_Play(AUDIO_SOUND_CLEAN_REMINDER);
+}
+
+/**
+ * @brief Bottle taken away after the clean reminder, counts as cleaned
+ */
+static void SysSm_ExitClean(void *pv_Ctx)
+{
+	SysSm_ArmClean(pv_Ctx);
+}
+
+static void SysSm_ArmClean(void *pv_Ctx)
+{
+	SysSm_TimerArm(pv_Ctx, BLE_CLEAN_TIMER);
+}
+
+/**
+ * @brief Clean timer expired without a bottle, remind when it comes back
+ */
+static void SysSm_CleanDue(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+
+	sm->b_CleanDue = true;
+}
+
+/**
+ * @brief The timer is not running again, so the expiry is current
+ */
+static bool SysSm_DrinkExpired(void *pv_Ctx)
+{
+	const SysSm_t *sm = pv_Ctx;
+
+	return xTimerIsTimerActive(sm->ax_Reminder[BLE_DRINK_TIMER]) == pdFALSE;
+}
+
+static bool SysSm_PlaceExpired(void *pv_Ctx)
+{
+	const SysSm_t *sm = pv_Ctx;
+
+	return xTimerIsTimerActive(sm->ax_Reminder[BLE_PLACE_TIMER]) == pdFALSE;
+}
+
+static bool SysSm_SleepExpired(void *pv_Ctx)
+{
+	const SysSm_t *sm = pv_Ctx;
+
+	return xTimerIsTimerActive(sm->x_StandbyTimer) == pdFALSE;
+}
+
+/**
+ * @brief Long STANDBY: save the state to RTC memory and enter deep sleep
+ *        until a bottle is placed or the next reminder is due. Waits for
+ *        a running sound or a reminder that is already due first.
+ */
+static void SysSm_DeepSleep(void *pv_Ctx)
+{
+	SysSm_t *sm = pv_Ctx;
+	SysSm_Snapshot_t snap;
+	uint32_t wake_ms = 0;
+
+	if (Audio_IsIdle() == false)
+	{
+		(void)xTimerReset(sm->x_StandbyTimer, portMAX_DELAY);
+		return;
+	}
+
+	(void)memset(&snap, 0, sizeof(snap));
+	snap.s64_SleptAt = (int64_t)time(NULL);
+	snap.u8_State = Hsm_GetState(&sm->st_Hsm);
+	snap.u8_IrPrev = (uint8_t)sm->e_IrPrev;
+	snap.u8_CleanDue = (sm->b_CleanDue != false) ? 1U : 0U;
+	for (uint32_t i = 0; i < SYSSM_TIMERS; i++)
+	{
+		if (xTimerIsTimerActive(sm->ax_Reminder[i]) != pdFALSE)
+		{
+			const int32_t left = (int32_t)(xTimerGetExpiryTime(sm->ax_Reminder[i]) - xTaskGetTickCount());
+
+			if (left <= 0)
+			{
+				/* expired, the daemon has not posted it yet: handle it awake */
+				(void)xTimerReset(sm->x_StandbyTimer, portMAX_DELAY);
+				return;
+			}
+			snap.au32_RemainMs[i] = ((uint32_t)left * portTICK_PERIOD_MS) + 1U;   // 0 means not running
+			if ((wake_ms == 0U) || (snap.au32_RemainMs[i] < wake_ms))
+			{
+				wake_ms = snap.au32_RemainMs[i];
+			}
+		}
+	}
+
+	/* RAM is lost, write out what is pending */
+	(void)Settings_Commit();
+	(void)Journal_Flush();
+	Resume_Save(SYSSM_SNAPSHOT_VERSION, &snap, sizeof(snap));
+	DLOG_I("deep sleep, wake in %d ms", (int32_t)wake_ms);
+	Dlog_Flush();
+	Power_DeepSleep(wake_ms);
 }
@@ -25,16 +25,32 @@ extern "C" {
 /* INCLUDES                                                                   */
 /******************************************************************************/
 #include <assert.h>
+#include <stdbool.h>
 #include "stdint.h"
 
 /******************************************************************************/
 /* PUBLIC DEFINITIONS                                                         */
 /******************************************************************************/
+#define AUDIO_QUEUE_LEN            4U        // pending play requests
+#define AUDIO_IDLE_OFF_MS          2000U     // I2S channel is disabled after this idle time
+#define AUDIO_AMPLITUDE            1000      // 1~32767
+#define AUDIO_VOLUME_DEFAULT       100U      // master volume in percent
 
 
 /******************************************************************************/
 /* PUBLIC TYPE DEFINITIONS                                                    */
 /******************************************************************************/
+/*
+ * @brief sounds that can be requested
+ */
+typedef enum Audio_Sound_t
+{
+  AUDIO_SOUND_CONFIRM = 0,
+  AUDIO_SOUND_DRINK_REMINDER,
+  AUDIO_SOUND_CLEAN_REMINDER,
+  AUDIO_SOUND_WELCOME,            // recorded prompt, clip 0 of the clip partition
+  AUDIO_SOUND_MAX
+}Audio_Sound_t;
 
 /******************************************************************************/
 /* PUBLIC DATA DECLARATIONS                                                   */
@@ -44,7 +60,9 @@ extern "C" {
 /******************************************************************************/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /******************************************************************************/
-void Audio_task(void *param);
+bool Audio_Play(Audio_Sound_t e_Sound);
+bool Audio_IsIdle(void);
+void Audio_SetVolume(uint8_t u8_Percent);
 
 
 #ifdef __cplusplus
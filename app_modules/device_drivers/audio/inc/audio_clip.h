@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_clip
+ *  Description        : IMA-ADPCM clip player streaming from flash
+ ******************************************************************************/
+
+#ifndef AUDIO_CLIP_H
+#define AUDIO_CLIP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define AUDIO_CLIP_PARTITION       "clips"           // data partition holding the clip image
+#define AUDIO_CLIP_MAGIC           0x504C4346UL      // "FCLP", see tools/clip_packer.py
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief Decoder state of one clip. The ADPCM data is read through the
+ *        partition mapping, only this state lives in RAM.
+ */
+typedef struct AudioClip_t
+{
+  const uint8_t *pu8_Block;  // next ADPCM block in the mapping
+  const uint8_t *pu8_Nib;    // next nibble pair in the current block
+  uint32_t u32_Left;         // samples left of the clip
+  uint16_t u16_BlockSize;    // ADPCM block size in bytes
+  uint16_t u16_BlockLeft;    // samples left in the current block
+  int32_t s32_Pred;          // predictor
+  int8_t s8_Index;           // step index 0..88
+  bool b_High;               // next nibble is the high one
+} AudioClip_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+bool AudioClip_Open(void);
+uint16_t AudioClip_GetCount(void);
+bool AudioClip_Start(AudioClip_t *pst_Clip, uint16_t u16_Clip);
+uint32_t AudioClip_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Clip);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_CLIP_H
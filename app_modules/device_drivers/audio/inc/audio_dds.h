@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_dds
+ *  Description        : fixed point direct digital synthesis of sine tones
+ ******************************************************************************/
+
+#ifndef AUDIO_DDS_H
+#define AUDIO_DDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+/* 1: linear interpolation between sine table entries, 0: nearest entry */
+#ifndef AUDIO_DDS_INTERPOLATE
+#define AUDIO_DDS_INTERPOLATE      1
+#endif
+
+/* sine table size is 2^AUDIO_DDS_TABLE_BITS entries per period */
+#define AUDIO_DDS_TABLE_BITS       8U
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief oscillator state
+ */
+typedef struct AudioDds_t
+{
+  uint32_t u32_Phase;   /* phase accumulator, one period = 2^32 */
+  uint32_t u32_Step;    /* phase increment per sample */
+  int16_t  s16_Amp;     /* peak amplitude 0..32767 */
+} AudioDds_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void AudioDds_Init(AudioDds_t *pst_Dds, int16_t s16_Amp);
+void AudioDds_SetFreq(AudioDds_t *pst_Dds, uint32_t u32_FreqHz, uint32_t u32_SampleRateHz);
+void AudioDds_SetFreqCHz(AudioDds_t *pst_Dds, uint32_t u32_FreqCHz, uint32_t u32_SampleRateHz);
+void AudioDds_Fill(AudioDds_t *pst_Dds, int16_t *ps16_Buf, uint32_t u32_Samples);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_DDS_H
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_env
+ *  Description        : block wise ADSR envelope and volume ramp
+ ******************************************************************************/
+
+#ifndef AUDIO_ENV_H
+#define AUDIO_ENV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+/* the envelope is evaluated every 2^AUDIO_ENV_TICK_SHIFT samples and
+ * interpolated linearly in between */
+#define AUDIO_ENV_TICK_SHIFT       5U
+#define AUDIO_ENV_TICK_SAMPLES     (1UL << AUDIO_ENV_TICK_SHIFT)
+
+#define AUDIO_ENV_SHAPES           4U        // envelope ids of the melody notation
+#define AUDIO_ENV_GAIN_ONE         (1L << 30) // Q30 gain of 1.0
+
+/* volume changes are spread over 2^AUDIO_ENV_RAMP_SHIFT samples */
+#ifndef AUDIO_ENV_RAMP_SHIFT
+#define AUDIO_ENV_RAMP_SHIFT       10U
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief envelope state of one note, gains in Q30
+ */
+typedef struct AudioEnv_t
+{
+  int32_t s32_Gain;         // gain of the next sample
+  int32_t s32_Step;         // gain increment per sample in this tick
+  int32_t s32_Target;       // gain at the end of this tick
+  int32_t s32_RelStep;      // release decrement per tick
+  uint16_t u16_TickLeft;    // samples left in this tick
+  uint8_t u8_Stage;         // AudioEnv stage
+  uint8_t u8_Shape;         // envelope id
+} AudioEnv_t;
+
+/*
+ * @brief linear gain ramp, gains in Q30
+ */
+typedef struct AudioEnv_Ramp_t
+{
+  int32_t s32_Gain;         // current gain
+  int32_t s32_Target;       // gain at the end of the ramp
+  int32_t s32_Step;         // gain increment per sample
+  uint32_t u32_Left;        // samples left of the ramp
+} AudioEnv_Ramp_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void AudioEnv_NoteOn(AudioEnv_t *pst_Env, uint8_t u8_Shape);
+void AudioEnv_NoteOff(AudioEnv_t *pst_Env);
+bool AudioEnv_IsIdle(const AudioEnv_t *pst_Env);
+uint32_t AudioEnv_GetReleaseSamples(uint8_t u8_Shape);
+void AudioEnv_Apply(AudioEnv_t *pst_Env, int16_t *ps16_Buf, uint32_t u32_Samples);
+
+void AudioEnv_RampInit(AudioEnv_Ramp_t *pst_Ramp, int16_t s16_Gain);
+void AudioEnv_RampSet(AudioEnv_Ramp_t *pst_Ramp, int16_t s16_Gain);
+void AudioEnv_RampApply(AudioEnv_Ramp_t *pst_Ramp, int16_t *ps16_Buf, uint32_t u32_Samples);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_ENV_H
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_mix
+ *  Description        : fixed point N voice mixer
+ ******************************************************************************/
+
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+#include "audio_env.h"
+#include "audio_out.h"
+#include "audio_sink.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#ifndef AUDIO_MIX_VOICES
+#define AUDIO_MIX_VOICES           4U        // voices mixed per block
+#endif
+
+#define AUDIO_MIX_GAIN_UNITY       32767     // Q15 gain of ~1.0
+
+/* mix level above which peaks are compressed softly towards full scale */
+#ifndef AUDIO_MIX_KNEE
+#define AUDIO_MIX_KNEE             24576
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief one mixer input
+ */
+typedef struct AudioMix_Voice_t
+{
+  AudioOut_Source_t pf_Source;   // NULL when the voice is free
+  void *pv_Ctx;                  // source context
+  int16_t s16_Gain;              // Q15 gain
+} AudioMix_Voice_t;
+
+/*
+ * @brief Mixer state, the block buffers live here and not on the task stack
+ */
+typedef struct AudioMix_t
+{
+  AudioMix_Voice_t ast_Voice[AUDIO_MIX_VOICES];
+  AudioEnv_Ramp_t st_Volume;                 // master volume
+  int32_t as32_Acc[AUDIO_BLOCK_SAMPLES];     // mix accumulator
+  int16_t as16_Voice[AUDIO_BLOCK_SAMPLES];   // block of the voice being mixed
+} AudioMix_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void AudioMix_Init(AudioMix_t *pst_Mix);
+int32_t AudioMix_GetFreeVoice(const AudioMix_t *pst_Mix);
+void AudioMix_Start(AudioMix_t *pst_Mix, uint32_t u32_Voice, AudioOut_Source_t pf_Source, void *pv_Ctx, int16_t s16_Gain);
+void AudioMix_SetGain(AudioMix_t *pst_Mix, uint32_t u32_Voice, int16_t s16_Gain);
+void AudioMix_SetVolume(AudioMix_t *pst_Mix, int16_t s16_Gain);
+void AudioMix_Stop(AudioMix_t *pst_Mix, uint32_t u32_Voice);
+bool AudioMix_IsActive(const AudioMix_t *pst_Mix, uint32_t u32_Voice);
+uint32_t AudioMix_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Mix);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_MIX_H
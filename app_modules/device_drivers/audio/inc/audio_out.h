@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_out
+ *  Description        : block streaming audio output stage
+ ******************************************************************************/
+
+#ifndef AUDIO_OUT_H
+#define AUDIO_OUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+#include "audio_sink.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+/* number of blocks the producer keeps queued ahead of the DMA, 1..AUDIO_DMA_BLOCKS */
+#ifndef AUDIO_OUT_LATENCY_BLOCKS
+#define AUDIO_OUT_LATENCY_BLOCKS   2U
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief Sample source. Renders up to u32_Samples samples into ps16_Buf and
+ *        returns the number rendered, less than requested means finished.
+ */
+typedef uint32_t (*AudioOut_Source_t)(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Ctx);
+
+/*
+ * @brief output counters
+ */
+typedef struct AudioOut_Stats_t
+{
+  uint32_t u32_Blocks;       // blocks handed to the sink
+  uint32_t u32_Underruns;    // blocks the sink had to play without data
+  uint32_t u32_WriteErrors;  // blocks the sink refused
+} AudioOut_Stats_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void AudioOut_Init(const AudioSink_t *pst_Sink);
+bool AudioOut_Start(void);
+void AudioOut_Stop(void);
+bool AudioOut_Pump(AudioOut_Source_t pf_Source, void *pv_Ctx, uint32_t u32_TimeoutMs);
+void AudioOut_GetStats(AudioOut_Stats_t *pst_Stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_OUT_H
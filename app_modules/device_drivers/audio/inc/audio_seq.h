@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_seq
+ *  Description        : sequencer for the compiled melody blob
+ ******************************************************************************/
+
+#ifndef AUDIO_SEQ_H
+#define AUDIO_SEQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+#include "audio_dds.h"
+#include "audio_env.h"
+#include "melody_data.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief Sequencer state. The score is decoded one note record at a time
+ *        straight from flash, nothing is copied to RAM.
+ */
+typedef struct AudioSeq_t
+{
+  AudioDds_t st_Dds;          // oscillator of the current note
+  AudioEnv_t st_Env;          // envelope of the current note
+  const uint8_t *pu8_Note;    // next note record, NULL when finished
+  uint32_t u32_UnitSamples;   // samples per duration unit
+  uint32_t u32_Left;          // samples left of the current note
+  uint32_t u32_RelAt;         // samples left when the release starts
+  bool b_Rest;                // the current note is a rest
+  bool b_Released;            // the release of the current note has started
+} AudioSeq_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+bool AudioSeq_Start(AudioSeq_t *pst_Seq, uint8_t u8_Melody, int16_t s16_Amp);
+uint32_t AudioSeq_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Seq);
+uint32_t AudioSeq_GetLengthMs(uint8_t u8_Melody);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_SEQ_H
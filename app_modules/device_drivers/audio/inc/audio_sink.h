@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_sink
+ *  Description        : audio output device interface
+ ******************************************************************************/
+
+#ifndef AUDIO_SINK_H
+#define AUDIO_SINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define AUDIO_SAMPLE_RATE_HZ       16000U     // output sample rate
+#define AUDIO_BLOCK_SAMPLES        256U       // samples per DMA block (16 ms)
+#define AUDIO_DMA_BLOCKS           3U         // DMA blocks owned by the sink (triple buffering)
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief Output device. Blocks are always AUDIO_BLOCK_SAMPLES long, the sink
+ *        owns AUDIO_DMA_BLOCKS of them.
+ */
+typedef struct AudioSink_t
+{
+  bool (*pf_Enable)(void);                        // claim and start the device, the caller becomes the producer
+  void (*pf_Disable)(void);                       // stop the device
+  uint32_t (*pf_WaitFree)(uint32_t u32_TimeoutMs); // wait for a free block, returns the number of free blocks
+  bool (*pf_Write)(const int16_t *ps16_Buf);      // queue one block, only called when a block is free
+  uint32_t (*pf_Underruns)(void);                 // blocks the device had to fill with silence
+} AudioSink_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+extern const AudioSink_t AudioSink_I2s;
+extern const AudioSink_t AudioSink_Null;
+extern const AudioSink_t AudioSink_Wav;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void AudioSinkNull_SetRealtime(bool b_Realtime);
+uint32_t AudioSinkNull_GetSamples(void);
+bool AudioSinkWav_Open(const char *pc_Path);
+void AudioSinkWav_Close(void);
+uint32_t AudioSinkWav_GetSamples(void);
+uint32_t AudioSinkWav_GetChecksum(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AUDIO_SINK_H
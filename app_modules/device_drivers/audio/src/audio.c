@@ -22,27 +22,48 @@
 #include <stdio.h>
 #include "esp_log.h"
 #include <stdint.h>
-#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "driver/i2s_pdm.h"
-#include "driver/gpio.h"
-#include "esp_check.h"
+#include "freertos/queue.h"
 #include "audio.h"
-#include "pin_config.h"
-#include "extended_services.h"
+#include "audio_clip.h"
+#include "audio_mix.h"
+#include "audio_out.h"
+#include "audio_seq.h"
+#include "boot.h"
+#include "fixed_math_library.h"
+#include "power.h"
 
 /******************************************************************************/
 /* PRIVATE DEFINITIONS                                                        */
 /******************************************************************************/
+/* volume 1..100 % spans AUDIO_VOLUME_RANGE_LOG2 octaves of gain (40 dB) */
+#define AUDIO_VOLUME_RANGE_LOG2    435412L   // log2(100) in Q16
+#define AUDIO_TASK_STACK           2048U
+#define AUDIO_TASK_PRIO            4U
 
 /******************************************************************************/
 /* PRIVATE TYPE DEFINITIONS                                                   */
 /******************************************************************************/
+typedef enum Audio_Kind_t
+{
+  AUDIO_KIND_MELODY = 0,     // synthesized from the melody blob
+  AUDIO_KIND_CLIP            // ADPCM clip from the clip partition
+}Audio_Kind_t;
+
+typedef struct Audio_SoundDef_t
+{
+  Audio_Kind_t e_Kind;
+  uint16_t u16_Id;           // melody or clip index
+  int16_t s16_Gain;          // mixer gain in Q15
+}Audio_SoundDef_t;
 
 /******************************************************************************/
 /* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
 /******************************************************************************/
+static bool Audio_StartSound(Audio_Sound_t e_Sound);
+static void Audio_Start(void);
+static void Audio_task(void *param);
 
 /******************************************************************************/
 /* EXTERN VARIABLE DEFINTIONS                                                 */
@@ -51,107 +72,180 @@
 /******************************************************************************/
 /* PRIVATE DATA DEFINTIONS                                                    */
 /******************************************************************************/
-#define EXAMPLE_BUFF_SIZE   1024
-#define EXAMPLE_PDM_TX_FREQ_HZ          16000           // I2S PDM TX frequency
-#define EXAMPLE_WAVE_AMPLITUDE          (1000.0)        // 1~32767
-#define CONST_PI                        (3.1416f)
-#define EXAMPLE_SINE_WAVE_LEN(tone)     (uint32_t)((EXAMPLE_PDM_TX_FREQ_HZ / (float)tone) + 0.5) // The sample point number per sine wave to generate the tone
-#define EXAMPLE_TONE_LAST_TIME_MS       500
-#define EXAMPLE_BYTE_NUM_EVERY_TONE     (EXAMPLE_TONE_LAST_TIME_MS * EXAMPLE_PDM_TX_FREQ_HZ / 1000)
-
-/* The frequency of tones: do, re, mi, fa, so, la, si, in Hz. */
-static const uint32_t tone[1][7] = {
-    {262, 294, 330, 349, 392, 440, 494},        // bass
+const static char *TAG = "audio";
+
+/* what is played for every sound */
+static const Audio_SoundDef_t sound_def[AUDIO_SOUND_MAX] = {
+    { AUDIO_KIND_MELODY, MELODY_CONFIRM,        AUDIO_MIX_GAIN_UNITY },
+    { AUDIO_KIND_MELODY, MELODY_DRINK_REMINDER, AUDIO_MIX_GAIN_UNITY },
+    { AUDIO_KIND_MELODY, MELODY_CLEAN_REMINDER, AUDIO_MIX_GAIN_UNITY },
+    { AUDIO_KIND_CLIP,   0,                     AUDIO_MIX_GAIN_UNITY },
 };
-/* Numbered musical notation of 'twinkle twinkle little star' */
-static const uint8_t song[28] = {1, 1, 5, 5, 6, 6, 5,
-                                 4, 4, 3, 3, 2, 2, 1,
-                                 5, 5, 4, 4, 3, 3, 2,
-                                 5, 5, 4, 4, 3, 3, 2
-                                };
-/* Rhythm of 'twinkle twinkle little star', it's repeated in four sections */
-static const uint8_t rhythm[7] = {1, 1, 1, 1, 1, 1, 2};
 
-static const char *tone_name[1] = {"bass"};
+static QueueHandle_t play_queue = NULL;
+static AudioMix_t mixer;
+/* player state of every mixer voice */
+static AudioSeq_t voice_seq[AUDIO_MIX_VOICES];
+static AudioClip_t voice_clip[AUDIO_MIX_VOICES];
+static volatile bool output_active = false;     // output enabled, playing or waiting for the idle timeout
+static volatile int16_t volume_gain = 0;        // requested master volume, Q15
+static bool volume_set = false;                 // Audio_SetVolume called, else AUDIO_VOLUME_DEFAULT
+static Boot_Drv_t audio_drv = BOOT_DRV("audio", Audio_Start);
 
 /******************************************************************************/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /******************************************************************************/
-static i2s_chan_handle_t i2s_example_init_pdm_tx(void)
+
+/**
+ * @brief audio service initialization, run by the first Audio_Play. Creates
+ *        the request queue and the audio task, no hardware is touched until
+ *        a sound is played.
+ *
+ */
+static void Audio_Start(void)
 {
-    i2s_chan_handle_t tx_chan;        // I2S tx channel handler
-    /* Setp 1: Determine the I2S channel configuration and allocate TX channel only
-     * The default configuration can be generated by the helper macro,
-     * it only requires the I2S controller id and I2S role,
-     * but note that PDM channel can only be registered on I2S_NUM_0 */
-    i2s_chan_config_t tx_chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
-    tx_chan_cfg.auto_clear = true;
-    ESP_ERROR_CHECK(i2s_new_channel(&tx_chan_cfg, &tx_chan, NULL));
-
-    /* Step 2: Setting the configurations of PDM TX mode and initialize the TX channel
-     * The slot configuration and clock configuration can be generated by the macros
-     * These two helper macros is defined in 'i2s_pdm.h' which can only be used in PDM TX mode.
-     * They can help to specify the slot and clock configurations for initialization or re-configuring */
-    i2s_pdm_tx_config_t pdm_tx_cfg = {
-
-        .clk_cfg = I2S_PDM_TX_CLK_DEFAULT_CONFIG(EXAMPLE_PDM_TX_FREQ_HZ),
-        /* The data bit-width of PDM mode is fixed to 16 */
-        .slot_cfg = I2S_PDM_TX_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO),
-        .gpio_cfg = {
-            .clk = I2S_BCLK_IO1,
-            .dout = I2S_DOUT_IO1,
-            .invert_flags = {
-                .clk_inv = false,
-            },
-        },
-    };
-    ESP_ERROR_CHECK(i2s_channel_init_pdm_tx_mode(tx_chan, &pdm_tx_cfg));
-
-    /* Step 3: Enable the tx channel before writing data */
-    ESP_ERROR_CHECK(i2s_channel_enable(tx_chan));
-
-    return tx_chan;
+    play_queue = xQueueCreate(AUDIO_QUEUE_LEN, sizeof(Audio_Sound_t));
+    assert(play_queue);
+    AudioMix_Init(&mixer);
+    if (volume_set == false) {
+        Audio_SetVolume(AUDIO_VOLUME_DEFAULT);
+    }
+    AudioOut_Init(&AudioSink_I2s);
+    if (xTaskCreate(Audio_task, "Audio_task", AUDIO_TASK_STACK, NULL, AUDIO_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "no audio task\n");
+    }
 }
 
-/******************************************************************************/
-/* PUBLIC FUNCTION DEFINITIONS                                                */
-/******************************************************************************/
 /**
- * @brief Audio task
+ * @brief Audio task, sleeps on the request queue. The output is enabled on
+ *        the first request and disabled again after AUDIO_IDLE_OFF_MS
+ *        without requests. Requests arriving while playing are mixed in.
  * @param param
  */
-void Audio_task(void *param) 
+static void Audio_task(void *param)
 {  
-    int16_t *w_buf = (int16_t *)calloc(1, EXAMPLE_BUFF_SIZE);
-    assert(w_buf);
-    i2s_chan_handle_t tx_chan = i2s_example_init_pdm_tx();
-
-    size_t w_bytes = 0;
+    Audio_Sound_t sound;
+    int16_t volume = AUDIO_MIX_GAIN_UNITY;
+    bool output_on = false;
+    bool playing = false;
 
-    uint8_t cnt = 0;            // The current index of the song
-
-    printf("Playing %s `twinkle twinkle little star`\n", tone_name[0]);
   while (1) {
-        int tone_point = EXAMPLE_SINE_WAVE_LEN(tone[0][song[cnt] - 1]);
-        /* Generate the tone buffer */
-        for (int i = 0; i < tone_point; i++) {
-            w_buf[i] = (int16_t)((sin(2 * (float)i * CONST_PI / tone_point)) * EXAMPLE_WAVE_AMPLITUDE);
-        }
-        for (int tot_bytes = 0; tot_bytes < EXAMPLE_BYTE_NUM_EVERY_TONE * rhythm[cnt % 7]; tot_bytes += w_bytes) {
-            /* Play the tone */
-            if (i2s_channel_write(tx_chan, w_buf, tone_point * sizeof(int16_t), &w_bytes, 1000) != ESP_OK) {
-                printf("Write Task: i2s write failed\n");
+        /* while playing only poll, the pump below does the waiting */
+        const TickType_t wait = playing ? 0 : (output_on ? pdMS_TO_TICKS(AUDIO_IDLE_OFF_MS) : portMAX_DELAY);
+
+        if (xQueueReceive(play_queue, &sound, wait) == pdTRUE) {
+            if (output_on == false) {
+                /* no light sleep while the I2S output runs */
+                Power_Hold(POWER_CLIENT_AUDIO);
+                if (AudioOut_Start() != false) {
+                    output_on = true;
+                    output_active = true;
+                } else {
+                    Power_Release(POWER_CLIENT_AUDIO);
+                }
+            }
+            if ((output_on != false) && (Audio_StartSound(sound) != false)) {
+                playing = true;
             }
+            ESP_LOGI(TAG, "play %d\n", sound);
+        } else if (playing == false) {
+            /* idle timeout, power the output down */
+            AudioOut_Stop();
+            output_on = false;
+            output_active = false;
+            Power_Release(POWER_CLIENT_AUDIO);
         }
-        cnt++;
-        /* If finished playing, switch the tone level */
-        if (cnt == sizeof(song)) {
-            cnt = 0;
-            printf("Playing %s `twinkle twinkle little star`\n", tone_name[0]);
+
+        if (volume != volume_gain) {
+            volume = volume_gain;
+            AudioMix_SetVolume(&mixer, volume);
+        }
+
+        if (playing != false) {
+            /* sleeps until the DMA hands back a block, then tops the queue up */
+            playing = AudioOut_Pump(AudioMix_Fill, &mixer, 100);
         }
-        /* Gap between the tones */
-    vTaskDelay(10 / portTICK_PERIOD_MS);
   }
-  free(w_buf);
   vTaskDelete(NULL);
-}	
+}
+
+/**
+ * @brief Start a sound on a free mixer voice, layered over what is playing
+ * @param e_Sound : sound to play
+ * @return false if no voice is free or the sound can not be played
+ */
+static bool Audio_StartSound(Audio_Sound_t e_Sound)
+{
+    const Audio_SoundDef_t *def = &sound_def[e_Sound];
+    const int32_t voice = AudioMix_GetFreeVoice(&mixer);
+    bool ret = false;
+
+    if (voice < 0) {
+        ESP_LOGW(TAG, "no free voice\n");
+    } else if (def->e_Kind == AUDIO_KIND_CLIP) {
+        ret = AudioClip_Start(&voice_clip[voice], def->u16_Id);
+        if (ret != false) {
+            AudioMix_Start(&mixer, (uint32_t)voice, AudioClip_Fill, &voice_clip[voice], def->s16_Gain);
+        }
+    } else {
+        ret = AudioSeq_Start(&voice_seq[voice], (uint8_t)def->u16_Id, AUDIO_AMPLITUDE);
+        if (ret != false) {
+            AudioMix_Start(&mixer, (uint32_t)voice, AudioSeq_Fill, &voice_seq[voice], def->s16_Gain);
+        }
+    }
+    return ret;
+}
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief Request a sound, never blocks once the audio service runs. The
+ *        first request starts the service.
+ * @param e_Sound : sound to play
+ * @return false if the request queue is full
+ */
+bool Audio_Play(Audio_Sound_t e_Sound)
+{
+    bool ret = false;
+
+    if (e_Sound < AUDIO_SOUND_MAX) {
+        Boot_Use(&audio_drv);
+        ret = (xQueueSend(play_queue, &e_Sound, 0) == pdTRUE);
+    }
+    return ret;
+}
+
+/**
+ * @brief Check if the audio service is powered down with nothing to play
+ * @return true when idle
+ */
+bool Audio_IsIdle(void)
+{
+    if (Boot_IsReady(&audio_drv) == false) {
+        return true;
+    }
+    return (output_active == false) && (uxQueueMessagesWaiting(play_queue) == 0U);
+}
+
+/**
+ * @brief Set the master volume, applied as a short ramp by the audio task.
+ *        The steps are logarithmic, each percent is the same loudness step.
+ * @param u8_Percent : 0..100, 0 mutes
+ */
+void Audio_SetVolume(uint8_t u8_Percent)
+{
+    int32_t gain = 0;
+
+    if (u8_Percent > 100U) {
+        u8_Percent = 100U;
+    }
+    if (u8_Percent > 0U) {
+        /* 2^(range * (p - 100) / 100), Q16 result to Q15 */
+        const int32_t exponent = ((int32_t)u8_Percent - 100) * (AUDIO_VOLUME_RANGE_LOG2 / 100);
+        gain = (int32_t)(Srvc_Exp2_S32_Q16(exponent) >> 1);
+    }
+    volume_gain = (int16_t)((gain > AUDIO_MIX_GAIN_UNITY) ? AUDIO_MIX_GAIN_UNITY : gain);
+    volume_set = true;
+}
+
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_clip
+ *  Description        : IMA-ADPCM clip player streaming from flash
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include "esp_log.h"
+#include "audio_clip.h"
+#include "audio_sink.h"
+#include "flash_port.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+/*
+ * Clip image layout (little endian), written by tools/clip_packer.py
+ *   header     : u32 magic, u16 clip count, u16 reserved
+ *   directory  : per clip u32 offset, u32 size, u32 samples, u16 rate, u16 block size
+ *   data       : IMA-ADPCM blocks, each s16 first sample, u8 step index,
+ *                u8 reserved, then two samples per byte, low nibble first
+ */
+#define AUDIO_CLIP_HDR_SIZE        8U
+#define AUDIO_CLIP_DIR_SIZE        16U
+#define AUDIO_CLIP_BLOCK_HDR       4U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t AudioClip_Rd32(const uint8_t *pu8_Src);
+static uint16_t AudioClip_Rd16(const uint8_t *pu8_Src);
+static void AudioClip_NextBlock(AudioClip_t *pst_Clip, int16_t *ps16_Out);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "clip";
+
+static const int8_t ima_index_tab[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const int16_t ima_step_tab[89] = {
+      7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+     19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+     50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+   2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+   5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static FlashPort_t clip_part;
+static const uint8_t *clip_image = NULL;     // mapped partition
+static uint16_t clip_count = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Map the clip partition and validate its header. Cheap to call
+ *        again once mapped.
+ * @return true if clips are available
+ */
+bool AudioClip_Open(void)
+{
+  if (clip_image != NULL) {
+    return true;
+  }
+
+  if ((FlashPort_Open(&clip_part, AUDIO_CLIP_PARTITION) != false) &&
+      (clip_part.u32_Size >= AUDIO_CLIP_HDR_SIZE)) {
+    const uint8_t *img = (const uint8_t *)FlashPort_Mmap(&clip_part);
+
+    if ((img != NULL) && (AudioClip_Rd32(img) == AUDIO_CLIP_MAGIC) &&
+        ((AUDIO_CLIP_HDR_SIZE + ((uint32_t)AudioClip_Rd16(&img[4]) * AUDIO_CLIP_DIR_SIZE)) <= clip_part.u32_Size)) {
+      clip_image = img;
+      clip_count = AudioClip_Rd16(&img[4]);
+    } else {
+      FlashPort_Munmap(&clip_part);
+      ESP_LOGW(TAG, "no clip image\n");
+    }
+  }
+  return clip_image != NULL;
+}
+
+/**
+ * @brief Number of clips in the image
+ * @return clip count, 0 if not opened
+ */
+uint16_t AudioClip_GetCount(void)
+{
+  return clip_count;
+}
+
+/**
+ * @brief Prepare a clip for playback
+ * @param pst_Clip : decoder state
+ * @param u16_Clip : clip index
+ * @return false if the clip does not exist or does not match the output rate
+ */
+bool AudioClip_Start(AudioClip_t *pst_Clip, uint16_t u16_Clip)
+{
+  pst_Clip->u32_Left = 0;
+  pst_Clip->u16_BlockLeft = 0;
+
+  if ((AudioClip_Open() == false) || (u16_Clip >= clip_count)) {
+    return false;
+  }
+
+  const uint8_t *dir = &clip_image[AUDIO_CLIP_HDR_SIZE + ((uint32_t)u16_Clip * AUDIO_CLIP_DIR_SIZE)];
+  const uint32_t u32_Off = AudioClip_Rd32(&dir[0]);
+  const uint32_t u32_Size = AudioClip_Rd32(&dir[4]);
+  const uint16_t u16_Block = AudioClip_Rd16(&dir[14]);
+
+  if ((AudioClip_Rd16(&dir[12]) != AUDIO_SAMPLE_RATE_HZ) || (u16_Block <= AUDIO_CLIP_BLOCK_HDR) ||
+      (u32_Off > clip_part.u32_Size) || (u32_Size > (clip_part.u32_Size - u32_Off))) {
+    ESP_LOGW(TAG, "clip %u invalid\n", u16_Clip);
+    return false;
+  }
+
+  pst_Clip->pu8_Block = &clip_image[u32_Off];
+  pst_Clip->u16_BlockSize = u16_Block;
+  pst_Clip->u32_Left = AudioClip_Rd32(&dir[8]);
+  /* never decode past the clip data, even if the sample count is wrong */
+  const uint32_t u32_MaxSamples = (u32_Size / u16_Block) * (((uint32_t)(u16_Block - AUDIO_CLIP_BLOCK_HDR) * 2U) + 1U);
+  if (pst_Clip->u32_Left > u32_MaxSamples) {
+    pst_Clip->u32_Left = u32_MaxSamples;
+  }
+  return true;
+}
+
+/**
+ * @brief Sample source (AudioOut_Source_t) decoding the clip straight from
+ *        the mapping into the output block
+ * @param ps16_Buf : destination
+ * @param u32_Samples : samples requested
+ * @param pv_Clip : decoder state
+ * @return samples rendered, less than requested at the end of the clip
+ */
+uint32_t AudioClip_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Clip)
+{
+  AudioClip_t *pst_Clip = (AudioClip_t *)pv_Clip;
+  uint32_t u32_Done = 0;
+
+  if (u32_Samples > pst_Clip->u32_Left) {
+    u32_Samples = pst_Clip->u32_Left;
+  }
+
+  while (u32_Done < u32_Samples) {
+    if (pst_Clip->u16_BlockLeft == 0U) {
+      AudioClip_NextBlock(pst_Clip, &ps16_Buf[u32_Done++]);
+      continue;
+    }
+
+    int32_t s32_Pred = pst_Clip->s32_Pred;
+    int32_t s32_Index = pst_Clip->s8_Index;
+    const uint8_t *pu8_Nib = pst_Clip->pu8_Nib;
+    bool b_High = pst_Clip->b_High;
+    uint32_t u32_Num = u32_Samples - u32_Done;
+
+    if (u32_Num > pst_Clip->u16_BlockLeft) {
+      u32_Num = pst_Clip->u16_BlockLeft;
+    }
+    pst_Clip->u16_BlockLeft -= (uint16_t)u32_Num;
+
+    for (uint32_t i = 0; i < u32_Num; i++) {
+      const uint32_t u32_Code = (b_High != false) ? ((uint32_t)*pu8_Nib++ >> 4) : ((uint32_t)*pu8_Nib & 0x0FU);
+      const int32_t s32_Step = ima_step_tab[s32_Index];
+      int32_t s32_Diff = s32_Step >> 3;
+
+      b_High = !b_High;
+      if ((u32_Code & 4U) != 0U) { s32_Diff += s32_Step; }
+      if ((u32_Code & 2U) != 0U) { s32_Diff += s32_Step >> 1; }
+      if ((u32_Code & 1U) != 0U) { s32_Diff += s32_Step >> 2; }
+      s32_Pred += ((u32_Code & 8U) != 0U) ? -s32_Diff : s32_Diff;
+      s32_Pred = (s32_Pred > INT16_MAX) ? INT16_MAX : ((s32_Pred < INT16_MIN) ? INT16_MIN : s32_Pred);
+
+      s32_Index += ima_index_tab[u32_Code];
+      s32_Index = (s32_Index < 0) ? 0 : ((s32_Index > 88) ? 88 : s32_Index);
+
+      ps16_Buf[u32_Done + i] = (int16_t)s32_Pred;
+    }
+
+    u32_Done += u32_Num;
+    pst_Clip->s32_Pred = s32_Pred;
+    pst_Clip->s8_Index = (int8_t)s32_Index;
+    pst_Clip->pu8_Nib = pu8_Nib;
+    pst_Clip->b_High = b_High;
+  }
+
+  pst_Clip->u32_Left -= u32_Done;
+  return u32_Done;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+static uint32_t AudioClip_Rd32(const uint8_t *pu8_Src)
+{
+  return (uint32_t)pu8_Src[0] | ((uint32_t)pu8_Src[1] << 8) | ((uint32_t)pu8_Src[2] << 16) | ((uint32_t)pu8_Src[3] << 24);
+}
+
+static uint16_t AudioClip_Rd16(const uint8_t *pu8_Src)
+{
+  return (uint16_t)((uint16_t)pu8_Src[0] | ((uint16_t)pu8_Src[1] << 8));
+}
+
+/**
+ * @brief Enter the next ADPCM block, its header carries the first sample
+ * @param pst_Clip : decoder state
+ * @param ps16_Out : destination of the header sample
+ */
+static void AudioClip_NextBlock(AudioClip_t *pst_Clip, int16_t *ps16_Out)
+{
+  const uint8_t *blk = pst_Clip->pu8_Block;
+
+  pst_Clip->s32_Pred = (int16_t)AudioClip_Rd16(&blk[0]);
+  pst_Clip->s8_Index = (int8_t)((blk[2] > 88U) ? 88U : blk[2]);
+  pst_Clip->pu8_Nib = &blk[AUDIO_CLIP_BLOCK_HDR];
+  pst_Clip->b_High = false;
+  pst_Clip->u16_BlockLeft = (uint16_t)((pst_Clip->u16_BlockSize - AUDIO_CLIP_BLOCK_HDR) * 2U);
+  pst_Clip->pu8_Block = &blk[pst_Clip->u16_BlockSize];
+
+  *ps16_Out = (int16_t)pst_Clip->s32_Pred;
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_dds
+ *  Description        : fixed point direct digital synthesis of sine tones
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdint.h>
+#include "audio_dds.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define AUDIO_DDS_IDX_SHIFT        (32U - AUDIO_DDS_TABLE_BITS)     // phase bits above the table index
+#define AUDIO_DDS_FRAC_SHIFT       (AUDIO_DDS_IDX_SHIFT - 15U)      // Q15 fraction right below the index
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* One sine period in Q15, the extra entry repeats the first one so that the
+ * interpolation never has to wrap. Being const it stays in flash. */
+static const int16_t audio_dds_sine[(1U << AUDIO_DDS_TABLE_BITS) + 1U] = {
+       0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+    6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+   12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+   18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+   23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+   27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+   30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+   32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+   32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+   32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+   30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+   27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+   23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+   18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+   12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+    6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+       0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+   -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+  -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+  -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+  -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+  -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+  -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+  -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+  -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+  -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+  -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+  -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+  -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+  -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+  -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+   -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804,
+       0
+};
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief oscillator initialization function
+ * @param pst_Dds : oscillator
+ * @param s16_Amp : peak amplitude 0..32767
+ *
+ */
+void AudioDds_Init(AudioDds_t *pst_Dds, int16_t s16_Amp)
+{
+  pst_Dds->u32_Phase = 0;
+  pst_Dds->u32_Step = 0;
+  pst_Dds->s16_Amp = s16_Amp;
+}
+
+/**
+ * @brief Set the tone frequency. The phase is restarted so that every note
+ *        begins at a zero crossing. The step is exact to fs / 2^32 Hz, so
+ *        unlike a whole-sample period the pitch is not rounded.
+ * @param pst_Dds : oscillator
+ * @param u32_FreqHz : tone frequency in Hz, below u32_SampleRateHz / 2
+ * @param u32_SampleRateHz : output sample rate in Hz
+ *
+ */
+void AudioDds_SetFreq(AudioDds_t *pst_Dds, uint32_t u32_FreqHz, uint32_t u32_SampleRateHz)
+{
+  AudioDds_SetFreqCHz(pst_Dds, u32_FreqHz * 100U, u32_SampleRateHz);
+}
+
+/**
+ * @brief Set the tone frequency in 1/100 Hz, see AudioDds_SetFreq
+ * @param pst_Dds : oscillator
+ * @param u32_FreqCHz : tone frequency in 1/100 Hz
+ * @param u32_SampleRateHz : output sample rate in Hz
+ *
+ */
+void AudioDds_SetFreqCHz(AudioDds_t *pst_Dds, uint32_t u32_FreqCHz, uint32_t u32_SampleRateHz)
+{
+  const uint64_t u64_Div = (uint64_t)u32_SampleRateHz * 100U;
+
+  pst_Dds->u32_Phase = 0;
+  pst_Dds->u32_Step = (uint32_t)((((uint64_t)u32_FreqCHz << 32) + (u64_Div / 2U)) / u64_Div);
+}
+
+/**
+ * @brief Render a block of samples, no libm and no divide per sample
+ * @param pst_Dds : oscillator
+ * @param ps16_Buf : destination
+ * @param u32_Samples : number of samples to render
+ *
+ */
+void AudioDds_Fill(AudioDds_t *pst_Dds, int16_t *ps16_Buf, uint32_t u32_Samples)
+{
+  uint32_t u32_Phase = pst_Dds->u32_Phase;
+  const uint32_t u32_Step = pst_Dds->u32_Step;
+  const int32_t s32_Amp = pst_Dds->s16_Amp;
+
+  for (uint32_t i = 0; i < u32_Samples; i++) {
+    const uint32_t u32_Idx = u32_Phase >> AUDIO_DDS_IDX_SHIFT;
+    int32_t s32_Val = audio_dds_sine[u32_Idx];
+#if (AUDIO_DDS_INTERPOLATE == 1)
+    const int32_t s32_Frac = (int32_t)((u32_Phase >> AUDIO_DDS_FRAC_SHIFT) & 0x7FFFU);
+    s32_Val += ((audio_dds_sine[u32_Idx + 1U] - s32_Val) * s32_Frac) >> 15;
+#endif
+    ps16_Buf[i] = (int16_t)((s32_Val * s32_Amp) >> 15);
+    u32_Phase += u32_Step;
+  }
+
+  pst_Dds->u32_Phase = u32_Phase;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
@@ -0,0 +1,280 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_env
+ *  Description        : block wise ADSR envelope and volume ramp
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "audio_env.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define AUDIO_ENV_IDLE             0U
+#define AUDIO_ENV_ATTACK           1U
+#define AUDIO_ENV_DECAY            2U        // decay, settles on the sustain level
+#define AUDIO_ENV_RELEASE          3U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+/*
+ * @brief envelope shape, all times are powers of two ticks so every
+ *        step is a shift
+ */
+typedef struct AudioEnv_Shape_t
+{
+  uint8_t u8_AttackShift;    // linear attack over 2^n ticks
+  uint8_t u8_DecayShift;     // exponential decay, 1/2^n of the distance per tick
+  uint8_t u8_SustainShift;   // sustain level is 1 - 1/2^n, 0 decays to silence
+  uint8_t u8_ReleaseShift;   // linear release over 2^n ticks
+} AudioEnv_Shape_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void AudioEnv_NextTick(AudioEnv_t *pst_Env);
+static void AudioEnv_Scale(int16_t *ps16_Buf, uint32_t u32_Samples, int32_t *ps32_Gain, int32_t s32_Step);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* envelope ids of the melody notation, one tick is 2 ms at 16 kHz */
+static const AudioEnv_Shape_t audio_env_shape[AUDIO_ENV_SHAPES] = {
+  { 2U, 4U, 2U, 3U },   // 0 default : 8 ms attack, settles at 75 %, 16 ms release
+  { 1U, 3U, 0U, 3U },   // 1 pluck   : 4 ms attack, dies away, 16 ms release
+  { 5U, 6U, 1U, 5U },   // 2 soft    : 64 ms attack, settles at 50 %, 64 ms release
+  { 0U, 2U, 1U, 2U },   // 3 staccato: 2 ms attack, quick fall to 50 %, 8 ms release
+};
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Start the attack of a note. The gain continues from where it is,
+ *        a note following a released one starts from silence.
+ * @param pst_Env : envelope
+ * @param u8_Shape : envelope id 0..AUDIO_ENV_SHAPES-1
+ */
+void AudioEnv_NoteOn(AudioEnv_t *pst_Env, uint8_t u8_Shape)
+{
+  if (AudioEnv_IsIdle(pst_Env) != false) {
+    pst_Env->s32_Gain = 0;
+  }
+  pst_Env->s32_Target = pst_Env->s32_Gain;
+  pst_Env->s32_Step = 0;
+  pst_Env->u16_TickLeft = 0;
+  pst_Env->u8_Shape = (u8_Shape < AUDIO_ENV_SHAPES) ? u8_Shape : 0U;
+  pst_Env->u8_Stage = AUDIO_ENV_ATTACK;
+}
+
+/**
+ * @brief Start the release, the gain reaches 0 after
+ *        AudioEnv_GetReleaseSamples samples from the next tick on
+ * @param pst_Env : envelope
+ */
+void AudioEnv_NoteOff(AudioEnv_t *pst_Env)
+{
+  if (pst_Env->u8_Stage != AUDIO_ENV_IDLE) {
+    /* release from where this tick ends */
+    pst_Env->s32_RelStep = (pst_Env->s32_Target >> audio_env_shape[pst_Env->u8_Shape].u8_ReleaseShift) + 1;
+    pst_Env->u8_Stage = AUDIO_ENV_RELEASE;
+  }
+}
+
+/**
+ * @brief Check if the envelope has released to silence. The stage turns
+ *        idle when the last release tick starts, silence is reached once
+ *        that tick has ramped down.
+ * @param pst_Env : envelope
+ * @return true when silent
+ */
+bool AudioEnv_IsIdle(const AudioEnv_t *pst_Env)
+{
+  return (pst_Env->u8_Stage == AUDIO_ENV_IDLE) && (pst_Env->u16_TickLeft == 0U);
+}
+
+/**
+ * @brief Samples from AudioEnv_NoteOff to silence, including the tick in
+ *        progress
+ * @param u8_Shape : envelope id
+ * @return release length in samples
+ */
+uint32_t AudioEnv_GetReleaseSamples(uint8_t u8_Shape)
+{
+  const uint8_t u8_Shift = audio_env_shape[(u8_Shape < AUDIO_ENV_SHAPES) ? u8_Shape : 0U].u8_ReleaseShift;
+  return ((1UL << u8_Shift) + 1U) << AUDIO_ENV_TICK_SHIFT;
+}
+
+/**
+ * @brief Scale a block by the envelope. The gain target is updated once
+ *        per tick, samples in between get a linearly interpolated gain.
+ * @param pst_Env : envelope
+ * @param ps16_Buf : samples, scaled in place
+ * @param u32_Samples : number of samples
+ */
+void AudioEnv_Apply(AudioEnv_t *pst_Env, int16_t *ps16_Buf, uint32_t u32_Samples)
+{
+  while (u32_Samples > 0U) {
+    if (AudioEnv_IsIdle(pst_Env) != false) {
+      /* released, the same silence as a caller skipping the idle envelope */
+      (void)memset(ps16_Buf, 0, u32_Samples * sizeof(int16_t));
+      break;
+    }
+    if (pst_Env->u16_TickLeft == 0U) {
+      AudioEnv_NextTick(pst_Env);
+    }
+
+    uint32_t u32_Num = pst_Env->u16_TickLeft;
+    if (u32_Num > u32_Samples) {
+      u32_Num = u32_Samples;
+    }
+
+    AudioEnv_Scale(ps16_Buf, u32_Num, &pst_Env->s32_Gain, pst_Env->s32_Step);
+    pst_Env->u16_TickLeft -= (uint16_t)u32_Num;
+    ps16_Buf += u32_Num;
+    u32_Samples -= u32_Num;
+  }
+}
+
+/**
+ * @brief Set a ramp to a fixed gain
+ * @param pst_Ramp : ramp
+ * @param s16_Gain : Q15 gain
+ */
+void AudioEnv_RampInit(AudioEnv_Ramp_t *pst_Ramp, int16_t s16_Gain)
+{
+  pst_Ramp->s32_Gain = (int32_t)s16_Gain << 15;
+  pst_Ramp->s32_Target = pst_Ramp->s32_Gain;
+  pst_Ramp->s32_Step = 0;
+  pst_Ramp->u32_Left = 0;
+}
+
+/**
+ * @brief Glide to a new gain over 2^AUDIO_ENV_RAMP_SHIFT samples
+ * @param pst_Ramp : ramp
+ * @param s16_Gain : Q15 gain
+ */
+void AudioEnv_RampSet(AudioEnv_Ramp_t *pst_Ramp, int16_t s16_Gain)
+{
+  pst_Ramp->s32_Target = (int32_t)s16_Gain << 15;
+  pst_Ramp->s32_Step = (pst_Ramp->s32_Target - pst_Ramp->s32_Gain) >> AUDIO_ENV_RAMP_SHIFT;
+  pst_Ramp->u32_Left = 1UL << AUDIO_ENV_RAMP_SHIFT;
+}
+
+/**
+ * @brief Scale a block by the ramp gain
+ * @param pst_Ramp : ramp
+ * @param ps16_Buf : samples, scaled in place
+ * @param u32_Samples : number of samples
+ */
+void AudioEnv_RampApply(AudioEnv_Ramp_t *pst_Ramp, int16_t *ps16_Buf, uint32_t u32_Samples)
+{
+  if (pst_Ramp->u32_Left > 0U) {
+    const uint32_t u32_Num = (u32_Samples < pst_Ramp->u32_Left) ? u32_Samples : pst_Ramp->u32_Left;
+
+    AudioEnv_Scale(ps16_Buf, u32_Num, &pst_Ramp->s32_Gain, pst_Ramp->s32_Step);
+    pst_Ramp->u32_Left -= u32_Num;
+    if (pst_Ramp->u32_Left == 0U) {
+      pst_Ramp->s32_Gain = pst_Ramp->s32_Target;
+    }
+    ps16_Buf += u32_Num;
+    u32_Samples -= u32_Num;
+  }
+
+  /* unity needs no work */
+  if ((u32_Samples > 0U) && (pst_Ramp->s32_Gain < ((int32_t)INT16_MAX << 15))) {
+    AudioEnv_Scale(ps16_Buf, u32_Samples, &pst_Ramp->s32_Gain, 0);
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Advance the envelope by one tick and set up the interpolation
+ *        towards the new target
+ * @param pst_Env : envelope
+ */
+static void AudioEnv_NextTick(AudioEnv_t *pst_Env)
+{
+  const AudioEnv_Shape_t *shape = &audio_env_shape[pst_Env->u8_Shape];
+  int32_t s32_Target = pst_Env->s32_Target;
+
+  /* land exactly on the previous target, no drift from the step rounding */
+  pst_Env->s32_Gain = s32_Target;
+
+  switch (pst_Env->u8_Stage) {
+    case AUDIO_ENV_ATTACK:
+      s32_Target += (AUDIO_ENV_GAIN_ONE >> shape->u8_AttackShift);
+      if (s32_Target >= AUDIO_ENV_GAIN_ONE) {
+        s32_Target = AUDIO_ENV_GAIN_ONE;
+        pst_Env->u8_Stage = AUDIO_ENV_DECAY;
+      }
+      break;
+
+    case AUDIO_ENV_DECAY:
+    {
+      const int32_t s32_Sustain = (shape->u8_SustainShift == 0U) ? 0 :
+                                  (AUDIO_ENV_GAIN_ONE - (AUDIO_ENV_GAIN_ONE >> shape->u8_SustainShift));
+      s32_Target -= (s32_Target - s32_Sustain) >> shape->u8_DecayShift;
+      break;
+    }
+
+    case AUDIO_ENV_RELEASE:
+      s32_Target -= pst_Env->s32_RelStep;
+      if (s32_Target <= 0) {
+        s32_Target = 0;
+        pst_Env->u8_Stage = AUDIO_ENV_IDLE;
+      }
+      break;
+
+    default:
+      s32_Target = 0;
+      break;
+  }
+
+  pst_Env->s32_Target = s32_Target;
+  pst_Env->s32_Step = (s32_Target - pst_Env->s32_Gain) >> AUDIO_ENV_TICK_SHIFT;
+  pst_Env->u16_TickLeft = AUDIO_ENV_TICK_SAMPLES;
+}
+
+/**
+ * @brief Scale samples by a gain stepping linearly, no divides
+ * @param ps16_Buf : samples, scaled in place
+ * @param u32_Samples : number of samples
+ * @param ps32_Gain : Q30 gain, advanced by the samples processed
+ * @param s32_Step : gain increment per sample
+ */
+static void AudioEnv_Scale(int16_t *ps16_Buf, uint32_t u32_Samples, int32_t *ps32_Gain, int32_t s32_Step)
+{
+  int32_t s32_Gain = *ps32_Gain;
+
+  for (uint32_t i = 0; i < u32_Samples; i++) {
+    ps16_Buf[i] = (int16_t)(((int32_t)ps16_Buf[i] * (s32_Gain >> 15)) >> 15);
+    s32_Gain += s32_Step;
+  }
+  *ps32_Gain = s32_Gain;
+}
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_mix
+ *  Description        : fixed point N voice mixer
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "audio_mix.h"
+#include "multiplication_library.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define AUDIO_MIX_HEADROOM         (INT16_MAX - AUDIO_MIX_KNEE)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void AudioMix_SoftClip(int32_t *ps32_Acc, uint32_t u32_Samples);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Free all voices, master volume at unity
+ * @param pst_Mix : mixer
+ */
+void AudioMix_Init(AudioMix_t *pst_Mix)
+{
+  memset(pst_Mix->ast_Voice, 0, sizeof(pst_Mix->ast_Voice));
+  AudioEnv_RampInit(&pst_Mix->st_Volume, AUDIO_MIX_GAIN_UNITY);
+}
+
+/**
+ * @brief Find a voice to start a source on
+ * @param pst_Mix : mixer
+ * @return voice index, -1 if all voices are busy
+ */
+int32_t AudioMix_GetFreeVoice(const AudioMix_t *pst_Mix)
+{
+  for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+    if (pst_Mix->ast_Voice[v].pf_Source == NULL) {
+      return (int32_t)v;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Start a source on a voice, replacing what the voice was playing
+ * @param pst_Mix : mixer
+ * @param u32_Voice : voice index
+ * @param pf_Source : sample source, already started
+ * @param pv_Ctx : source context
+ * @param s16_Gain : Q15 gain
+ */
+void AudioMix_Start(AudioMix_t *pst_Mix, uint32_t u32_Voice, AudioOut_Source_t pf_Source, void *pv_Ctx, int16_t s16_Gain)
+{
+  if (u32_Voice < AUDIO_MIX_VOICES) {
+    AudioMix_Voice_t *voice = &pst_Mix->ast_Voice[u32_Voice];
+
+    voice->pv_Ctx = pv_Ctx;
+    voice->s16_Gain = s16_Gain;
+    voice->pf_Source = pf_Source;
+  }
+}
+
+/**
+ * @brief Change the gain of a voice, takes effect with the next block
+ * @param pst_Mix : mixer
+ * @param u32_Voice : voice index
+ * @param s16_Gain : Q15 gain
+ */
+void AudioMix_SetGain(AudioMix_t *pst_Mix, uint32_t u32_Voice, int16_t s16_Gain)
+{
+  if (u32_Voice < AUDIO_MIX_VOICES) {
+    pst_Mix->ast_Voice[u32_Voice].s16_Gain = s16_Gain;
+  }
+}
+
+/**
+ * @brief Change the master volume, ramped over 2^AUDIO_ENV_RAMP_SHIFT samples
+ * @param pst_Mix : mixer
+ * @param s16_Gain : Q15 gain
+ */
+void AudioMix_SetVolume(AudioMix_t *pst_Mix, int16_t s16_Gain)
+{
+  AudioEnv_RampSet(&pst_Mix->st_Volume, s16_Gain);
+}
+
+/**
+ * @brief Free a voice
+ * @param pst_Mix : mixer
+ * @param u32_Voice : voice index
+ */
+void AudioMix_Stop(AudioMix_t *pst_Mix, uint32_t u32_Voice)
+{
+  if (u32_Voice < AUDIO_MIX_VOICES) {
+    pst_Mix->ast_Voice[u32_Voice].pf_Source = NULL;
+  }
+}
+
+/**
+ * @brief Check if a voice is playing
+ * @param pst_Mix : mixer
+ * @param u32_Voice : voice index
+ * @return true while the voice has a source
+ */
+bool AudioMix_IsActive(const AudioMix_t *pst_Mix, uint32_t u32_Voice)
+{
+  return (u32_Voice < AUDIO_MIX_VOICES) && (pst_Mix->ast_Voice[u32_Voice].pf_Source != NULL);
+}
+
+/**
+ * @brief Sample source (AudioOut_Source_t) mixing all active voices. Every
+ *        voice renders the whole block in one call, it is then scaled and
+ *        accumulated in 32 bit, soft clipped and scaled by the master volume
+ *        once per block. Voices that run short are freed.
+ * @param ps16_Buf : destination
+ * @param u32_Samples : samples requested, at most AUDIO_BLOCK_SAMPLES
+ * @param pv_Mix : mixer
+ * @return samples rendered by the longest voice, 0 when no voice is left
+ */
+uint32_t AudioMix_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Mix)
+{
+  AudioMix_t *pst_Mix = (AudioMix_t *)pv_Mix;
+  uint32_t u32_Len = 0;
+
+  if (u32_Samples > AUDIO_BLOCK_SAMPLES) {
+    u32_Samples = AUDIO_BLOCK_SAMPLES;
+  }
+
+  memset(pst_Mix->as32_Acc, 0, u32_Samples * sizeof(int32_t));
+
+  for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+    AudioMix_Voice_t *voice = &pst_Mix->ast_Voice[v];
+
+    if (voice->pf_Source == NULL) {
+      continue;
+    }
+
+    const uint32_t u32_Num = voice->pf_Source(pst_Mix->as16_Voice, u32_Samples, voice->pv_Ctx);
+    Srvc_MulAcc_S16Q15_Blk(pst_Mix->as32_Acc, pst_Mix->as16_Voice, voice->s16_Gain, (uint16_t)u32_Num);
+
+    if (u32_Num > u32_Len) {
+      u32_Len = u32_Num;
+    }
+    if (u32_Num < u32_Samples) {
+      voice->pf_Source = NULL;
+    }
+  }
+
+  AudioMix_SoftClip(pst_Mix->as32_Acc, u32_Len);
+  Srvc_TypeLimiter_S32_S16_Blk(ps16_Buf, pst_Mix->as32_Acc, (uint16_t)u32_Len);
+  AudioEnv_RampApply(&pst_Mix->st_Volume, ps16_Buf, u32_Len);
+  return u32_Len;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Compress peaks above AUDIO_MIX_KNEE so the mix approaches full scale
+ *        smoothly instead of clipping hard:
+ *          y = knee + H * e / (e + H), e = |x| - knee, H = full scale - knee
+ *        The slope is 1 at the knee, the division only runs on peaks.
+ * @param ps32_Acc : mix, compressed in place
+ * @param u32_Samples : number of samples
+ */
+static void AudioMix_SoftClip(int32_t *ps32_Acc, uint32_t u32_Samples)
+{
+  for (uint32_t i = 0; i < u32_Samples; i++) {
+    const int32_t s32_X = ps32_Acc[i];
+    const int32_t s32_Abs = (s32_X < 0) ? -s32_X : s32_X;
+
+    if (s32_Abs > AUDIO_MIX_KNEE) {
+      const int64_t s64_Exc = (int64_t)s32_Abs - AUDIO_MIX_KNEE;
+      const int32_t s32_Y = AUDIO_MIX_KNEE + (int32_t)((s64_Exc * AUDIO_MIX_HEADROOM) / (s64_Exc + AUDIO_MIX_HEADROOM));
+      ps32_Acc[i] = (s32_X < 0) ? -s32_Y : s32_Y;
+    }
+  }
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_out
+ *  Description        : block streaming audio output stage
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <string.h>
+#include "audio_out.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static const AudioSink_t *sink = NULL;
+static int16_t block[AUDIO_BLOCK_SAMPLES];     // staging block, copied into the DMA ring by the sink
+static AudioOut_Stats_t stats;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief output stage initialization function
+ * @param pst_Sink : output device
+ *
+ */
+void AudioOut_Init(const AudioSink_t *pst_Sink)
+{
+  sink = pst_Sink;
+  (void)memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief Start streaming, the calling task becomes the producer
+ * @return true if the sink is running
+ */
+bool AudioOut_Start(void)
+{
+  return sink->pf_Enable();
+}
+
+/**
+ * @brief Stop streaming
+ *
+ */
+void AudioOut_Stop(void)
+{
+  sink->pf_Disable();
+}
+
+/**
+ * @brief Keep the sink topped up. Sleeps until the DMA returns a block, then
+ *        renders blocks until AUDIO_OUT_LATENCY_BLOCKS are queued ahead of
+ *        the DMA. A partial block from the source is padded with silence.
+ * @param pf_Source : sample source
+ * @param pv_Ctx : source context
+ * @param u32_TimeoutMs : maximum wait for a free block
+ * @return false once the source is finished
+ */
+bool AudioOut_Pump(AudioOut_Source_t pf_Source, void *pv_Ctx, uint32_t u32_TimeoutMs)
+{
+  bool b_Active = true;
+  uint32_t u32_Free = sink->pf_WaitFree(u32_TimeoutMs);
+
+  while ((b_Active != false) && ((AUDIO_DMA_BLOCKS - u32_Free) < AUDIO_OUT_LATENCY_BLOCKS)) {
+    uint32_t u32_Got = pf_Source(block, AUDIO_BLOCK_SAMPLES, pv_Ctx);
+
+    if (u32_Got < AUDIO_BLOCK_SAMPLES) {
+      (void)memset(&block[u32_Got], 0, (AUDIO_BLOCK_SAMPLES - u32_Got) * sizeof(int16_t));
+      b_Active = false;
+    }
+
+    if (u32_Got > 0U) {
+      if (sink->pf_Write(block) != false) {
+        stats.u32_Blocks++;
+      } else {
+        stats.u32_WriteErrors++;
+      }
+      u32_Free--;
+    }
+  }
+
+  return b_Active;
+}
+
+/**
+ * @brief Read the output counters
+ * @param pst_Stats : destination
+ *
+ */
+void AudioOut_GetStats(AudioOut_Stats_t *pst_Stats)
+{
+  *pst_Stats = stats;
+  pst_Stats->u32_Underruns = (sink != NULL) ? sink->pf_Underruns() : 0U;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
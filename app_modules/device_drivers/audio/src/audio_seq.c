@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_seq
+ *  Description        : sequencer for the compiled melody blob
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "audio_seq.h"
+#include "audio_sink.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+/* note record layout, see tools/melody_compiler.py */
+#define AUDIO_SEQ_PITCH_MASK       0x3FU
+#define AUDIO_SEQ_PITCH_REST       0x3FU
+#define AUDIO_SEQ_ENV_SHIFT        6U
+#define AUDIO_SEQ_END              0xFFU
+#define AUDIO_SEQ_RECORD_SIZE      2U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static const uint8_t *AudioSeq_Melody(uint8_t u8_Melody);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* equal temperament pitch in 1/100 Hz, index 0 is C3 */
+static const uint32_t audio_seq_pitch_cHz[AUDIO_SEQ_PITCH_REST] = {
+    13081,   13859,   14683,   15556,   16481,   17461,   18500,   19600,
+    20765,   22000,   23308,   24694,   26163,   27718,   29366,   31113,
+    32963,   34923,   36999,   39200,   41530,   44000,   46616,   49388,
+    52325,   55437,   58733,   62225,   65926,   69846,   73999,   78399,
+    83061,   88000,   93233,   98777,  104650,  110873,  117466,  124451,
+   131851,  139691,  147998,  156798,  166122,  176000,  186466,  197553,
+   209300,  221746,  234932,  248902,  263702,  279383,  295996,  313596,
+   332244,  352000,  372931,  395107,  418601,  443492,  469864,
+};
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Start playing a melody of the blob
+ * @param pst_Seq : sequencer
+ * @param u8_Melody : MELODY_xxx id
+ * @param s16_Amp : peak amplitude 0..32767
+ * @return false if the melody does not exist
+ */
+bool AudioSeq_Start(AudioSeq_t *pst_Seq, uint8_t u8_Melody, int16_t s16_Amp)
+{
+  const uint8_t *pu8_Mel = AudioSeq_Melody(u8_Melody);
+
+  AudioDds_Init(&pst_Seq->st_Dds, s16_Amp);
+  (void)memset(&pst_Seq->st_Env, 0, sizeof(pst_Seq->st_Env));
+  pst_Seq->u32_Left = 0;
+  pst_Seq->u32_RelAt = 0;
+  pst_Seq->b_Rest = true;
+  pst_Seq->b_Released = true;
+  pst_Seq->pu8_Note = NULL;
+
+  if (pu8_Mel != NULL) {
+    const uint32_t u32_UnitMs = (uint32_t)pu8_Mel[0] | ((uint32_t)pu8_Mel[1] << 8);
+    pst_Seq->u32_UnitSamples = (u32_UnitMs * AUDIO_SAMPLE_RATE_HZ) / 1000U;
+    pst_Seq->pu8_Note = &pu8_Mel[2];
+  }
+  return pst_Seq->pu8_Note != NULL;
+}
+
+/**
+ * @brief Sample source (AudioOut_Source_t) rendering the melody. Note
+ *        records are decoded as the render position reaches them.
+ *        A note starting from silence starts at a zero crossing of the
+ *        oscillator, and its release is timed to reach silence at the
+ *        end of the note, so note boundaries do not click.
+ * @param ps16_Buf : destination
+ * @param u32_Samples : samples requested
+ * @param pv_Seq : sequencer
+ * @return samples rendered, less than requested at the end of the melody
+ */
+uint32_t AudioSeq_Fill(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Seq)
+{
+  AudioSeq_t *pst_Seq = (AudioSeq_t *)pv_Seq;
+  uint32_t u32_Done = 0;
+
+  while ((u32_Done < u32_Samples) && (pst_Seq->pu8_Note != NULL)) {
+    if (pst_Seq->u32_Left == 0U) {
+      const uint8_t u8_Code = pst_Seq->pu8_Note[0];
+      const uint8_t u8_Pitch = u8_Code & AUDIO_SEQ_PITCH_MASK;
+
+      if (u8_Code == AUDIO_SEQ_END) {
+        pst_Seq->pu8_Note = NULL;
+        break;
+      }
+
+      pst_Seq->u32_Left = pst_Seq->pu8_Note[1] * pst_Seq->u32_UnitSamples;
+      pst_Seq->b_Rest = (u8_Pitch == AUDIO_SEQ_PITCH_REST);
+      pst_Seq->b_Released = pst_Seq->b_Rest;
+      if (pst_Seq->b_Rest == false) {
+        const uint8_t u8_Env = (uint8_t)(u8_Code >> AUDIO_SEQ_ENV_SHIFT);
+        const uint32_t u32_Rel = AudioEnv_GetReleaseSamples(u8_Env);
+
+        /* from silence the note starts at the zero crossing of phase 0,
+         * otherwise it glides on from the unfinished release */
+        if (AudioEnv_IsIdle(&pst_Seq->st_Env) != false) {
+          pst_Seq->st_Dds.u32_Phase = 0;
+        }
+        AudioDds_SetFreqCHz(&pst_Seq->st_Dds, audio_seq_pitch_cHz[u8_Pitch], AUDIO_SAMPLE_RATE_HZ);
+        AudioEnv_NoteOn(&pst_Seq->st_Env, u8_Env);
+        /* short notes spend at most half their length releasing */
+        pst_Seq->u32_RelAt = (u32_Rel < (pst_Seq->u32_Left >> 1)) ? u32_Rel : (pst_Seq->u32_Left >> 1);
+      }
+      pst_Seq->pu8_Note += AUDIO_SEQ_RECORD_SIZE;
+      continue;
+    }
+
+    uint32_t u32_Num = u32_Samples - u32_Done;
+    if (u32_Num > pst_Seq->u32_Left) {
+      u32_Num = pst_Seq->u32_Left;
+    }
+    if ((pst_Seq->b_Released == false) && (u32_Num > (pst_Seq->u32_Left - pst_Seq->u32_RelAt))) {
+      u32_Num = pst_Seq->u32_Left - pst_Seq->u32_RelAt;
+    }
+
+    if (AudioEnv_IsIdle(&pst_Seq->st_Env) != false) {
+      (void)memset(&ps16_Buf[u32_Done], 0, u32_Num * sizeof(int16_t));
+    } else {
+      /* a note, or a rest still playing out the previous release */
+      AudioDds_Fill(&pst_Seq->st_Dds, &ps16_Buf[u32_Done], u32_Num);
+      AudioEnv_Apply(&pst_Seq->st_Env, &ps16_Buf[u32_Done], u32_Num);
+    }
+    u32_Done += u32_Num;
+    pst_Seq->u32_Left -= u32_Num;
+
+    if ((pst_Seq->b_Released == false) && (pst_Seq->u32_Left == pst_Seq->u32_RelAt)) {
+      AudioEnv_NoteOff(&pst_Seq->st_Env);
+      pst_Seq->b_Released = true;
+    }
+  }
+
+  return u32_Done;
+}
+
+/**
+ * @brief Total length of a melody
+ * @param u8_Melody : MELODY_xxx id
+ * @return length in ms, 0 if the melody does not exist
+ */
+uint32_t AudioSeq_GetLengthMs(uint8_t u8_Melody)
+{
+  const uint8_t *pu8_Mel = AudioSeq_Melody(u8_Melody);
+  uint32_t u32_Units = 0;
+
+  if (pu8_Mel == NULL) {
+    return 0;
+  }
+
+  for (const uint8_t *pu8_Note = &pu8_Mel[2]; pu8_Note[0] != AUDIO_SEQ_END; pu8_Note += AUDIO_SEQ_RECORD_SIZE) {
+    u32_Units += pu8_Note[1];
+  }
+  return u32_Units * ((uint32_t)pu8_Mel[0] | ((uint32_t)pu8_Mel[1] << 8));
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Locate a melody in the blob
+ * @param u8_Melody : MELODY_xxx id
+ * @return melody header, NULL if out of range
+ */
+static const uint8_t *AudioSeq_Melody(uint8_t u8_Melody)
+{
+  const uint8_t *pu8_Mel = NULL;
+
+  if (u8_Melody < melody_blob[0]) {
+    const uint8_t *pu8_Off = &melody_blob[1U + (2U * u8_Melody)];
+    pu8_Mel = &melody_blob[(uint32_t)pu8_Off[0] | ((uint32_t)pu8_Off[1] << 8)];
+  }
+  return pu8_Mel;
+}
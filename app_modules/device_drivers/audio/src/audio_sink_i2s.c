@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_sink_i2s
+ *  Description        : I2S PDM output device
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/i2s_pdm.h"
+#include "driver/gpio.h"
+#include "esp_check.h"
+#include "audio_sink.h"
+#include "pin_config.h"
+#include "prof.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static esp_err_t AudioSinkI2s_Create(void);
+static bool AudioSinkI2s_Enable(void);
+static void AudioSinkI2s_Disable(void);
+static uint32_t AudioSinkI2s_WaitFree(uint32_t u32_TimeoutMs);
+static bool AudioSinkI2s_Write(const int16_t *ps16_Buf);
+static uint32_t AudioSinkI2s_Underruns(void);
+static bool AudioSinkI2s_OnSent(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+static bool AudioSinkI2s_OnSendOvf(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+const AudioSink_t AudioSink_I2s = {
+  .pf_Enable = AudioSinkI2s_Enable,
+  .pf_Disable = AudioSinkI2s_Disable,
+  .pf_WaitFree = AudioSinkI2s_WaitFree,
+  .pf_Write = AudioSinkI2s_Write,
+  .pf_Underruns = AudioSinkI2s_Underruns,
+};
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "i2s_sink";
+
+static i2s_chan_handle_t tx_chan = NULL;       // I2S tx channel handler
+static TaskHandle_t producer = NULL;           // task notified by the DMA callbacks
+static uint32_t free_blocks = 0;               // DMA blocks the producer may fill, producer context only
+static volatile uint32_t underruns = 0;        // incremented from the I2S ISR
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Create the PDM TX channel. The DMA is set up with AUDIO_DMA_BLOCKS
+ *        descriptors of one block each, so every on_sent event hands exactly
+ *        one block back to the producer.
+ * @return ESP_OK on success
+ */
+static esp_err_t AudioSinkI2s_Create(void)
+{
+  i2s_chan_config_t tx_chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
+  tx_chan_cfg.dma_desc_num = AUDIO_DMA_BLOCKS;
+  tx_chan_cfg.dma_frame_num = AUDIO_BLOCK_SAMPLES;
+  tx_chan_cfg.auto_clear = true;                // play silence on underrun
+  ESP_RETURN_ON_ERROR(i2s_new_channel(&tx_chan_cfg, &tx_chan, NULL), TAG, "new channel");
+
+  /* PDM TX can only be registered on I2S_NUM_0, data bit-width is fixed to 16 */
+  i2s_pdm_tx_config_t pdm_tx_cfg = {
+    .clk_cfg = I2S_PDM_TX_CLK_DEFAULT_CONFIG(AUDIO_SAMPLE_RATE_HZ),
+    .slot_cfg = I2S_PDM_TX_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO),
+    .gpio_cfg = {
+      .clk = I2S_BCLK_IO1,
+      .dout = I2S_DOUT_IO1,
+      .invert_flags = {
+        .clk_inv = false,
+      },
+    },
+  };
+  ESP_RETURN_ON_ERROR(i2s_channel_init_pdm_tx_mode(tx_chan, &pdm_tx_cfg), TAG, "pdm tx mode");
+
+  const i2s_event_callbacks_t cbs = {
+    .on_sent = AudioSinkI2s_OnSent,
+    .on_send_q_ovf = AudioSinkI2s_OnSendOvf,
+  };
+  ESP_RETURN_ON_ERROR(i2s_channel_register_event_callback(tx_chan, &cbs, NULL), TAG, "callbacks");
+
+  return ESP_OK;
+}
+
+/**
+ * @brief Create the channel on first use and start it, the calling task
+ *        becomes the producer that is notified for every sent block
+ * @return true if the channel is running
+ */
+static bool AudioSinkI2s_Enable(void)
+{
+  esp_err_t err = ESP_OK;
+
+  if (tx_chan == NULL) {
+    err = AudioSinkI2s_Create();
+  }
+
+  if (err == ESP_OK) {
+    producer = xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTake(pdTRUE, 0);           // drop stale notifications
+    free_blocks = AUDIO_DMA_BLOCKS;
+    err = i2s_channel_enable(tx_chan);
+  }
+
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "enable failed: %d\n", err);
+  }
+  return err == ESP_OK;
+}
+
+/**
+ * @brief Stop the channel, the DMA memory is kept for the next enable
+ */
+static void AudioSinkI2s_Disable(void)
+{
+  if (tx_chan != NULL) {
+    (void)i2s_channel_disable(tx_chan);
+  }
+}
+
+/**
+ * @brief Sleep until the DMA hands back a block, unless one came back since
+ *        the last call or all are free. Returning free blocks that were
+ *        already reported would let the producer spin at its latency target.
+ * @param u32_TimeoutMs : maximum wait
+ * @return number of free blocks
+ */
+static uint32_t AudioSinkI2s_WaitFree(uint32_t u32_TimeoutMs)
+{
+  uint32_t sent = ulTaskNotifyTake(pdTRUE, 0);
+
+  if ((sent == 0U) && (free_blocks < AUDIO_DMA_BLOCKS)) {
+    sent = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(u32_TimeoutMs));
+  }
+  free_blocks += sent;
+
+  if (free_blocks > AUDIO_DMA_BLOCKS) {
+    free_blocks = AUDIO_DMA_BLOCKS;             // sent events of silence blocks
+  }
+  return free_blocks;
+}
+
+/**
+ * @brief Copy one block into the DMA ring, a block is known to be free so
+ *        the write never waits
+ * @param ps16_Buf : AUDIO_BLOCK_SAMPLES samples
+ * @return true if the whole block was queued
+ */
+static bool AudioSinkI2s_Write(const int16_t *ps16_Buf)
+{
+  size_t w_bytes = 0;
+  esp_err_t err;
+
+  {
+    PROF_SCOPE("i2s_channel_write");
+    err = i2s_channel_write(tx_chan, ps16_Buf, AUDIO_BLOCK_SAMPLES * sizeof(int16_t), &w_bytes, 0);
+  }
+
+  if (free_blocks > 0U) {
+    free_blocks--;
+  }
+  return (err == ESP_OK) && (w_bytes == (AUDIO_BLOCK_SAMPLES * sizeof(int16_t)));
+}
+
+/**
+ * @brief Underrun counter
+ * @return number of blocks the DMA sent without fresh data
+ */
+static uint32_t AudioSinkI2s_Underruns(void)
+{
+  return underruns;
+}
+
+/**
+ * @brief I2S ISR: a DMA block has been sent and can be refilled
+ */
+static bool AudioSinkI2s_OnSent(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx)
+{
+  BaseType_t woken = pdFALSE;
+
+  if (producer != NULL) {
+    vTaskNotifyGiveFromISR(producer, &woken);
+  }
+  return woken == pdTRUE;
+}
+
+/**
+ * @brief I2S ISR: the sent queue overflowed, i.e. the producer fell behind
+ */
+static bool AudioSinkI2s_OnSendOvf(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx)
+{
+  underruns++;
+  return false;
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_sink_null
+ *  Description        : output device that discards the samples, used on host
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "audio_sink.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define AUDIO_SINK_NULL_BLOCK_US   ((int64_t)AUDIO_BLOCK_SAMPLES * 1000000LL / AUDIO_SAMPLE_RATE_HZ)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool AudioSinkNull_Enable(void);
+static void AudioSinkNull_Disable(void);
+static uint32_t AudioSinkNull_WaitFree(uint32_t u32_TimeoutMs);
+static bool AudioSinkNull_Write(const int16_t *ps16_Buf);
+static uint32_t AudioSinkNull_Underruns(void);
+static void AudioSinkNull_Drain(void);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+const AudioSink_t AudioSink_Null = {
+  .pf_Enable = AudioSinkNull_Enable,
+  .pf_Disable = AudioSinkNull_Disable,
+  .pf_WaitFree = AudioSinkNull_WaitFree,
+  .pf_Write = AudioSinkNull_Write,
+  .pf_Underruns = AudioSinkNull_Underruns,
+};
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static bool realtime = false;      // consume blocks at the sample rate instead of instantly
+static bool running = false;
+static uint32_t queued = 0;        // blocks in the virtual DMA ring
+static int64_t deadline_us = 0;    // time the head block has been played out
+static uint32_t samples = 0;       // samples accepted since the last enable
+static uint32_t underruns = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Select the consumption model. Realtime mode plays the virtual DMA
+ *        ring at AUDIO_SAMPLE_RATE_HZ and counts underruns like the I2S
+ *        sink, otherwise every write completes instantly (throughput runs).
+ * @param b_Realtime : true for realtime consumption
+ *
+ */
+void AudioSinkNull_SetRealtime(bool b_Realtime)
+{
+  realtime = b_Realtime;
+}
+
+/**
+ * @brief Number of samples written since the last enable
+ * @return sample count
+ */
+uint32_t AudioSinkNull_GetSamples(void)
+{
+  return samples;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+static bool AudioSinkNull_Enable(void)
+{
+  running = true;
+  queued = 0;
+  samples = 0;
+  deadline_us = esp_timer_get_time() + AUDIO_SINK_NULL_BLOCK_US;
+  return true;
+}
+
+static void AudioSinkNull_Disable(void)
+{
+  running = false;
+}
+
+static uint32_t AudioSinkNull_WaitFree(uint32_t u32_TimeoutMs)
+{
+  if (realtime == false) {
+    return AUDIO_DMA_BLOCKS;
+  }
+
+  /* like the DMA, sleep until a block has been played out */
+  const uint32_t before = queued;
+  AudioSinkNull_Drain();
+  if ((queued == before) && (queued > 0U) && (u32_TimeoutMs > 0U)) {
+    int64_t wait_ms = ((deadline_us - esp_timer_get_time()) / 1000LL) + 1LL;
+    if (wait_ms > (int64_t)u32_TimeoutMs) {
+      wait_ms = (int64_t)u32_TimeoutMs;
+    }
+    vTaskDelay(pdMS_TO_TICKS((uint32_t)wait_ms) + 1U);
+    AudioSinkNull_Drain();
+  }
+  return AUDIO_DMA_BLOCKS - queued;
+}
+
+static bool AudioSinkNull_Write(const int16_t *ps16_Buf)
+{
+  (void)ps16_Buf;
+  samples += AUDIO_BLOCK_SAMPLES;
+  if ((realtime != false) && (queued < AUDIO_DMA_BLOCKS)) {
+    queued++;
+  }
+  return running;
+}
+
+static uint32_t AudioSinkNull_Underruns(void)
+{
+  return underruns;
+}
+
+/**
+ * @brief Retire the blocks the virtual DAC has played by now, an empty ring
+ *        at a block boundary is an underrun
+ */
+static void AudioSinkNull_Drain(void)
+{
+  const int64_t now_us = esp_timer_get_time();
+
+  while ((running != false) && (now_us >= deadline_us)) {
+    if (queued > 0U) {
+      queued--;
+    } else {
+      underruns++;
+    }
+    deadline_us += AUDIO_SINK_NULL_BLOCK_US;
+  }
+}
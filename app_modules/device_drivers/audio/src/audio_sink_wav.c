@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : audio_sink_wav
+ *  Description        : output device writing a WAV file, used on host
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "audio_sink.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define AUDIO_SINK_WAV_HDR_SIZE    44U
+#define AUDIO_SINK_WAV_FNV_BASIS   0x811C9DC5UL
+#define AUDIO_SINK_WAV_FNV_PRIME   0x01000193UL
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool AudioSinkWav_Enable(void);
+static void AudioSinkWav_Disable(void);
+static uint32_t AudioSinkWav_WaitFree(uint32_t u32_TimeoutMs);
+static bool AudioSinkWav_Write(const int16_t *ps16_Buf);
+static uint32_t AudioSinkWav_Underruns(void);
+static void AudioSinkWav_Header(uint8_t *pu8_Hdr, uint32_t u32_Samples);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+const AudioSink_t AudioSink_Wav = {
+  .pf_Enable = AudioSinkWav_Enable,
+  .pf_Disable = AudioSinkWav_Disable,
+  .pf_WaitFree = AudioSinkWav_WaitFree,
+  .pf_Write = AudioSinkWav_Write,
+  .pf_Underruns = AudioSinkWav_Underruns,
+};
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static FILE *wav_file = NULL;      // NULL renders without writing
+static bool running = false;
+static uint32_t samples = 0;       // samples written since AudioSinkWav_Open
+static uint32_t checksum = AUDIO_SINK_WAV_FNV_BASIS;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Start a new output file. Blocks complete instantly, so rendering
+ *        runs as fast as the host allows.
+ * @param pc_Path : WAV file to write, NULL to only count and checksum
+ * @return false if the file can not be created
+ */
+bool AudioSinkWav_Open(const char *pc_Path)
+{
+  uint8_t hdr[AUDIO_SINK_WAV_HDR_SIZE];
+
+  AudioSinkWav_Close();
+  samples = 0;
+  checksum = AUDIO_SINK_WAV_FNV_BASIS;
+
+  if (pc_Path != NULL) {
+    wav_file = fopen(pc_Path, "wb");
+    if (wav_file == NULL) {
+      return false;
+    }
+    AudioSinkWav_Header(hdr, 0);
+    (void)fwrite(hdr, 1, sizeof(hdr), wav_file);
+  }
+  return true;
+}
+
+/**
+ * @brief Finish the output file, the header gets the final length
+ *
+ */
+void AudioSinkWav_Close(void)
+{
+  uint8_t hdr[AUDIO_SINK_WAV_HDR_SIZE];
+
+  if (wav_file != NULL) {
+    AudioSinkWav_Header(hdr, samples);
+    (void)fseek(wav_file, 0, SEEK_SET);
+    (void)fwrite(hdr, 1, sizeof(hdr), wav_file);
+    (void)fclose(wav_file);
+    wav_file = NULL;
+  }
+}
+
+/**
+ * @brief Number of samples written since AudioSinkWav_Open
+ * @return sample count
+ */
+uint32_t AudioSinkWav_GetSamples(void)
+{
+  return samples;
+}
+
+/**
+ * @brief FNV-1a hash of the little endian sample bytes written since
+ *        AudioSinkWav_Open, for regression checks of the synthesis
+ * @return checksum
+ */
+uint32_t AudioSinkWav_GetChecksum(void)
+{
+  return checksum;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+static bool AudioSinkWav_Enable(void)
+{
+  running = true;
+  return true;
+}
+
+static void AudioSinkWav_Disable(void)
+{
+  running = false;
+}
+
+static uint32_t AudioSinkWav_WaitFree(uint32_t u32_TimeoutMs)
+{
+  (void)u32_TimeoutMs;
+  return AUDIO_DMA_BLOCKS;
+}
+
+static bool AudioSinkWav_Write(const int16_t *ps16_Buf)
+{
+  uint8_t bytes[AUDIO_BLOCK_SAMPLES * 2U];
+  uint32_t hash = checksum;
+
+  if (running == false) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+    bytes[2U * i] = (uint8_t)((uint16_t)ps16_Buf[i] & 0xFFU);
+    bytes[(2U * i) + 1U] = (uint8_t)((uint16_t)ps16_Buf[i] >> 8);
+  }
+  for (uint32_t i = 0; i < sizeof(bytes); i++) {
+    hash = (hash ^ bytes[i]) * AUDIO_SINK_WAV_FNV_PRIME;
+  }
+  checksum = hash;
+  samples += AUDIO_BLOCK_SAMPLES;
+
+  return (wav_file == NULL) || (fwrite(bytes, 1, sizeof(bytes), wav_file) == sizeof(bytes));
+}
+
+static uint32_t AudioSinkWav_Underruns(void)
+{
+  return 0;
+}
+
+/**
+ * @brief Build a 16 bit mono PCM WAV header
+ * @param pu8_Hdr : destination, AUDIO_SINK_WAV_HDR_SIZE bytes
+ * @param u32_Samples : samples in the data chunk
+ */
+static void AudioSinkWav_Header(uint8_t *pu8_Hdr, uint32_t u32_Samples)
+{
+  const uint32_t fields[] = {
+    AUDIO_SINK_WAV_HDR_SIZE - 8U + (u32_Samples * 2U),   // RIFF size
+    16U,                                                 // fmt size
+    1U | (1UL << 16),                                    // PCM, mono
+    AUDIO_SAMPLE_RATE_HZ,
+    AUDIO_SAMPLE_RATE_HZ * 2U,                           // byte rate
+    2U | (16UL << 16),                                   // block align, bits
+    u32_Samples * 2U,                                    // data size
+  };
+  static const uint8_t offsets[] = { 4U, 16U, 20U, 24U, 28U, 32U, 40U };
+
+  (void)memcpy(&pu8_Hdr[0], "RIFF", 4);
+  (void)memcpy(&pu8_Hdr[8], "WAVEfmt ", 8);
+  (void)memcpy(&pu8_Hdr[36], "data", 4);
+  for (uint32_t i = 0; i < sizeof(offsets); i++) {
+    for (uint32_t b = 0; b < 4U; b++) {
+      pu8_Hdr[offsets[i] + b] = (uint8_t)(fields[i] >> (8U * b));
+    }
+  }
+}
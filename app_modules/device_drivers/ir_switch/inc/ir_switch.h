@@ -26,10 +26,15 @@ extern "C" {
 /******************************************************************************/
 #include <assert.h>
 #include "stdint.h"
+#include "extended_services.h"
 
 /******************************************************************************/
 /* PUBLIC DEFINITIONS                                                         */
 /******************************************************************************/
+#define IR_SWITCH_SAMPLE_MS       10        // nominal time between two GetIRswitchStatus calls
+#define IR_SWITCH_DT_MAX_MS       (4 * IR_SWITCH_SAMPLE_MS)  // longer steps were not watched, e.g. sleep
+#define IR_SWITCH_DEB_PLACE_MS    10        // bottle seen this long: placed
+#define IR_SWITCH_DEB_REMOVE_MS   200       // bottle gone this long: removed
 
 
 /******************************************************************************/
@@ -44,6 +49,16 @@ typedef enum IRSwitch_State
   IR_SWITCH_SET
 }IRSwitch_State;
 
+/*
+ * @brief debounce of one IR switch. The state machine has one per instance,
+ *        the replay harness one per replayed device.
+ */
+typedef struct IR_Switch_t
+{
+  Srvc_DebounceParam_t st_Param;
+  Srvc_DebounceState_t st_Deb;
+}IR_Switch_t;
+
 /******************************************************************************/
 /* PUBLIC DATA DECLARATIONS                                                   */
 /******************************************************************************/
@@ -53,7 +68,10 @@ typedef enum IRSwitch_State
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /******************************************************************************/
 void IR_Switch_Init(void);
-uint8_t GetIRswitchStatus(void);
+uint8_t GetIRswitchStatus(IR_Switch_t *pst_Sw, uint32_t u32_DtMs);
+void IR_Switch_Restore(IR_Switch_t *pst_Sw, uint8_t u8_State);
+void IR_Switch_Setup(IR_Switch_t *pst_Sw);
+uint8_t IR_Switch_Filter(IR_Switch_t *pst_Sw, uint32_t u32_Level, int32_t s32_DtMs);
 
 
 #ifdef __cplusplus
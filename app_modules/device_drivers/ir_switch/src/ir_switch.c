@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include "esp_log.h"
 #include "driver/gpio.h"
+#include "input_trace.h"
 #include "ir_switch.h"
 #include "pin_config.h"
 #include "extended_services.h"
@@ -45,8 +46,6 @@
 /******************************************************************************/
 /* PRIVATE DATA DEFINTIONS                                                    */
 /******************************************************************************/
-static Srvc_DebounceParam_t st_Ir_tmdeb_ms;
-static Srvc_DebounceState_t st_Ir_stateDeb = {0,0};
 
 /******************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
@@ -61,27 +60,69 @@ void IR_Switch_Init(void)
   gpio_reset_pin(IR_SWITCH_GPIO);
   gpio_set_direction(IR_SWITCH_GPIO, GPIO_MODE_INPUT);
   gpio_set_pull_mode(IR_SWITCH_GPIO,GPIO_PULLDOWN_ONLY);
-  
-  st_Ir_tmdeb_ms.TimeHighLow = 200;
-  st_Ir_tmdeb_ms.TimeLowHigh = 10;
 }
 
 /**
- * @brief IR switch status
- *
+ * @brief IR switch status, called about every IR_SWITCH_SAMPLE_MS. The raw
+ *        level goes to the input trace.
+ * @param pst_Sw : debounce of the caller, see IR_Switch_Setup
+ * @param u32_DtMs : measured time since the previous call
  */
-uint8_t GetIRswitchStatus(void)
+uint8_t GetIRswitchStatus(IR_Switch_t *pst_Sw, uint32_t u32_DtMs)
 {
-	IRSwitch_State IrSwitchStatus = (gpio_get_level(IR_SWITCH_GPIO) == 1) ? IR_SWITCH_RESET:IR_SWITCH_SET;
-	uint8_t debval = Srvc_Debounce((bool)IrSwitchStatus, 
-	                     &st_Ir_stateDeb,
-	                     &st_Ir_tmdeb_ms,
-	                     10);
+	const uint32_t level = (uint32_t)gpio_get_level(IR_SWITCH_GPIO);
+
+	InputTrace_Sample(INPUT_TRACE_SRC_IR, level);
+	uint8_t debval = IR_Switch_Filter(pst_Sw, level, (int32_t)u32_DtMs);
 	                     
 //	ESP_LOGI(TAG, "IR:%d IRD:%d\n", IrSwitchStatus,debval);                     
 	return(debval);
 }
 
+/**
+ * @brief Continue from a debounced state saved before deep sleep
+ * @param pst_Sw : switch
+ * @param u8_State : IRSwitch_State
+ */
+void IR_Switch_Restore(IR_Switch_t *pst_Sw, uint8_t u8_State)
+{
+	pst_Sw->st_Deb.XOld = (u8_State != (uint8_t)IR_SWITCH_RESET);
+	pst_Sw->st_Deb.Timer = 0;
+}
+
+/**
+ * @brief Debounce times of the IR switch, no bottle
+ * @param pst_Sw : switch
+ */
+void IR_Switch_Setup(IR_Switch_t *pst_Sw)
+{
+	pst_Sw->st_Param.TimeHighLow = IR_SWITCH_DEB_REMOVE_MS;
+	pst_Sw->st_Param.TimeLowHigh = IR_SWITCH_DEB_PLACE_MS;
+	pst_Sw->st_Deb.XOld = false;
+	pst_Sw->st_Deb.Timer = 0;
+}
+
+/**
+ * @brief Debounce one sample of the IR switch line. The switch pulls the
+ *        line low while a bottle is present.
+ * @param pst_Sw : switch
+ * @param u32_Level : GPIO level
+ * @param s32_DtMs : time since the previous sample, at most
+ *        IR_SWITCH_DT_MAX_MS counts
+ * @return IRSwitch_State
+ */
+uint8_t IR_Switch_Filter(IR_Switch_t *pst_Sw, uint32_t u32_Level, int32_t s32_DtMs)
+{
+	const IRSwitch_State IrSwitchStatus = (u32_Level == 1U) ? IR_SWITCH_RESET : IR_SWITCH_SET;
+
+	if (s32_DtMs > IR_SWITCH_DT_MAX_MS)
+	{
+		s32_DtMs = IR_SWITCH_DT_MAX_MS;
+	}
+
+	return (uint8_t)Srvc_Debounce((bool)IrSwitchStatus, &pst_Sw->st_Deb, &pst_Sw->st_Param, s32_DtMs);
+}
+
 /******************************************************************************/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /******************************************************************************/
@@ -26,6 +26,7 @@ extern "C" {
 /******************************************************************************/
 #include <assert.h>
 #include "stdint.h"
+#include "extended_services.h"
 
 /******************************************************************************/
 /* PUBLIC DEFINITIONS                                                         */
@@ -41,6 +42,16 @@ typedef enum LED_State
   LED_OFF
 }LED_State;
 
+/*
+ * @brief blink state of the on board LED, owned by the state machine that
+ *        blinks it
+ */
+typedef struct Led_t
+{
+  Srvc_SWTmrU32_t st_BlinkTimer;
+  uint32_t u32_Level;
+}Led_t;
+
 /******************************************************************************/
 /* PUBLIC DATA DECLARATIONS                                                   */
 /******************************************************************************/
@@ -50,7 +61,8 @@ typedef enum LED_State
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /******************************************************************************/
 void Led_Init(void);
-void Led_Blink(uint32_t time_ms);
+void Led_Setup(Led_t *pst_Led);
+void Led_Blink(Led_t *pst_Led, uint32_t time_ms);
 void Led_Set(LED_State Ledstate);
 
 
@@ -47,9 +47,6 @@
 /******************************************************************************/
 //const static char *TAG = "Led";
 
-static Srvc_SWTmrU32_t led_blink_timer;
-static uint32_t ledtoggle = 0;
-
 /******************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /******************************************************************************/
@@ -63,33 +60,43 @@ void Led_Init(void)
   gpio_reset_pin(ON_BOARD_LED_GPIO);
   gpio_set_direction(ON_BOARD_LED_GPIO, GPIO_MODE_OUTPUT);
   gpio_set_level(ON_BOARD_LED_GPIO, 1);
-  Srvc_StartSWTmrU32(&led_blink_timer);
+}
+
+/**
+ * @brief Start the blink timer of a LED, the next toggle sets it on
+ * @param pst_Led : blink state
+ */
+void Led_Setup(Led_t *pst_Led)
+{
+  pst_Led->u32_Level = 0;
+  Srvc_StartSWTmrU32(&pst_Led->st_BlinkTimer);
 }
 
 /**
  * @brief Function to blink on board led
+ * @param pst_Led : blink state
  * @param time_ms : time in ms
  *
  */
-void Led_Blink(uint32_t time_ms)
+void Led_Blink(Led_t *pst_Led, uint32_t time_ms)
 {
-	if(Srvc_TestSWTmrU32(&led_blink_timer) != false) // timer stopped
+	if(Srvc_TestSWTmrU32(&pst_Led->st_BlinkTimer) != false) // timer stopped
 	{
-		Srvc_StartSWTmrU32(&led_blink_timer);
+		Srvc_StartSWTmrU32(&pst_Led->st_BlinkTimer);
 	}
-	else if (Srvc_DiffSWTmrU32(&led_blink_timer) > time_ms) // timer elapsed
+	else if (Srvc_DiffSWTmrU32(&pst_Led->st_BlinkTimer) > time_ms) // timer elapsed
 	{
-		if(ledtoggle == 1)
+		if(pst_Led->u32_Level == 1)
 		{
-			ledtoggle = 0;
+			pst_Led->u32_Level = 0;
 		}
 		else
 		{
-			ledtoggle = 1;
+			pst_Led->u32_Level = 1;
 		}
-		gpio_set_level(ON_BOARD_LED_GPIO, ledtoggle);
+		gpio_set_level(ON_BOARD_LED_GPIO, pst_Led->u32_Level);
 
-		Srvc_StartSWTmrU32(&led_blink_timer); // restart timer
+		Srvc_StartSWTmrU32(&pst_Led->st_BlinkTimer); // restart timer
 	}
 }
 
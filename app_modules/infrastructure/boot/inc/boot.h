@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : boot
+ *  Description        : boot timeline and lazily initialized drivers
+ ******************************************************************************/
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define BOOT_MAX_MARKS            16        // boot steps kept for the report
+#define BOOT_MAX_DRVS             24        // lazy drivers, one event group bit each
+
+/* run an init step and mark its end under a short name for the report */
+#define BOOT_STEP(name, call)     do { call; Boot_Mark(name); } while (0)
+
+/* lazy driver, initialized by the first Boot_Use */
+#define BOOT_DRV(name, init)      { .pc_Name = (name), .pf_Init = (init), .u32_State = BOOT_DRV_IDLE }
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef enum Boot_DrvState_t
+{
+  BOOT_DRV_IDLE = 0,         // not used yet
+  BOOT_DRV_STARTING,         // init running in the first user
+  BOOT_DRV_READY
+}Boot_DrvState_t;
+
+/*
+ * @brief driver initialized on first use, defined by the driver
+ */
+typedef struct Boot_Drv_t
+{
+  const char *pc_Name;
+  void (*pf_Init)(void);
+  volatile uint32_t u32_State;   // Boot_DrvState_t
+  uint32_t u32_ReadyBit;         // set in the boot event group once ready
+  uint32_t u32_AtUs;             // time since reset the init started
+  uint32_t u32_InitUs;           // time the init took
+  struct Boot_Drv_t *pst_Next;   // initialized drivers, for the report
+}Boot_Drv_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Boot_Mark(const char *pc_Step);
+void Boot_Done(void);
+bool Boot_IsDone(void);
+void Boot_Use(Boot_Drv_t *pst_Drv);
+bool Boot_IsReady(const Boot_Drv_t *pst_Drv);
+void Boot_Report(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_H
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : boot
+ *  Description        : boot timeline and lazily initialized drivers. Every
+ *                       init step in app_main is marked with its time and
+ *                       the free heap, the boot ends with the first
+ *                       SysSm_Process. Drivers not needed for that are
+ *                       initialized by their first user instead.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+#include "esp_heap_caps.h"
+#endif
+#include "boot.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Boot_Mark_t
+{
+  const char *pc_Step;
+  uint32_t u32_AtUs;         // end of the step
+  uint32_t u32_Free;         // free heap after the step
+}Boot_Mark_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Boot_FreeHeap(void);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "boot";
+
+static portMUX_TYPE boot_lock = portMUX_INITIALIZER_UNLOCKED;
+static Boot_Mark_t marks[BOOT_MAX_MARKS];
+static uint32_t mark_n = 0;
+static bool done = false;
+static uint32_t total_heap = 0;
+static uint32_t min_free = 0;              // lowest free heap up to the end of the boot
+static Boot_Drv_t *drv_list = NULL;        // initialized drivers, newest first
+static uint32_t drv_n = 0;                 // drivers started, bits of drv_ready handed out
+static EventGroupHandle_t drv_ready = NULL; // bit of each driver set once it is ready
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief Mark the end of a boot step, see BOOT_STEP. Ignored once the boot
+ *        is done or BOOT_MAX_MARKS steps are marked.
+ * @param pc_Step : step name, must stay valid
+ */
+void Boot_Mark(const char *pc_Step)
+{
+  const uint32_t now = (uint32_t)esp_timer_get_time();
+  const uint32_t free_heap = Boot_FreeHeap();
+
+  taskENTER_CRITICAL(&boot_lock);
+  if ((done == false) && (mark_n < BOOT_MAX_MARKS)) {
+    marks[mark_n].pc_Step = pc_Step;
+    marks[mark_n].u32_AtUs = now;
+    marks[mark_n].u32_Free = free_heap;
+    mark_n++;
+  }
+  taskEXIT_CRITICAL(&boot_lock);
+}
+
+/**
+ * @brief End the boot, called when the device first does its work. Keeps the
+ *        lowest free heap seen so far as the boot peak.
+ *
+ */
+void Boot_Done(void)
+{
+  if (done != false) {
+    return;
+  }
+  Boot_Mark("boot done");
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  total_heap = (uint32_t)heap_caps_get_total_size(MALLOC_CAP_DEFAULT);
+  min_free = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+#endif
+  done = true;
+  ESP_LOGI(TAG, "boot done after %lu us\n", (unsigned long)marks[mark_n - 1U].u32_AtUs);
+}
+
+/**
+ * @brief Check if the boot has ended, see Boot_Done
+ * @return true once the device did its first work
+ */
+bool Boot_IsDone(void)
+{
+  return done;
+}
+
+/**
+ * @brief Make sure a driver is initialized, called by the driver at the top
+ *        of its public functions. The first caller runs the init, callers
+ *        arriving meanwhile block on the driver's bit in the boot event
+ *        group. Not for ISRs, and the init must not use its own driver.
+ * @param pst_Drv : driver, see BOOT_DRV
+ */
+void Boot_Use(Boot_Drv_t *pst_Drv)
+{
+  bool start = false;
+  uint32_t bit;
+
+  if (pst_Drv->u32_State == BOOT_DRV_READY) {
+    return;
+  }
+
+  /* the group exists before any driver is starting, so every waiter has it */
+  if (drv_ready == NULL) {
+    EventGroupHandle_t group = xEventGroupCreate();
+
+    assert(group);
+    taskENTER_CRITICAL(&boot_lock);
+    if (drv_ready == NULL) {
+      drv_ready = group;
+      group = NULL;
+    }
+    taskEXIT_CRITICAL(&boot_lock);
+    if (group != NULL) {
+      vEventGroupDelete(group);
+    }
+  }
+
+  taskENTER_CRITICAL(&boot_lock);
+  if (pst_Drv->u32_State == BOOT_DRV_IDLE) {
+    assert(drv_n < BOOT_MAX_DRVS);
+    pst_Drv->u32_ReadyBit = 1UL << drv_n;
+    drv_n++;
+    pst_Drv->u32_State = BOOT_DRV_STARTING;
+    start = true;
+  }
+  bit = pst_Drv->u32_ReadyBit;
+  taskEXIT_CRITICAL(&boot_lock);
+
+  if (start != false) {
+    const int64_t t0 = esp_timer_get_time();
+
+    pst_Drv->pf_Init();
+    pst_Drv->u32_AtUs = (uint32_t)t0;
+    pst_Drv->u32_InitUs = (uint32_t)(esp_timer_get_time() - t0);
+    taskENTER_CRITICAL(&boot_lock);
+    pst_Drv->pst_Next = drv_list;
+    drv_list = pst_Drv;
+    pst_Drv->u32_State = BOOT_DRV_READY;
+    taskEXIT_CRITICAL(&boot_lock);
+    (void)xEventGroupSetBits(drv_ready, bit);
+  } else {
+    (void)xEventGroupWaitBits(drv_ready, bit, pdFALSE, pdTRUE, portMAX_DELAY);
+  }
+}
+
+/**
+ * @brief Check if a driver was initialized, for functions that have nothing
+ *        to do before its first use
+ * @param pst_Drv : driver
+ * @return true when ready
+ */
+bool Boot_IsReady(const Boot_Drv_t *pst_Drv)
+{
+  return (pst_Drv->u32_State == BOOT_DRV_READY);
+}
+
+/**
+ * @brief Print the boot timeline, the boot heap peak and the drivers
+ *        initialized on first use, for the console after the boot and the
+ *        boot command
+ *
+ */
+void Boot_Report(void)
+{
+  uint32_t prev = 0;
+
+  printf("%-32s %10s %10s %10s\n", "step", "at us", "step us", "free heap");
+  for (uint32_t i = 0; i < mark_n; i++) {
+    printf("%-32s %10lu %10lu %10lu\n", marks[i].pc_Step, (unsigned long)marks[i].u32_AtUs,
+           (unsigned long)(marks[i].u32_AtUs - prev), (unsigned long)marks[i].u32_Free);
+    prev = marks[i].u32_AtUs;
+  }
+  if (done != false) {
+    printf("boot heap: %lu total, %lu min free, %lu peak use\n", (unsigned long)total_heap,
+           (unsigned long)min_free, (unsigned long)(total_heap - min_free));
+  } else {
+    printf("boot not done\n");
+  }
+
+  printf("initialized on first use:\n");
+  for (const Boot_Drv_t *drv = drv_list; drv != NULL; drv = drv->pst_Next) {
+    printf("  %-12s at %10lu us, init %lu us\n", drv->pc_Name, (unsigned long)drv->u32_AtUs,
+           (unsigned long)drv->u32_InitUs);
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Current free heap, 0 where the heap is not tracked
+ * @return bytes
+ */
+static uint32_t Boot_FreeHeap(void)
+{
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,289 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : console
+ *  Description        : UART console with diagnostic commands
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_console.h"
+#include "boot.h"
+#include "console.h"
+#include "input_trace.h"
+#include "period.h"
+#include "power.h"
+#include "prof.h"
+#include "ring_buffer.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+#if (RING_BUFFER_STATS_ENABLE == 1)
+static int Console_CmdRbStats(int argc, char **argv);
+#endif
+static int Console_CmdPower(int argc, char **argv);
+static int Console_CmdBoot(int argc, char **argv);
+static int Console_CmdTrace(int argc, char **argv);
+static int Console_CmdProf(int argc, char **argv);
+static int Console_CmdPeriod(int argc, char **argv);
+static void Console_BootReport(void);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "console";
+static bool boot_reported = false;   // boot report printed by the first command after the boot
+
+/* command table, one entry per diagnostic command */
+static const esp_console_cmd_t console_cmds[] = {
+#if (RING_BUFFER_STATS_ENABLE == 1)
+  {
+    .command = "rbstats",
+    .help = "Print ring buffer fill, overflow and latency counters. 'rbstats reset' clears them",
+    .hint = "[reset]",
+    .func = &Console_CmdRbStats,
+  },
+#endif
+  {
+    .command = "power",
+    .help = "Print the time spent awake, idle and in light sleep and the IR wake to handled latency",
+    .hint = NULL,
+    .func = &Console_CmdPower,
+  },
+  {
+    .command = "boot",
+    .help = "Print the time and free heap after every boot step, the boot heap peak and the drivers started on first use",
+    .hint = NULL,
+    .func = &Console_CmdBoot,
+  },
+  {
+    .command = "trace",
+    .help = "Input trace: print its fill, 'dump' prints it for tools/trace_extract.py, 'on', 'off' and 'clear' control it",
+    .hint = "[dump|on|off|clear]",
+    .func = &Console_CmdTrace,
+  },
+  {
+    .command = "prof",
+    .help = "Cycle profile of the PROF_SCOPE sites, hottest first. 'tasks' prints the CPU time per task, 'dump' prints the profile for tools/prof_extract.py, 'reset' clears it",
+    .hint = "[tasks|dump|reset]",
+    .func = &Console_CmdProf,
+  },
+  {
+    .command = "period",
+    .help = "Interval and execution time of the periodic tasks in us with deadline misses and overruns. 'dump' prints them for tools/period_extract.py, 'reset' clears them",
+    .hint = "[dump|reset]",
+    .func = &Console_CmdPeriod,
+  },
+};
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief console initialization function, starts the REPL task on the
+ *        default UART and registers the diagnostic commands
+ *
+ */
+void Console_Init(void)
+{
+  esp_console_repl_t *repl = NULL;
+  esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+  esp_console_dev_uart_config_t uart_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+
+  repl_config.prompt = CONSOLE_PROMPT;
+  ESP_ERROR_CHECK(esp_console_new_repl_uart(&uart_config, &repl_config, &repl));
+
+  ESP_ERROR_CHECK(esp_console_register_help_command());
+  for (size_t i = 0; i < (sizeof(console_cmds) / sizeof(console_cmds[0])); i++) {
+    ESP_ERROR_CHECK(esp_console_cmd_register(&console_cmds[i]));
+  }
+
+  ESP_ERROR_CHECK(esp_console_start_repl(repl));
+  ESP_LOGI(TAG, "console ready\n");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+#if (RING_BUFFER_STATS_ENABLE == 1)
+/**
+ * @brief rbstats command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success
+ */
+static int Console_CmdRbStats(int argc, char **argv)
+{
+  Console_BootReport();
+  if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+    for (uint8_t i = 0; i < (uint8_t)RING_BUFFER_MAX_IDX; i++) {
+      RingBuffer_ResetStats((enum ringbufferIndex)i);
+    }
+  } else {
+    RingBuffer_PrintStats();
+  }
+  return 0;
+}
+#endif
+
+/**
+ * @brief power command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success
+ */
+static int Console_CmdPower(int argc, char **argv)
+{
+  static const char *const state_name[POWER_STATE_MAX] = { "active", "idle", "sleep" };
+  Power_Stats_t stats;
+
+  (void)argc;
+  (void)argv;
+  Console_BootReport();
+  Power_GetStats(&stats);
+  for (uint32_t i = 0; i < (uint32_t)POWER_STATE_MAX; i++) {
+    printf("%-8s %10llu ms\n", state_name[i], (unsigned long long)(stats.au64_TimeUs[i] / 1000U));
+  }
+  printf("sleeps %lu, ir wakes %lu\n", (unsigned long)stats.u32_Sleeps, (unsigned long)stats.u32_IrWakes);
+  printf("wake to handled: %lu samples, min %lu us, avg %lu us, max %lu us\n", (unsigned long)stats.u32_LatCount,
+         (unsigned long)stats.u32_LatMinUs, (unsigned long)stats.u32_LatAvgUs, (unsigned long)stats.u32_LatMaxUs);
+  return 0;
+}
+
+/**
+ * @brief boot command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success
+ */
+static int Console_CmdBoot(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  if (Boot_IsDone() != false) {
+    boot_reported = true;   // asked for, not printed again by the next command
+  }
+  Boot_Report();
+  return 0;
+}
+
+/**
+ * @brief trace command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success, 1 for an unknown argument
+ */
+static int Console_CmdTrace(int argc, char **argv)
+{
+  InputTrace_Stats_t stats;
+
+  Console_BootReport();
+  if (argc > 1) {
+    if (strcmp(argv[1], "dump") == 0) {
+      InputTrace_Dump();
+    } else if (strcmp(argv[1], "on") == 0) {
+      InputTrace_Enable(true);
+    } else if (strcmp(argv[1], "off") == 0) {
+      InputTrace_Enable(false);
+    } else if (strcmp(argv[1], "clear") == 0) {
+      InputTrace_Clear();
+    } else {
+      printf("trace [dump|on|off|clear]\n");
+      return 1;
+    }
+    return 0;
+  }
+
+  InputTrace_GetStats(&stats);
+  printf("trace %s, %lu samples in %lu of %u words since %lu ms, %lu words dropped\n", (stats.b_On != false) ? "on" : "off",
+         (unsigned long)stats.u32_Samples, (unsigned long)stats.u32_Words, INPUT_TRACE_WORDS,
+         (unsigned long)stats.u32_FirstMs, (unsigned long)stats.u32_Dropped);
+  return 0;
+}
+
+/**
+ * @brief prof command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success, 1 for an unknown argument
+ */
+static int Console_CmdProf(int argc, char **argv)
+{
+  Console_BootReport();
+  if (argc < 2) {
+    Prof_Report();
+  } else if (strcmp(argv[1], "tasks") == 0) {
+    Prof_Tasks();
+  } else if (strcmp(argv[1], "dump") == 0) {
+    Prof_Dump();
+  } else if (strcmp(argv[1], "reset") == 0) {
+    Prof_Reset();
+  } else {
+    printf("prof [tasks|dump|reset]\n");
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief period command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success, 1 for an unknown argument
+ */
+static int Console_CmdPeriod(int argc, char **argv)
+{
+  Console_BootReport();
+  if (argc < 2) {
+    Period_Report();
+  } else if (strcmp(argv[1], "dump") == 0) {
+    Period_Dump();
+  } else if (strcmp(argv[1], "reset") == 0) {
+    Period_Reset();
+  } else {
+    printf("period [dump|reset]\n");
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Print the boot report once, ahead of the output of the first command
+ *        after the boot, so the timeline shows up without asking for it
+ */
+static void Console_BootReport(void)
+{
+  if ((boot_reported == false) && (Boot_IsDone() != false)) {
+    boot_reported = true;
+    Boot_Report();
+  }
+}
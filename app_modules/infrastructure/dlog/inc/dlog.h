@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : dlog
+ *  Description        : deferred binary logging. A call site stores its
+ *                       format id, a timestamp and the raw arguments, the
+ *                       text is made on the host by tools/dlog_extract.py
+ ******************************************************************************/
+
+#ifndef DLOG_H
+#define DLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdio.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#ifndef DLOG_BUF_WORDS
+#define DLOG_BUF_WORDS            256U      // per core, power of 2
+#endif
+#ifndef DLOG_FLUSH_MS
+#define DLOG_FLUSH_MS             200U      // Dlog_task drain period
+#endif
+#define DLOG_MAX_ARGS             4U
+
+#define DLOG_LEVEL_ERROR          0U
+#define DLOG_LEVEL_WARN           1U
+#define DLOG_LEVEL_INFO           2U
+
+/* record header: file id | level | argument count | line */
+#define DLOG_HDR_FILE_SHIFT       22U
+#define DLOG_HDR_LEVEL_SHIFT      20U
+#define DLOG_HDR_NARG_SHIFT       17U
+#define DLOG_HDR_LINE_MASK        0x1FFFFUL
+
+/*
+ * Every source file that logs defines a unique DLOG_FILE_ID (1..1023) before
+ * including this header, tools/dlog_extract.py maps file id and line back to
+ * the format string. Arguments are stored as 32 bit integers, so only
+ * integer conversions are allowed and at most one call per line. The format
+ * string is only seen by the compiler for -Wformat and is not in the image.
+ */
+#define DLOG_E(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define DLOG_W(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define DLOG_I(fmt, ...)          DLOG_WRITE(DLOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+
+#define DLOG_WRITE(lvl, fmt, ...)                                                          \
+  do {                                                                                     \
+    const uint32_t au32_DlogArg[] = { 0U, ##__VA_ARGS__ };                                 \
+    const uint32_t u32_DlogN = (uint32_t)(sizeof(au32_DlogArg) / sizeof(uint32_t)) - 1U;   \
+    static_assert((sizeof(au32_DlogArg) / sizeof(uint32_t)) <= (DLOG_MAX_ARGS + 1U),       \
+                  "too many dlog arguments");                                              \
+    if (0) {                                                                               \
+      (void)printf(fmt, ##__VA_ARGS__);                                                    \
+    }                                                                                      \
+    Dlog_Write(((uint32_t)DLOG_FILE_ID << DLOG_HDR_FILE_SHIFT) |                           \
+               ((uint32_t)(lvl) << DLOG_HDR_LEVEL_SHIFT) |                                 \
+               (u32_DlogN << DLOG_HDR_NARG_SHIFT) | ((uint32_t)__LINE__ & DLOG_HDR_LINE_MASK), \
+               &au32_DlogArg[1]);                                                          \
+  } while (0)
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Dlog_Init(void);
+void Dlog_Write(uint32_t u32_Hdr, const uint32_t *pu32_Arg);
+void Dlog_Flush(void);
+uint32_t Dlog_GetDropped(void);
+void Dlog_task(void *param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DLOG_H
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : dlog
+ *  Description        : deferred binary logging, one record ring per core
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "dlog.h"
+#include "period.h"
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#include <pthread.h>
+#else
+#include "freertos/semphr.h"
+#include "esp_cpu.h"
+#endif
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define DLOG_LINE_WORDS           15U       // words per output line, 60 bytes are 80 base64 characters
+#define DLOG_BUF_MASK             (DLOG_BUF_WORDS - 1U)
+
+/*
+ * A record is only ever written by the core it was logged on, with that
+ * core's interrupts masked for the few stores. Producers never contend across
+ * cores and Dlog_task reads with acquire/release indices, without any lock.
+ * Flushes are serialized by the flush lock instead, SysSm_DeepSleep sends the
+ * last records itself while Dlog_task may be halfway through a flush.
+ */
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#define DLOG_CORES                1U
+#define DLOG_ENTER()              (pthread_mutex_lock(&dlog_mutex), 0U)
+#define DLOG_EXIT(m)              do { (void)(m); pthread_mutex_unlock(&dlog_mutex); } while (0)
+#define DLOG_CORE()               0U
+#define DLOG_FLUSH_LOCK()         pthread_mutex_lock(&dlog_flush_mutex)
+#define DLOG_FLUSH_UNLOCK()       pthread_mutex_unlock(&dlog_flush_mutex)
+#else
+#define DLOG_CORES                portNUM_PROCESSORS
+#define DLOG_ENTER()              portSET_INTERRUPT_MASK_FROM_ISR()
+#define DLOG_EXIT(m)              portCLEAR_INTERRUPT_MASK_FROM_ISR(m)
+#define DLOG_CORE()               ((uint32_t)esp_cpu_get_core_id())
+#define DLOG_FLUSH_LOCK()         (void)xSemaphoreTake(dlog_flush_lock, portMAX_DELAY)
+#define DLOG_FLUSH_UNLOCK()       (void)xSemaphoreGive(dlog_flush_lock)
+#endif
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Dlog_Ring_t
+{
+  uint32_t au32_Buf[DLOG_BUF_WORDS];
+  volatile uint32_t u32_Head;     // free running word index, written by the owning core
+  volatile uint32_t u32_Tail;     // free running word index, written under the flush lock
+  volatile uint32_t u32_Dropped;  // records that did not fit
+  uint32_t u32_Reported;          // drops already sent as a drop record
+}Dlog_Ring_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Dlog_Emit(uint32_t u32_Core, const uint32_t *pu32_Words, uint32_t u32_N);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Dlog_Ring_t dlog_ring[DLOG_CORES];
+#if defined(CONFIG_IDF_TARGET_LINUX)
+static pthread_mutex_t dlog_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t dlog_flush_mutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+static SemaphoreHandle_t dlog_flush_lock = NULL;  // one Dlog_Flush at a time
+#endif
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief dlog initialization function, call before the first log record
+ *
+ */
+void Dlog_Init(void)
+{
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  if (dlog_flush_lock == NULL) {
+    dlog_flush_lock = xSemaphoreCreateMutex();
+    assert(dlog_flush_lock);
+  }
+#endif
+  for (uint32_t i = 0; i < DLOG_CORES; i++) {
+    dlog_ring[i].u32_Head = 0;
+    dlog_ring[i].u32_Tail = 0;
+    dlog_ring[i].u32_Dropped = 0;
+    dlog_ring[i].u32_Reported = 0;
+  }
+}
+
+/**
+ * @brief Store one record in the ring of the calling core, called through the
+ *        DLOG_x macros. A record that does not fit is counted and dropped,
+ *        the caller never waits.
+ * @param u32_Hdr : record header, see DLOG_HDR_x
+ * @param pu32_Arg : arguments, count taken from the header
+ */
+void Dlog_Write(uint32_t u32_Hdr, const uint32_t *pu32_Arg)
+{
+  const uint32_t u32_Args = (u32_Hdr >> DLOG_HDR_NARG_SHIFT) & 0x7U;
+  const uint32_t u32_Ts = (uint32_t)esp_timer_get_time();
+  const uint32_t u32_Mask = DLOG_ENTER();
+  Dlog_Ring_t *pst_Ring = &dlog_ring[DLOG_CORE()];
+  const uint32_t u32_Head = pst_Ring->u32_Head;
+
+  if ((DLOG_BUF_WORDS - (u32_Head - __atomic_load_n(&pst_Ring->u32_Tail, __ATOMIC_ACQUIRE))) < (u32_Args + 2U)) {
+    pst_Ring->u32_Dropped++;
+  } else {
+    pst_Ring->au32_Buf[u32_Head & DLOG_BUF_MASK] = u32_Hdr;
+    pst_Ring->au32_Buf[(u32_Head + 1U) & DLOG_BUF_MASK] = u32_Ts;
+    for (uint32_t i = 0; i < u32_Args; i++) {
+      pst_Ring->au32_Buf[(u32_Head + 2U + i) & DLOG_BUF_MASK] = pu32_Arg[i];
+    }
+    __atomic_store_n(&pst_Ring->u32_Head, u32_Head + 2U + u32_Args, __ATOMIC_RELEASE);
+  }
+  DLOG_EXIT(u32_Mask);
+}
+
+/**
+ * @brief Send all queued records to stdout as "~D<core>:<base64>" lines.
+ *        Normally called by Dlog_task, a second caller waits for the flush
+ *        in progress so no word is sent twice or out of order.
+ *
+ */
+void Dlog_Flush(void)
+{
+  uint32_t au32_Line[DLOG_LINE_WORDS];
+
+  DLOG_FLUSH_LOCK();
+  for (uint32_t u32_Core = 0; u32_Core < DLOG_CORES; u32_Core++) {
+    Dlog_Ring_t *pst_Ring = &dlog_ring[u32_Core];
+    const uint32_t u32_Head = __atomic_load_n(&pst_Ring->u32_Head, __ATOMIC_ACQUIRE);
+    const uint32_t u32_Dropped = pst_Ring->u32_Dropped;
+    uint32_t u32_Tail = pst_Ring->u32_Tail;
+
+    while (u32_Tail != u32_Head) {
+      uint32_t u32_N = u32_Head - u32_Tail;
+
+      if (u32_N > DLOG_LINE_WORDS) {
+        u32_N = DLOG_LINE_WORDS;
+      }
+      for (uint32_t i = 0; i < u32_N; i++) {
+        au32_Line[i] = pst_Ring->au32_Buf[(u32_Tail + i) & DLOG_BUF_MASK];
+      }
+      u32_Tail += u32_N;
+      /* the words are copied, hand the space back before the slow output */
+      __atomic_store_n(&pst_Ring->u32_Tail, u32_Tail, __ATOMIC_RELEASE);
+      Dlog_Emit(u32_Core, au32_Line, u32_N);
+    }
+
+    if (u32_Dropped != pst_Ring->u32_Reported) {
+      /* drop record: file id 0, one argument */
+      au32_Line[0] = 1UL << DLOG_HDR_NARG_SHIFT;
+      au32_Line[1] = (uint32_t)esp_timer_get_time();
+      au32_Line[2] = u32_Dropped - pst_Ring->u32_Reported;
+      pst_Ring->u32_Reported = u32_Dropped;
+      Dlog_Emit(u32_Core, au32_Line, 3U);
+    }
+  }
+  DLOG_FLUSH_UNLOCK();
+}
+
+/**
+ * @brief Records dropped because a ring was full, all cores
+ * @return count since Dlog_Init
+ */
+uint32_t Dlog_GetDropped(void)
+{
+  uint32_t u32_Sum = 0;
+
+  for (uint32_t i = 0; i < DLOG_CORES; i++) {
+    u32_Sum += dlog_ring[i].u32_Dropped;
+  }
+  return u32_Sum;
+}
+
+/**
+ * @brief Low priority task, drains the rings every DLOG_FLUSH_MS
+ * @param param
+ */
+void Dlog_task(void *param)
+{
+  static Period_Mon_t flush_period;
+
+  (void)param;
+  Period_Register(&flush_period, "dlog_flush", DLOG_FLUSH_MS * 1000U, 2U * DLOG_FLUSH_MS * 1000U);
+  while (1) {
+    vTaskDelay(pdMS_TO_TICKS(DLOG_FLUSH_MS));
+    (void)Period_Begin(&flush_period);
+    Dlog_Flush();
+    Period_End(&flush_period);
+  }
+  vTaskDelete(NULL);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Print one line of record words, base64 of the little endian bytes
+ * @param u32_Core : ring the words come from
+ * @param pu32_Words : words
+ * @param u32_N : 1..DLOG_LINE_WORDS
+ */
+static void Dlog_Emit(uint32_t u32_Core, const uint32_t *pu32_Words, uint32_t u32_N)
+{
+  static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  char line[8U + ((DLOG_LINE_WORDS * 4U + 2U) / 3U) * 4U];
+  uint8_t bytes[DLOG_LINE_WORDS * 4U];
+  const uint32_t u32_Bytes = u32_N * 4U;
+  uint32_t u32_Len = (uint32_t)snprintf(line, sizeof(line), "~D%lu:", (unsigned long)u32_Core);
+
+  for (uint32_t i = 0; i < u32_Bytes; i++) {
+    bytes[i] = (uint8_t)(pu32_Words[i >> 2] >> ((i & 3U) * 8U));
+  }
+  for (uint32_t i = 0; i < u32_Bytes; i += 3U) {
+    const uint32_t u32_Left = u32_Bytes - i;
+    const uint32_t u32_Grp = ((uint32_t)bytes[i] << 16) |
+                             ((u32_Left > 1U) ? ((uint32_t)bytes[i + 1U] << 8) : 0U) |
+                             ((u32_Left > 2U) ? (uint32_t)bytes[i + 2U] : 0U);
+    line[u32_Len++] = b64[(u32_Grp >> 18) & 0x3FU];
+    line[u32_Len++] = b64[(u32_Grp >> 12) & 0x3FU];
+    line[u32_Len++] = (u32_Left > 1U) ? b64[(u32_Grp >> 6) & 0x3FU] : '=';
+    line[u32_Len++] = (u32_Left > 2U) ? b64[u32_Grp & 0x3FU] : '=';
+  }
+  line[u32_Len++] = '\n';
+  (void)fwrite(line, 1, u32_Len, stdout);
+}
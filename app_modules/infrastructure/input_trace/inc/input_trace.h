@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : input_trace
+ *  Description        : flight recorder of raw input samples. Drivers store
+ *                       every sample they read, run length coded in a RAM
+ *                       ring that keeps the latest samples. The console dumps
+ *                       it, host/frost_replay and frost_sim play it back.
+ ******************************************************************************/
+
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#ifndef INPUT_TRACE_WORDS
+#define INPUT_TRACE_WORDS         1024U     // ring size, power of 2
+#endif
+
+/*
+ * A trace is a header of INPUT_TRACE_HDR_WORDS followed by little endian
+ * 32 bit words, oldest first:
+ *   header   magic, version, time of the first word in ms, word count
+ *   sample   source | level | dt | count: count samples of the same level,
+ *            each dt ms after the previous sample of any source
+ *   gap      INPUT_TRACE_SRC_GAP | ms: nothing sampled for ms, then the
+ *            next sample follows with its own dt
+ */
+#define INPUT_TRACE_MAGIC         0x52545246UL  // "FRTR"
+#define INPUT_TRACE_VERSION       1U
+#define INPUT_TRACE_HDR_WORDS     4U
+
+#define INPUT_TRACE_SRC_SHIFT     28U
+#define INPUT_TRACE_LEVEL_SHIFT   27U
+#define INPUT_TRACE_DT_SHIFT      16U
+#define INPUT_TRACE_DT_MAX        0x7FFUL   // longer steps are written as a gap first
+#define INPUT_TRACE_COUNT_MAX     0xFFFFUL
+#define INPUT_TRACE_GAP_MAX       0x0FFFFFFFUL
+
+#define INPUT_TRACE_SRC(w)        ((w) >> INPUT_TRACE_SRC_SHIFT)
+#define INPUT_TRACE_LEVEL(w)      (((w) >> INPUT_TRACE_LEVEL_SHIFT) & 1UL)
+#define INPUT_TRACE_DT(w)         (((w) >> INPUT_TRACE_DT_SHIFT) & INPUT_TRACE_DT_MAX)
+#define INPUT_TRACE_COUNT(w)      ((w) & INPUT_TRACE_COUNT_MAX)
+#define INPUT_TRACE_GAP(w)        ((w) & INPUT_TRACE_GAP_MAX)
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief input sampled by a driver, 4 bits in a trace word
+ */
+typedef enum InputTrace_Source_t
+{
+  INPUT_TRACE_SRC_IR = 0,         // IR switch GPIO level, see GetIRswitchStatus
+  INPUT_TRACE_SRC_GAP = 15        // not a source, marks a pause
+}InputTrace_Source_t;
+
+typedef struct InputTrace_Stats_t
+{
+  uint32_t u32_Samples;           // since the last clear
+  uint32_t u32_Words;             // in the ring
+  uint32_t u32_Dropped;           // oldest words overwritten
+  uint32_t u32_FirstMs;           // time of the oldest sample kept
+  bool b_On;
+}InputTrace_Stats_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void InputTrace_Sample(InputTrace_Source_t e_Src, uint32_t u32_Level);
+void InputTrace_Enable(bool b_On);
+void InputTrace_Clear(void);
+void InputTrace_GetStats(InputTrace_Stats_t *pst_Stats);
+void InputTrace_Dump(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_TRACE_H
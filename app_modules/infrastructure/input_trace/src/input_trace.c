@@ -0,0 +1,222 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : input_trace
+ *  Description        : flight recorder of raw input samples, run length
+ *                       coded. The bottle standing for 11 minutes of 10 ms
+ *                       IR polls is one word, a week of use fits the ring.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "input_trace.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define INPUT_TRACE_MASK          (INPUT_TRACE_WORDS - 1U)
+#define INPUT_TRACE_LINE_WORDS    8U        // words per dump line
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void InputTrace_Push(uint32_t u32_Word);
+static uint32_t InputTrace_Duration(uint32_t u32_Word);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static portMUX_TYPE trace_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t ring[INPUT_TRACE_WORDS];
+static uint32_t head = 0;                // free running word indices
+static uint32_t tail = 0;
+static uint32_t first_ms = 0;            // time before the oldest word
+static uint32_t last_ms = 0;             // time of the newest sample
+static uint32_t samples = 0;
+static uint32_t dropped = 0;
+static bool trace_on = true;             // recording from reset
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Record one raw sample, called by the driver that read it. A sample
+ *        equal to the previous one only counts up the last word.
+ * @param e_Src : input
+ * @param u32_Level : 0 or 1
+ */
+void InputTrace_Sample(InputTrace_Source_t e_Src, uint32_t u32_Level)
+{
+  const uint32_t u32_Now = (uint32_t)(esp_timer_get_time() / 1000);
+
+  taskENTER_CRITICAL(&trace_lock);
+  if (trace_on != false) {
+    uint32_t u32_Dt = u32_Now - last_ms;
+    uint32_t u32_Word;
+
+    while (u32_Dt > INPUT_TRACE_DT_MAX) {
+      const uint32_t u32_Gap = (u32_Dt > INPUT_TRACE_GAP_MAX) ? INPUT_TRACE_GAP_MAX : u32_Dt;
+      InputTrace_Push(((uint32_t)INPUT_TRACE_SRC_GAP << INPUT_TRACE_SRC_SHIFT) | u32_Gap);
+      u32_Dt -= u32_Gap;
+    }
+    u32_Word = ((uint32_t)e_Src << INPUT_TRACE_SRC_SHIFT) | (((u32_Level != 0U) ? 1UL : 0UL) << INPUT_TRACE_LEVEL_SHIFT) |
+               (u32_Dt << INPUT_TRACE_DT_SHIFT);
+
+    /* same input, level and step as the last word: one more of it */
+    if ((head != tail) && ((ring[(head - 1U) & INPUT_TRACE_MASK] & ~INPUT_TRACE_COUNT_MAX) == u32_Word) &&
+        (INPUT_TRACE_COUNT(ring[(head - 1U) & INPUT_TRACE_MASK]) < INPUT_TRACE_COUNT_MAX)) {
+      ring[(head - 1U) & INPUT_TRACE_MASK]++;
+    } else {
+      InputTrace_Push(u32_Word | 1U);
+    }
+    last_ms = u32_Now;
+    samples++;
+  }
+  taskEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * @brief Start or stop recording, the ring is kept
+ * @param b_On : record
+ */
+void InputTrace_Enable(bool b_On)
+{
+  const uint32_t u32_Now = (uint32_t)(esp_timer_get_time() / 1000);
+
+  taskENTER_CRITICAL(&trace_lock);
+  if ((b_On != false) && (trace_on == false) && (head == tail)) {
+    first_ms = u32_Now;
+    last_ms = u32_Now;
+  }
+  trace_on = b_On;
+  taskEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * @brief Empty the ring, the next trace starts now
+ *
+ */
+void InputTrace_Clear(void)
+{
+  const uint32_t u32_Now = (uint32_t)(esp_timer_get_time() / 1000);
+
+  taskENTER_CRITICAL(&trace_lock);
+  head = 0;
+  tail = 0;
+  first_ms = u32_Now;
+  last_ms = u32_Now;
+  samples = 0;
+  dropped = 0;
+  taskEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * @brief Fill level and counters
+ * @param pst_Stats : result
+ */
+void InputTrace_GetStats(InputTrace_Stats_t *pst_Stats)
+{
+  taskENTER_CRITICAL(&trace_lock);
+  pst_Stats->u32_Samples = samples;
+  pst_Stats->u32_Words = head - tail;
+  pst_Stats->u32_Dropped = dropped;
+  pst_Stats->u32_FirstMs = first_ms;
+  pst_Stats->b_On = trace_on;
+  taskEXIT_CRITICAL(&trace_lock);
+}
+
+/**
+ * @brief Print the trace as "~T:<hex words>" lines, header first. The ring
+ *        is copied in one short critical section, recording goes on.
+ *        tools/trace_extract.py turns the lines into a trace file.
+ */
+void InputTrace_Dump(void)
+{
+  uint32_t *pu32_Copy = malloc((INPUT_TRACE_HDR_WORDS + INPUT_TRACE_WORDS) * sizeof(uint32_t));
+  uint32_t u32_N;
+
+  if (pu32_Copy == NULL) {
+    printf("trace: no memory for the dump\n");
+    return;
+  }
+
+  taskENTER_CRITICAL(&trace_lock);
+  u32_N = head - tail;
+  pu32_Copy[0] = INPUT_TRACE_MAGIC;
+  pu32_Copy[1] = INPUT_TRACE_VERSION;
+  pu32_Copy[2] = first_ms;
+  pu32_Copy[3] = u32_N;
+  for (uint32_t i = 0; i < u32_N; i++) {
+    pu32_Copy[INPUT_TRACE_HDR_WORDS + i] = ring[(tail + i) & INPUT_TRACE_MASK];
+  }
+  taskEXIT_CRITICAL(&trace_lock);
+
+  u32_N += INPUT_TRACE_HDR_WORDS;
+  for (uint32_t i = 0; i < u32_N; i += INPUT_TRACE_LINE_WORDS) {
+    printf("~T:");
+    for (uint32_t j = i; (j < u32_N) && (j < (i + INPUT_TRACE_LINE_WORDS)); j++) {
+      printf("%08lx", (unsigned long)pu32_Copy[j]);
+    }
+    printf("\n");
+  }
+  free(pu32_Copy);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Append a word, a full ring drops its oldest word. trace_lock held.
+ * @param u32_Word : trace word
+ */
+static void InputTrace_Push(uint32_t u32_Word)
+{
+  if ((head - tail) == INPUT_TRACE_WORDS) {
+    first_ms += InputTrace_Duration(ring[tail & INPUT_TRACE_MASK]);
+    tail++;
+    dropped++;
+  }
+  ring[head & INPUT_TRACE_MASK] = u32_Word;
+  head++;
+}
+
+/**
+ * @brief Time covered by a word
+ * @param u32_Word : trace word
+ * @return ms
+ */
+static uint32_t InputTrace_Duration(uint32_t u32_Word)
+{
+  if (INPUT_TRACE_SRC(u32_Word) == (uint32_t)INPUT_TRACE_SRC_GAP) {
+    return INPUT_TRACE_GAP(u32_Word);
+  }
+  return INPUT_TRACE_DT(u32_Word) * INPUT_TRACE_COUNT(u32_Word);
+}
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      hsm library
+ ******************************************************************************/
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file          hsm.c
+ *
+ *  \brief         Table driven hierarchical state machine
+ *
+ *  \details       A transition leaves the active state up to the lowest
+ *                 common ancestor of source and target, runs the action and
+ *                 enters down to the target. A transition to the source
+ *                 itself or one of its ancestors leaves and re-enters that
+ *                 state. Targets are entered as they are, there are no
+ *                 initial sub-state transitions.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stddef.h>
+#include "hsm.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Hsm_vTransition(Hsm_t * pst_Hsm, uint8_t u8_Source, uint8_t u8_Target, Hsm_Hook_t pf_Action);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/*****************************************************************************/
+/*!
+ * \brief Initialise a machine and enter its initial state from the root down
+ *
+ * \param [in] pst_Hsm - machine
+ * \param [in] pst_Def - const description
+ * \param [in] pv_Ctx - handed to every hook
+ *****************************************************************************/
+void Hsm_Init(Hsm_t * pst_Hsm, const Hsm_Def_t * pst_Def, void * pv_Ctx)
+{
+  uint8_t au8_Path[HSM_MAX_DEPTH];
+  uint8_t u8_Depth = 0U;
+
+  pst_Hsm->pst_Def = pst_Def;
+  pst_Hsm->pv_Ctx = pv_Ctx;
+  pst_Hsm->u8_State = pst_Def->u8_Initial;
+
+  for (uint8_t u8_S = pst_Def->u8_Initial; u8_S != HSM_NO_PARENT; u8_S = pst_Def->pst_States[u8_S].u8_Parent)
+  {
+    assert(u8_Depth < HSM_MAX_DEPTH);
+    au8_Path[u8_Depth++] = u8_S;
+  }
+  while (u8_Depth > 0U)
+  {
+    const Hsm_State_t * pst_State = &pst_Def->pst_States[au8_Path[--u8_Depth]];
+    if (pst_State->pf_Entry != NULL)
+    {
+      pst_State->pf_Entry(pv_Ctx);
+    }
+  }
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Set up a machine in a saved state, no hook runs. The caller restores
+ *        what the entry actions of that state would have set up.
+ *
+ * \param [in] pst_Hsm - machine
+ * \param [in] pst_Def - const description
+ * \param [in] pv_Ctx - handed to every hook
+ * \param [in] u8_State - state from Hsm_GetState before it was saved
+ *****************************************************************************/
+void Hsm_Restore(Hsm_t * pst_Hsm, const Hsm_Def_t * pst_Def, void * pv_Ctx, uint8_t u8_State)
+{
+  assert(u8_State < pst_Def->u8_States);
+  pst_Hsm->pst_Def = pst_Def;
+  pst_Hsm->pv_Ctx = pv_Ctx;
+  pst_Hsm->u8_State = u8_State;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Dispatch one event
+ *
+ * The cell of the active state is looked up directly, a missing or guarded
+ * cell passes the event on to the parent.
+ *
+ * \param [in] pst_Hsm - machine
+ * \param [in] u8_Event - event, below u8_Events of the description
+ *
+ * \return true if some state handled the event
+ *****************************************************************************/
+bool Hsm_Dispatch(Hsm_t * pst_Hsm, uint8_t u8_Event)
+{
+  const Hsm_Def_t * pst_Def = pst_Hsm->pst_Def;
+  uint8_t u8_S = pst_Hsm->u8_State;
+
+  assert(u8_Event < pst_Def->u8_Events);
+
+  while (u8_S != HSM_NO_PARENT)
+  {
+    const Hsm_Trans_t * pst_T = &pst_Def->pst_Trans[((uint16_t)u8_S * pst_Def->u8_Events) + u8_Event];
+
+    if ((pst_T->u8_Next != HSM_NEXT_UNHANDLED) &&
+        ((pst_T->pf_Guard == NULL) || (pst_T->pf_Guard(pst_Hsm->pv_Ctx) != false)))
+    {
+      if (pst_T->u8_Next == HSM_NEXT_INTERNAL)
+      {
+        if (pst_T->pf_Action != NULL)
+        {
+          pst_T->pf_Action(pst_Hsm->pv_Ctx);
+        }
+      }
+      else
+      {
+        Hsm_vTransition(pst_Hsm, u8_S, (uint8_t)(pst_T->u8_Next - 1U), pst_T->pf_Action);
+      }
+      return true;
+    }
+    u8_S = pst_Def->pst_States[u8_S].u8_Parent;
+  }
+  return false;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Active state
+ *
+ * \param [in] pst_Hsm - machine
+ *
+ * \return state index
+ *****************************************************************************/
+uint8_t Hsm_GetState(const Hsm_t * pst_Hsm)
+{
+  return pst_Hsm->u8_State;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Check if a state is the active state or one of its ancestors
+ *
+ * \param [in] pst_Hsm - machine
+ * \param [in] u8_State - state to test
+ *
+ * \return true if u8_State is active
+ *****************************************************************************/
+bool Hsm_IsIn(const Hsm_t * pst_Hsm, uint8_t u8_State)
+{
+  for (uint8_t u8_S = pst_Hsm->u8_State; u8_S != HSM_NO_PARENT; u8_S = pst_Hsm->pst_Def->pst_States[u8_S].u8_Parent)
+  {
+    if (u8_S == u8_State)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Name of the active state
+ *
+ * \param [in] pst_Hsm - machine
+ *
+ * \return name from the state table
+ *****************************************************************************/
+const char * Hsm_GetStateName(const Hsm_t * pst_Hsm)
+{
+  return pst_Hsm->pst_Def->pst_States[pst_Hsm->u8_State].pc_Name;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/*****************************************************************************/
+/*!
+ * \brief Leave the active state up to the common ancestor, run the action and
+ *        enter down to the target
+ *
+ * \param [in] pst_Hsm - machine
+ * \param [in] u8_Source - state whose cell fired, the active one or an ancestor
+ * \param [in] u8_Target - new state
+ * \param [in] pf_Action - transition action or NULL
+ *****************************************************************************/
+static void Hsm_vTransition(Hsm_t * pst_Hsm, uint8_t u8_Source, uint8_t u8_Target, Hsm_Hook_t pf_Action)
+{
+  const Hsm_State_t * pst_States = pst_Hsm->pst_Def->pst_States;
+  uint8_t au8_Path[HSM_MAX_DEPTH];   // target and its ancestors
+  uint8_t u8_Depth = 0U;
+  uint8_t u8_Lca = HSM_NO_PARENT;
+  uint8_t u8_S;
+
+  for (u8_S = u8_Target; u8_S != HSM_NO_PARENT; u8_S = pst_States[u8_S].u8_Parent)
+  {
+    assert(u8_Depth < HSM_MAX_DEPTH);
+    au8_Path[u8_Depth++] = u8_S;
+  }
+
+  /* the lowest ancestor of the source on the target path, the target itself does not count */
+  for (u8_S = u8_Source; (u8_S != HSM_NO_PARENT) && (u8_Lca == HSM_NO_PARENT); u8_S = pst_States[u8_S].u8_Parent)
+  {
+    for (uint8_t i = 1U; i < u8_Depth; i++)
+    {
+      if (au8_Path[i] == u8_S)
+      {
+        u8_Lca = u8_S;
+        /* cut the path at the common ancestor */
+        u8_Depth = i;
+        break;
+      }
+    }
+  }
+
+  for (u8_S = pst_Hsm->u8_State; u8_S != u8_Lca; u8_S = pst_States[u8_S].u8_Parent)
+  {
+    if (pst_States[u8_S].pf_Exit != NULL)
+    {
+      pst_States[u8_S].pf_Exit(pst_Hsm->pv_Ctx);
+    }
+  }
+
+  if (pf_Action != NULL)
+  {
+    pf_Action(pst_Hsm->pv_Ctx);
+  }
+
+  pst_Hsm->u8_State = u8_Target;
+  while (u8_Depth > 0U)
+  {
+    const Hsm_State_t * pst_State = &pst_States[au8_Path[--u8_Depth]];
+    if (pst_State->pf_Entry != NULL)
+    {
+      pst_State->pf_Entry(pst_Hsm->pv_Ctx);
+    }
+  }
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      hsm library
+ ******************************************************************************/
+
+#ifndef HSM_H_
+#define HSM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file
+ *
+ *
+ *  \ingroup  hsm.h
+ *
+ *  \brief    Table driven hierarchical state machine. States and transitions
+ *            are const tables, dispatch indexes the transition table by
+ *            state and event and walks up to the parents only for events
+ *            the state itself does not handle.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+/*!
+ * \brief Deepest state nesting, root states are depth 1
+ */
+#ifndef HSM_MAX_DEPTH
+#define HSM_MAX_DEPTH             6U
+#endif
+
+#define HSM_NO_PARENT             0xFFU     // u8_Parent of a root state
+
+/* transition table entries, a zero entry is "not handled here" */
+#define HSM_NEXT_UNHANDLED        0x00U
+#define HSM_NEXT_INTERNAL         0xFFU
+#define HSM_GOTO(S, G, A)         { .u8_Next = (uint8_t)((S) + 1U), .pf_Guard = (G), .pf_Action = (A) }
+#define HSM_STAY(G, A)            { .u8_Next = HSM_NEXT_INTERNAL, .pf_Guard = (G), .pf_Action = (A) }
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+typedef void (*Hsm_Hook_t)(void *pv_Ctx);
+typedef bool (*Hsm_Guard_t)(void *pv_Ctx);
+
+/*!
+ * \brief one state
+ */
+typedef struct
+{
+  uint8_t u8_Parent;          // enclosing state or HSM_NO_PARENT
+  Hsm_Hook_t pf_Entry;        // may be NULL
+  Hsm_Hook_t pf_Exit;         // may be NULL
+  const char * pc_Name;
+} Hsm_State_t;
+
+/*!
+ * \brief one cell of the state x event table
+ */
+typedef struct
+{
+  uint8_t u8_Next;            // target state + 1, HSM_NEXT_INTERNAL or HSM_NEXT_UNHANDLED
+  Hsm_Guard_t pf_Guard;       // NULL or false blocks the cell, the parent is asked next
+  Hsm_Hook_t pf_Action;       // runs after the exits and before the entries
+} Hsm_Trans_t;
+
+/*!
+ * \brief machine description, everything const
+ */
+typedef struct
+{
+  const Hsm_State_t * pst_States;
+  const Hsm_Trans_t * pst_Trans;   // u8_States rows of u8_Events cells
+  uint8_t u8_States;
+  uint8_t u8_Events;
+  uint8_t u8_Initial;
+} Hsm_Def_t;
+
+/*!
+ * \brief machine instance
+ */
+typedef struct
+{
+  const Hsm_Def_t * pst_Def;
+  void * pv_Ctx;              // handed to every hook
+  uint8_t u8_State;           // active state
+} Hsm_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Hsm_Init(Hsm_t * pst_Hsm, const Hsm_Def_t * pst_Def, void * pv_Ctx);
+void Hsm_Restore(Hsm_t * pst_Hsm, const Hsm_Def_t * pst_Def, void * pv_Ctx, uint8_t u8_State);
+bool Hsm_Dispatch(Hsm_t * pst_Hsm, uint8_t u8_Event);
+uint8_t Hsm_GetState(const Hsm_t * pst_Hsm);
+bool Hsm_IsIn(const Hsm_t * pst_Hsm, uint8_t u8_State);
+const char * Hsm_GetStateName(const Hsm_t * pst_Hsm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // HSM_H_
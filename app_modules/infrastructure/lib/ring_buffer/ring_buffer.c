@@ -27,9 +27,20 @@
 /******************************************************************************/
 #include "ring_buffer.h"
 
+#if (RING_BUFFER_STATS_ENABLE == 1)
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_cpu.h"
+#endif
+
 /******************************************************************************/
 /* PRIVATE DEFINITIONS                                                        */
 /******************************************************************************/
+#if (RING_BUFFER_STATS_ENABLE == 1)
+#define RING_BUFFER_GET_CYCLES()    esp_cpu_get_cycle_count()
+#endif
 
 /******************************************************************************/
 /* PRIVATE TYPE DEFINITIONS                                                   */
@@ -38,6 +49,11 @@
 /******************************************************************************/
 /* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
 /******************************************************************************/
+#if (RING_BUFFER_STATS_ENABLE == 1)
+static uint16_t RingBuffer_u16TotalFill(enum ringbufferIndex Indx);
+static void RingBuffer_vStatsPush(enum ringbufferIndex Indx);
+static void RingBuffer_vStatsRead(enum ringbufferIndex Indx, uint16_t u16_Consumed);
+#endif
 
 /******************************************************************************/
 /* EXTERN VARIABLE DEFINTIONS                                                 */
@@ -58,6 +74,27 @@ struct RingBuffer_Ctrl_st
 };
 
 static struct RingBuffer_Ctrl_st RingBufferData[RING_BUFFER_MAX_IDX];
+
+#if (RING_BUFFER_STATS_ENABLE == 1)
+/*!
+ * \brief instrumentation data, one entry per buffer
+ */
+struct RingBuffer_Trace_st
+{
+  RingBuffer_Stats_t st_Stats;  // counters handed out by RingBuffer_GetStats
+  uint32_t u32_OldestTs;        // cycle count of the oldest unread byte
+  bool b_Pending;               // u32_OldestTs is valid
+};
+
+static struct RingBuffer_Trace_st RingBufferTrace[RING_BUFFER_MAX_IDX];
+
+static const char * const RingBufferName[RING_BUFFER_MAX_IDX] =
+{
+  "shell",
+  "console",
+  "touch_comms"
+};
+#endif
 /******************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /******************************************************************************/
@@ -80,6 +117,10 @@ void RingBuffer_vInit(enum ringbufferIndex Indx, uint8_t * pv_buffer, uint16_t p
   // Initialize shell pointers (READ and WRITE)
   RingBufferData[Indx].u8WritePtr = RingBufferData[Indx].u8StrtPtr;
   RingBufferData[Indx].u8ReadPtr = RingBufferData[Indx].u8StrtPtr;
+
+#if (RING_BUFFER_STATS_ENABLE == 1)
+  RingBuffer_ResetStats(Indx);
+#endif
 }
 
 /*****************************************************************************/
@@ -92,6 +133,9 @@ void RingBuffer_vInit(enum ringbufferIndex Indx, uint8_t * pv_buffer, uint16_t p
  *****************************************************************************/
 void RingBuffer_Push(enum ringbufferIndex Indx, uint8_t pv_data)
 {
+#if (RING_BUFFER_STATS_ENABLE == 1)
+  RingBuffer_vStatsPush(Indx);
+#endif
 
   *RingBufferData[Indx].u8WritePtr = pv_data; // Write into buffer
   RingBufferData[Indx].u8WritePtr++;                               // Increment write pointer
@@ -155,6 +199,10 @@ uint8_t* RingBuffer_ReadPtr(enum ringbufferIndex Indx)
  *****************************************************************************/
 void RingBuffer_UpdateReadPtr(enum ringbufferIndex Indx)
 {
+#if (RING_BUFFER_STATS_ENABLE == 1)
+  RingBuffer_vStatsRead(Indx, RingBuffer_GetFilledCount(Indx));
+#endif
+
   if(RingBufferData[Indx].u8ReadPtr < RingBufferData[Indx].u8WritePtr)
   {
     // Assign read pointer to write pointer
@@ -170,3 +218,191 @@ void RingBuffer_UpdateReadPtr(enum ringbufferIndex Indx)
     // Do nothing
   }
 }
+
+#if (RING_BUFFER_STATS_ENABLE == 1)
+/*****************************************************************************/
+/*!
+ * \brief Get a snapshot of the instrumentation counters
+ *
+ * \param [in] ringbufferIndex - Buffer Index
+ * \param [out] pst_Stats - destination of the snapshot
+ *
+ *****************************************************************************/
+void RingBuffer_GetStats(enum ringbufferIndex Indx, RingBuffer_Stats_t * pst_Stats)
+{
+  *pst_Stats = RingBufferTrace[Indx].st_Stats;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Clear the instrumentation counters, the buffer size is kept
+ *
+ * \param [in] ringbufferIndex - Buffer Index
+ *
+ *****************************************************************************/
+void RingBuffer_ResetStats(enum ringbufferIndex Indx)
+{
+  (void)memset(&RingBufferTrace[Indx], 0, sizeof(RingBufferTrace[Indx]));
+
+  if (RingBufferData[Indx].u8StrtPtr != NULL)
+  {
+    RingBufferTrace[Indx].st_Stats.u16_Size =
+      (uint16_t)(RingBufferData[Indx].u8EndPtr - RingBufferData[Indx].u8StrtPtr + 1);
+  }
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Print the counters of all initialised buffers to stdout
+ *
+ *****************************************************************************/
+void RingBuffer_PrintStats(void)
+{
+  RingBuffer_Stats_t st_Stats;
+  uint8_t u8_Idx;
+  uint8_t u8_Bucket;
+
+  for (u8_Idx = 0; u8_Idx < (uint8_t)RING_BUFFER_MAX_IDX; u8_Idx++)
+  {
+    RingBuffer_GetStats((enum ringbufferIndex)u8_Idx, &st_Stats);
+
+    if (st_Stats.u16_Size == 0U)
+    {
+      continue;  // not initialised
+    }
+
+    printf("%-12s size:%u peak:%u in:%lu out:%lu ovf:%lu drop:%lu latmax:%lu\n",
+           RingBufferName[u8_Idx],
+           (unsigned)st_Stats.u16_Size,
+           (unsigned)st_Stats.u16_PeakFill,
+           (unsigned long)st_Stats.u32_BytesIn,
+           (unsigned long)st_Stats.u32_BytesOut,
+           (unsigned long)st_Stats.u32_Overflows,
+           (unsigned long)st_Stats.u32_Drops,
+           (unsigned long)st_Stats.u32_LatMax);
+
+    for (u8_Bucket = 0; u8_Bucket < RING_BUFFER_LAT_BUCKETS; u8_Bucket++)
+    {
+      if (st_Stats.au32_LatHist[u8_Bucket] != 0U)
+      {
+        printf("  <2^%-2u cyc: %lu\n",
+               (unsigned)(u8_Bucket + RING_BUFFER_LAT_MIN_SHIFT + 1U),
+               (unsigned long)st_Stats.au32_LatHist[u8_Bucket]);
+      }
+    }
+  }
+}
+#endif
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+#if (RING_BUFFER_STATS_ENABLE == 1)
+/*****************************************************************************/
+/*!
+ * \brief Number of unread bytes including the part behind the wrap around.
+ *        RingBuffer_GetFilledCount only reports the contiguous part.
+ *
+ * \param [in] ringbufferIndex - Buffer Index
+ * \return number of unread bytes
+ *
+ *****************************************************************************/
+static uint16_t RingBuffer_u16TotalFill(enum ringbufferIndex Indx)
+{
+  const struct RingBuffer_Ctrl_st * pst_Buf = &RingBufferData[Indx];
+  uint16_t u16_Fill;
+
+  if (pst_Buf->u8WritePtr >= pst_Buf->u8ReadPtr)
+  {
+    u16_Fill = (uint16_t)(pst_Buf->u8WritePtr - pst_Buf->u8ReadPtr);
+  }
+  else
+  {
+    u16_Fill = (uint16_t)((pst_Buf->u8EndPtr - pst_Buf->u8ReadPtr + 1) +
+                          (pst_Buf->u8WritePtr - pst_Buf->u8StrtPtr));
+  }
+
+  return u16_Fill;
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Account one byte about to be pushed. A push into a buffer holding
+ *        size - 1 bytes makes the write pointer catch up with the read
+ *        pointer, the buffer then reads as empty and all data is lost.
+ *
+ * \param [in] ringbufferIndex - Buffer Index
+ *
+ *****************************************************************************/
+static void RingBuffer_vStatsPush(enum ringbufferIndex Indx)
+{
+  struct RingBuffer_Trace_st * pst_Trace = &RingBufferTrace[Indx];
+  uint16_t u16_Fill = RingBuffer_u16TotalFill(Indx);
+
+  pst_Trace->st_Stats.u32_BytesIn++;
+
+  if ((uint32_t)u16_Fill + 1U >= (uint32_t)pst_Trace->st_Stats.u16_Size)
+  {
+    pst_Trace->st_Stats.u32_Overflows++;
+    pst_Trace->st_Stats.u32_Drops += (uint32_t)u16_Fill + 1U;
+    pst_Trace->b_Pending = false;
+  }
+  else
+  {
+    if (pst_Trace->b_Pending == false)
+    {
+      pst_Trace->u32_OldestTs = RING_BUFFER_GET_CYCLES();
+      pst_Trace->b_Pending = true;
+    }
+
+    if (u16_Fill + 1U > pst_Trace->st_Stats.u16_PeakFill)
+    {
+      pst_Trace->st_Stats.u16_PeakFill = (uint16_t)(u16_Fill + 1U);
+    }
+  }
+}
+
+/*****************************************************************************/
+/*!
+ * \brief Account bytes released by RingBuffer_UpdateReadPtr. The latency is
+ *        measured for the oldest byte of the released block; when data is
+ *        left behind the wrap around its age is kept, so the next sample is
+ *        an upper bound.
+ *
+ * \param [in] ringbufferIndex - Buffer Index
+ * \param [in] u16_Consumed - number of bytes released
+ *
+ *****************************************************************************/
+static void RingBuffer_vStatsRead(enum ringbufferIndex Indx, uint16_t u16_Consumed)
+{
+  struct RingBuffer_Trace_st * pst_Trace = &RingBufferTrace[Indx];
+  uint32_t u32_Lat;
+  uint8_t u8_Bucket = 0;
+
+  pst_Trace->st_Stats.u32_BytesOut += u16_Consumed;
+
+  if ((u16_Consumed == 0U) || (pst_Trace->b_Pending == false))
+  {
+    return;
+  }
+
+  u32_Lat = RING_BUFFER_GET_CYCLES() - pst_Trace->u32_OldestTs;
+  if (u32_Lat > pst_Trace->st_Stats.u32_LatMax)
+  {
+    pst_Trace->st_Stats.u32_LatMax = u32_Lat;
+  }
+
+  u32_Lat >>= RING_BUFFER_LAT_MIN_SHIFT;
+  while ((u32_Lat > 1U) && (u8_Bucket < (RING_BUFFER_LAT_BUCKETS - 1U)))
+  {
+    u32_Lat >>= 1;
+    u8_Bucket++;
+  }
+  pst_Trace->st_Stats.au32_LatHist[u8_Bucket]++;
+
+  if (u16_Consumed == RingBuffer_u16TotalFill(Indx))
+  {
+    pst_Trace->b_Pending = false;  // buffer drained
+  }
+}
+#endif
@@ -41,6 +41,23 @@ extern "C" {
 /* PUBLIC DEFINITIONS                                                         */
 /******************************************************************************/
 
+/*!
+ * \brief Per buffer instrumentation (byte counters, peak fill, overflows and
+ *        enqueue-to-dequeue latency) and the rbstats console command.
+ *        Compiled out unless built with idf.py -DRING_BUFFER_STATS_ENABLE=1 build
+ */
+#ifndef RING_BUFFER_STATS_ENABLE
+#define RING_BUFFER_STATS_ENABLE        0
+#endif
+
+/*!
+ * \brief Latency histogram layout: bucket i counts latencies in
+ *        [2^(i + MIN_SHIFT), 2^(i + 1 + MIN_SHIFT)) cycles, the first bucket
+ *        also holds everything below and the last one everything above.
+ */
+#define RING_BUFFER_LAT_BUCKETS         20U
+#define RING_BUFFER_LAT_MIN_SHIFT       10U
+
 /******************************************************************************/
 /* PUBLIC TYPE DEFINITIONS                                                    */
 /******************************************************************************/
@@ -57,6 +74,21 @@ enum ringbufferIndex
   RING_BUFFER_MAX_IDX 
 };
 
+/*!
+ * \brief snapshot of the instrumentation counters of one buffer
+ */
+typedef struct
+{
+  uint32_t u32_BytesIn;                                 // bytes pushed
+  uint32_t u32_BytesOut;                                // bytes released by the reader
+  uint16_t u16_Size;                                    // usable size of the buffer in bytes
+  uint16_t u16_PeakFill;                                // high-water mark in bytes
+  uint32_t u32_Overflows;                               // number of times the writer ran into the reader
+  uint32_t u32_Drops;                                   // bytes lost by overflows
+  uint32_t u32_LatMax;                                  // worst enqueue-to-dequeue latency in cycles
+  uint32_t au32_LatHist[RING_BUFFER_LAT_BUCKETS];       // latency histogram, see RING_BUFFER_LAT_MIN_SHIFT
+} RingBuffer_Stats_t;
+
 /******************************************************************************/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /******************************************************************************/
@@ -66,6 +98,12 @@ uint16_t RingBuffer_GetFilledCount(enum ringbufferIndex Indx);
 uint8_t* RingBuffer_ReadPtr(enum ringbufferIndex Indx);
 void RingBuffer_UpdateReadPtr(enum ringbufferIndex Indx);
 
+#if (RING_BUFFER_STATS_ENABLE == 1)
+void RingBuffer_GetStats(enum ringbufferIndex Indx, RingBuffer_Stats_t * pst_Stats);
+void RingBuffer_ResetStats(enum ringbufferIndex Indx);
+void RingBuffer_PrintStats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -110,6 +110,7 @@ typedef sint32 Srvc_CurveS32_t[];
 /******************************************************************************/
 extern uint8_t Srvc_CalcCRC (const uint8_t pu8_Buff[], const uint16_t u16_Lgth);
 uint16_t Srvc_calc_2sComplementcrc(const uint8_t* buffer, const uint8_t size );
+uint32_t Srvc_CalcCRC32(uint32_t u32_Crc, const uint8_t pu8_Buff[], uint32_t u32_Lgth);
 extern bool Srvc_Debounce(bool X, Srvc_DebounceState_t * State, const Srvc_DebounceParam_t * Param, int32_t Dt_Time);
 
 extern void Srvc_StartSWTmrU32(Srvc_SWTmrU32_t * tmrPtr);
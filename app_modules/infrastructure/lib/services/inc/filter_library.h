@@ -0,0 +1,258 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      Filter library
+ ******************************************************************************/
+
+#ifndef FILTER_LIBRARY_H_
+#define FILTER_LIBRARY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file
+ *
+ *
+ *  \ingroup  filter_library.h
+ *
+ *  \brief    Streaming filters for sensor conditioning. All state lives in
+ *            memory provided by the caller, nothing is allocated.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+#define SRVC_MEDIAN_MAX_N         31U        // longest median window
+
+#define SRVC_EMA_FRAC             16U        // fraction bits of the EMA state
+
+/* biquad coefficients from constants, folded by the compiler. Q14 for S16 data, Q30 for S32 data, |C| < 2 */
+#define SRVC_BIQ_Q14(C)           ((int16_t)((C) * 16384.0 + (((C) >= 0.0) ? 0.5 : -0.5)))
+#define SRVC_BIQ_Q30(C)           ((int32_t)((C) * 1073741824.0 + (((C) >= 0.0) ? 0.5 : -0.5)))
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+/* sliding minimum or maximum, monotonic deque of u16_N entries, used in Srvc_SlidingMinMax_S16 */
+typedef struct
+{
+  int16_t * ps16_Val;     // deque values, u16_N entries
+  uint32_t * pu32_Idx;    // sample number of every deque value, u16_N entries
+  uint32_t u32_Cnt;       // samples pushed so far
+  uint16_t u16_N;         // window length
+  uint16_t u16_Head;      // oldest deque entry
+  uint16_t u16_Len;       // deque entries in use
+  bool b_Max;             // true: maximum, false: minimum
+} Srvc_SlidMinMaxS16_t;
+
+/* specialised struct, used in Srvc_SlidingMinMax_S32 */
+typedef struct
+{
+  int32_t * ps32_Val;
+  uint32_t * pu32_Idx;
+  uint32_t u32_Cnt;
+  uint16_t u16_N;
+  uint16_t u16_Head;
+  uint16_t u16_Len;
+  bool b_Max;
+} Srvc_SlidMinMaxS32_t;
+
+/* streaming median over u8_N samples, used in Srvc_Median_S16 */
+typedef struct
+{
+  int16_t * ps16_Ring;    // last u8_N samples in arrival order
+  int16_t * ps16_Sorted;  // the same samples sorted, not used for u8_N <= 5
+  uint8_t u8_N;           // window length 1..SRVC_MEDIAN_MAX_N
+  uint8_t u8_Pos;         // ring slot replaced next
+} Srvc_MedianS16_t;
+
+/* first order low-pass y += (x - y) / 2^u8_Shift, used in Srvc_Ema_S16 */
+typedef struct
+{
+  int32_t s32_State;      // y in Q(SRVC_EMA_FRAC)
+  uint8_t u8_Shift;       // time constant, 2^u8_Shift samples, 1..15
+} Srvc_EmaS16_t;
+
+/* u16_Ch EMAs with the same time constant, used in Srvc_EmaBank_S16 */
+typedef struct
+{
+  int32_t * ps32_State;   // u16_Ch states
+  uint16_t u16_Ch;
+  uint8_t u8_Shift;
+} Srvc_EmaBankS16_t;
+
+/* direct form I biquad y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2, coefficients in Q14 */
+typedef struct
+{
+  int16_t s16_B0;
+  int16_t s16_B1;
+  int16_t s16_B2;
+  int16_t s16_A1;
+  int16_t s16_A2;
+} Srvc_BiquadCoefS16_t;
+
+/* history of one S16 biquad */
+typedef struct
+{
+  int16_t s16_X1;
+  int16_t s16_X2;
+  int16_t s16_Y1;
+  int16_t s16_Y2;
+} Srvc_BiquadS16_t;
+
+/* same for S32 data, coefficients in Q30 */
+typedef struct
+{
+  int32_t s32_B0;
+  int32_t s32_B1;
+  int32_t s32_B2;
+  int32_t s32_A1;
+  int32_t s32_A2;
+} Srvc_BiquadCoefS32_t;
+
+typedef struct
+{
+  int32_t s32_X1;
+  int32_t s32_X2;
+  int32_t s32_Y1;
+  int32_t s32_Y2;
+} Srvc_BiquadS32_t;
+
+/* u16_Ch S16 biquads sharing one coefficient set, history stored per tap, used in Srvc_BiquadBank_S16 */
+typedef struct
+{
+  const Srvc_BiquadCoefS16_t * pst_Coef;
+  int16_t * ps16_X1;      // u16_Ch entries each
+  int16_t * ps16_X2;
+  int16_t * ps16_Y1;
+  int16_t * ps16_Y2;
+  uint16_t u16_Ch;
+} Srvc_BiquadBankS16_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+
+void Srvc_SlidingMinMaxInit_S16(Srvc_SlidMinMaxS16_t * const pst_Flt, int16_t * ps16_Val, uint32_t * pu32_Idx,
+                                uint16_t u16_N, bool b_Max);
+int16_t Srvc_SlidingMinMax_S16(Srvc_SlidMinMaxS16_t * const pst_Flt, int16_t s16_Inp);
+void Srvc_SlidingMinMaxInit_S32(Srvc_SlidMinMaxS32_t * const pst_Flt, int32_t * ps32_Val, uint32_t * pu32_Idx,
+                                uint16_t u16_N, bool b_Max);
+int32_t Srvc_SlidingMinMax_S32(Srvc_SlidMinMaxS32_t * const pst_Flt, int32_t s32_Inp);
+
+void Srvc_MedianInit_S16(Srvc_MedianS16_t * const pst_Flt, int16_t * ps16_Ring, int16_t * ps16_Sorted, uint8_t u8_N);
+int16_t Srvc_Median_S16(Srvc_MedianS16_t * const pst_Flt, int16_t s16_Inp);
+
+void Srvc_EmaInit_S16(Srvc_EmaS16_t * const pst_Flt, uint8_t u8_Shift, int16_t s16_Init);
+void Srvc_Ema_S16_Blk(Srvc_EmaS16_t * const pst_Flt, int16_t * ps16_Buf, uint16_t u16_N);
+void Srvc_EmaBankInit_S16(Srvc_EmaBankS16_t * const pst_Bank, int32_t * ps32_State, uint16_t u16_Ch, uint8_t u8_Shift);
+void Srvc_EmaBank_S16(Srvc_EmaBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out);
+
+void Srvc_BiquadInit_S16(Srvc_BiquadS16_t * const pst_Flt);
+void Srvc_Biquad_S16_Blk(const Srvc_BiquadCoefS16_t * pst_Coef, Srvc_BiquadS16_t * const pst_Flt,
+                         int16_t * ps16_Buf, uint16_t u16_N);
+void Srvc_BiquadInit_S32(Srvc_BiquadS32_t * const pst_Flt);
+void Srvc_Biquad_S32_Blk(const Srvc_BiquadCoefS32_t * pst_Coef, Srvc_BiquadS32_t * const pst_Flt,
+                         int32_t * ps32_Buf, uint16_t u16_N);
+void Srvc_BiquadBankInit_S16(Srvc_BiquadBankS16_t * const pst_Bank, const Srvc_BiquadCoefS16_t * pst_Coef,
+                             int16_t * ps16_Hist, uint16_t u16_Ch);
+void Srvc_BiquadBank_S16(Srvc_BiquadBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out);
+
+/******************************************************************************/
+/* PUBLIC INLINE FUNCTION DEFINITIONS                                         */
+/******************************************************************************/
+/* Per sample steps. Called with constant shifts or a const coefficient set the compiler specialises them, the
+ * shift-only EMA needs no multiplier at all. Saturation is that of Srvc_TypeLimiter_S32_S16. */
+
+/* one EMA step on a raw state, returns the rounded and limited output */
+static inline int16_t Srvc_EmaStep_S16(int32_t * ps32_State, int16_t s16_Inp, uint8_t u8_Shift)
+{
+  /* both terms are shifted separately so that x - y can not overflow */
+  const int32_t s32_Y = *ps32_State + (((int32_t)s16_Inp * (1L << SRVC_EMA_FRAC)) >> u8_Shift) - (*ps32_State >> u8_Shift);
+  const int32_t s32_Out = (s32_Y + (1L << (SRVC_EMA_FRAC - 1U))) >> SRVC_EMA_FRAC;
+
+  *ps32_State = s32_Y;
+  return (int16_t)((s32_Out >= (int32_t)INT16_MAX) ? INT16_MAX : s32_Out);
+}
+
+static inline int16_t Srvc_Ema_S16(Srvc_EmaS16_t * const pst_Flt, int16_t s16_Inp)
+{
+  return Srvc_EmaStep_S16(&pst_Flt->s32_State, s16_Inp, pst_Flt->u8_Shift);
+}
+
+static inline int16_t Srvc_Biquad_S16(const Srvc_BiquadCoefS16_t * pst_Coef, Srvc_BiquadS16_t * const pst_Flt,
+                                      int16_t s16_Inp)
+{
+  /* accumulated modulo 2^32, exact as long as the unlimited output stays within 4x full scale */
+  uint32_t u32_Acc = (uint32_t)1U << 13;
+  int32_t s32_Y;
+
+  u32_Acc += (uint32_t)((int32_t)pst_Coef->s16_B0 * s16_Inp);
+  u32_Acc += (uint32_t)((int32_t)pst_Coef->s16_B1 * pst_Flt->s16_X1);
+  u32_Acc += (uint32_t)((int32_t)pst_Coef->s16_B2 * pst_Flt->s16_X2);
+  u32_Acc -= (uint32_t)((int32_t)pst_Coef->s16_A1 * pst_Flt->s16_Y1);
+  u32_Acc -= (uint32_t)((int32_t)pst_Coef->s16_A2 * pst_Flt->s16_Y2);
+  s32_Y = (int32_t)u32_Acc >> 14;
+  s32_Y = (s32_Y <= (int32_t)INT16_MIN) ? INT16_MIN : ((s32_Y >= (int32_t)INT16_MAX) ? INT16_MAX : s32_Y);
+
+  pst_Flt->s16_X2 = pst_Flt->s16_X1;
+  pst_Flt->s16_X1 = s16_Inp;
+  pst_Flt->s16_Y2 = pst_Flt->s16_Y1;
+  pst_Flt->s16_Y1 = (int16_t)s32_Y;
+  return (int16_t)s32_Y;
+}
+
+static inline int32_t Srvc_Biquad_S32(const Srvc_BiquadCoefS32_t * pst_Coef, Srvc_BiquadS32_t * const pst_Flt,
+                                      int32_t s32_Inp)
+{
+  /* accumulated modulo 2^64, exact as long as the unlimited output stays within 4x full scale */
+  uint64_t u64_Acc = (uint64_t)1U << 29;
+  int64_t s64_Y;
+
+  u64_Acc += (uint64_t)((int64_t)pst_Coef->s32_B0 * s32_Inp);
+  u64_Acc += (uint64_t)((int64_t)pst_Coef->s32_B1 * pst_Flt->s32_X1);
+  u64_Acc += (uint64_t)((int64_t)pst_Coef->s32_B2 * pst_Flt->s32_X2);
+  u64_Acc -= (uint64_t)((int64_t)pst_Coef->s32_A1 * pst_Flt->s32_Y1);
+  u64_Acc -= (uint64_t)((int64_t)pst_Coef->s32_A2 * pst_Flt->s32_Y2);
+  s64_Y = (int64_t)u64_Acc >> 30;
+  s64_Y = (s64_Y <= (int64_t)INT32_MIN) ? INT32_MIN : ((s64_Y >= (int64_t)INT32_MAX) ? INT32_MAX : s64_Y);
+
+  pst_Flt->s32_X2 = pst_Flt->s32_X1;
+  pst_Flt->s32_X1 = s32_Inp;
+  pst_Flt->s32_Y2 = pst_Flt->s32_Y1;
+  pst_Flt->s32_Y1 = (int32_t)s64_Y;
+  return (int32_t)s64_Y;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FILTER_LIBRARY_H_
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      Fixed point math library
+ ******************************************************************************/
+
+#ifndef FIXED_MATH_LIBRARY_H_
+#define FIXED_MATH_LIBRARY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file
+ *
+ *
+ *  \ingroup  fixed_math_library.h
+ *
+ *  \brief    Transcendental functions in fixed point, no libm and no floats
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+#define SRVC_ANGLE_QUARTER        0x4000U     // 90 degree, one turn is 0x10000
+#define SRVC_Q16_ONE              0x10000L    // 1.0 in Q16
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+
+void Srvc_SinCos_Q15(uint16_t u16_Angle, int16_t * ps16_Sin, int16_t * ps16_Cos);
+int16_t Srvc_Sin_Q15(uint16_t u16_Angle);
+int16_t Srvc_Cos_Q15(uint16_t u16_Angle);
+
+uint16_t Srvc_Sqrt_U32_U16(uint32_t u32_X);
+
+int32_t Srvc_Log2_U32_Q16(uint32_t u32_X);
+uint32_t Srvc_Exp2_S32_Q16(int32_t s32_X);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FIXED_MATH_LIBRARY_H_
@@ -43,6 +43,9 @@ extern "C" {
 
 #define Srvc_MulDiv32(M1, M2, D)             Srvc_MulDiv_S32S32S32_S32((M1), (M2), (D))
 
+/* division of a signed value by 2^S rounded toward zero, same result as X / (1 << S) */
+#define SRVC_SHIFT_DIV(X, S)                 (((X) + (((X) < 0) ? ((1L << (S)) - 1) : 0)) >> (S))
+
 // TODO: remove once finalyse what is the exact value
 #define TX_TIMER_TICKS_PER_SECOND         1
 
@@ -54,6 +57,7 @@ typedef struct
 {
   int32_t s32_Sum;       // Sum value stored
   uint8_t u8_N;           // no of average to be considered
+  uint8_t u8_Shift;       // log2(u8_N) for power of two windows, 0 divides
   int16_t * ps16_Beg;     // starting address of array
   int16_t * ps16_End;     // end address of array
   int16_t * ps16_Act;     // actual position of array. Initialize with starting address of array.
@@ -65,11 +69,23 @@ typedef struct
 {
   int64_t s64_Sum;
   uint8_t u8_N;
+  uint8_t u8_Shift;       // log2(u8_N) for power of two windows, 0 divides
   int32_t * ps32_Beg;
   int32_t * ps32_End;
   int32_t * ps32_Act;
 } Srvc_AvrgsldngS32_t;
 
+/* bank of sliding averages with a common window, structure of arrays, used in Srvc_AverageBank_S16 */
+typedef struct
+{
+  int32_t * ps32_Sum;     // sum per channel
+  int16_t * ps16_Hist;    // u16_N rows of u16_Ch values
+  uint16_t u16_Ch;        // number of channels
+  uint16_t u16_N;         // window length
+  uint16_t u16_Pos;       // row to be replaced next
+  uint8_t u8_Shift;       // log2(u16_N) for power of two windows, 0 divides
+} Srvc_AvrgBankS16_t;
+
 /******************************************************************************/
 /* PUBLIC DATA DECLARATIONS                                                   */
 /******************************************************************************/
@@ -104,9 +120,17 @@ int32_t Srvc_Average_S32S32_S32(int32_t s32_X, int32_t s32_Y);
 
 
 int16_t Srvc_AverageArray_S16(const int16_t * Array_pcs16, uint8_t u8_N);
+int32_t Srvc_AverageArray_S32(const int32_t * Array_pcs32, uint8_t u8_N);
 
 // int16_t Srvc_AverageSliding_S16 (Srvc_AvrgsldngS16_t *const Struct_cpst, int16_t s16_Inp);
 int16_t Srvc_AverageSliding_S16(  Srvc_AvrgsldngS16_t * const Struct_cpst, int16_t s16_Inp, int32_t s32_SampleCount, int32_t s32_MaxSampleCount);
+int32_t Srvc_AverageSliding_S32(Srvc_AvrgsldngS32_t * const Struct_cpst, int32_t Inp_s32);
+void Srvc_AverageSlidingInit_S16(Srvc_AvrgsldngS16_t * const Struct_cpst, int16_t * ps16_Buf, uint8_t u8_N);
+void Srvc_AverageSlidingInit_S32(Srvc_AvrgsldngS32_t * const Struct_cpst, int32_t * ps32_Buf, uint8_t u8_N);
+void Srvc_AverageBankInit_S16(Srvc_AvrgBankS16_t * const pst_Bank, int32_t * ps32_Sum, int16_t * ps16_Hist,
+                              uint16_t u16_Ch, uint16_t u16_N);
+void Srvc_AverageBank_S16(Srvc_AvrgBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out);
+uint8_t Srvc_Log2Exact_U16(uint16_t u16_N);
 
 /********************************************************
 *   Accessed by other functions
@@ -120,6 +144,12 @@ uint16_t Srvc_Div_S32S32_U16(int32_t s32_X, int32_t s32_Y);
 int64_t Srvc_Mul_S32S32_S64(int32_t s32_X, int32_t s32_Y);
 uint64_t Srvc_Mul_U32U32_U64(uint32_t u32_X, uint32_t u32_Y);
 
+/********************************************************
+*   Block functions
+********************************************************/
+void Srvc_MulAcc_S16Q15_Blk(int32_t *ps32_Acc, const int16_t *ps16_X, int16_t s16_Gain, uint16_t u16_N);
+void Srvc_TypeLimiter_S32_S16_Blk(int16_t *ps16_Dst, const int32_t *ps32_Src, uint16_t u16_N);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      Time series library
+ ******************************************************************************/
+
+#ifndef TIMESERIES_LIBRARY_H_
+#define TIMESERIES_LIBRARY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file
+ *
+ *
+ *  \ingroup  timeseries_library.h
+ *
+ *  \brief    Block codec for (time, values) records. Times are stored as
+ *            delta-of-delta, values as zigzag deltas, both bit packed.
+ *            A block is decoded on its own with constant memory.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+#define SRVC_TS_MAX_VALS          4U         // values per record
+#define SRVC_TS_HDR_SIZE          4U         // u16 record count, u8 values per record, u8 version
+#define SRVC_TS_VERSION           1U
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+/* block encoder, used in Srvc_TsEncPut */
+typedef struct
+{
+  uint8_t * pu8_Buf;                      // block, u16_Size bytes
+  uint32_t u32_Bit;                       // next free bit
+  uint32_t u32_PrevT;
+  uint32_t u32_PrevDelta;                 // modulo 2^32, signed only in the zigzag code
+  uint32_t au32_PrevV[SRVC_TS_MAX_VALS];
+  uint16_t u16_Size;
+  uint16_t u16_Count;                     // records in the block
+  uint8_t u8_Vals;                        // values per record 1..SRVC_TS_MAX_VALS
+} Srvc_TsEnc_t;
+
+/* block decoder, used in Srvc_TsDecGet */
+typedef struct
+{
+  const uint8_t * pu8_Buf;
+  uint32_t u32_Bit;                       // next bit to read
+  uint32_t u32_End;                       // bits in the block
+  uint32_t u32_PrevT;
+  uint32_t u32_PrevDelta;                 // modulo 2^32, signed only in the zigzag code
+  uint32_t au32_PrevV[SRVC_TS_MAX_VALS];
+  uint16_t u16_Count;                     // records in the block
+  uint16_t u16_Read;                      // records decoded so far
+  uint8_t u8_Vals;
+} Srvc_TsDec_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+
+void Srvc_TsEncInit(Srvc_TsEnc_t * const pst_Enc, uint8_t * pu8_Buf, uint16_t u16_Size, uint8_t u8_Vals);
+bool Srvc_TsEncPut(Srvc_TsEnc_t * const pst_Enc, uint32_t u32_Time, const uint32_t * pu32_Val);
+uint16_t Srvc_TsEncFinish(Srvc_TsEnc_t * const pst_Enc);
+
+bool Srvc_TsDecInit(Srvc_TsDec_t * const pst_Dec, const uint8_t * pu8_Buf, uint16_t u16_Len);
+bool Srvc_TsDecGet(Srvc_TsDec_t * const pst_Dec, uint32_t * pu32_Time, uint32_t * pu32_Val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TIMESERIES_LIBRARY_H_
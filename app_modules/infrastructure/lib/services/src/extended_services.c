@@ -32,6 +32,7 @@
 #include "freertos/timers.h"
 #include "esp_timer.h"
 #include "math.h"
+#include "prof.h"
 
 /******************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
@@ -126,6 +127,35 @@ uint16_t Srvc_calc_2sComplementcrc(const uint8_t* buffer, const uint8_t size )
 	return (uint16_t)(0 - calculated_crc);
 }
 
+/**
+***************************************************************************************************
+* CRC-32 (IEEE 802.3, same as zlib crc32) of a byte buffer.
+* Calls can be chained, pass 0 for the first block and the previous result for the next ones.
+* \param u32_Crc  CRC of the data before, 0 to start
+* \param pu8_Buff pointer to the buffer
+* \param u32_Lgth length of the buffer
+* \return uint32_t CRC
+****************************************************************************************************
+*/
+uint32_t Srvc_CalcCRC32(uint32_t u32_Crc, const uint8_t pu8_Buff[], uint32_t u32_Lgth)
+{
+  /* nibble table for the reflected polynomial 0xEDB88320 */
+  static const uint32_t u32_Srvc_CRC32_Tab[16] =
+  {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+  };
+
+  u32_Crc = ~u32_Crc;
+  for (uint32_t u32_Ctr = 0; u32_Ctr < u32_Lgth; u32_Ctr++)
+  {
+    u32_Crc ^= pu8_Buff[u32_Ctr];
+    u32_Crc = (u32_Crc >> 4) ^ u32_Srvc_CRC32_Tab[u32_Crc & 0x0FU];
+    u32_Crc = (u32_Crc >> 4) ^ u32_Srvc_CRC32_Tab[u32_Crc & 0x0FU];
+  }
+  return ~u32_Crc;
+}
+
 /**
  ***************************************************************************************************
  * Interpolation for maps with S16, S16 input and S16 output values.
@@ -287,6 +317,7 @@ bool Srvc_Debounce(
   bool b_X, Srvc_DebounceState_t * State, const Srvc_DebounceParam_t * Param,
   int32_t s32_DtTime_ms)
 {
+  PROF_SCOPE("Srvc_Debounce");
   if (b_X == State->XOld) {  /* Input has not changed */
     State->Timer = 0L;  /* Stop timer  */
   } else {  /* Check if the running timer has run out */
@@ -337,6 +368,7 @@ int16_t Srvc_IpoCurveS16(int32_t s32_X, Srvc_CurveS16_t s16_Cur)
   const int16_t * ps16_Xval;  /* Pointer to X-data       */
   const int16_t * ps16_Yval;  /* Pointer to Y-data       */
   int16_t s16_Res;
+  PROF_SCOPE("Srvc_IpoCurveS16");
 
   /* Get Number of data in curve  */
   s32_Num = s16_Cur[0];
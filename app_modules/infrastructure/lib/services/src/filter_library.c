@@ -0,0 +1,566 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      filter library
+ ******************************************************************************/
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file          filter_library.c
+ *
+ *  \brief         Streaming filters for sensor conditioning
+ *
+ *  \details       Order statistics over a sliding window and recursive
+ *                 low-pass filters. Like the sliding averages, every window
+ *                 filter starts on a window filled with 0.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <string.h>
+#include "filter_library.h"
+
+/*
+ ***********************************************************************************************************************
+ *
+ * List of Functions
+ *
+ * Srvc_SlidingMinMaxInit_S16   Srvc_SlidingMinMax_S16
+ * Srvc_SlidingMinMaxInit_S32   Srvc_SlidingMinMax_S32
+ * Srvc_MedianInit_S16          Srvc_Median_S16
+ * Srvc_EmaInit_S16             Srvc_Ema_S16_Blk             Srvc_EmaBankInit_S16
+ * Srvc_EmaBank_S16
+ * Srvc_BiquadInit_S16          Srvc_Biquad_S16_Blk          Srvc_BiquadInit_S32
+ * Srvc_Biquad_S32_Blk          Srvc_BiquadBankInit_S16      Srvc_BiquadBank_S16
+ *
+ * inline in filter_library.h:
+ * Srvc_EmaStep_S16             Srvc_Ema_S16                 Srvc_Biquad_S16
+ * Srvc_Biquad_S32
+ *
+ **/
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/* compare and swap of a sorting network */
+#define SRVC_CSWAP(A, B)          do { if ((A) > (B)) { const int16_t s16_T = (A); (A) = (B); (B) = s16_T; } } while (0)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS                                              */
+/******************************************************************************/
+
+static uint8_t Srvc_MedianFind_S16(const int16_t * ps16_Sorted, uint8_t u8_N, int16_t s16_X);
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Sliding minimum / maximum
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_SlidingMinMaxInit_S16
+ *
+ * \brief Sets up a sliding minimum or maximum over a window filled with 0.
+ *
+ * \param     pst_Flt       filter to initialize
+ * \param     ps16_Val      deque memory, u16_N values
+ * \param     pu32_Idx      deque memory, u16_N sample numbers
+ * \param     u16_N         window length, at least 1
+ * \param     b_Max         true for the maximum, false for the minimum
+ ***********************************************************************************************************************
+ */
+void Srvc_SlidingMinMaxInit_S16(Srvc_SlidMinMaxS16_t * const pst_Flt, int16_t * ps16_Val, uint32_t * pu32_Idx,
+                                uint16_t u16_N, bool b_Max)
+{
+  pst_Flt->ps16_Val = ps16_Val;
+  pst_Flt->pu32_Idx = pu32_Idx;
+  pst_Flt->u16_N = u16_N;
+  pst_Flt->b_Max = b_Max;
+  /* the zero filled window is one deque entry, the newest zero counts */
+  pst_Flt->ps16_Val[0] = 0;
+  pst_Flt->pu32_Idx[0] = (uint32_t)u16_N - 1U;
+  pst_Flt->u32_Cnt = 0;
+  pst_Flt->u16_Head = 0;
+  pst_Flt->u16_Len = 1;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_SlidingMinMax_S16
+ *
+ * \brief Pushes a sample and returns the minimum or maximum of the last u16_N samples.
+ *
+ * The deque holds only the samples that can still become the extreme, in window order and monotonic in value:
+ * a new sample removes all weaker ones from the back, the front leaves when it drops out of the window. Every
+ * sample enters and leaves once, so the cost is O(1) amortized.
+ *
+ * \param     pst_Flt       filter
+ * \param     s16_Inp       new sample
+ * \return    int16_t
+ * \retval    min or max of the window
+ ***********************************************************************************************************************
+ */
+int16_t Srvc_SlidingMinMax_S16(Srvc_SlidMinMaxS16_t * const pst_Flt, int16_t s16_Inp)
+{
+  const uint16_t u16_N = pst_Flt->u16_N;
+  const uint32_t u32_Now = pst_Flt->u32_Cnt + u16_N;   // sample number, the zero fill is 0..u16_N-1
+  uint16_t u16_Tail;
+
+  pst_Flt->u32_Cnt++;
+
+  /* drop the weaker samples from the back */
+  while (pst_Flt->u16_Len > 0U) {
+    u16_Tail = (uint16_t)((pst_Flt->u16_Head + pst_Flt->u16_Len - 1U) % u16_N);
+    if ((pst_Flt->b_Max != false) ? (pst_Flt->ps16_Val[u16_Tail] > s16_Inp) : (pst_Flt->ps16_Val[u16_Tail] < s16_Inp)) {
+      break;
+    }
+    pst_Flt->u16_Len--;
+  }
+
+  /* the front leaves the window */
+  if ((pst_Flt->u16_Len > 0U) && ((u32_Now - pst_Flt->pu32_Idx[pst_Flt->u16_Head]) >= u16_N)) {
+    pst_Flt->u16_Head = (uint16_t)((pst_Flt->u16_Head + 1U < u16_N) ? (pst_Flt->u16_Head + 1U) : 0U);
+    pst_Flt->u16_Len--;
+  }
+
+  u16_Tail = (uint16_t)((pst_Flt->u16_Head + pst_Flt->u16_Len) % u16_N);
+  pst_Flt->ps16_Val[u16_Tail] = s16_Inp;
+  pst_Flt->pu32_Idx[u16_Tail] = u32_Now;
+  pst_Flt->u16_Len++;
+
+  return pst_Flt->ps16_Val[pst_Flt->u16_Head];
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_SlidingMinMaxInit_S32
+ *
+ * \brief Sets up a sliding minimum or maximum over a window filled with 0, see Srvc_SlidingMinMaxInit_S16.
+ *
+ * \param     pst_Flt       filter to initialize
+ * \param     ps32_Val      deque memory, u16_N values
+ * \param     pu32_Idx      deque memory, u16_N sample numbers
+ * \param     u16_N         window length, at least 1
+ * \param     b_Max         true for the maximum, false for the minimum
+ ***********************************************************************************************************************
+ */
+void Srvc_SlidingMinMaxInit_S32(Srvc_SlidMinMaxS32_t * const pst_Flt, int32_t * ps32_Val, uint32_t * pu32_Idx,
+                                uint16_t u16_N, bool b_Max)
+{
+  pst_Flt->ps32_Val = ps32_Val;
+  pst_Flt->pu32_Idx = pu32_Idx;
+  pst_Flt->u16_N = u16_N;
+  pst_Flt->b_Max = b_Max;
+  pst_Flt->ps32_Val[0] = 0;
+  pst_Flt->pu32_Idx[0] = (uint32_t)u16_N - 1U;
+  pst_Flt->u32_Cnt = 0;
+  pst_Flt->u16_Head = 0;
+  pst_Flt->u16_Len = 1;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_SlidingMinMax_S32
+ *
+ * \brief Pushes a sample and returns the minimum or maximum of the last u16_N samples, see Srvc_SlidingMinMax_S16.
+ *
+ * \param     pst_Flt       filter
+ * \param     s32_Inp       new sample
+ * \return    int32_t
+ * \retval    min or max of the window
+ ***********************************************************************************************************************
+ */
+int32_t Srvc_SlidingMinMax_S32(Srvc_SlidMinMaxS32_t * const pst_Flt, int32_t s32_Inp)
+{
+  const uint16_t u16_N = pst_Flt->u16_N;
+  const uint32_t u32_Now = pst_Flt->u32_Cnt + u16_N;
+  uint16_t u16_Tail;
+
+  pst_Flt->u32_Cnt++;
+
+  while (pst_Flt->u16_Len > 0U) {
+    u16_Tail = (uint16_t)((pst_Flt->u16_Head + pst_Flt->u16_Len - 1U) % u16_N);
+    if ((pst_Flt->b_Max != false) ? (pst_Flt->ps32_Val[u16_Tail] > s32_Inp) : (pst_Flt->ps32_Val[u16_Tail] < s32_Inp)) {
+      break;
+    }
+    pst_Flt->u16_Len--;
+  }
+
+  if ((pst_Flt->u16_Len > 0U) && ((u32_Now - pst_Flt->pu32_Idx[pst_Flt->u16_Head]) >= u16_N)) {
+    pst_Flt->u16_Head = (uint16_t)((pst_Flt->u16_Head + 1U < u16_N) ? (pst_Flt->u16_Head + 1U) : 0U);
+    pst_Flt->u16_Len--;
+  }
+
+  u16_Tail = (uint16_t)((pst_Flt->u16_Head + pst_Flt->u16_Len) % u16_N);
+  pst_Flt->ps32_Val[u16_Tail] = s32_Inp;
+  pst_Flt->pu32_Idx[u16_Tail] = u32_Now;
+  pst_Flt->u16_Len++;
+
+  return pst_Flt->ps32_Val[pst_Flt->u16_Head];
+}
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Streaming median
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_MedianInit_S16
+ *
+ * \brief Sets up a streaming median over a window filled with 0.
+ *
+ * \param     pst_Flt       filter to initialize
+ * \param     ps16_Ring     memory for u8_N samples
+ * \param     ps16_Sorted   memory for u8_N samples, may be NULL for u8_N <= 5
+ * \param     u8_N          window length 1..SRVC_MEDIAN_MAX_N, odd lengths give a true median
+ ***********************************************************************************************************************
+ */
+void Srvc_MedianInit_S16(Srvc_MedianS16_t * const pst_Flt, int16_t * ps16_Ring, int16_t * ps16_Sorted, uint8_t u8_N)
+{
+  pst_Flt->ps16_Ring = ps16_Ring;
+  pst_Flt->ps16_Sorted = ps16_Sorted;
+  pst_Flt->u8_N = (u8_N > SRVC_MEDIAN_MAX_N) ? (uint8_t)SRVC_MEDIAN_MAX_N : u8_N;
+  pst_Flt->u8_Pos = 0;
+  (void)memset(ps16_Ring, 0, pst_Flt->u8_N * sizeof(int16_t));
+  if (ps16_Sorted != NULL) {
+    (void)memset(ps16_Sorted, 0, pst_Flt->u8_N * sizeof(int16_t));
+  }
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Median_S16
+ *
+ * \brief Pushes a sample and returns the median of the last u8_N samples.
+ *
+ * Windows of 3 and 5 run a sorting network over a copy of the window. Longer windows keep a sorted copy: the
+ * oldest sample is found by binary search and the new one moved into place with a single memmove. For windows up
+ * to 31 samples this touches less memory than a skiplist or two heaps would. Even windows return the upper of
+ * the two middle samples.
+ *
+ * \param     pst_Flt       filter
+ * \param     s16_Inp       new sample
+ * \return    int16_t
+ * \retval    median of the window
+ ***********************************************************************************************************************
+ */
+int16_t Srvc_Median_S16(Srvc_MedianS16_t * const pst_Flt, int16_t s16_Inp)
+{
+  const uint8_t u8_N = pst_Flt->u8_N;
+  const int16_t s16_Old = pst_Flt->ps16_Ring[pst_Flt->u8_Pos];
+  const int16_t * ps16_Ring = pst_Flt->ps16_Ring;
+
+  pst_Flt->ps16_Ring[pst_Flt->u8_Pos] = s16_Inp;
+  pst_Flt->u8_Pos = (uint8_t)((pst_Flt->u8_Pos + 1U < u8_N) ? (pst_Flt->u8_Pos + 1U) : 0U);
+
+  if (u8_N == 3U) {
+    int16_t a = ps16_Ring[0], b = ps16_Ring[1], c = ps16_Ring[2];
+    SRVC_CSWAP(a, b);
+    SRVC_CSWAP(b, c);
+    SRVC_CSWAP(a, b);
+    return b;
+  }
+  if (u8_N == 5U) {
+    /* 7 comparator network for the median of 5 */
+    int16_t a = ps16_Ring[0], b = ps16_Ring[1], c = ps16_Ring[2], d = ps16_Ring[3], e = ps16_Ring[4];
+    SRVC_CSWAP(a, b);
+    SRVC_CSWAP(d, e);
+    SRVC_CSWAP(a, d);
+    SRVC_CSWAP(b, e);
+    SRVC_CSWAP(b, c);
+    SRVC_CSWAP(c, d);
+    SRVC_CSWAP(b, c);
+    return c;
+  }
+  if (u8_N < 2U) {
+    return s16_Inp;
+  }
+
+  int16_t * ps16_Sorted = pst_Flt->ps16_Sorted;
+  const uint8_t u8_Out = Srvc_MedianFind_S16(ps16_Sorted, u8_N, s16_Old);
+  uint8_t u8_In = Srvc_MedianFind_S16(ps16_Sorted, u8_N, s16_Inp);
+
+  /* replace the old sample by shifting the samples in between by one */
+  if (u8_In > u8_Out) {
+    u8_In--;
+    (void)memmove(&ps16_Sorted[u8_Out], &ps16_Sorted[u8_Out + 1U], (size_t)(u8_In - u8_Out) * sizeof(int16_t));
+  } else if (u8_In < u8_Out) {
+    (void)memmove(&ps16_Sorted[u8_In + 1U], &ps16_Sorted[u8_In], (size_t)(u8_Out - u8_In) * sizeof(int16_t));
+  } else {
+    /* same slot */
+  }
+  ps16_Sorted[u8_In] = s16_Inp;
+
+  return ps16_Sorted[u8_N >> 1];
+}
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Recursive filters
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_EmaInit_S16
+ *
+ * \brief Sets up a first order low-pass, the exponential moving average.
+ *
+ * Two bytes of state stand in for the 2^u8_Shift samples a sliding average of the same smoothing would store.
+ *
+ * \param     pst_Flt       filter to initialize
+ * \param     u8_Shift      time constant of 2^u8_Shift samples, 1..15
+ * \param     s16_Init      start value
+ ***********************************************************************************************************************
+ */
+void Srvc_EmaInit_S16(Srvc_EmaS16_t * const pst_Flt, uint8_t u8_Shift, int16_t s16_Init)
+{
+  pst_Flt->s32_State = (int32_t)s16_Init * (1L << SRVC_EMA_FRAC);
+  pst_Flt->u8_Shift = u8_Shift;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Ema_S16_Blk
+ *
+ * \brief Filters a block in place, block variant of Srvc_Ema_S16.
+ *
+ * \param     pst_Flt       filter
+ * \param     ps16_Buf      samples, replaced by the filtered ones
+ * \param     u16_N         number of samples
+ ***********************************************************************************************************************
+ */
+void Srvc_Ema_S16_Blk(Srvc_EmaS16_t * const pst_Flt, int16_t * ps16_Buf, uint16_t u16_N)
+{
+  int32_t s32_State = pst_Flt->s32_State;
+  const uint8_t u8_Shift = pst_Flt->u8_Shift;
+
+  for (uint16_t i = 0; i < u16_N; i++)
+  {
+    ps16_Buf[i] = Srvc_EmaStep_S16(&s32_State, ps16_Buf[i], u8_Shift);
+  }
+  pst_Flt->s32_State = s32_State;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_EmaBankInit_S16
+ *
+ * \brief Sets up u16_Ch EMAs with a common time constant, all starting at 0.
+ *
+ * \param     pst_Bank      bank to initialize
+ * \param     ps32_State    memory for u16_Ch states
+ * \param     u16_Ch        number of channels
+ * \param     u8_Shift      time constant of 2^u8_Shift samples, 1..15
+ ***********************************************************************************************************************
+ */
+void Srvc_EmaBankInit_S16(Srvc_EmaBankS16_t * const pst_Bank, int32_t * ps32_State, uint16_t u16_Ch, uint8_t u8_Shift)
+{
+  pst_Bank->ps32_State = ps32_State;
+  pst_Bank->u16_Ch = u16_Ch;
+  pst_Bank->u8_Shift = u8_Shift;
+  (void)memset(ps32_State, 0, (size_t)u16_Ch * sizeof(int32_t));
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_EmaBank_S16
+ *
+ * \brief Filters one sample of every channel in one pass over the state array.
+ *
+ * \param     pst_Bank      bank
+ * \param     ps16_Inp      u16_Ch new samples
+ * \param     ps16_Out      u16_Ch filtered samples, may be ps16_Inp
+ ***********************************************************************************************************************
+ */
+void Srvc_EmaBank_S16(Srvc_EmaBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out)
+{
+  int32_t * ps32_State = pst_Bank->ps32_State;
+  const uint8_t u8_Shift = pst_Bank->u8_Shift;
+
+  for (uint16_t i = 0; i < pst_Bank->u16_Ch; i++)
+  {
+    ps16_Out[i] = Srvc_EmaStep_S16(&ps32_State[i], ps16_Inp[i], u8_Shift);
+  }
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_BiquadInit_S16
+ *
+ * \brief Clears the history of a biquad section.
+ *
+ * \param     pst_Flt       filter to initialize
+ ***********************************************************************************************************************
+ */
+void Srvc_BiquadInit_S16(Srvc_BiquadS16_t * const pst_Flt)
+{
+  (void)memset(pst_Flt, 0, sizeof(*pst_Flt));
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Biquad_S16_Blk
+ *
+ * \brief Filters a block in place, block variant of Srvc_Biquad_S16.
+ *
+ * The history is kept in registers for the whole block. Sections are cascaded by calling this once per section.
+ *
+ * \param     pst_Coef      coefficients in Q14, a0 is 1
+ * \param     pst_Flt       history
+ * \param     ps16_Buf      samples, replaced by the filtered ones
+ * \param     u16_N         number of samples
+ ***********************************************************************************************************************
+ */
+void Srvc_Biquad_S16_Blk(const Srvc_BiquadCoefS16_t * pst_Coef, Srvc_BiquadS16_t * const pst_Flt,
+                         int16_t * ps16_Buf, uint16_t u16_N)
+{
+  const Srvc_BiquadCoefS16_t st_Coef = *pst_Coef;
+  Srvc_BiquadS16_t st_Hist = *pst_Flt;
+
+  for (uint16_t i = 0; i < u16_N; i++)
+  {
+    ps16_Buf[i] = Srvc_Biquad_S16(&st_Coef, &st_Hist, ps16_Buf[i]);
+  }
+  *pst_Flt = st_Hist;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_BiquadInit_S32
+ *
+ * \brief Clears the history of a biquad section.
+ *
+ * \param     pst_Flt       filter to initialize
+ ***********************************************************************************************************************
+ */
+void Srvc_BiquadInit_S32(Srvc_BiquadS32_t * const pst_Flt)
+{
+  (void)memset(pst_Flt, 0, sizeof(*pst_Flt));
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Biquad_S32_Blk
+ *
+ * \brief Filters a block in place, block variant of Srvc_Biquad_S32.
+ *
+ * \param     pst_Coef      coefficients in Q30, a0 is 1
+ * \param     pst_Flt       history
+ * \param     ps32_Buf      samples, replaced by the filtered ones
+ * \param     u16_N         number of samples
+ ***********************************************************************************************************************
+ */
+void Srvc_Biquad_S32_Blk(const Srvc_BiquadCoefS32_t * pst_Coef, Srvc_BiquadS32_t * const pst_Flt,
+                         int32_t * ps32_Buf, uint16_t u16_N)
+{
+  const Srvc_BiquadCoefS32_t st_Coef = *pst_Coef;
+  Srvc_BiquadS32_t st_Hist = *pst_Flt;
+
+  for (uint16_t i = 0; i < u16_N; i++)
+  {
+    ps32_Buf[i] = Srvc_Biquad_S32(&st_Coef, &st_Hist, ps32_Buf[i]);
+  }
+  *pst_Flt = st_Hist;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_BiquadBankInit_S16
+ *
+ * \brief Sets up u16_Ch biquads sharing one coefficient set, all history cleared.
+ *
+ * \param     pst_Bank      bank to initialize
+ * \param     pst_Coef      coefficients in Q14, a0 is 1
+ * \param     ps16_Hist     memory for 4 * u16_Ch history values
+ * \param     u16_Ch        number of channels
+ ***********************************************************************************************************************
+ */
+void Srvc_BiquadBankInit_S16(Srvc_BiquadBankS16_t * const pst_Bank, const Srvc_BiquadCoefS16_t * pst_Coef,
+                             int16_t * ps16_Hist, uint16_t u16_Ch)
+{
+  pst_Bank->pst_Coef = pst_Coef;
+  pst_Bank->u16_Ch = u16_Ch;
+  pst_Bank->ps16_X1 = &ps16_Hist[0];
+  pst_Bank->ps16_X2 = &ps16_Hist[u16_Ch];
+  pst_Bank->ps16_Y1 = &ps16_Hist[2U * u16_Ch];
+  pst_Bank->ps16_Y2 = &ps16_Hist[3U * u16_Ch];
+  (void)memset(ps16_Hist, 0, 4U * (size_t)u16_Ch * sizeof(int16_t));
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_BiquadBank_S16
+ *
+ * \brief Filters one sample of every channel in one pass.
+ *
+ * The coefficients are loaded once per call and every history tap is a contiguous array, so the loop streams
+ * through memory without reloading the coefficients per channel.
+ *
+ * \param     pst_Bank      bank
+ * \param     ps16_Inp      u16_Ch new samples
+ * \param     ps16_Out      u16_Ch filtered samples, may be ps16_Inp
+ ***********************************************************************************************************************
+ */
+void Srvc_BiquadBank_S16(Srvc_BiquadBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out)
+{
+  const Srvc_BiquadCoefS16_t st_Coef = *pst_Bank->pst_Coef;
+
+  for (uint16_t i = 0; i < pst_Bank->u16_Ch; i++)
+  {
+    Srvc_BiquadS16_t st_Hist = { pst_Bank->ps16_X1[i], pst_Bank->ps16_X2[i], pst_Bank->ps16_Y1[i], pst_Bank->ps16_Y2[i] };
+
+    ps16_Out[i] = Srvc_Biquad_S16(&st_Coef, &st_Hist, ps16_Inp[i]);
+    pst_Bank->ps16_X1[i] = st_Hist.s16_X1;
+    pst_Bank->ps16_X2[i] = st_Hist.s16_X2;
+    pst_Bank->ps16_Y1[i] = st_Hist.s16_Y1;
+    pst_Bank->ps16_Y2[i] = st_Hist.s16_Y2;
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Binary search in the sorted window
+ * @param ps16_Sorted : sorted samples
+ * @param u8_N : number of samples
+ * @param s16_X : value to look for
+ * @return index of the first sample not less than s16_X
+ */
+static uint8_t Srvc_MedianFind_S16(const int16_t * ps16_Sorted, uint8_t u8_N, int16_t s16_X)
+{
+  uint8_t u8_Lo = 0U;
+  uint8_t u8_Hi = u8_N;
+
+  while (u8_Lo < u8_Hi) {
+    const uint8_t u8_Mid = (uint8_t)((u8_Lo + u8_Hi) >> 1);
+    if (ps16_Sorted[u8_Mid] < s16_X) {
+      u8_Lo = (uint8_t)(u8_Mid + 1U);
+    } else {
+      u8_Hi = u8_Mid;
+    }
+  }
+  return u8_Lo;
+}
@@ -0,0 +1,315 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      fixed point math library
+ ******************************************************************************/
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file          fixed_math_library.c
+ *
+ *  \brief         Transcendental functions in fixed point
+ *
+ *  \details       All functions are integer only and saturate like the
+ *                 Srvc_TypeLimiter functions instead of wrapping. The error
+ *                 bounds given per function were measured against libm
+ *                 doubles over the whole input range.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdbool.h>
+#include "fixed_math_library.h"
+#include "multiplication_library.h"
+
+/*
+ ***********************************************************************************************************************
+ *
+ * List of Functions
+ *
+ * Srvc_SinCos_Q15              Srvc_Sin_Q15                 Srvc_Cos_Q15
+ * Srvc_Sqrt_U32_U16            Srvc_Log2_U32_Q16            Srvc_Exp2_S32_Q16
+ *
+ **/
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+#define SRVC_CORDIC_STEPS         16U
+#define SRVC_CORDIC_GAIN_Q30      652032874L  // 1/K = 0.60725293 in Q30, start length of the vector
+#define SRVC_Q30_ONE              (1L << 30)
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+
+/* atan(2^-i) in 2^32 per turn */
+static const int32_t s32_Srvc_CordicAtan[SRVC_CORDIC_STEPS] =
+{
+  536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+  2670163,   1335087,   667544,    333772,   166886,   83443,    41722,    20861
+};
+
+/* 2^(2^-k) in Q30 for k = 1..16 */
+static const uint32_t u32_Srvc_Exp2Root[16] =
+{
+  1518500250UL, 1276901417UL, 1170923762UL, 1121280436UL, 1097253708UL, 1085434106UL, 1079572136UL, 1076653033UL,
+  1075196443UL, 1074468888UL, 1074105294UL, 1073923544UL, 1073832680UL, 1073787251UL, 1073764537UL, 1073753181UL
+};
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Trigonometry
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_SinCos_Q15
+ *
+ * \brief Sine and cosine of an angle by CORDIC rotation.
+ *
+ * The angle is reduced to +-90 degree, then rotated in 16 shift and add steps in Q30. Both results are rounded
+ * to Q15 and saturated to INT16_MAX, so sin(90 degree) is 32767.
+ * Error: at most 1.5 LSB of Q15 (4.6e-5).
+ *
+ * \param     u16_Angle     Angle, 0x10000 is one full turn
+ * \param     ps16_Sin      Returns the sine in Q15
+ * \param     ps16_Cos      Returns the cosine in Q15
+ ***********************************************************************************************************************
+ */
+void Srvc_SinCos_Q15(uint16_t u16_Angle, int16_t * ps16_Sin, int16_t * ps16_Cos)
+{
+  int32_t s32_Z = (int32_t)((uint32_t)u16_Angle << 16);
+  int32_t s32_X = SRVC_CORDIC_GAIN_Q30;
+  int32_t s32_Y = 0;
+  bool b_Neg = false;
+
+  /* CORDIC converges for +-99 degree only, rotate the rest by half a turn */
+  if ((s32_Z > (int32_t)SRVC_Q30_ONE) || (s32_Z < -(int32_t)SRVC_Q30_ONE))
+  {
+    s32_Z = (int32_t)((uint32_t)s32_Z + 0x80000000UL);
+    b_Neg = true;
+  }
+
+  for (uint32_t i = 0; i < SRVC_CORDIC_STEPS; i++)
+  {
+    const int32_t s32_Dx = s32_Y >> i;
+    const int32_t s32_Dy = s32_X >> i;
+
+    if (s32_Z >= 0)
+    {
+      s32_X -= s32_Dx;
+      s32_Y += s32_Dy;
+      s32_Z -= s32_Srvc_CordicAtan[i];
+    }
+    else
+    {
+      s32_X += s32_Dx;
+      s32_Y -= s32_Dy;
+      s32_Z += s32_Srvc_CordicAtan[i];
+    }
+  }
+
+  if (b_Neg != false)
+  {
+    s32_X = -s32_X;
+    s32_Y = -s32_Y;
+  }
+
+  *ps16_Sin = Srvc_TypeLimiter_S32_S16((s32_Y + (1L << 14)) >> 15);
+  *ps16_Cos = Srvc_TypeLimiter_S32_S16((s32_X + (1L << 14)) >> 15);
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Sin_Q15
+ *
+ * \brief Sine of an angle, see Srvc_SinCos_Q15.
+ *
+ * \param     u16_Angle     Angle, 0x10000 is one full turn
+ * \return    int16_t       sin(u16_Angle) in Q15
+ ***********************************************************************************************************************
+ */
+int16_t Srvc_Sin_Q15(uint16_t u16_Angle)
+{
+  int16_t s16_Sin;
+  int16_t s16_Cos;
+
+  Srvc_SinCos_Q15(u16_Angle, &s16_Sin, &s16_Cos);
+  return s16_Sin;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Cos_Q15
+ *
+ * \brief Cosine of an angle, see Srvc_SinCos_Q15.
+ *
+ * \param     u16_Angle     Angle, 0x10000 is one full turn
+ * \return    int16_t       cos(u16_Angle) in Q15
+ ***********************************************************************************************************************
+ */
+int16_t Srvc_Cos_Q15(uint16_t u16_Angle)
+{
+  int16_t s16_Sin;
+  int16_t s16_Cos;
+
+  Srvc_SinCos_Q15(u16_Angle, &s16_Sin, &s16_Cos);
+  return s16_Cos;
+}
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Roots, logarithm and exponential
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Sqrt_U32_U16
+ *
+ * \brief Integer square root, bit by bit without multiplications.
+ *
+ * Exact: the result is floor(sqrt(u32_X)).
+ *
+ * \param     u32_X         Radicand
+ * \return    uint16_t      floor(sqrt(u32_X))
+ ***********************************************************************************************************************
+ */
+uint16_t Srvc_Sqrt_U32_U16(uint32_t u32_X)
+{
+  uint32_t u32_Res = 0;
+  uint32_t u32_Bit = 1UL << 30;
+
+  while (u32_Bit > u32_X)
+  {
+    u32_Bit >>= 2;
+  }
+
+  while (u32_Bit != 0U)
+  {
+    if (u32_X >= (u32_Res + u32_Bit))
+    {
+      u32_X -= u32_Res + u32_Bit;
+      u32_Res = (u32_Res >> 1) + u32_Bit;
+    }
+    else
+    {
+      u32_Res >>= 1;
+    }
+    u32_Bit >>= 2;
+  }
+  return (uint16_t)u32_Res;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Log2_U32_Q16
+ *
+ * \brief Binary logarithm in Q16 of a Q16 value.
+ *
+ * The integer part is the position of the leading one, the 16 fraction bits are produced by squaring the
+ * normalized mantissa. log2(0) saturates to INT32_MIN.
+ * Error: at most 1 LSB of Q16 (1.5e-5), results are truncated.
+ *
+ * \param     u32_X         Value in Q16, 0x10000 is 1.0
+ * \return    int32_t       log2(u32_X / 65536) in Q16
+ ***********************************************************************************************************************
+ */
+int32_t Srvc_Log2_U32_Q16(uint32_t u32_X)
+{
+  int32_t s32_Msb = 31;
+  uint64_t u64_M;
+  int32_t s32_Res;
+
+  if (u32_X == 0U)
+  {
+    return INT32_MIN;
+  }
+
+  while ((u32_X & (1UL << s32_Msb)) == 0U)
+  {
+    s32_Msb--;
+  }
+
+  /* mantissa in [1, 2) as Q30 */
+  u64_M = (s32_Msb <= 30) ? ((uint64_t)u32_X << (30 - s32_Msb)) : ((uint64_t)u32_X >> 1);
+  s32_Res = (s32_Msb - 16) * (int32_t)SRVC_Q16_ONE;
+
+  for (int32_t s32_Bit = 15; s32_Bit >= 0; s32_Bit--)
+  {
+    u64_M = (u64_M * u64_M) >> 30;
+    if (u64_M >= (2ULL << 30))
+    {
+      u64_M >>= 1;
+      s32_Res += (int32_t)(1L << s32_Bit);
+    }
+  }
+  return s32_Res;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_Exp2_S32_Q16
+ *
+ * \brief Power of two in Q16 of a Q16 exponent.
+ *
+ * 2^frac is the product of the precomputed roots 2^(2^-k) of all set fraction bits, the integer part is a
+ * shift. Results above the Q16 range saturate to UINT32_MAX, results below 1 LSB become 0.
+ * Error: at most 1 LSB of Q16 or 5e-7 relative, whichever is larger.
+ *
+ * \param     s32_X         Exponent in Q16
+ * \return    uint32_t      2^(s32_X / 65536) in Q16
+ ***********************************************************************************************************************
+ */
+uint32_t Srvc_Exp2_S32_Q16(int32_t s32_X)
+{
+  const int32_t s32_Int = s32_X >> 16;
+  const uint32_t u32_Frac = (uint32_t)s32_X & 0xFFFFU;
+  uint64_t u64_R = SRVC_Q30_ONE;
+
+  if (s32_Int >= 16)
+  {
+    return UINT32_MAX;
+  }
+  if (s32_Int < -17)
+  {
+    return 0;
+  }
+
+  for (uint32_t k = 0; k < 16U; k++)
+  {
+    if ((u32_Frac & (0x8000UL >> k)) != 0U)
+    {
+      u64_R = ((u64_R * u32_Srvc_Exp2Root[k]) + (1ULL << 29)) >> 30;
+    }
+  }
+
+  /* Q30 mantissa to Q16 scaled by 2^int, rounded */
+  const int32_t s32_Shift = 14 - s32_Int;
+  if (s32_Shift > 0)
+  {
+    u64_R = (u64_R + (1ULL << (s32_Shift - 1))) >> s32_Shift;
+  }
+  else
+  {
+    u64_R <<= -s32_Shift;
+  }
+  return (u64_R > UINT32_MAX) ? UINT32_MAX : (uint32_t)u64_R;
+}
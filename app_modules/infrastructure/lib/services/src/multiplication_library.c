@@ -42,7 +42,11 @@
  * Srvc_MulDiv_S32S32S32_U16    Srvc_MulDiv_U32U32U32_U16    Srvc_TypeLimiter_U32_U16
  * Srvc_TypeLimiter_S32_S16     Srvc_TypeLimiter_S32_U16     Srvc_TypeLimiter_S32_U32
  * Srvc_AverageArray_S16        Srvc_Average_S32S32_S32      Srvc_AverageSliding_S16
+ * Srvc_AverageArray_S32        Srvc_AverageSliding_S32      Srvc_AverageSlidingInit_S16
+ * Srvc_AverageSlidingInit_S32  Srvc_AverageBankInit_S16     Srvc_AverageBank_S16
+ * Srvc_Log2Exact_U16
  * Srvc_Mul_S32S32_S64          Srvc_Mul_U32U32_U64
+ * Srvc_MulAcc_S16Q15_Blk       Srvc_TypeLimiter_S32_S16_Blk
  *
  **/
 
@@ -547,7 +551,7 @@ int32_t Srvc_Average_S32S32_S32(int32_t s32_X, int32_t s32_Y)
   return s32_Res;
 }
 
-/*
+/**
  ***********************************************************************************************************************
  * Srvc_AverageArray_S32
  *
@@ -559,24 +563,22 @@ int32_t Srvc_Average_S32S32_S32(int32_t s32_X, int32_t s32_Y)
  * \retval   sum(X[u_Index]) / u8_N
  ***********************************************************************************************************************
  */
-/*int32_t Srvc_AverageArray_S32 (const int32_t *Array_pcs32, uint8_t u8_N)
+int32_t Srvc_AverageArray_S32(const int32_t * Array_pcs32, uint8_t u8_N)
 {
-    int64_t s64_Tmp;
-    uint   u_Index;
+  int64_t s64_Tmp;
+  uint8_t u_Index;
 
-    s64_Tmp = Array_pcs32[0];
+  s64_Tmp = Array_pcs32[0];
 
-    if(u8_N > 1)
-    {
-        for(u_Index = 1U; u_Index <((uint)( u8_N)) ; u_Index++)
-        {
-            s64_Tmp += (*(++Array_pcs32));
-        }
-        s64_Tmp = (int64_t)Srvc_Div_S64S32_S32(s64_Tmp, (int32_t)u8_N);
+  if (u8_N > 1) {
+    for (u_Index = 1U; u_Index < ((uint8_t)(u8_N)); u_Index++) {
+      s64_Tmp += (*(++Array_pcs32));
     }
+    s64_Tmp = (int64_t)Srvc_Div_S64S32_S32(s64_Tmp, (int32_t)u8_N);
+  }
 
-    return ((int32_t)s64_Tmp);
-}*/
+  return ((int32_t)s64_Tmp);
+}
 
 /**
  *********************************************************************************************************************
@@ -586,16 +588,12 @@ int32_t Srvc_Average_S32S32_S32(int32_t s32_X, int32_t s32_Y)
  * \brief The function calculates the new average of listed values, after a swap of one defined value.
  *
  *   Srvc_AvrgsldngS16_t x;
- *  int16_t a[32] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
- *                   0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}, Avgd_Val ;
- *   x.ps16_Beg = &a[0];
- *   x.ps16_End = &a[31];
- *   x.ps16_Act = &a[0];
- *   x.u8_N = 32;
- *   x.s32_Sum = 0;
+ *  int16_t a[32], Avgd_Val ;
+ *   Srvc_AverageSlidingInit_S16(&x, a, 32);
  *   s16_Inp = current value;
  *   Pointer increment will be done by the fumction itself
  *   Avgd_Val = Srvc_AverageSliding_S16 (&x,s16_Inp);
+ *  With a power of two window the division is a shift, rounded toward zero like the division.
  * \param       *Struct_cpst            pointer to an Array of int16_t operands X[u_Index]
  * \param       s16_Inp                 value of a defined operand to swap
  * \param       s32_SampleCount
@@ -627,7 +625,11 @@ int16_t Srvc_AverageSliding_S16(
     (Struct_cpst->ps16_Act)++;
   }
 
-  s32_Tmp = (Struct_cpst->s32_Sum / ((int32_t)(Struct_cpst->u8_N)));
+  if (Struct_cpst->u8_Shift != 0U) {
+    s32_Tmp = SRVC_SHIFT_DIV(Struct_cpst->s32_Sum, Struct_cpst->u8_Shift);
+  } else {
+    s32_Tmp = (Struct_cpst->s32_Sum / ((int32_t)(Struct_cpst->u8_N)));
+  }
 
   /** check if the samples reached the maximum sample value*/
   if (s32_SampleCount >= s32_MaxSampleCount) {
@@ -640,46 +642,194 @@ int16_t Srvc_AverageSliding_S16(
   return (int16_t)(s16_MovAvgVal);
 }
 
-/*
+/**
  ***********************************************************************************************************************
  *
  * Srvc_AverageSliding_S32
  *
- * \brief The function calculates the new average of listed values, after a swap of one defined value. *     .
+ * \brief The function calculates the new average of listed values, after a swap of one defined value.
  *
+ * Same as Srvc_AverageSliding_S16 with a 64 bit sum, initialize with Srvc_AverageSlidingInit_S32.
  *
- * \param           Struct_cpst      pointer to an Array of int16_t operands
+ * \param           Struct_cpst      pointer to an Array of int32_t operands
  * \param           Inp_s32          value of a defined operand to swap
- * \return
+ * \return  int32_t
  * \retval  sum(X[u_Index])/n,                                 average of the listed int32_t operands past swap
  ***********************************************************************************************************************
 */
-// int32_t Srvc_AverageSliding_S32 (Srvc_AvrgsldngS32_t *const Struct_cpst, int32_t Inp_s32)
-//{
-//
-//     /* calculate the new sum */
-//     Struct_cpst->s64_Sum = ((Struct_cpst->s64_Sum - ((int64_t) (*(Struct_cpst->act_ps32))))
-//                                                         + ((int64_t) (Inp_s32)));
-//
-//     /* swap the actual value (act) against the new one (Inp) */
-//     *Struct_cpst->act_ps32    = Inp_s32;
-//
-//     /* compare references */
-//     if( Struct_cpst->act_ps32 == Struct_cpst->ps32_End )
-//     {
-//         /* close the  memory loop */
-//         Struct_cpst->act_ps32 = Struct_cpst->ps32_Beg;
-//     }
-//     else
-//     {
-//         /* actualize actual reference */
-//         (Struct_cpst->ps32_Act)++;
-//     }
-//
-//     return (Srvc_Div_S64S32_S32(Struct_cpst->s64_Sum, (int32_t)Struct_cpst->u8_N));
-//
-//}
+int32_t Srvc_AverageSliding_S32(Srvc_AvrgsldngS32_t * const Struct_cpst, int32_t Inp_s32)
+{
+  /* calculate the new sum */
+  Struct_cpst->s64_Sum = ((Struct_cpst->s64_Sum - ((int64_t) (*(Struct_cpst->ps32_Act))))
+                          + ((int64_t) (Inp_s32)));
+
+  /* swap the actual value (act) against the new one (Inp) */
+  *Struct_cpst->ps32_Act = Inp_s32;
+
+  /* compare references */
+  if (Struct_cpst->ps32_Act == Struct_cpst->ps32_End) {
+    /* close the  memory loop */
+    Struct_cpst->ps32_Act = Struct_cpst->ps32_Beg;
+  } else {
+    /* actualize actual reference */
+    (Struct_cpst->ps32_Act)++;
+  }
+
+  if (Struct_cpst->u8_Shift != 0U) {
+    return (int32_t)SRVC_SHIFT_DIV(Struct_cpst->s64_Sum, Struct_cpst->u8_Shift);
+  }
+  return Srvc_Div_S64S32_S32(Struct_cpst->s64_Sum, (int32_t)Struct_cpst->u8_N);
+}
+
+/**
+ ***********************************************************************************************************************
+ *
+ * Srvc_AverageSlidingInit_S16
+ *
+ * \brief Sets up a sliding average over an empty (all zero) window.
+ *
+ * \param           Struct_cpst      sliding average to initialize
+ * \param           ps16_Buf         window memory of u8_N values
+ * \param           u8_N             window length 1..255, powers of two use a shift instead of a division
+ ***********************************************************************************************************************
+*/
+void Srvc_AverageSlidingInit_S16(Srvc_AvrgsldngS16_t * const Struct_cpst, int16_t * ps16_Buf, uint8_t u8_N)
+{
+  for (uint8_t u_Index = 0U; u_Index < u8_N; u_Index++) {
+    ps16_Buf[u_Index] = 0;
+  }
+  Struct_cpst->s32_Sum = 0;
+  Struct_cpst->u8_N = u8_N;
+  Struct_cpst->u8_Shift = Srvc_Log2Exact_U16(u8_N);
+  Struct_cpst->ps16_Beg = ps16_Buf;
+  Struct_cpst->ps16_End = &ps16_Buf[u8_N - 1U];
+  Struct_cpst->ps16_Act = ps16_Buf;
+}
+
+/**
+ ***********************************************************************************************************************
+ *
+ * Srvc_AverageSlidingInit_S32
+ *
+ * \brief Sets up a sliding average over an empty (all zero) window.
+ *
+ * \param           Struct_cpst      sliding average to initialize
+ * \param           ps32_Buf         window memory of u8_N values
+ * \param           u8_N             window length 1..255, powers of two use a shift instead of a division
+ ***********************************************************************************************************************
+*/
+void Srvc_AverageSlidingInit_S32(Srvc_AvrgsldngS32_t * const Struct_cpst, int32_t * ps32_Buf, uint8_t u8_N)
+{
+  for (uint8_t u_Index = 0U; u_Index < u8_N; u_Index++) {
+    ps32_Buf[u_Index] = 0;
+  }
+  Struct_cpst->s64_Sum = 0;
+  Struct_cpst->u8_N = u8_N;
+  Struct_cpst->u8_Shift = Srvc_Log2Exact_U16(u8_N);
+  Struct_cpst->ps32_Beg = ps32_Buf;
+  Struct_cpst->ps32_End = &ps32_Buf[u8_N - 1U];
+  Struct_cpst->ps32_Act = ps32_Buf;
+}
+
+/**
+ ***********************************************************************************************************************
+ *
+ * Srvc_AverageBankInit_S16
+ *
+ * \brief Sets up a bank of u16_Ch sliding averages sharing one window length.
+ *
+ * The history is stored structure of arrays: one row of u16_Ch values per time slot, so an update walks
+ * both the sums and the row linearly.
+ *
+ * \param           pst_Bank         bank to initialize
+ * \param           ps32_Sum         sums, u16_Ch values
+ * \param           ps16_Hist        history, u16_N * u16_Ch values
+ * \param           u16_Ch           number of channels
+ * \param           u16_N            window length 1..32768, powers of two use a shift instead of a division
+ ***********************************************************************************************************************
+*/
+void Srvc_AverageBankInit_S16(Srvc_AvrgBankS16_t * const pst_Bank, int32_t * ps32_Sum, int16_t * ps16_Hist,
+                              uint16_t u16_Ch, uint16_t u16_N)
+{
+  for (uint32_t u_Index = 0U; u_Index < ((uint32_t)u16_Ch * u16_N); u_Index++) {
+    ps16_Hist[u_Index] = 0;
+  }
+  for (uint16_t u_Index = 0U; u_Index < u16_Ch; u_Index++) {
+    ps32_Sum[u_Index] = 0;
+  }
+  pst_Bank->ps32_Sum = ps32_Sum;
+  pst_Bank->ps16_Hist = ps16_Hist;
+  pst_Bank->u16_Ch = u16_Ch;
+  pst_Bank->u16_N = u16_N;
+  pst_Bank->u16_Pos = 0;
+  pst_Bank->u8_Shift = Srvc_Log2Exact_U16(u16_N);
+}
+
+/**
+ ***********************************************************************************************************************
+ *
+ * Srvc_AverageBank_S16
+ *
+ * \brief Pushes one new value per channel and returns all averages, same results as Srvc_AverageSliding_S16
+ *        past the warm up.
+ *
+ * \param           pst_Bank         bank
+ * \param           ps16_Inp         new values, u16_Ch
+ * \param           ps16_Out         averages, u16_Ch, may alias ps16_Inp
+ ***********************************************************************************************************************
+*/
+void Srvc_AverageBank_S16(Srvc_AvrgBankS16_t * const pst_Bank, const int16_t * ps16_Inp, int16_t * ps16_Out)
+{
+  const uint16_t u16_Ch = pst_Bank->u16_Ch;
+  int32_t * const ps32_Sum = pst_Bank->ps32_Sum;
+  int16_t * const ps16_Row = &pst_Bank->ps16_Hist[(uint32_t)pst_Bank->u16_Pos * u16_Ch];
+
+  for (uint16_t c = 0U; c < u16_Ch; c++) {
+    const int16_t s16_In = ps16_Inp[c];
+    ps32_Sum[c] += (int32_t)s16_In - ps16_Row[c];
+    ps16_Row[c] = s16_In;
+  }
+
+  /* separate loops keep the division test out of the per channel work */
+  if (pst_Bank->u8_Shift != 0U) {
+    const uint8_t u8_Shift = pst_Bank->u8_Shift;
+    for (uint16_t c = 0U; c < u16_Ch; c++) {
+      ps16_Out[c] = (int16_t)SRVC_SHIFT_DIV(ps32_Sum[c], u8_Shift);
+    }
+  } else {
+    const int32_t s32_N = pst_Bank->u16_N;
+    for (uint16_t c = 0U; c < u16_Ch; c++) {
+      ps16_Out[c] = (int16_t)(ps32_Sum[c] / s32_N);
+    }
+  }
+
+  pst_Bank->u16_Pos = (uint16_t)((pst_Bank->u16_Pos + 1U < pst_Bank->u16_N) ? (pst_Bank->u16_Pos + 1U) : 0U);
+}
 
+/**
+ ***********************************************************************************************************************
+ *
+ * Srvc_Log2Exact_U16
+ *
+ * \brief Shift replacing a division by u16_N.
+ *
+ * \param           u16_N            divisor
+ * \return  uint8_t
+ * \retval  log2(u16_N) if u16_N is a power of two above 1, else 0 (divide)
+ ***********************************************************************************************************************
+*/
+uint8_t Srvc_Log2Exact_U16(uint16_t u16_N)
+{
+  uint8_t u8_Shift = 0U;
+
+  if ((u16_N < 2U) || ((u16_N & (u16_N - 1U)) != 0U)) {
+    return 0U;
+  }
+  while ((1U << u8_Shift) < u16_N) {
+    u8_Shift++;
+  }
+  return u8_Shift;
+}
 /**
  ***********************************************************************************************************************
  * Srvc_Mul_S32S32_S64
@@ -730,7 +880,7 @@ uint64_t Srvc_Mul_U32U32_U64(uint32_t u32_X, uint32_t u32_Y)
  *
  * \brief Limitation of a int32_t value to int16_t.
  *
- * The input variable is limited thus the return value is between INT16_MIN and UINT16_MAX.
+ * The input variable is limited thus the return value is between INT16_MIN and INT16_MAX.
  *
  * \param      s32_X   Value to be limited
  * \return   int16_t          The value of s32_X limited to int16_t range
@@ -739,7 +889,7 @@ uint64_t Srvc_Mul_U32U32_U64(uint32_t u32_X, uint32_t u32_Y)
 int16_t Srvc_TypeLimiter_S32_S16(int32_t s32_X)
 {
   return (int16_t) ( (s32_X <= (int32_t) INT16_MIN) ? (INT16_MIN) : (
-           (s32_X >= (int32_t) UINT16_MAX) ? (UINT16_MAX) : (s32_X)
+           (s32_X >= (int32_t) INT16_MAX) ? (INT16_MAX) : (s32_X)
   ) );
 }
 
@@ -903,3 +1053,64 @@ uint16_t Srvc_MulDiv_U32U32U32_U16(uint32_t u32_X, uint32_t u32_Y, uint32_t u32_
 {
   return Srvc_TypeLimiter_U32_U16(Srvc_MulDiv_U32U32U32_U32(u32_X, u32_Y, u32_Z));
 }
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Block functions
+ * operating on whole sample buffers, one call per buffer instead of one per sample.
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_MulAcc_S16Q15_Blk
+ *
+ * \brief Scales a block of int16_t values by a Q15 gain and adds them to a block of int32_t accumulators.
+ *
+ * ps32_Acc[i] += (ps16_X[i] * s16_Gain) >> 15. A single product is within int16_t range, the accumulator only
+ * overflows after 65536 full scale blocks, so no saturation is needed per sample.
+ *
+ * \param     ps32_Acc      Accumulators, updated in place
+ * \param     ps16_X        Input values
+ * \param     s16_Gain      Gain in Q15, 32767 is ~1.0
+ * \param     u16_N         Number of values
+ ***********************************************************************************************************************
+ */
+void Srvc_MulAcc_S16Q15_Blk(int32_t *ps32_Acc, const int16_t *ps16_X, int16_t s16_Gain, uint16_t u16_N)
+{
+  const int32_t s32_Gain = s16_Gain;
+  uint16_t i;
+
+  for (i = 0; (i + 1U) < u16_N; i += 2U)
+  {
+    ps32_Acc[i]      += ((int32_t)ps16_X[i] * s32_Gain) >> 15;
+    ps32_Acc[i + 1U] += ((int32_t)ps16_X[i + 1U] * s32_Gain) >> 15;
+  }
+  if (i < u16_N)
+  {
+    ps32_Acc[i] += ((int32_t)ps16_X[i] * s32_Gain) >> 15;
+  }
+}
+
+/**
+ **********************************************************************************************************************
+ * Srvc_TypeLimiter_S32_S16_Blk
+ *
+ * \brief Limitation of a block of int32_t values to int16_t, block variant of Srvc_TypeLimiter_S32_S16.
+ *
+ * \param     ps16_Dst      Limited values, may not alias ps32_Src
+ * \param     ps32_Src      Values to be limited
+ * \param     u16_N         Number of values
+ **********************************************************************************************************************
+ */
+void Srvc_TypeLimiter_S32_S16_Blk(int16_t *ps16_Dst, const int32_t *ps32_Src, uint16_t u16_N)
+{
+  for (uint16_t i = 0; i < u16_N; i++)
+  {
+    const int32_t s32_X = ps32_Src[i];
+    ps16_Dst[i] = (int16_t) ( (s32_X <= (int32_t) INT16_MIN) ? (INT16_MIN) : (
+                  (s32_X >= (int32_t) INT16_MAX) ? (INT16_MAX) : (s32_X) ) );
+  }
+}
@@ -0,0 +1,406 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 BSH Hausgeraete GmbH,
+ *  Carl-Wery-Str. 34, 81739 Munich, Germany, www.bsh-group.de
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *******************************************************************************
+ *  PROJECT          TWO_IN1_CPM
+ *  COMP_ABBREV      time series library
+ ******************************************************************************/
+
+/******************************************************************************/
+/* DOCUMENTATION                                                              */
+/******************************************************************************/
+/** \file          timeseries_library.c
+ *
+ *  \brief         Delta-of-delta block codec for time series
+ *
+ *  \details       Block layout: u16 record count (little endian), u8 values
+ *                 per record, u8 version, then a bit stream written MSB
+ *                 first. Every record is the time followed by its values:
+ *
+ *                 time, zigzag of (delta - previous delta)
+ *                   0                      same interval
+ *                   10   + 7 bits
+ *                   110  + 12 bits
+ *                   1110 + 20 bits
+ *                   1111 + 32 bits
+ *                 value, zigzag of (value - previous value)
+ *                   0                      unchanged
+ *                   1    + groups of 4 bits, low group first, each
+ *                          preceded by a bit telling if another follows
+ *
+ *                 The first record is coded against time 0 and values 0.
+ *
+ */
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <string.h>
+#include "timeseries_library.h"
+
+/*
+ ***********************************************************************************************************************
+ *
+ * List of Functions
+ *
+ * Srvc_TsEncInit               Srvc_TsEncPut                Srvc_TsEncFinish
+ * Srvc_TsDecInit               Srvc_TsDecGet
+ *
+ **/
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/* Differences are taken modulo 2^32 and read as two's complement only here,
+ * so wrapping times and values never overflow a signed type */
+#define SRVC_TS_ZIGZAG(U32)       (((uint32_t)(U32) << 1) ^ (0U - ((uint32_t)(U32) >> 31)))
+#define SRVC_TS_UNZIGZAG(U32)     (((U32) >> 1) ^ (0U - ((U32) & 1U)))
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS                                              */
+/******************************************************************************/
+
+static uint32_t Srvc_TsTimeBits(uint32_t u32_Zz);
+static uint32_t Srvc_TsValBits(uint32_t u32_Zz);
+static void Srvc_TsWrite(Srvc_TsEnc_t * const pst_Enc, uint32_t u32_Bits, uint32_t u32_N);
+static uint32_t Srvc_TsRead(Srvc_TsDec_t * const pst_Dec, uint32_t u32_N);
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Encoder
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsEncInit
+ *
+ * \brief Starts an empty block.
+ *
+ * \param     pst_Enc       encoder
+ * \param     pu8_Buf       block memory, cleared here
+ * \param     u16_Size      block size, more than SRVC_TS_HDR_SIZE
+ * \param     u8_Vals       values per record, 1..SRVC_TS_MAX_VALS
+ ***********************************************************************************************************************
+ */
+void Srvc_TsEncInit(Srvc_TsEnc_t * const pst_Enc, uint8_t * pu8_Buf, uint16_t u16_Size, uint8_t u8_Vals)
+{
+  (void)memset(pst_Enc, 0, sizeof(*pst_Enc));
+  (void)memset(pu8_Buf, 0, u16_Size);
+  pst_Enc->pu8_Buf = pu8_Buf;
+  pst_Enc->u16_Size = u16_Size;
+  pst_Enc->u8_Vals = u8_Vals;
+  pst_Enc->u32_Bit = SRVC_TS_HDR_SIZE * 8U;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsEncPut
+ *
+ * \brief Appends a record if it fits, a record is never split over blocks.
+ *
+ * \param     pst_Enc       encoder
+ * \param     u32_Time      time, normally not decreasing
+ * \param     pu32_Val      u8_Vals values
+ * \return    bool
+ * \retval    false if the block is full, start a new one for this record
+ ***********************************************************************************************************************
+ */
+bool Srvc_TsEncPut(Srvc_TsEnc_t * const pst_Enc, uint32_t u32_Time, const uint32_t * pu32_Val)
+{
+  const uint32_t u32_Delta = u32_Time - pst_Enc->u32_PrevT;
+  const uint32_t u32_TimeZz = SRVC_TS_ZIGZAG(u32_Delta - pst_Enc->u32_PrevDelta);
+  uint32_t au32_Zz[SRVC_TS_MAX_VALS];
+  uint32_t u32_Need = Srvc_TsTimeBits(u32_TimeZz);
+  uint8_t u8_I;
+
+  if (pst_Enc->u16_Count == UINT16_MAX) {
+    return false;
+  }
+  for (u8_I = 0; u8_I < pst_Enc->u8_Vals; u8_I++) {
+    au32_Zz[u8_I] = SRVC_TS_ZIGZAG(pu32_Val[u8_I] - pst_Enc->au32_PrevV[u8_I]);
+    u32_Need += Srvc_TsValBits(au32_Zz[u8_I]);
+  }
+  if ((pst_Enc->u32_Bit + u32_Need) > ((uint32_t)pst_Enc->u16_Size * 8U)) {
+    return false;
+  }
+
+  if (u32_TimeZz == 0U) {
+    Srvc_TsWrite(pst_Enc, 0x0U, 1U);
+  } else if (u32_TimeZz < (1UL << 7)) {
+    Srvc_TsWrite(pst_Enc, 0x2U, 2U);
+    Srvc_TsWrite(pst_Enc, u32_TimeZz, 7U);
+  } else if (u32_TimeZz < (1UL << 12)) {
+    Srvc_TsWrite(pst_Enc, 0x6U, 3U);
+    Srvc_TsWrite(pst_Enc, u32_TimeZz, 12U);
+  } else if (u32_TimeZz < (1UL << 20)) {
+    Srvc_TsWrite(pst_Enc, 0xEU, 4U);
+    Srvc_TsWrite(pst_Enc, u32_TimeZz, 20U);
+  } else {
+    Srvc_TsWrite(pst_Enc, 0xFU, 4U);
+    Srvc_TsWrite(pst_Enc, u32_TimeZz, 32U);
+  }
+
+  for (u8_I = 0; u8_I < pst_Enc->u8_Vals; u8_I++) {
+    uint32_t u32_Zz = au32_Zz[u8_I];
+    if (u32_Zz == 0U) {
+      Srvc_TsWrite(pst_Enc, 0x0U, 1U);
+    } else {
+      Srvc_TsWrite(pst_Enc, 0x1U, 1U);
+      while (u32_Zz > 0xFU) {
+        Srvc_TsWrite(pst_Enc, 0x10U | (u32_Zz & 0xFU), 5U);
+        u32_Zz >>= 4;
+      }
+      Srvc_TsWrite(pst_Enc, u32_Zz, 5U);
+    }
+    pst_Enc->au32_PrevV[u8_I] = pu32_Val[u8_I];
+  }
+
+  pst_Enc->u32_PrevT = u32_Time;
+  pst_Enc->u32_PrevDelta = u32_Delta;
+  pst_Enc->u16_Count++;
+  return true;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsEncFinish
+ *
+ * \brief Writes the block header.
+ *
+ * \param     pst_Enc       encoder
+ * \return    uint16_t
+ * \retval    bytes used in the block
+ ***********************************************************************************************************************
+ */
+uint16_t Srvc_TsEncFinish(Srvc_TsEnc_t * const pst_Enc)
+{
+  pst_Enc->pu8_Buf[0] = (uint8_t)pst_Enc->u16_Count;
+  pst_Enc->pu8_Buf[1] = (uint8_t)(pst_Enc->u16_Count >> 8);
+  pst_Enc->pu8_Buf[2] = pst_Enc->u8_Vals;
+  pst_Enc->pu8_Buf[3] = SRVC_TS_VERSION;
+  return (uint16_t)((pst_Enc->u32_Bit + 7U) / 8U);
+}
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Decoder
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsDecInit
+ *
+ * \brief Checks a block header and starts decoding it.
+ *
+ * \param     pst_Dec       decoder
+ * \param     pu8_Buf       block
+ * \param     u16_Len       bytes in the block
+ * \return    bool
+ * \retval    false if the header is not valid
+ ***********************************************************************************************************************
+ */
+bool Srvc_TsDecInit(Srvc_TsDec_t * const pst_Dec, const uint8_t * pu8_Buf, uint16_t u16_Len)
+{
+  (void)memset(pst_Dec, 0, sizeof(*pst_Dec));
+  if ((u16_Len < SRVC_TS_HDR_SIZE) || (pu8_Buf[3] != SRVC_TS_VERSION) ||
+      (pu8_Buf[2] == 0U) || (pu8_Buf[2] > SRVC_TS_MAX_VALS)) {
+    return false;
+  }
+  pst_Dec->pu8_Buf = pu8_Buf;
+  pst_Dec->u32_Bit = SRVC_TS_HDR_SIZE * 8U;
+  pst_Dec->u32_End = (uint32_t)u16_Len * 8U;
+  pst_Dec->u16_Count = (uint16_t)(pu8_Buf[0] | ((uint16_t)pu8_Buf[1] << 8));
+  pst_Dec->u8_Vals = pu8_Buf[2];
+  return true;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsDecGet
+ *
+ * \brief Decodes the next record of the block.
+ *
+ * \param     pst_Dec       decoder
+ * \param     pu32_Time     time
+ * \param     pu32_Val      u8_Vals values
+ * \return    bool
+ * \retval    false at the end of the block or if the block is truncated
+ ***********************************************************************************************************************
+ */
+bool Srvc_TsDecGet(Srvc_TsDec_t * const pst_Dec, uint32_t * pu32_Time, uint32_t * pu32_Val)
+{
+  uint32_t u32_Zz = 0;
+  uint32_t u32_Len = 0;
+  uint8_t u8_I;
+
+  if (pst_Dec->u16_Read >= pst_Dec->u16_Count) {
+    return false;
+  }
+
+  /* prefix: number of leading 1 bits, at most 4 */
+  while ((u32_Len < 4U) && (Srvc_TsRead(pst_Dec, 1U) != 0U)) {
+    u32_Len++;
+  }
+  switch (u32_Len) {
+    case 0U:  u32_Zz = 0U;                            break;
+    case 1U:  u32_Zz = Srvc_TsRead(pst_Dec, 7U);      break;
+    case 2U:  u32_Zz = Srvc_TsRead(pst_Dec, 12U);     break;
+    case 3U:  u32_Zz = Srvc_TsRead(pst_Dec, 20U);     break;
+    default:  u32_Zz = Srvc_TsRead(pst_Dec, 32U);     break;
+  }
+  pst_Dec->u32_PrevDelta += SRVC_TS_UNZIGZAG(u32_Zz);
+  pst_Dec->u32_PrevT += pst_Dec->u32_PrevDelta;
+
+  for (u8_I = 0; u8_I < pst_Dec->u8_Vals; u8_I++) {
+    if (Srvc_TsRead(pst_Dec, 1U) != 0U) {
+      uint32_t u32_Group;
+      uint32_t u32_Shift = 0;
+      u32_Zz = 0;
+      do {
+        u32_Group = Srvc_TsRead(pst_Dec, 5U);
+        u32_Zz |= (u32_Group & 0xFU) << u32_Shift;
+        u32_Shift += 4U;
+      } while (((u32_Group & 0x10U) != 0U) && (u32_Shift < 32U));
+      pst_Dec->au32_PrevV[u8_I] += SRVC_TS_UNZIGZAG(u32_Zz);
+    }
+    pu32_Val[u8_I] = pst_Dec->au32_PrevV[u8_I];
+  }
+  *pu32_Time = pst_Dec->u32_PrevT;
+
+  if (pst_Dec->u32_Bit > pst_Dec->u32_End) {
+    pst_Dec->u16_Read = pst_Dec->u16_Count;
+    return false;
+  }
+  pst_Dec->u16_Read++;
+  return true;
+}
+
+/*
+ ***********************************************************************************************************************
+ *
+ * Bit stream
+ *
+ ***********************************************************************************************************************
+ */
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsTimeBits
+ *
+ * \brief Bits used by a coded time.
+ *
+ * \param     u32_Zz        zigzag delta-of-delta
+ * \return    uint32_t
+ * \retval    bits
+ ***********************************************************************************************************************
+ */
+static uint32_t Srvc_TsTimeBits(uint32_t u32_Zz)
+{
+  uint32_t u32_Bits;
+
+  if (u32_Zz == 0U) {
+    u32_Bits = 1U;
+  } else if (u32_Zz < (1UL << 7)) {
+    u32_Bits = 2U + 7U;
+  } else if (u32_Zz < (1UL << 12)) {
+    u32_Bits = 3U + 12U;
+  } else if (u32_Zz < (1UL << 20)) {
+    u32_Bits = 4U + 20U;
+  } else {
+    u32_Bits = 4U + 32U;
+  }
+  return u32_Bits;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsValBits
+ *
+ * \brief Bits used by a coded value.
+ *
+ * \param     u32_Zz        zigzag delta
+ * \return    uint32_t
+ * \retval    bits
+ ***********************************************************************************************************************
+ */
+static uint32_t Srvc_TsValBits(uint32_t u32_Zz)
+{
+  uint32_t u32_Bits = 1U;
+
+  if (u32_Zz != 0U) {
+    do {
+      u32_Bits += 5U;
+      u32_Zz >>= 4;
+    } while (u32_Zz != 0U);
+  }
+  return u32_Bits;
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsWrite
+ *
+ * \brief Appends the low u32_N bits, MSB first, to the cleared block.
+ *
+ * \param     pst_Enc       encoder
+ * \param     u32_Bits      bits
+ * \param     u32_N         number of bits, 1..32
+ ***********************************************************************************************************************
+ */
+static void Srvc_TsWrite(Srvc_TsEnc_t * const pst_Enc, uint32_t u32_Bits, uint32_t u32_N)
+{
+  while (u32_N > 0U) {
+    const uint32_t u32_Free = 8U - (pst_Enc->u32_Bit & 7U);
+    const uint32_t u32_Take = (u32_N < u32_Free) ? u32_N : u32_Free;
+
+    u32_N -= u32_Take;
+    pst_Enc->pu8_Buf[pst_Enc->u32_Bit >> 3] |=
+      (uint8_t)(((u32_Bits >> u32_N) & ((1UL << u32_Take) - 1U)) << (u32_Free - u32_Take));
+    pst_Enc->u32_Bit += u32_Take;
+  }
+}
+
+/**
+ ***********************************************************************************************************************
+ * Srvc_TsRead
+ *
+ * \brief Reads u32_N bits, MSB first. Past the end of the block 0 bits are
+ *        returned and the position still moves, the caller checks it.
+ *
+ * \param     pst_Dec       decoder
+ * \param     u32_N         number of bits, 1..32
+ * \return    uint32_t
+ * \retval    bits
+ ***********************************************************************************************************************
+ */
+static uint32_t Srvc_TsRead(Srvc_TsDec_t * const pst_Dec, uint32_t u32_N)
+{
+  uint32_t u32_Val = 0;
+
+  while (u32_N > 0U) {
+    const uint32_t u32_Avail = 8U - (pst_Dec->u32_Bit & 7U);
+    const uint32_t u32_Take = (u32_N < u32_Avail) ? u32_N : u32_Avail;
+    uint32_t u32_Byte = 0;
+
+    if (pst_Dec->u32_Bit < pst_Dec->u32_End) {
+      u32_Byte = pst_Dec->pu8_Buf[pst_Dec->u32_Bit >> 3];
+    }
+    u32_N -= u32_Take;
+    u32_Val <<= u32_Take;
+    u32_Val |= (u32_Byte >> (u32_Avail - u32_Take)) & ((1UL << u32_Take) - 1U);
+    pst_Dec->u32_Bit += u32_Take;
+  }
+  return u32_Val;
+}
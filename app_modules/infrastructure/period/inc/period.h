@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : period
+ *  Description        : period monitor of periodic tasks and timers. Measures
+ *                       the time between activations and the execution time
+ *                       into log linear histograms and counts the deadline
+ *                       misses. The measured time step is handed back for
+ *                       the debounce and timers of the caller.
+ ******************************************************************************/
+
+#ifndef PERIOD_H
+#define PERIOD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+
+/*
+ * Histogram of us values with PERIOD_SUB_BITS significant bits, like HDR
+ * histograms: 0..15 us exact, above that 8 buckets per power of 2, so a
+ * bucket is at most 12.5 % wide. Values from 2^24 us (16.7 s) on go to the
+ * last bucket.
+ */
+#define PERIOD_SUB_BITS           3U
+#define PERIOD_SUB_COUNT          (1UL << PERIOD_SUB_BITS)
+#define PERIOD_MAX_BIT            23U       // highest bit of a value with its own bucket
+#define PERIOD_BUCKETS            ((2U * PERIOD_SUB_COUNT) + ((PERIOD_MAX_BIT - PERIOD_SUB_BITS) * PERIOD_SUB_COUNT))
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef struct Period_Hist_t
+{
+  uint32_t u32_Count;
+  uint32_t u32_Min;              // us
+  uint32_t u32_Max;
+  uint64_t u64_Total;
+  uint32_t au32_Hist[PERIOD_BUCKETS];
+}Period_Hist_t;
+
+/*
+ * @brief one periodic activity, static in its module or in the instance it
+ *        belongs to. Only the task or timer callback it monitors calls
+ *        Period_Begin and Period_End.
+ */
+typedef struct Period_Mon_t
+{
+  const char *pc_Name;
+  uint32_t u32_PeriodUs;         // nominal period, also the execution deadline
+  uint32_t u32_LateUs;           // a longer interval is a deadline miss
+  bool b_Running;                // the last activation started the current interval
+  int64_t s64_LastUs;            // start of the last activation
+  uint32_t u32_Misses;           // intervals longer than u32_LateUs
+  uint32_t u32_Overruns;         // executions longer than u32_PeriodUs
+  Period_Hist_t st_Interval;
+  Period_Hist_t st_Exec;
+  struct Period_Mon_t *pst_Next;
+}Period_Mon_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Period_Register(Period_Mon_t *pst_Mon, const char *pc_Name, uint32_t u32_PeriodUs, uint32_t u32_LateUs);
+uint32_t Period_Begin(Period_Mon_t *pst_Mon);
+void Period_End(Period_Mon_t *pst_Mon);
+void Period_Pause(Period_Mon_t *pst_Mon);
+void Period_Report(void);
+void Period_Dump(void);
+void Period_Reset(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PERIOD_H
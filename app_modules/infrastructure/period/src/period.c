@@ -0,0 +1,355 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : period
+ *  Description        : period monitor, interval and execution time
+ *                       histograms and deadline misses per periodic activity,
+ *                       console report and dump
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "period.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define PERIOD_NAME_WORDS         4U        // name bytes in the dump / 4
+#define PERIOD_DUMP_MAGIC         0x4D505246UL  // "FRPM"
+#define PERIOD_DUMP_VERSION       1U
+#define PERIOD_LINE_WORDS         8U
+#define PERIOD_HIST_WORDS         (5U + PERIOD_BUCKETS)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Period_Record(Period_Hist_t *pst_Hist, uint32_t u32_Us);
+static uint32_t Period_Bucket(uint32_t u32_Us);
+static uint32_t Period_Percentile(const Period_Hist_t *pst_Hist, uint32_t u32_PerMille);
+static bool Period_Copy(const Period_Mon_t *pst_Mon, Period_Mon_t *pst_Copy);
+static uint32_t Period_HistWords(const Period_Hist_t *pst_Hist, uint32_t *pu32_Words);
+static void Period_DumpWords(const uint32_t *pu32_Words, uint32_t u32_N);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static portMUX_TYPE period_lock = portMUX_INITIALIZER_UNLOCKED;
+static Period_Mon_t *monitors = NULL;     // registered at init, never removed
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Set up a monitor and add it to the report
+ * @param pst_Mon : monitor, static
+ * @param pc_Name : name in the report, at most 16 characters in the dump
+ * @param u32_PeriodUs : nominal period
+ * @param u32_LateUs : an interval longer than this is a deadline miss
+ */
+void Period_Register(Period_Mon_t *pst_Mon, const char *pc_Name, uint32_t u32_PeriodUs, uint32_t u32_LateUs)
+{
+  (void)memset(pst_Mon, 0, sizeof(*pst_Mon));
+  pst_Mon->pc_Name = pc_Name;
+  pst_Mon->u32_PeriodUs = u32_PeriodUs;
+  pst_Mon->u32_LateUs = u32_LateUs;
+
+  taskENTER_CRITICAL(&period_lock);
+  pst_Mon->pst_Next = monitors;
+  monitors = pst_Mon;
+  taskEXIT_CRITICAL(&period_lock);
+}
+
+/**
+ * @brief Start of an activation, records the interval since the last one
+ * @param pst_Mon : monitor
+ * @return ms since the last activation, the difference of the ms clock
+ *         like the input trace; the nominal period after a pause
+ */
+uint32_t Period_Begin(Period_Mon_t *pst_Mon)
+{
+  const int64_t s64_Now = esp_timer_get_time();
+  uint32_t u32_DtMs = pst_Mon->u32_PeriodUs / 1000U;
+
+  taskENTER_CRITICAL(&period_lock);
+  if (pst_Mon->b_Running != false) {
+    const uint32_t u32_Interval = (uint32_t)(s64_Now - pst_Mon->s64_LastUs);
+
+    Period_Record(&pst_Mon->st_Interval, u32_Interval);
+    if (u32_Interval > pst_Mon->u32_LateUs) {
+      pst_Mon->u32_Misses++;
+    }
+    u32_DtMs = (uint32_t)((s64_Now / 1000) - (pst_Mon->s64_LastUs / 1000));
+  }
+  pst_Mon->s64_LastUs = s64_Now;
+  pst_Mon->b_Running = true;
+  taskEXIT_CRITICAL(&period_lock);
+  return u32_DtMs;
+}
+
+/**
+ * @brief End of an activation, records the execution time
+ * @param pst_Mon : monitor
+ */
+void Period_End(Period_Mon_t *pst_Mon)
+{
+  const int64_t s64_Now = esp_timer_get_time();
+
+  taskENTER_CRITICAL(&period_lock);
+  const uint32_t u32_Exec = (uint32_t)(s64_Now - pst_Mon->s64_LastUs);
+  Period_Record(&pst_Mon->st_Exec, u32_Exec);
+  if (u32_Exec > pst_Mon->u32_PeriodUs) {
+    pst_Mon->u32_Overruns++;
+  }
+  taskEXIT_CRITICAL(&period_lock);
+}
+
+/**
+ * @brief The activity stops on purpose, e.g. its timer is stopped for
+ *        light sleep. The next activation starts a new interval.
+ * @param pst_Mon : monitor
+ */
+void Period_Pause(Period_Mon_t *pst_Mon)
+{
+  taskENTER_CRITICAL(&period_lock);
+  pst_Mon->b_Running = false;
+  taskEXIT_CRITICAL(&period_lock);
+}
+
+/**
+ * @brief Print interval and execution time per monitor in us, percentiles
+ *        are bucket upper bounds
+ *
+ */
+void Period_Report(void)
+{
+  Period_Mon_t *pst_Copy = malloc(sizeof(Period_Mon_t));
+
+  if (pst_Copy == NULL) {
+    printf("period: no memory for the report\n");
+    return;
+  }
+  printf("%-12s %9s %8s %8s %8s %8s %8s %8s %6s %8s %8s %8s %6s\n", "monitor", "count", "period", "min", "p50<=",
+         "p99<=", "p999<=", "max", "miss", "exec avg", "p99<=", "max", "over");
+  for (const Period_Mon_t *pst_Mon = monitors; pst_Mon != NULL; pst_Mon = pst_Mon->pst_Next) {
+    if (Period_Copy(pst_Mon, pst_Copy) == false) {
+      continue;
+    }
+    const Period_Hist_t *pst_In = &pst_Copy->st_Interval;
+    const Period_Hist_t *pst_Ex = &pst_Copy->st_Exec;
+    printf("%-12.12s %9lu %8lu %8lu %8lu %8lu %8lu %8lu %6lu %8lu %8lu %8lu %6lu\n", pst_Copy->pc_Name,
+           (unsigned long)pst_In->u32_Count, (unsigned long)pst_Copy->u32_PeriodUs, (unsigned long)pst_In->u32_Min,
+           (unsigned long)Period_Percentile(pst_In, 500U), (unsigned long)Period_Percentile(pst_In, 990U),
+           (unsigned long)Period_Percentile(pst_In, 999U), (unsigned long)pst_In->u32_Max,
+           (unsigned long)pst_Copy->u32_Misses,
+           (unsigned long)((pst_Ex->u32_Count != 0U) ? (pst_Ex->u64_Total / pst_Ex->u32_Count) : 0U),
+           (unsigned long)Period_Percentile(pst_Ex, 990U), (unsigned long)pst_Ex->u32_Max,
+           (unsigned long)pst_Copy->u32_Overruns);
+  }
+  free(pst_Copy);
+}
+
+/**
+ * @brief Print all monitors as "~M:<hex words>" lines for
+ *        tools/period_extract.py: magic, version, buckets, monitors, then
+ *        per monitor the name in PERIOD_NAME_WORDS, period, late limit,
+ *        misses, overruns and the interval and execution histograms, each
+ *        count, min, max, total low and high word and the buckets
+ */
+void Period_Dump(void)
+{
+  Period_Mon_t *pst_Copy = malloc(sizeof(Period_Mon_t));
+  uint32_t *pu32_Words = malloc((PERIOD_NAME_WORDS + 4U + (2U * PERIOD_HIST_WORDS)) * sizeof(uint32_t));
+  uint32_t u32_Monitors = 0;
+
+  if ((pst_Copy == NULL) || (pu32_Words == NULL)) {
+    printf("period: no memory for the dump\n");
+    free(pst_Copy);
+    free(pu32_Words);
+    return;
+  }
+
+  for (const Period_Mon_t *pst_Mon = monitors; pst_Mon != NULL; pst_Mon = pst_Mon->pst_Next) {
+    u32_Monitors++;
+  }
+  pu32_Words[0] = PERIOD_DUMP_MAGIC;
+  pu32_Words[1] = PERIOD_DUMP_VERSION;
+  pu32_Words[2] = PERIOD_BUCKETS;
+  pu32_Words[3] = u32_Monitors;
+  Period_DumpWords(pu32_Words, 4U);
+
+  for (const Period_Mon_t *pst_Mon = monitors; pst_Mon != NULL; pst_Mon = pst_Mon->pst_Next) {
+    uint32_t n = PERIOD_NAME_WORDS;
+
+    (void)Period_Copy(pst_Mon, pst_Copy);
+    (void)memset(pu32_Words, 0, PERIOD_NAME_WORDS * sizeof(uint32_t));
+    (void)strncpy((char *)pu32_Words, pst_Copy->pc_Name, (PERIOD_NAME_WORDS * sizeof(uint32_t)) - 1U);
+    pu32_Words[n++] = pst_Copy->u32_PeriodUs;
+    pu32_Words[n++] = pst_Copy->u32_LateUs;
+    pu32_Words[n++] = pst_Copy->u32_Misses;
+    pu32_Words[n++] = pst_Copy->u32_Overruns;
+    n += Period_HistWords(&pst_Copy->st_Interval, &pu32_Words[n]);
+    n += Period_HistWords(&pst_Copy->st_Exec, &pu32_Words[n]);
+    Period_DumpWords(pu32_Words, n);
+  }
+  free(pst_Copy);
+  free(pu32_Words);
+}
+
+/**
+ * @brief Clear the statistics of all monitors, the running intervals go on
+ *
+ */
+void Period_Reset(void)
+{
+  for (Period_Mon_t *pst_Mon = monitors; pst_Mon != NULL; pst_Mon = pst_Mon->pst_Next) {
+    taskENTER_CRITICAL(&period_lock);
+    pst_Mon->u32_Misses = 0;
+    pst_Mon->u32_Overruns = 0;
+    (void)memset(&pst_Mon->st_Interval, 0, sizeof(pst_Mon->st_Interval));
+    (void)memset(&pst_Mon->st_Exec, 0, sizeof(pst_Mon->st_Exec));
+    taskEXIT_CRITICAL(&period_lock);
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Add a value to a histogram, period_lock held
+ * @param pst_Hist : histogram
+ * @param u32_Us : value
+ */
+static void Period_Record(Period_Hist_t *pst_Hist, uint32_t u32_Us)
+{
+  if ((pst_Hist->u32_Count == 0U) || (u32_Us < pst_Hist->u32_Min)) {
+    pst_Hist->u32_Min = u32_Us;
+  }
+  if (u32_Us > pst_Hist->u32_Max) {
+    pst_Hist->u32_Max = u32_Us;
+  }
+  pst_Hist->u32_Count++;
+  pst_Hist->u64_Total += u32_Us;
+  pst_Hist->au32_Hist[Period_Bucket(u32_Us)]++;
+}
+
+/**
+ * @brief Bucket of a value: the value below 2 * PERIOD_SUB_COUNT, else its
+ *        highest bit and the PERIOD_SUB_BITS bits below it
+ * @param u32_Us : value
+ * @return 0..PERIOD_BUCKETS-1
+ */
+static uint32_t Period_Bucket(uint32_t u32_Us)
+{
+  uint32_t u32_Bit;
+
+  if (u32_Us < (2U * PERIOD_SUB_COUNT)) {
+    return u32_Us;
+  }
+  u32_Bit = 31U - (uint32_t)__builtin_clz(u32_Us);
+  if (u32_Bit > PERIOD_MAX_BIT) {
+    return PERIOD_BUCKETS - 1U;
+  }
+  return ((u32_Bit - PERIOD_SUB_BITS) * PERIOD_SUB_COUNT) + ((u32_Us >> (u32_Bit - PERIOD_SUB_BITS)) & (PERIOD_SUB_COUNT - 1U)) +
+         PERIOD_SUB_COUNT;
+}
+
+/**
+ * @brief Upper bound of a percentile from the histogram
+ * @param pst_Hist : histogram
+ * @param u32_PerMille : 1..1000
+ * @return us, at most the maximum
+ */
+static uint32_t Period_Percentile(const Period_Hist_t *pst_Hist, uint32_t u32_PerMille)
+{
+  const uint64_t u64_Need = (((uint64_t)pst_Hist->u32_Count * u32_PerMille) + 999U) / 1000U;
+  uint64_t u64_Seen = 0;
+
+  for (uint32_t b = 0; b < (PERIOD_BUCKETS - 1U); b++) {
+    u64_Seen += pst_Hist->au32_Hist[b];
+    if (u64_Seen >= u64_Need) {
+      uint32_t u32_Upper = b;
+
+      if (b >= (2U * PERIOD_SUB_COUNT)) {
+        const uint32_t u32_Shift = ((b - PERIOD_SUB_COUNT) / PERIOD_SUB_COUNT);
+        u32_Upper = (((PERIOD_SUB_COUNT + ((b - PERIOD_SUB_COUNT) % PERIOD_SUB_COUNT)) + 1U) << u32_Shift) - 1U;
+      }
+      return (u32_Upper < pst_Hist->u32_Max) ? u32_Upper : pst_Hist->u32_Max;
+    }
+  }
+  return pst_Hist->u32_Max;
+}
+
+/**
+ * @brief Consistent copy of a monitor
+ * @param pst_Mon : monitor
+ * @param pst_Copy : result
+ * @return false if it never ran
+ */
+static bool Period_Copy(const Period_Mon_t *pst_Mon, Period_Mon_t *pst_Copy)
+{
+  taskENTER_CRITICAL(&period_lock);
+  *pst_Copy = *pst_Mon;
+  taskEXIT_CRITICAL(&period_lock);
+  return pst_Copy->st_Exec.u32_Count != 0U;
+}
+
+/**
+ * @brief Histogram as dump words
+ * @param pst_Hist : histogram
+ * @param pu32_Words : PERIOD_HIST_WORDS words
+ * @return PERIOD_HIST_WORDS
+ */
+static uint32_t Period_HistWords(const Period_Hist_t *pst_Hist, uint32_t *pu32_Words)
+{
+  pu32_Words[0] = pst_Hist->u32_Count;
+  pu32_Words[1] = pst_Hist->u32_Min;
+  pu32_Words[2] = pst_Hist->u32_Max;
+  pu32_Words[3] = (uint32_t)pst_Hist->u64_Total;
+  pu32_Words[4] = (uint32_t)(pst_Hist->u64_Total >> 32);
+  (void)memcpy(&pu32_Words[5], pst_Hist->au32_Hist, sizeof(pst_Hist->au32_Hist));
+  return PERIOD_HIST_WORDS;
+}
+
+/**
+ * @brief Print words as "~M:" lines of PERIOD_LINE_WORDS
+ * @param pu32_Words : words
+ * @param u32_N : count
+ */
+static void Period_DumpWords(const uint32_t *pu32_Words, uint32_t u32_N)
+{
+  for (uint32_t i = 0; i < u32_N; i += PERIOD_LINE_WORDS) {
+    printf("~M:");
+    for (uint32_t j = i; (j < u32_N) && (j < (i + PERIOD_LINE_WORDS)); j++) {
+      printf("%08lx", (unsigned long)pu32_Words[j]);
+    }
+    printf("\n");
+  }
+}
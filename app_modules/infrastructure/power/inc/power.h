@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : power
+ *  Description        : light sleep power manager
+ ******************************************************************************/
+
+#ifndef POWER_H
+#define POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define POWER_MAX_FREQ_MHZ        160       // CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define POWER_MIN_FREQ_MHZ        40        // XTAL, used while nothing holds the CPU awake
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief modules that can keep the device out of light sleep
+ */
+typedef enum Power_Client_t
+{
+  POWER_CLIENT_SYSSM = 0,    // IR switch sampled, bottle present or reminder running
+  POWER_CLIENT_AUDIO,        // audio output enabled
+  POWER_CLIENT_MAX
+}Power_Client_t;
+
+/*
+ * @brief power states time is accounted for
+ */
+typedef enum Power_State_t
+{
+  POWER_STATE_ACTIVE = 0,    // a client holds the device awake
+  POWER_STATE_IDLE,          // nothing held, awake for timers or tasks
+  POWER_STATE_SLEEP,         // light sleep
+  POWER_STATE_MAX
+}Power_State_t;
+
+/*
+ * @brief called from the timer task when the IR switch woke the device,
+ *        with the argument given to Power_ArmIrWake
+ */
+typedef void (*Power_WakeCb_t)(void *pv_Arg);
+
+/*
+ * @brief counters for the power command
+ */
+typedef struct Power_Stats_t
+{
+  uint64_t au64_TimeUs[POWER_STATE_MAX];
+  uint32_t u32_Sleeps;       // light sleep periods
+  uint32_t u32_IrWakes;      // IR switch wakeups
+  uint32_t u32_LatCount;     // wakeups handled, see Power_Handled
+  uint32_t u32_LatMinUs;     // wake to handled latency
+  uint32_t u32_LatMaxUs;
+  uint32_t u32_LatAvgUs;
+} Power_Stats_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Power_Init(void);
+void Power_Hold(Power_Client_t e_Client);
+void Power_Release(Power_Client_t e_Client);
+void Power_ArmIrWake(Power_WakeCb_t pf_Wake, void *pv_Arg);
+void Power_Handled(void);
+void Power_DeepSleep(uint32_t u32_WakeMs);
+void Power_GetStats(Power_Stats_t *pst_Stats);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POWER_H
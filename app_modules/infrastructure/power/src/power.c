@@ -0,0 +1,327 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : power
+ *  Description        : light sleep power manager. The CPU enters light sleep
+ *                       from the idle task whenever no client holds it
+ *                       awake, the next FreeRTOS timer or the IR switch
+ *                       wakes it up again.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#define DLOG_FILE_ID              2
+
+#include <stdio.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "driver/gpio.h"
+#include "pin_config.h"
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+#include "esp_pm.h"
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include "driver/rtc_io.h"
+#endif
+#include "dlog.h"
+#include "power.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define POWER_IR_WAKE_LEVEL       GPIO_INTR_LOW_LEVEL   // bottle present, see GetIRswitchStatus
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Power_Account(Power_State_t e_State, int64_t s64_Now);
+static void Power_IrIsr(void *pv_Arg);
+static void Power_IrWoken(void *pv_Arg, uint32_t u32_Arg);
+#if !defined(CONFIG_IDF_TARGET_LINUX) && defined(CONFIG_PM_LIGHT_SLEEP_CALLBACKS)
+static esp_err_t Power_SleepExit(int64_t s64_SleepUs, void *pv_Arg);
+#endif
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "power";
+
+static portMUX_TYPE power_lock = portMUX_INITIALIZER_UNLOCKED;
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+static esp_pm_lock_handle_t pm_lock = NULL;
+#endif
+static Power_WakeCb_t ir_wake_cb = NULL;
+static void *ir_wake_arg = NULL;
+static uint32_t hold_mask = 0;                  // one bit per Power_Client_t
+static Power_State_t state = POWER_STATE_IDLE;  // ACTIVE or IDLE, sleep is accounted by the sleep callback
+static int64_t state_since = 0;
+static int64_t wake_at = 0;                     // IR wakeup not handled yet, 0: none
+static Power_Stats_t stats;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief power manager initialization function. Enables automatic light
+ *        sleep, call before any client holds the device.
+ *
+ */
+void Power_Init(void)
+{
+  stats.u32_LatMinUs = UINT32_MAX;
+  state_since = esp_timer_get_time();
+
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  const esp_pm_config_t pm_config = {
+    .max_freq_mhz = POWER_MAX_FREQ_MHZ,
+    .min_freq_mhz = POWER_MIN_FREQ_MHZ,
+    .light_sleep_enable = true,
+  };
+
+  ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "power", &pm_lock));
+  if (esp_pm_configure(&pm_config) != ESP_OK) {
+    ESP_LOGW(TAG, "light sleep not available\n");
+  }
+#if defined(CONFIG_PM_LIGHT_SLEEP_CALLBACKS)
+  esp_pm_sleep_cbs_register_config_t sleep_cbs = {
+    .exit_cb = Power_SleepExit,
+  };
+  ESP_ERROR_CHECK(esp_pm_light_sleep_register_cbs(&sleep_cbs));
+#endif
+
+  /* the pins keep their configuration in sleep: LED level, IR pull-down */
+  (void)gpio_sleep_sel_dis(IR_SWITCH_GPIO);
+  (void)gpio_sleep_sel_dis(ON_BOARD_LED_GPIO);
+  ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+#endif
+
+  esp_err_t err = gpio_install_isr_service(0);
+  ESP_ERROR_CHECK((err == ESP_ERR_INVALID_STATE) ? ESP_OK : err);   // already installed
+  ESP_ERROR_CHECK(gpio_isr_handler_add(IR_SWITCH_GPIO, Power_IrIsr, NULL));
+  (void)gpio_intr_disable(IR_SWITCH_GPIO);
+}
+
+/**
+ * @brief Keep the device out of light sleep
+ * @param e_Client : module asking
+ */
+void Power_Hold(Power_Client_t e_Client)
+{
+  const uint32_t bit = 1UL << e_Client;
+
+  taskENTER_CRITICAL(&power_lock);
+  if ((hold_mask & bit) == 0U) {
+    if (hold_mask == 0U) {
+      Power_Account(POWER_STATE_ACTIVE, esp_timer_get_time());
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+      (void)esp_pm_lock_acquire(pm_lock);
+#endif
+    }
+    hold_mask |= bit;
+  }
+  taskEXIT_CRITICAL(&power_lock);
+}
+
+/**
+ * @brief Allow light sleep as far as this client is concerned
+ * @param e_Client : module releasing
+ */
+void Power_Release(Power_Client_t e_Client)
+{
+  const uint32_t bit = 1UL << e_Client;
+
+  taskENTER_CRITICAL(&power_lock);
+  if ((hold_mask & bit) != 0U) {
+    hold_mask &= ~bit;
+    if (hold_mask == 0U) {
+      Power_Account(POWER_STATE_IDLE, esp_timer_get_time());
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+      (void)esp_pm_lock_release(pm_lock);
+#endif
+    }
+  }
+  taskEXIT_CRITICAL(&power_lock);
+}
+
+/**
+ * @brief Wake up when a bottle is placed. Call before releasing the device
+ *        while the IR switch is not sampled, the wakeup is disarmed again
+ *        when it fires.
+ * @param pf_Wake : called from the timer task after the wakeup, with
+ *                  POWER_CLIENT_SYSSM held
+ * @param pv_Arg : passed to pf_Wake
+ */
+void Power_ArmIrWake(Power_WakeCb_t pf_Wake, void *pv_Arg)
+{
+  ir_wake_cb = pf_Wake;
+  ir_wake_arg = pv_Arg;
+  /* level triggered, a bottle placed before this call wakes at once */
+  (void)gpio_wakeup_enable(IR_SWITCH_GPIO, POWER_IR_WAKE_LEVEL);
+  (void)gpio_intr_enable(IR_SWITCH_GPIO);
+}
+
+/**
+ * @brief The event caused by the last IR wakeup was handled, records the
+ *        wake to handled latency
+ */
+void Power_Handled(void)
+{
+  int64_t latency = -1;
+
+  taskENTER_CRITICAL(&power_lock);
+  if (wake_at != 0) {
+    latency = esp_timer_get_time() - wake_at;
+    wake_at = 0;
+    stats.u32_LatCount++;
+    stats.u32_LatAvgUs += (uint32_t)((latency - (int64_t)stats.u32_LatAvgUs) / (int64_t)stats.u32_LatCount);
+    if ((uint32_t)latency < stats.u32_LatMinUs) {
+      stats.u32_LatMinUs = (uint32_t)latency;
+    }
+    if ((uint32_t)latency > stats.u32_LatMaxUs) {
+      stats.u32_LatMaxUs = (uint32_t)latency;
+    }
+  }
+  taskEXIT_CRITICAL(&power_lock);
+
+  if (latency >= 0) {
+    DLOG_I("ir wake handled after %d us", (int32_t)latency);
+  }
+}
+
+/**
+ * @brief Enter deep sleep until a bottle is placed or a time has passed.
+ *        Does not return on the target, the wakeup boots the application
+ *        again, see resume.
+ * @param u32_WakeMs : timer wakeup, 0 for the IR switch only
+ */
+void Power_DeepSleep(uint32_t u32_WakeMs)
+{
+  ESP_LOGI(TAG, "deep sleep, timer %lu ms\n", (unsigned long)u32_WakeMs);
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  /* the digital pad pull-down is off in deep sleep, the RTC one takes over */
+  (void)rtc_gpio_pullup_dis(IR_SWITCH_GPIO);
+  (void)rtc_gpio_pulldown_en(IR_SWITCH_GPIO);
+  ESP_ERROR_CHECK(esp_sleep_enable_ext0_wakeup(IR_SWITCH_GPIO, 0));   // bottle present, see GetIRswitchStatus
+  if (u32_WakeMs != 0U) {
+    ESP_ERROR_CHECK(esp_sleep_enable_timer_wakeup((uint64_t)u32_WakeMs * 1000U));
+  }
+  esp_deep_sleep_start();
+#endif
+}
+
+/**
+ * @brief Copy the counters, the time of the current state included
+ * @param pst_Stats : counters
+ */
+void Power_GetStats(Power_Stats_t *pst_Stats)
+{
+  taskENTER_CRITICAL(&power_lock);
+  Power_Account(state, esp_timer_get_time());
+  *pst_Stats = stats;
+  taskEXIT_CRITICAL(&power_lock);
+
+  /* the idle time is measured across the sleep periods */
+  if (pst_Stats->au64_TimeUs[POWER_STATE_IDLE] > pst_Stats->au64_TimeUs[POWER_STATE_SLEEP]) {
+    pst_Stats->au64_TimeUs[POWER_STATE_IDLE] -= pst_Stats->au64_TimeUs[POWER_STATE_SLEEP];
+  } else {
+    pst_Stats->au64_TimeUs[POWER_STATE_IDLE] = 0;
+  }
+  if (pst_Stats->u32_LatCount == 0U) {
+    pst_Stats->u32_LatMinUs = 0;
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Add the time since the last change to the current state, called
+ *        with power_lock taken
+ * @param e_State : state from now on
+ * @param s64_Now : esp_timer time
+ */
+static void Power_Account(Power_State_t e_State, int64_t s64_Now)
+{
+  stats.au64_TimeUs[state] += (uint64_t)(s64_Now - state_since);
+  state_since = s64_Now;
+  state = e_State;
+}
+
+/**
+ * @brief IR switch level interrupt, armed by Power_ArmIrWake. The work is
+ *        passed to the timer task, the device stays awake until it ran.
+ * @param pv_Arg
+ */
+static void Power_IrIsr(void *pv_Arg)
+{
+  BaseType_t woken = pdFALSE;
+
+  (void)pv_Arg;
+  (void)gpio_intr_disable(IR_SWITCH_GPIO);
+  taskENTER_CRITICAL_ISR(&power_lock);
+  wake_at = esp_timer_get_time();
+  stats.u32_IrWakes++;
+  taskEXIT_CRITICAL_ISR(&power_lock);
+  (void)xTimerPendFunctionCallFromISR(Power_IrWoken, NULL, 0, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief IR wakeup in the timer task: disarm, hold the device for the state
+ *        machine and let it sample the switch
+ * @param pv_Arg
+ * @param u32_Arg
+ */
+static void Power_IrWoken(void *pv_Arg, uint32_t u32_Arg)
+{
+  (void)pv_Arg;
+  (void)u32_Arg;
+  (void)gpio_wakeup_disable(IR_SWITCH_GPIO);
+  Power_Hold(POWER_CLIENT_SYSSM);
+  if (ir_wake_cb != NULL) {
+    ir_wake_cb(ir_wake_arg);
+  }
+}
+
+#if !defined(CONFIG_IDF_TARGET_LINUX) && defined(CONFIG_PM_LIGHT_SLEEP_CALLBACKS)
+/**
+ * @brief Light sleep ended, called by the power management with interrupts
+ *        disabled
+ * @param s64_SleepUs : time slept
+ * @param pv_Arg
+ * @return ESP_OK
+ */
+static esp_err_t IRAM_ATTR Power_SleepExit(int64_t s64_SleepUs, void *pv_Arg)
+{
+  (void)pv_Arg;
+  portENTER_CRITICAL_SAFE(&power_lock);
+  stats.au64_TimeUs[POWER_STATE_SLEEP] += (uint64_t)s64_SleepUs;
+  stats.u32_Sleeps++;
+  portEXIT_CRITICAL_SAFE(&power_lock);
+  return ESP_OK;
+}
+#endif
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : prof
+ *  Description        : cycle profiler. PROF_SCOPE measures the CPU cycles
+ *                       from its line to the end of the enclosing block into
+ *                       a log2 histogram per call site and core. Compiled
+ *                       out unless PROF_ENABLE is 1.
+ ******************************************************************************/
+
+#ifndef PROF_H
+#define PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+#include "sdkconfig.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#ifndef PROF_ENABLE
+#define PROF_ENABLE               0         // idf.py -DPROF_ENABLE=1 build
+#endif
+
+#if defined(CONFIG_IDF_TARGET_LINUX) || defined(CONFIG_FREERTOS_UNICORE)
+#define PROF_CORES                1U
+#else
+#define PROF_CORES                2U
+#endif
+#define PROF_BUCKETS              24U       // bucket b counts 2^b..2^(b+1)-1 cycles, the last one also more
+
+/*
+ * PROF_SCOPE("name") at the start of a block measures until the block is
+ * left, returns included. One scope per block, the name is a string
+ * literal. The time is inclusive: calls, interrupts and tasks that ran in
+ * between count. A scope that ends on another core than it began on is
+ * only counted as migrated, the cycle counters of the cores differ.
+ */
+#if (PROF_ENABLE == 1)
+#define PROF_SCOPE(name)                                                                   \
+  static Prof_Site_t prof_site = { .pc_Name = (name) };                                    \
+  Prof_Scope_t prof_scope __attribute__((cleanup(Prof_End))) = Prof_Begin(&prof_site)
+#else
+#define PROF_SCOPE(name)          do { } while (0)
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef struct Prof_Stat_t
+{
+  uint32_t u32_Count;
+  uint32_t u32_Min;              // cycles
+  uint32_t u32_Max;
+  uint64_t u64_Total;
+  uint32_t au32_Hist[PROF_BUCKETS];
+}Prof_Stat_t;
+
+/*
+ * @brief one PROF_SCOPE, static at the call site. Each core only writes its
+ *        own statistics.
+ */
+typedef struct Prof_Site_t
+{
+  const char *pc_Name;
+  struct Prof_Site_t *pst_Next;  // list of the sites that ran
+  uint32_t u32_Listed;
+  uint32_t u32_Migrated;
+  Prof_Stat_t ast_Core[PROF_CORES];
+}Prof_Site_t;
+
+typedef struct Prof_Scope_t
+{
+  Prof_Site_t *pst_Site;
+  uint32_t u32_Start;            // cycle count
+  uint32_t u32_Core;
+}Prof_Scope_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+Prof_Scope_t Prof_Begin(Prof_Site_t *pst_Site);
+void Prof_End(Prof_Scope_t *pst_Scope);
+void Prof_Report(void);
+void Prof_Dump(void);
+void Prof_Reset(void);
+void Prof_Tasks(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROF_H
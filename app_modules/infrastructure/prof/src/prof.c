@@ -0,0 +1,327 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : prof
+ *  Description        : cycle profiler, statistics per call site and core,
+ *                       console report and dump, FreeRTOS run time stats
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "prof.h"
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#include <pthread.h>
+#endif
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define PROF_MAX_REPORT           32U       // sites in the report, the hottest first
+#define PROF_NAME_WORDS           6U        // name bytes in the dump / 4
+#define PROF_DUMP_MAGIC           0x46505246UL  // "FRPF"
+#define PROF_DUMP_VERSION         1U
+#define PROF_LINE_WORDS           8U
+#define PROF_TASK_LINE            48U       // bytes per task of vTaskGetRunTimeStats
+#define PROF_MAX_TASKS            16U
+
+/*
+ * Like dlog: the statistics of a core are only written on that core with its
+ * interrupts masked for the few stores, the cores never wait on each other.
+ */
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#define PROF_ENTER()              (pthread_mutex_lock(&prof_mutex), 0U)
+#define PROF_EXIT(m)              do { (void)(m); pthread_mutex_unlock(&prof_mutex); } while (0)
+#else
+#define PROF_ENTER()              portSET_INTERRUPT_MASK_FROM_ISR()
+#define PROF_EXIT(m)              portCLEAR_INTERRUPT_MASK_FROM_ISR(m)
+#endif
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Prof_Sum(const Prof_Site_t *pst_Site, Prof_Stat_t *pst_Sum);
+static uint32_t Prof_Percentile(const Prof_Stat_t *pst_Stat, uint32_t u32_Pct);
+static void Prof_DumpWords(const uint32_t *pu32_Words, uint32_t u32_N);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Prof_Site_t *sites = NULL;        // pushed with compare and swap, never removed
+#if defined(CONFIG_IDF_TARGET_LINUX)
+static pthread_mutex_t prof_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Start of a scope, see PROF_SCOPE
+ * @param pst_Site : call site
+ * @return scope, handed to Prof_End
+ */
+Prof_Scope_t Prof_Begin(Prof_Site_t *pst_Site)
+{
+  const Prof_Scope_t scope = {
+    .pst_Site = pst_Site,
+    .u32_Core = (uint32_t)esp_cpu_get_core_id(),
+    .u32_Start = (uint32_t)esp_cpu_get_cycle_count(),
+  };
+  return scope;
+}
+
+/**
+ * @brief End of a scope, called when the block of PROF_SCOPE is left
+ * @param pst_Scope : scope from Prof_Begin
+ */
+void Prof_End(Prof_Scope_t *pst_Scope)
+{
+  const uint32_t u32_Cycles = (uint32_t)esp_cpu_get_cycle_count() - pst_Scope->u32_Start;
+  Prof_Site_t *pst_Site = pst_Scope->pst_Site;
+  uint32_t u32_Bucket = 31U - (uint32_t)__builtin_clz(u32_Cycles | 1U);
+
+  if (__atomic_exchange_n(&pst_Site->u32_Listed, 1U, __ATOMIC_ACQ_REL) == 0U) {
+    Prof_Site_t *pst_Head = __atomic_load_n(&sites, __ATOMIC_ACQUIRE);
+    do {
+      pst_Site->pst_Next = pst_Head;
+    } while (__atomic_compare_exchange_n(&sites, &pst_Head, pst_Site, true, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE) ==
+             false);
+  }
+
+  if ((uint32_t)esp_cpu_get_core_id() != pst_Scope->u32_Core) {
+    (void)__atomic_fetch_add(&pst_Site->u32_Migrated, 1U, __ATOMIC_RELAXED);
+    return;
+  }
+  if (u32_Bucket >= PROF_BUCKETS) {
+    u32_Bucket = PROF_BUCKETS - 1U;
+  }
+
+  const uint32_t u32_Mask = PROF_ENTER();
+  Prof_Stat_t *pst_Stat = &pst_Site->ast_Core[pst_Scope->u32_Core];
+  if ((pst_Stat->u32_Count == 0U) || (u32_Cycles < pst_Stat->u32_Min)) {
+    pst_Stat->u32_Min = u32_Cycles;
+  }
+  if (u32_Cycles > pst_Stat->u32_Max) {
+    pst_Stat->u32_Max = u32_Cycles;
+  }
+  pst_Stat->u32_Count++;
+  pst_Stat->u64_Total += u32_Cycles;
+  pst_Stat->au32_Hist[u32_Bucket]++;
+  PROF_EXIT(u32_Mask);
+}
+
+/**
+ * @brief Print the sites, the most cycles in total first, one line per core
+ *
+ */
+void Prof_Report(void)
+{
+  Prof_Site_t *hot[PROF_MAX_REPORT];
+  uint64_t total[PROF_MAX_REPORT];
+  uint32_t n = 0;
+
+  for (Prof_Site_t *pst_Site = __atomic_load_n(&sites, __ATOMIC_ACQUIRE); pst_Site != NULL;
+       pst_Site = pst_Site->pst_Next) {
+    Prof_Stat_t sum;
+    uint32_t i;
+
+    Prof_Sum(pst_Site, &sum);
+    /* insertion into the sorted list, drops the coldest when full */
+    for (i = n; (i > 0U) && (total[i - 1U] < sum.u64_Total); i--) {
+      if (i < PROF_MAX_REPORT) {
+        hot[i] = hot[i - 1U];
+        total[i] = total[i - 1U];
+      }
+    }
+    if (i < PROF_MAX_REPORT) {
+      hot[i] = pst_Site;
+      total[i] = sum.u64_Total;
+      n += (n < PROF_MAX_REPORT) ? 1U : 0U;
+    }
+  }
+
+  if (n == 0U) {
+    printf("no profile%s\n", (PROF_ENABLE == 1) ? "" : ", build with PROF_ENABLE=1");
+    return;
+  }
+  printf("%-20s core %9s %12s %8s %8s %8s %8s %8s\n", "site", "count", "total", "min", "avg", "p50<=", "p99<=",
+         "max");
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t c = 0; c < PROF_CORES; c++) {
+      const Prof_Stat_t *pst_Stat = &hot[i]->ast_Core[c];
+      if (pst_Stat->u32_Count == 0U) {
+        continue;
+      }
+      printf("%-20.20s %4lu %9lu %12llu %8lu %8lu %8lu %8lu %8lu\n", hot[i]->pc_Name, (unsigned long)c,
+             (unsigned long)pst_Stat->u32_Count, (unsigned long long)pst_Stat->u64_Total,
+             (unsigned long)pst_Stat->u32_Min, (unsigned long)(pst_Stat->u64_Total / pst_Stat->u32_Count),
+             (unsigned long)Prof_Percentile(pst_Stat, 50U), (unsigned long)Prof_Percentile(pst_Stat, 99U),
+             (unsigned long)pst_Stat->u32_Max);
+    }
+    if (hot[i]->u32_Migrated != 0U) {
+      printf("%-20.20s      %9lu migrated between cores, not counted\n", hot[i]->pc_Name,
+             (unsigned long)hot[i]->u32_Migrated);
+    }
+  }
+}
+
+/**
+ * @brief Print all sites as "~P:<hex words>" lines for tools/prof_extract.py:
+ *        magic, version, cores, buckets, then per site the name in
+ *        PROF_NAME_WORDS, the migrated count and per core count, min, max,
+ *        total low and high word and the histogram
+ */
+void Prof_Dump(void)
+{
+  uint32_t au32_Words[PROF_NAME_WORDS + 1U + (PROF_CORES * (5U + PROF_BUCKETS))];
+  const Prof_Site_t *pst_Head = __atomic_load_n(&sites, __ATOMIC_ACQUIRE);   // sites added later are in front
+  uint32_t u32_Sites = 0;
+
+  for (const Prof_Site_t *pst_Site = pst_Head; pst_Site != NULL; pst_Site = pst_Site->pst_Next) {
+    u32_Sites++;
+  }
+  au32_Words[0] = PROF_DUMP_MAGIC;
+  au32_Words[1] = PROF_DUMP_VERSION;
+  au32_Words[2] = PROF_CORES;
+  au32_Words[3] = PROF_BUCKETS;
+  au32_Words[4] = u32_Sites;
+  Prof_DumpWords(au32_Words, 5U);
+
+  for (const Prof_Site_t *pst_Site = pst_Head; pst_Site != NULL; pst_Site = pst_Site->pst_Next) {
+    uint32_t n = PROF_NAME_WORDS;
+
+    (void)memset(au32_Words, 0, PROF_NAME_WORDS * sizeof(uint32_t));
+    (void)strncpy((char *)au32_Words, pst_Site->pc_Name, (PROF_NAME_WORDS * sizeof(uint32_t)) - 1U);
+    au32_Words[n++] = pst_Site->u32_Migrated;
+    for (uint32_t c = 0; c < PROF_CORES; c++) {
+      const Prof_Stat_t *pst_Stat = &pst_Site->ast_Core[c];
+      au32_Words[n++] = pst_Stat->u32_Count;
+      au32_Words[n++] = pst_Stat->u32_Min;
+      au32_Words[n++] = pst_Stat->u32_Max;
+      au32_Words[n++] = (uint32_t)pst_Stat->u64_Total;
+      au32_Words[n++] = (uint32_t)(pst_Stat->u64_Total >> 32);
+      (void)memcpy(&au32_Words[n], pst_Stat->au32_Hist, sizeof(pst_Stat->au32_Hist));
+      n += PROF_BUCKETS;
+    }
+    Prof_DumpWords(au32_Words, n);
+  }
+}
+
+/**
+ * @brief Clear the statistics of all sites. A scope ending on the other core
+ *        meanwhile may survive the reset.
+ *
+ */
+void Prof_Reset(void)
+{
+  for (Prof_Site_t *pst_Site = __atomic_load_n(&sites, __ATOMIC_ACQUIRE); pst_Site != NULL;
+       pst_Site = pst_Site->pst_Next) {
+    const uint32_t u32_Mask = PROF_ENTER();
+    pst_Site->u32_Migrated = 0;
+    (void)memset(pst_Site->ast_Core, 0, sizeof(pst_Site->ast_Core));
+    PROF_EXIT(u32_Mask);
+  }
+}
+
+/**
+ * @brief Print the CPU time of every task from the FreeRTOS run time stats
+ *
+ */
+void Prof_Tasks(void)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS == 1)
+  char *pc_Buf = malloc(PROF_MAX_TASKS * PROF_TASK_LINE);
+
+  if (pc_Buf == NULL) {
+    printf("no memory for the task list\n");
+    return;
+  }
+  vTaskGetRunTimeStats(pc_Buf);
+  printf("task\t\ttime\t\t%%\n%s", pc_Buf);
+  free(pc_Buf);
+#else
+  printf("run time stats off, set CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS\n");
+#endif
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Statistics of a site over all cores
+ * @param pst_Site : site
+ * @param pst_Sum : result, only count and total
+ */
+static void Prof_Sum(const Prof_Site_t *pst_Site, Prof_Stat_t *pst_Sum)
+{
+  pst_Sum->u32_Count = 0;
+  pst_Sum->u64_Total = 0;
+  for (uint32_t c = 0; c < PROF_CORES; c++) {
+    pst_Sum->u32_Count += pst_Site->ast_Core[c].u32_Count;
+    pst_Sum->u64_Total += pst_Site->ast_Core[c].u64_Total;
+  }
+}
+
+/**
+ * @brief Upper bound of a percentile from the histogram
+ * @param pst_Stat : statistics
+ * @param u32_Pct : 1..100
+ * @return cycles, at most the maximum
+ */
+static uint32_t Prof_Percentile(const Prof_Stat_t *pst_Stat, uint32_t u32_Pct)
+{
+  const uint64_t u64_Need = (((uint64_t)pst_Stat->u32_Count * u32_Pct) + 99U) / 100U;
+  uint64_t u64_Seen = 0;
+
+  for (uint32_t b = 0; b < (PROF_BUCKETS - 1U); b++) {
+    u64_Seen += pst_Stat->au32_Hist[b];
+    if (u64_Seen >= u64_Need) {
+      const uint32_t u32_Upper = (2UL << b) - 1U;
+      return (u32_Upper < pst_Stat->u32_Max) ? u32_Upper : pst_Stat->u32_Max;
+    }
+  }
+  return pst_Stat->u32_Max;
+}
+
+/**
+ * @brief Print words as "~P:" lines of PROF_LINE_WORDS
+ * @param pu32_Words : words
+ * @param u32_N : count
+ */
+static void Prof_DumpWords(const uint32_t *pu32_Words, uint32_t u32_N)
+{
+  for (uint32_t i = 0; i < u32_N; i += PROF_LINE_WORDS) {
+    printf("~P:");
+    for (uint32_t j = i; (j < u32_N) && (j < (i + PROF_LINE_WORDS)); j++) {
+      printf("%08lx", (unsigned long)pu32_Words[j]);
+    }
+    printf("\n");
+  }
+}
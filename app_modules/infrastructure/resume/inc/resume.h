@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : resume
+ *  Description        : state snapshot in RTC memory for resume from deep sleep
+ ******************************************************************************/
+
+#ifndef RESUME_H
+#define RESUME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define RESUME_DATA_MAX           64U       // snapshot bytes kept in RTC slow memory
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Resume_Save(uint16_t u16_Version, const void *pv_Data, uint16_t u16_Len);
+bool Resume_Load(uint16_t u16_Version, void *pv_Data, uint16_t u16_Len);
+uint32_t Resume_GetWakeUs(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESUME_H
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : resume
+ *  Description        : state snapshot in RTC slow memory. It is written
+ *                       right before deep sleep and checked by the wake stub,
+ *                       which also stamps the wakeup time, so the application
+ *                       can continue where it stopped instead of booting cold.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "extended_services.h"
+#include "resume.h"
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include "esp_private/esp_clk.h"
+#include "soc/rtc.h"
+#include "soc/rtc_cntl_reg.h"
+#endif
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define RESUME_MAGIC              0x4D535246UL  // "FRSM"
+#define RESUME_STUB_VALID         0x56415244UL  // set by the wake stub for a good snapshot
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#define RTC_NOINIT_ATTR
+#endif
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Resume_Snapshot_t
+{
+  uint32_t u32_Magic;
+  uint16_t u16_Version;      // layout of au8_Data, owned by the caller
+  uint16_t u16_Len;
+  uint32_t u32_Crc;          // CRC-32 of the u16_Len data bytes
+  uint8_t au8_Data[RESUME_DATA_MAX];
+} Resume_Snapshot_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "resume";
+
+/* kept over deep sleep, garbage after power on */
+static RTC_NOINIT_ATTR Resume_Snapshot_t snapshot;
+static RTC_NOINIT_ATTR uint32_t stub_state;
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+static RTC_NOINIT_ATTR uint64_t stub_wake_ticks;   // RTC slow clock at the wake stub
+#endif
+static bool resumed = false;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief Store the snapshot, call right before deep sleep
+ * @param u16_Version : layout version of the data, a changed layout is not loaded
+ * @param pv_Data : data
+ * @param u16_Len : bytes, at most RESUME_DATA_MAX
+ */
+void Resume_Save(uint16_t u16_Version, const void *pv_Data, uint16_t u16_Len)
+{
+  assert(u16_Len <= RESUME_DATA_MAX);
+  (void)memcpy(snapshot.au8_Data, pv_Data, u16_Len);
+  snapshot.u16_Version = u16_Version;
+  snapshot.u16_Len = u16_Len;
+  snapshot.u32_Crc = Srvc_CalcCRC32(0, snapshot.au8_Data, u16_Len);
+  snapshot.u32_Magic = RESUME_MAGIC;
+}
+
+/**
+ * @brief Take the snapshot after a deep sleep wakeup. It is consumed, a
+ *        later reset boots cold.
+ * @param u16_Version : expected layout version
+ * @param pv_Data : data
+ * @param u16_Len : expected bytes
+ * @return false on a cold boot or if the snapshot is not valid
+ */
+bool Resume_Load(uint16_t u16_Version, void *pv_Data, uint16_t u16_Len)
+{
+  bool ok = false;
+
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  ok = (esp_reset_reason() == ESP_RST_DEEPSLEEP) && (stub_state == RESUME_STUB_VALID) &&
+       (snapshot.u16_Version == u16_Version) && (snapshot.u16_Len == u16_Len);
+#endif
+  if (ok != false) {
+    (void)memcpy(pv_Data, snapshot.au8_Data, u16_Len);
+    resumed = true;
+    ESP_LOGI(TAG, "resumed, version %u\n", u16_Version);
+  }
+  snapshot.u32_Magic = 0;
+  stub_state = 0;
+  return ok;
+}
+
+/**
+ * @brief Time since the wake stub ran, for the resume instrumentation
+ * @return us, 0 after a cold boot
+ */
+uint32_t Resume_GetWakeUs(void)
+{
+  uint32_t us = 0;
+
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+  if (resumed != false) {
+    us = (uint32_t)rtc_time_slowclk_to_us(rtc_time_get() - stub_wake_ticks, esp_clk_slowclk_cal_get());
+  }
+#endif
+  return us;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+#if !defined(CONFIG_IDF_TARGET_LINUX)
+/**
+ * @brief Deep sleep wake stub, runs from RTC fast memory before the
+ *        bootloader. Only ROM code and RTC memory are available here. The
+ *        ROM CRC-32 gives the same result as Srvc_CalcCRC32.
+ */
+void RTC_IRAM_ATTR esp_wake_deep_sleep(void)
+{
+  esp_default_wake_deep_sleep();
+
+  SET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_UPDATE);
+  while (GET_PERI_REG_MASK(RTC_CNTL_TIME_UPDATE_REG, RTC_CNTL_TIME_VALID) == 0U) {
+    /* the counter is latched within a few slow clock cycles */
+  }
+  stub_wake_ticks = READ_PERI_REG(RTC_CNTL_TIME0_REG) | ((uint64_t)READ_PERI_REG(RTC_CNTL_TIME1_REG) << 32);
+
+  stub_state = ((snapshot.u32_Magic == RESUME_MAGIC) && (snapshot.u16_Len <= RESUME_DATA_MAX) &&
+                (esp_rom_crc32_le(0, snapshot.au8_Data, snapshot.u16_Len) == snapshot.u32_Crc)) ? RESUME_STUB_VALID : 0U;
+}
+#endif
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : flash_port
+ *  Description        : access to raw data partitions, file backed on host
+ ******************************************************************************/
+
+#ifndef FLASH_PORT_H
+#define FLASH_PORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+/* host only: directory holding <label>.bin partition images, overridden by
+ * the FROST_FLASH_DIR environment variable */
+#define FLASH_PORT_HOST_DIR        "."
+
+#define FLASH_PORT_SECTOR_SIZE     0x1000U   // erase unit
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+/*
+ * @brief opened partition
+ */
+typedef struct FlashPort_t
+{
+  const void *pv_Part;       // esp_partition_t on target, NULL on host
+  int32_t s32_Fd;            // image file on host, -1 on target
+  uint32_t u32_Size;         // partition size in bytes
+  const void *pv_Map;        // read only mapping, NULL if not mapped
+  uint32_t u32_MapHandle;    // esp_partition_mmap handle
+  uint32_t u32_Erases;       // sectors erased through this handle
+  uint32_t u32_Writes;       // write calls through this handle
+} FlashPort_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+bool FlashPort_Open(FlashPort_t *pst_Port, const char *pc_Label);
+const void *FlashPort_Mmap(FlashPort_t *pst_Port);
+void FlashPort_Munmap(FlashPort_t *pst_Port);
+bool FlashPort_Read(FlashPort_t *pst_Port, uint32_t u32_Offset, void *pv_Dst, uint32_t u32_Len);
+bool FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len);
+bool FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLASH_PORT_H
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : journal
+ *  Description        : append-only event journal in a flash partition
+ ******************************************************************************/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define JOURNAL_PARTITION         "journal"
+#define JOURNAL_MAX_SECTORS       64U       // largest partition the sector index covers
+#define JOURNAL_PAGE_SIZE         256U      // flash program page, records are written in pages
+#define JOURNAL_EXPORT_VALS       2U        // values per exported record: type << 16 | arg, data
+#ifndef JOURNAL_FLUSH_MS
+#define JOURNAL_FLUSH_MS          60000U    // longest a record waits in RAM
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef enum Journal_Type_t
+{
+  JOURNAL_BOTTLE_PLACED = 1,
+  JOURNAL_BOTTLE_REMOVED,
+  JOURNAL_TYPE_MAX
+}Journal_Type_t;
+
+/*
+ * @brief one record, 16 bytes in flash
+ */
+typedef struct Journal_Rec_t
+{
+  uint32_t u32_Time;         // seconds, never decreasing within the journal
+  uint16_t u16_Type;         // Journal_Type_t
+  uint16_t u16_Arg;
+  uint32_t u32_Data;
+  uint32_t u32_Crc;          // Srvc_CalcCRC32 of the 12 bytes before
+} Journal_Rec_t;
+
+/*
+ * @brief read position, see Journal_Seek
+ */
+typedef struct Journal_Iter_t
+{
+  uint32_t u32_Seq;          // sequence number of the sector
+  uint32_t u32_Slot;         // record slot in that sector, slots past the flash records address the RAM batch
+} Journal_Iter_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+bool Journal_Append(Journal_Type_t e_Type, uint32_t u32_Time, uint16_t u16_Arg, uint32_t u32_Data);
+bool Journal_Flush(void);
+void Journal_Seek(Journal_Iter_t *pst_It, uint32_t u32_From);
+bool Journal_Next(Journal_Iter_t *pst_It, Journal_Rec_t *pst_Rec);
+uint32_t Journal_Trim(uint32_t u32_Before);
+uint16_t Journal_Export(Journal_Iter_t *pst_It, uint8_t *pu8_Buf, uint16_t u16_Size);
+uint32_t Journal_GetErases(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOURNAL_H
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : settings
+ *  Description        : persistent settings, read from a RAM shadow and
+ *                       written to flash in coalesced commits
+ ******************************************************************************/
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define SETTINGS_PARTITION        "settings"  // two sectors, written alternately
+#ifndef SETTINGS_QUIET_MS
+#define SETTINGS_QUIET_MS         3000U       // commit after this long without changes
+#endif
+#ifndef SETTINGS_MAX_DEFER_MS
+#define SETTINGS_MAX_DEFER_MS     30000U      // commit at the latest this long after the first change
+#endif
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef enum Settings_Id_t
+{
+  SETTINGS_DRINK_TIMER_S = 0,   // drink reminder after the bottle was untouched, s
+  SETTINGS_PLACE_TIMER_S,       // standby after the bottle was away, s
+  SETTINGS_CLEAN_TIMER_S,       // clean reminder period, s
+  SETTINGS_MAX
+}Settings_Id_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Settings_Init(void);
+int32_t Settings_Get(Settings_Id_t e_Id);
+void Settings_Set(Settings_Id_t e_Id, int32_t s32_Value);
+bool Settings_Commit(void);
+uint32_t Settings_GetCommits(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SETTINGS_H
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : storage
+ *  Description        : storage worker task, runs the deferred flash writes
+ *                       that timer callbacks must not do themselves
+ ******************************************************************************/
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+#include "stdint.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define STORAGE_JOBS              4U        // jobs waiting for the worker
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef void (*Storage_Job_t)(void);
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Storage_Init(void);
+bool Storage_Pend(Storage_Job_t pf_Job);
+void Storage_task(void *param);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STORAGE_H
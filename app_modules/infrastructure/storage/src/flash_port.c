@@ -0,0 +1,249 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : flash_port
+ *  Description        : access to raw data partitions, file backed on host
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "flash_port.h"
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include "esp_partition.h"
+#endif
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "flash";
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Open a data partition by label. On host the partition is the file
+ *        <FROST_FLASH_DIR>/<label>.bin
+ * @param pst_Port : handle to fill
+ * @param pc_Label : partition label
+ * @return false if the partition does not exist
+ */
+bool FlashPort_Open(FlashPort_t *pst_Port, const char *pc_Label)
+{
+  pst_Port->pv_Part = NULL;
+  pst_Port->s32_Fd = -1;
+  pst_Port->u32_Size = 0;
+  pst_Port->pv_Map = NULL;
+  pst_Port->u32_MapHandle = 0;
+  pst_Port->u32_Erases = 0;
+  pst_Port->u32_Writes = 0;
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  char path[256];
+  struct stat st;
+  const char *dir = getenv("FROST_FLASH_DIR");
+
+  (void)snprintf(path, sizeof(path), "%s/%s.bin", (dir != NULL) ? dir : FLASH_PORT_HOST_DIR, pc_Label);
+  pst_Port->s32_Fd = open(path, O_RDWR);
+  if (pst_Port->s32_Fd < 0) {
+    pst_Port->s32_Fd = open(path, O_RDONLY);
+  }
+  if ((pst_Port->s32_Fd >= 0) && (fstat(pst_Port->s32_Fd, &st) == 0)) {
+    pst_Port->u32_Size = (uint32_t)st.st_size;
+  }
+#else
+  const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, pc_Label);
+  if (part != NULL) {
+    pst_Port->pv_Part = part;
+    pst_Port->u32_Size = part->size;
+  }
+#endif
+
+  if (pst_Port->u32_Size == 0U) {
+    ESP_LOGW(TAG, "partition %s not found\n", pc_Label);
+  }
+  return pst_Port->u32_Size != 0U;
+}
+
+/**
+ * @brief Map the whole partition read only into the address space. On
+ *        target this goes through the flash cache MMU, no data is copied.
+ * @param pst_Port : opened partition
+ * @return mapping, NULL on failure
+ */
+const void *FlashPort_Mmap(FlashPort_t *pst_Port)
+{
+  if ((pst_Port->pv_Map != NULL) || (pst_Port->u32_Size == 0U)) {
+    return pst_Port->pv_Map;
+  }
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  void *map = mmap(NULL, pst_Port->u32_Size, PROT_READ, MAP_SHARED, pst_Port->s32_Fd, 0);
+  if (map != MAP_FAILED) {
+    pst_Port->pv_Map = map;
+  }
+#else
+  const void *map = NULL;
+  esp_partition_mmap_handle_t handle;
+  if (esp_partition_mmap((const esp_partition_t *)pst_Port->pv_Part, 0, pst_Port->u32_Size,
+                         ESP_PARTITION_MMAP_DATA, &map, &handle) == ESP_OK) {
+    pst_Port->pv_Map = map;
+    pst_Port->u32_MapHandle = handle;
+  }
+#endif
+
+  if (pst_Port->pv_Map == NULL) {
+    ESP_LOGE(TAG, "mmap failed\n");
+  }
+  return pst_Port->pv_Map;
+}
+
+/**
+ * @brief Release the mapping
+ * @param pst_Port : opened partition
+ */
+void FlashPort_Munmap(FlashPort_t *pst_Port)
+{
+  if (pst_Port->pv_Map == NULL) {
+    return;
+  }
+
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  (void)munmap((void *)pst_Port->pv_Map, pst_Port->u32_Size);
+#else
+  esp_partition_munmap(pst_Port->u32_MapHandle);
+#endif
+  pst_Port->pv_Map = NULL;
+}
+
+/**
+ * @brief Read from the partition
+ * @param pst_Port : opened partition
+ * @param u32_Offset : byte offset
+ * @param pv_Dst : destination
+ * @param u32_Len : bytes to read
+ * @return false if out of range or the read failed
+ */
+bool FlashPort_Read(FlashPort_t *pst_Port, uint32_t u32_Offset, void *pv_Dst, uint32_t u32_Len)
+{
+  if ((u32_Offset > pst_Port->u32_Size) || (u32_Len > (pst_Port->u32_Size - u32_Offset))) {
+    return false;
+  }
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  return pread(pst_Port->s32_Fd, pv_Dst, u32_Len, (off_t)u32_Offset) == (ssize_t)u32_Len;
+#else
+  return esp_partition_read((const esp_partition_t *)pst_Port->pv_Part, u32_Offset, pv_Dst, u32_Len) == ESP_OK;
+#endif
+}
+
+/**
+ * @brief Program erased flash. Like NOR flash, bits only go from 1 to 0, the
+ *        host image behaves the same way.
+ * @param pst_Port : opened partition
+ * @param u32_Offset : byte offset
+ * @param pv_Src : data
+ * @param u32_Len : bytes to write
+ * @return false if out of range or the write failed
+ */
+bool FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len)
+{
+  if ((u32_Offset > pst_Port->u32_Size) || (u32_Len > (pst_Port->u32_Size - u32_Offset))) {
+    return false;
+  }
+  pst_Port->u32_Writes++;
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  uint8_t chunk[256];
+  const uint8_t *src = (const uint8_t *)pv_Src;
+
+  while (u32_Len > 0U) {
+    const uint32_t n = (u32_Len > sizeof(chunk)) ? (uint32_t)sizeof(chunk) : u32_Len;
+    if (pread(pst_Port->s32_Fd, chunk, n, (off_t)u32_Offset) != (ssize_t)n) {
+      return false;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      chunk[i] &= src[i];
+    }
+    if (pwrite(pst_Port->s32_Fd, chunk, n, (off_t)u32_Offset) != (ssize_t)n) {
+      return false;
+    }
+    src += n;
+    u32_Offset += n;
+    u32_Len -= n;
+  }
+  return true;
+#else
+  return esp_partition_write((const esp_partition_t *)pst_Port->pv_Part, u32_Offset, pv_Src, u32_Len) == ESP_OK;
+#endif
+}
+
+/**
+ * @brief Erase whole sectors to 0xFF
+ * @param pst_Port : opened partition
+ * @param u32_Offset : byte offset, multiple of FLASH_PORT_SECTOR_SIZE
+ * @param u32_Len : bytes, multiple of FLASH_PORT_SECTOR_SIZE
+ * @return false if out of range, unaligned or the erase failed
+ */
+bool FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len)
+{
+  if ((((u32_Offset | u32_Len) % FLASH_PORT_SECTOR_SIZE) != 0U) ||
+      (u32_Offset > pst_Port->u32_Size) || (u32_Len > (pst_Port->u32_Size - u32_Offset))) {
+    return false;
+  }
+  pst_Port->u32_Erases += u32_Len / FLASH_PORT_SECTOR_SIZE;
+#if defined(CONFIG_IDF_TARGET_LINUX)
+  uint8_t ff[256];
+
+  (void)memset(ff, 0xFF, sizeof(ff));
+  for (uint32_t done = 0; done < u32_Len; done += (uint32_t)sizeof(ff)) {
+    if (pwrite(pst_Port->s32_Fd, ff, sizeof(ff), (off_t)(u32_Offset + done)) != (ssize_t)sizeof(ff)) {
+      return false;
+    }
+  }
+  return true;
+#else
+  return esp_partition_erase_range((const esp_partition_t *)pst_Port->pv_Part, u32_Offset, u32_Len) == ESP_OK;
+#endif
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
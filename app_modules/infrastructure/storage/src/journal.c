@@ -0,0 +1,572 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : journal
+ *  Description        : append-only event journal. The partition is a ring
+ *                       of sectors, each starting with a header that holds
+ *                       its sequence number and the time of its first
+ *                       record. The headers are kept in RAM as a sparse
+ *                       index, records are batched per flash page, the
+ *                       oldest sector is erased when the ring is full.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+#include "boot.h"
+#include "extended_services.h"
+#include "flash_port.h"
+#include "timeseries_library.h"
+#include "journal.h"
+#include "storage.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define JOURNAL_MAGIC             0x4C4E4A46UL  // "FJNL"
+#define JOURNAL_REC_SIZE          16U
+#define JOURNAL_SLOTS             (FLASH_PORT_SECTOR_SIZE / JOURNAL_REC_SIZE)   // slot 0 is the header
+#define JOURNAL_BATCH             (JOURNAL_PAGE_SIZE / JOURNAL_REC_SIZE)
+#define JOURNAL_CRC_LEN           12U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Journal_Hdr_t
+{
+  uint32_t u32_Magic;
+  uint32_t u32_Seq;          // 1 for the first sector ever written, +1 per sector
+  uint32_t u32_First;        // time of the first record
+  uint32_t u32_Crc;          // Srvc_CalcCRC32 of the 12 bytes before
+}Journal_Hdr_t;
+
+/* sparse index, one entry per sector */
+typedef struct Journal_Idx_t
+{
+  uint32_t u32_Seq;          // 0: erased or not part of the journal
+  uint32_t u32_First;
+}Journal_Idx_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool Journal_FlushLocked(void);
+static bool Journal_ReadRec(uint32_t u32_Sector, uint32_t u32_Slot, Journal_Rec_t *pst_Rec);
+static bool Journal_IsErased(uint32_t u32_Sector, uint32_t u32_Slot);
+static uint32_t Journal_SectorOf(uint32_t u32_Seq);
+static uint32_t Journal_EndOf(uint32_t u32_Seq);
+static void Journal_FlushExpired(TimerHandle_t timer);
+static void Journal_FlushJob(void);
+static void Journal_Start(void);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "journal";
+
+static FlashPort_t port;
+static bool port_ok = false;
+static Journal_Idx_t sector_idx[JOURNAL_MAX_SECTORS];
+static uint32_t sectors = 0;               // sectors in the partition
+static uint32_t head = 0;                  // sector written now
+static uint32_t used = 0;                  // sectors holding records, ending at head
+static uint32_t next_slot = JOURNAL_SLOTS; // free slot in head, JOURNAL_SLOTS when a new sector is needed
+static uint32_t last_time = 0;
+static Journal_Rec_t pending[JOURNAL_BATCH];
+static uint32_t pending_n = 0;
+static SemaphoreHandle_t lock = NULL;
+static TimerHandle_t flush_timer = NULL;
+static Boot_Drv_t journal_drv = BOOT_DRV("journal", Journal_Start);
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief Add a record. It is kept in RAM until its flash page is complete,
+ *        Journal_Flush is called or JOURNAL_FLUSH_MS have passed.
+ * @param e_Type : record type
+ * @param u32_Time : time in seconds, raised to the last record time if older
+ * @param u16_Arg : type specific
+ * @param u32_Data : type specific
+ * @return false if there is no journal, if the write of a complete page
+ *         failed, or if the record was refused because the RAM batch is
+ *         full and still can not be written
+ */
+bool Journal_Append(Journal_Type_t e_Type, uint32_t u32_Time, uint16_t u16_Arg, uint32_t u32_Data)
+{
+  Journal_Rec_t *rec;
+  uint32_t slot;
+  bool ok = true;
+
+  Boot_Use(&journal_drv);
+  if (port_ok == false) {
+    return false;
+  }
+
+  (void)xSemaphoreTake(lock, portMAX_DELAY);
+  /* a failed flush leaves a full batch behind, it has to go before more fit */
+  if ((pending_n == JOURNAL_BATCH) && (Journal_FlushLocked() == false)) {
+    (void)xSemaphoreGive(lock);
+    return false;
+  }
+  if (u32_Time < last_time) {
+    u32_Time = last_time;
+  }
+  last_time = u32_Time;
+
+  rec = &pending[pending_n++];
+  rec->u32_Time = u32_Time;
+  rec->u16_Type = (uint16_t)e_Type;
+  rec->u16_Arg = u16_Arg;
+  rec->u32_Data = u32_Data;
+  rec->u32_Crc = Srvc_CalcCRC32(0, (const uint8_t *)rec, JOURNAL_CRC_LEN);
+
+  /* write when the batch reaches the end of a flash page */
+  slot = ((next_slot < JOURNAL_SLOTS) ? next_slot : 1U) + pending_n;
+  if ((slot % JOURNAL_BATCH) == 0U) {
+    ok = Journal_FlushLocked();
+  } else if (pending_n == 1U) {
+    (void)xTimerReset(flush_timer, 0);
+  } else {
+    /* batch keeps growing */
+  }
+  (void)xSemaphoreGive(lock);
+  return ok;
+}
+
+/**
+ * @brief Write the records held in RAM, also used before sleep or power
+ *        off. Blocks, not for timer callbacks.
+ * @return false if a flash operation failed, the records stay in RAM
+ */
+bool Journal_Flush(void)
+{
+  bool ok;
+
+  if (Boot_IsReady(&journal_drv) == false) {
+    return true;   // nothing appended yet
+  }
+  if (port_ok == false) {
+    return false;
+  }
+  (void)xSemaphoreTake(lock, portMAX_DELAY);
+  ok = Journal_FlushLocked();
+  (void)xSemaphoreGive(lock);
+  return ok;
+}
+
+/**
+ * @brief Position an iterator on the first record at or after a time. The
+ *        sector is found by binary search over the index, the record by
+ *        binary search inside the sector.
+ * @param pst_It : iterator
+ * @param u32_From : time
+ */
+void Journal_Seek(Journal_Iter_t *pst_It, uint32_t u32_From)
+{
+  uint32_t lo = 0U;
+  uint32_t hi;
+
+  Boot_Use(&journal_drv);
+  (void)xSemaphoreTake(lock, portMAX_DELAY);
+  hi = used;
+  const uint32_t oldest = (used > 0U) ? (sector_idx[head].u32_Seq - (used - 1U)) : 1U;
+
+  /* last sector starting at or before u32_From */
+  while (lo < hi) {
+    const uint32_t mid = (lo + hi) / 2U;
+    if (sector_idx[Journal_SectorOf(oldest + mid)].u32_First <= u32_From) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+  pst_It->u32_Seq = oldest + ((lo > 0U) ? (lo - 1U) : 0U);
+  pst_It->u32_Slot = 1U;
+
+  if (used > 0U) {
+    const uint32_t sector = Journal_SectorOf(pst_It->u32_Seq);
+    uint32_t end = Journal_EndOf(pst_It->u32_Seq);
+    Journal_Rec_t rec;
+
+    lo = 1U;
+    hi = end;
+    while (lo < hi) {
+      const uint32_t mid = (lo + hi) / 2U;
+      uint32_t valid = mid;
+      while ((valid < hi) && (Journal_ReadRec(sector, valid, &rec) == false)) {
+        valid++;
+      }
+      if (valid == hi) {
+        hi = mid;
+      } else if (rec.u32_Time < u32_From) {
+        lo = valid + 1U;
+      } else {
+        hi = mid;
+      }
+    }
+    pst_It->u32_Slot = lo;
+  }
+
+  /* past the flash records: skip older ones of the RAM batch */
+  if ((used == 0U) || ((pst_It->u32_Seq == sector_idx[head].u32_Seq) && (pst_It->u32_Slot >= next_slot))) {
+    pst_It->u32_Seq = (used > 0U) ? sector_idx[head].u32_Seq : 1U;
+    pst_It->u32_Slot = next_slot;
+    for (uint32_t i = 0; (i < pending_n) && (pending[i].u32_Time < u32_From); i++) {
+      pst_It->u32_Slot++;
+    }
+  }
+  (void)xSemaphoreGive(lock);
+}
+
+/**
+ * @brief Read the next record, records in RAM follow the ones in flash
+ * @param pst_It : iterator from Journal_Seek
+ * @param pst_Rec : record read
+ * @return false at the end of the journal
+ */
+bool Journal_Next(Journal_Iter_t *pst_It, Journal_Rec_t *pst_Rec)
+{
+  bool found = false;
+
+  Boot_Use(&journal_drv);
+  (void)xSemaphoreTake(lock, portMAX_DELAY);
+  const uint32_t head_seq = (used > 0U) ? sector_idx[head].u32_Seq : 0U;
+  const uint32_t oldest = head_seq - ((used > 0U) ? (used - 1U) : 0U);
+
+  while (found == false) {
+    if (pst_It->u32_Slot >= JOURNAL_SLOTS) {
+      /* positions past a sector end continue in the next one */
+      pst_It->u32_Slot = 1U + (pst_It->u32_Slot - JOURNAL_SLOTS);
+      pst_It->u32_Seq++;
+      continue;
+    }
+    if ((used > 0U) && (pst_It->u32_Seq < oldest)) {
+      /* the sector was reclaimed meanwhile */
+      pst_It->u32_Seq = oldest;
+      pst_It->u32_Slot = 1U;
+    }
+    if ((used == 0U) || (pst_It->u32_Seq > head_seq) ||
+        ((pst_It->u32_Seq == head_seq) && (pst_It->u32_Slot >= next_slot))) {
+      /* RAM batch, it continues the flash at next_slot of the head sector */
+      const uint32_t base = (used == 0U) ? 1U : head_seq;
+      const uint32_t start = (next_slot < JOURNAL_SLOTS) ? next_slot : JOURNAL_SLOTS;
+      const uint32_t v = ((pst_It->u32_Seq - base) * (JOURNAL_SLOTS - 1U)) + pst_It->u32_Slot - start;
+      if (v < pending_n) {
+        *pst_Rec = pending[v];
+        pst_It->u32_Slot++;
+        found = true;
+      }
+      break;
+    }
+    found = Journal_ReadRec(Journal_SectorOf(pst_It->u32_Seq), pst_It->u32_Slot, pst_Rec);
+    pst_It->u32_Slot++;
+  }
+  (void)xSemaphoreGive(lock);
+  return found;
+}
+
+/**
+ * @brief Erase the oldest sectors whose records are all older than a time.
+ *        The sector being written is never erased.
+ * @param u32_Before : time
+ * @return sectors erased
+ */
+uint32_t Journal_Trim(uint32_t u32_Before)
+{
+  uint32_t erased = 0;
+
+  Boot_Use(&journal_drv);
+  if (port_ok == false) {
+    return 0;
+  }
+  (void)xSemaphoreTake(lock, portMAX_DELAY);
+  while (used > 1U) {
+    const uint32_t oldest = Journal_SectorOf(sector_idx[head].u32_Seq - (used - 1U));
+    const uint32_t next = (oldest + 1U) % sectors;
+    if (sector_idx[next].u32_First >= u32_Before) {
+      break;
+    }
+    (void)FlashPort_Erase(&port, oldest * FLASH_PORT_SECTOR_SIZE, FLASH_PORT_SECTOR_SIZE);
+    sector_idx[oldest].u32_Seq = 0;
+    used--;
+    erased++;
+  }
+  (void)xSemaphoreGive(lock);
+  return erased;
+}
+
+/**
+ * @brief Encode records from an iterator into one compressed block, for the
+ *        history transfer. Times are delta-of-delta coded, every record has
+ *        JOURNAL_EXPORT_VALS values, see timeseries_library.
+ * @param pst_It : iterator from Journal_Seek, left on the first record not exported
+ * @param pu8_Buf : block
+ * @param u16_Size : block size
+ * @return bytes used in the block, 0 if there was no record left
+ */
+uint16_t Journal_Export(Journal_Iter_t *pst_It, uint8_t *pu8_Buf, uint16_t u16_Size)
+{
+  Srvc_TsEnc_t enc;
+  Journal_Iter_t at = *pst_It;
+  Journal_Rec_t rec;
+
+  Srvc_TsEncInit(&enc, pu8_Buf, u16_Size, JOURNAL_EXPORT_VALS);
+  while (Journal_Next(&at, &rec)) {
+    const uint32_t val[JOURNAL_EXPORT_VALS] = { ((uint32_t)rec.u16_Type << 16) | rec.u16_Arg, rec.u32_Data };
+    if (Srvc_TsEncPut(&enc, rec.u32_Time, val) == false) {
+      break;
+    }
+    *pst_It = at;
+  }
+  return (enc.u16_Count > 0U) ? Srvc_TsEncFinish(&enc) : 0U;
+}
+
+/**
+ * @brief Sectors erased since boot, for wear checks
+ * @return count
+ */
+uint32_t Journal_GetErases(void)
+{
+  return port.u32_Erases;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief journal initialization, run by the first journal use. Reads the
+ *        sector headers, finds the newest sector and looks for the end of the
+ *        records in that sector only. A record torn by a power failure fails
+ *        its CRC and is skipped. Without a usable partition port_ok stays false.
+ *
+ */
+static void Journal_Start(void)
+{
+  Journal_Hdr_t hdr;
+  uint32_t newest = JOURNAL_MAX_SECTORS;
+
+  lock = xSemaphoreCreateMutex();
+  flush_timer = xTimerCreate("journal", pdMS_TO_TICKS(JOURNAL_FLUSH_MS), pdFALSE, NULL, Journal_FlushExpired);
+  assert(lock && flush_timer);
+
+  port_ok = FlashPort_Open(&port, JOURNAL_PARTITION);
+  sectors = port.u32_Size / FLASH_PORT_SECTOR_SIZE;
+  if (sectors > JOURNAL_MAX_SECTORS) {
+    sectors = JOURNAL_MAX_SECTORS;
+  }
+  if ((port_ok == false) || (sectors < 2U)) {
+    ESP_LOGW(TAG, "no journal partition\n");
+    port_ok = false;
+    return;
+  }
+
+  for (uint32_t s = 0; s < sectors; s++) {
+    sector_idx[s].u32_Seq = 0;
+    if (FlashPort_Read(&port, s * FLASH_PORT_SECTOR_SIZE, &hdr, sizeof(hdr)) &&
+        (hdr.u32_Magic == JOURNAL_MAGIC) && (hdr.u32_Seq != 0U) &&
+        (hdr.u32_Crc == Srvc_CalcCRC32(0, (const uint8_t *)&hdr, JOURNAL_CRC_LEN))) {
+      sector_idx[s].u32_Seq = hdr.u32_Seq;
+      sector_idx[s].u32_First = hdr.u32_First;
+      if ((newest == JOURNAL_MAX_SECTORS) || (hdr.u32_Seq > sector_idx[newest].u32_Seq)) {
+        newest = s;
+      }
+    }
+  }
+
+  if (newest == JOURNAL_MAX_SECTORS) {
+    head = sectors - 1U;   // the first record opens sector 0
+    used = 0;
+    next_slot = JOURNAL_SLOTS;
+    return;
+  }
+
+  /* the journal is the run of consecutive sequence numbers ending at the
+   * newest sector, anything else is left over and gets erased when reached */
+  head = newest;
+  used = 1;
+  while (used < sectors) {
+    const uint32_t s = (head + sectors - used) % sectors;
+    if (sector_idx[s].u32_Seq != (sector_idx[head].u32_Seq - used)) {
+      break;
+    }
+    used++;
+  }
+  for (uint32_t k = used; k < sectors; k++) {
+    sector_idx[(head + sectors - k) % sectors].u32_Seq = 0;
+  }
+
+  /* records fill a sector front to back, binary search for the first erased slot */
+  uint32_t lo = 1U;
+  uint32_t hi = JOURNAL_SLOTS;
+  while (lo < hi) {
+    const uint32_t mid = (lo + hi) / 2U;
+    if (Journal_IsErased(head, mid)) {
+      hi = mid;
+    } else {
+      lo = mid + 1U;
+    }
+  }
+  next_slot = lo;
+
+  last_time = sector_idx[head].u32_First;
+  for (uint32_t slot = next_slot; slot > 1U; slot--) {
+    Journal_Rec_t rec;
+    if (Journal_ReadRec(head, slot - 1U, &rec)) {
+      last_time = rec.u32_Time;
+      break;
+    }
+  }
+  ESP_LOGI(TAG, "%lu sectors, head %lu slot %lu\n", (unsigned long)used, (unsigned long)head, (unsigned long)next_slot);
+}
+
+/**
+ * @brief Write the RAM batch, opening new sectors as needed. A new sector
+ *        reuses the oldest one once the ring is full.
+ * @return false if a flash operation failed
+ */
+static bool Journal_FlushLocked(void)
+{
+  uint32_t done = 0;
+
+  while (done < pending_n) {
+    if (next_slot >= JOURNAL_SLOTS) {
+      const uint32_t s = (head + 1U) % sectors;
+      Journal_Hdr_t hdr;
+
+      hdr.u32_Magic = JOURNAL_MAGIC;
+      hdr.u32_Seq = (used > 0U) ? (sector_idx[head].u32_Seq + 1U) : 1U;
+      hdr.u32_First = pending[done].u32_Time;
+      hdr.u32_Crc = Srvc_CalcCRC32(0, (const uint8_t *)&hdr, JOURNAL_CRC_LEN);
+      if (sector_idx[s].u32_Seq != 0U) {
+        used--;   // the oldest sector is reclaimed
+      }
+      sector_idx[s].u32_Seq = 0;
+      if ((FlashPort_Erase(&port, s * FLASH_PORT_SECTOR_SIZE, FLASH_PORT_SECTOR_SIZE) == false) ||
+          (FlashPort_Write(&port, s * FLASH_PORT_SECTOR_SIZE, &hdr, sizeof(hdr)) == false)) {
+        break;
+      }
+      sector_idx[s].u32_Seq = hdr.u32_Seq;
+      sector_idx[s].u32_First = hdr.u32_First;
+      head = s;
+      used++;
+      next_slot = 1U;
+    }
+
+    uint32_t n = pending_n - done;
+    if (n > (JOURNAL_SLOTS - next_slot)) {
+      n = JOURNAL_SLOTS - next_slot;
+    }
+    if (FlashPort_Write(&port, (head * FLASH_PORT_SECTOR_SIZE) + (next_slot * JOURNAL_REC_SIZE),
+                        &pending[done], n * JOURNAL_REC_SIZE) == false) {
+      break;
+    }
+    next_slot += n;
+    done += n;
+  }
+
+  if (done > 0U) {
+    pending_n -= done;
+    (void)memmove(&pending[0], &pending[done], pending_n * sizeof(Journal_Rec_t));
+  }
+  if (pending_n == 0U) {
+    (void)xTimerStop(flush_timer, 0);
+  } else {
+    ESP_LOGE(TAG, "flush failed\n");
+  }
+  return pending_n == 0U;
+}
+
+/**
+ * @brief Read one record slot and check its CRC
+ * @param u32_Sector : sector
+ * @param u32_Slot : slot 1..JOURNAL_SLOTS-1
+ * @param pst_Rec : record read
+ * @return true if the slot holds a valid record
+ */
+static bool Journal_ReadRec(uint32_t u32_Sector, uint32_t u32_Slot, Journal_Rec_t *pst_Rec)
+{
+  return FlashPort_Read(&port, (u32_Sector * FLASH_PORT_SECTOR_SIZE) + (u32_Slot * JOURNAL_REC_SIZE),
+                        pst_Rec, sizeof(*pst_Rec)) &&
+         (pst_Rec->u32_Crc == Srvc_CalcCRC32(0, (const uint8_t *)pst_Rec, JOURNAL_CRC_LEN));
+}
+
+/**
+ * @brief Check if a record slot was never written
+ * @param u32_Sector : sector
+ * @param u32_Slot : slot
+ * @return true if all bytes are 0xFF
+ */
+static bool Journal_IsErased(uint32_t u32_Sector, uint32_t u32_Slot)
+{
+  uint32_t words[JOURNAL_REC_SIZE / 4U];
+
+  if (FlashPort_Read(&port, (u32_Sector * FLASH_PORT_SECTOR_SIZE) + (u32_Slot * JOURNAL_REC_SIZE),
+                     words, sizeof(words)) == false) {
+    return false;
+  }
+  return (words[0] & words[1] & words[2] & words[3]) == 0xFFFFFFFFUL;
+}
+
+/**
+ * @brief Sector holding a sequence number of the journal
+ * @param u32_Seq : sequence number between the oldest and the head
+ * @return sector
+ */
+static uint32_t Journal_SectorOf(uint32_t u32_Seq)
+{
+  return (head + sectors - ((sector_idx[head].u32_Seq - u32_Seq) % sectors)) % sectors;
+}
+
+/**
+ * @brief First slot after the records of a sector
+ * @param u32_Seq : sequence number of the sector
+ * @return slot
+ */
+static uint32_t Journal_EndOf(uint32_t u32_Seq)
+{
+  return (u32_Seq == sector_idx[head].u32_Seq) ? next_slot : JOURNAL_SLOTS;
+}
+
+/**
+ * @brief Batch waited JOURNAL_FLUSH_MS, timer callback. The flush takes the
+ *        lock and may erase a sector, it runs in Storage_task instead of the
+ *        timer daemon. A full job queue tries again JOURNAL_FLUSH_MS later.
+ * @param timer
+ */
+static void Journal_FlushExpired(TimerHandle_t timer)
+{
+  if (Storage_Pend(Journal_FlushJob) == false) {
+    (void)xTimerReset(timer, 0);
+  }
+}
+
+/**
+ * @brief Deferred flush, runs in Storage_task
+ */
+static void Journal_FlushJob(void)
+{
+  (void)Journal_Flush();
+}
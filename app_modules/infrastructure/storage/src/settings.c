@@ -0,0 +1,280 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : settings
+ *  Description        : persistent settings. Changes only touch the RAM
+ *                       shadow and a dirty mask, a burst of changes ends in
+ *                       one commit that writes the whole set to the older
+ *                       of two flash sectors.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "extended_services.h"
+#include "flash_port.h"
+#include "settings.h"
+#include "storage.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define SETTINGS_MAGIC            0x54455346UL  // "FSET"
+#define SETTINGS_SLOTS            2U
+#define SETTINGS_STORE_MAX        64U           // most values a record can hold
+
+/* record at the start of each slot, 32 bit words:
+ * magic, sequence (higher is newer, wraps), value count, values, CRC-32 of
+ * all words before. Records of other firmware versions may hold fewer or
+ * more values than SETTINGS_MAX. */
+#define SETTINGS_REC_HDR          3U
+#define SETTINGS_REC_WORDS(n)     (SETTINGS_REC_HDR + (n) + 1U)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef uint32_t Settings_Record_t[SETTINGS_REC_WORDS(SETTINGS_STORE_MAX)];
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Settings_Load(uint32_t u32_Slot, Settings_Record_t au32_Rec);
+static void Settings_QuietExpired(TimerHandle_t timer);
+static void Settings_CommitJob(void);
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+const static char *TAG = "settings";
+
+static const int32_t settings_default[SETTINGS_MAX] = {
+  [SETTINGS_DRINK_TIMER_S] = 3600,
+  [SETTINGS_PLACE_TIMER_S] = 300,
+  [SETTINGS_CLEAN_TIMER_S] = 86400,
+};
+
+static portMUX_TYPE settings_lock = portMUX_INITIALIZER_UNLOCKED;
+static int32_t shadow[SETTINGS_MAX];
+static uint32_t dirty = 0;              // bit per Settings_Id_t changed since the last commit
+static TickType_t dirty_since = 0;      // tick of the first change of the current burst
+static FlashPort_t port;
+static bool port_ok = false;
+static uint32_t next_slot = 0;          // slot the next commit goes to
+static uint32_t seq = 0;                // sequence of the newest stored record
+static uint32_t commits = 0;
+static TimerHandle_t quiet_timer = NULL;
+static SemaphoreHandle_t commit_lock = NULL;  // one commit at a time, held across the flash write
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief settings initialization function, loads the newest valid record.
+ *        Values it does not hold keep their defaults.
+ *
+ */
+void Settings_Init(void)
+{
+  static Settings_Record_t rec[SETTINGS_SLOTS];
+  uint32_t count[SETTINGS_SLOTS];
+  int32_t newest = -1;
+
+  (void)memcpy(shadow, settings_default, sizeof(shadow));
+  quiet_timer = xTimerCreate("settings", pdMS_TO_TICKS(SETTINGS_QUIET_MS), pdFALSE, NULL, Settings_QuietExpired);
+  commit_lock = xSemaphoreCreateMutex();
+  assert(quiet_timer && commit_lock);
+
+  port_ok = FlashPort_Open(&port, SETTINGS_PARTITION) &&
+            (port.u32_Size >= (SETTINGS_SLOTS * FLASH_PORT_SECTOR_SIZE));
+  if (port_ok == false) {
+    ESP_LOGW(TAG, "no settings partition, defaults only\n");
+    return;
+  }
+
+  for (uint32_t i = 0; i < SETTINGS_SLOTS; i++) {
+    count[i] = Settings_Load(i, rec[i]);
+    if ((count[i] != 0U) && ((newest < 0) || ((int32_t)(rec[i][1] - rec[newest][1]) > 0))) {
+      newest = (int32_t)i;
+    }
+  }
+
+  if (newest >= 0) {
+    const uint32_t n = (count[newest] < SETTINGS_MAX) ? count[newest] : (uint32_t)SETTINGS_MAX;
+    (void)memcpy(shadow, &rec[newest][SETTINGS_REC_HDR], n * sizeof(int32_t));
+    seq = rec[newest][1];
+    next_slot = ((uint32_t)newest + 1U) % SETTINGS_SLOTS;
+    ESP_LOGI(TAG, "loaded slot %ld seq %lu\n", (long)newest, (unsigned long)seq);
+  }
+}
+
+/**
+ * @brief Read a setting, from RAM only
+ * @param e_Id : setting
+ * @return value
+ */
+int32_t Settings_Get(Settings_Id_t e_Id)
+{
+  return (e_Id < SETTINGS_MAX) ? shadow[e_Id] : 0;
+}
+
+/**
+ * @brief Change a setting. The flash write is deferred until no change came
+ *        for SETTINGS_QUIET_MS, or SETTINGS_MAX_DEFER_MS after the first
+ *        change of a burst, whichever is first. Unchanged values cost nothing.
+ * @param e_Id : setting
+ * @param s32_Value : new value
+ */
+void Settings_Set(Settings_Id_t e_Id, int32_t s32_Value)
+{
+  bool overdue;
+
+  if ((e_Id >= SETTINGS_MAX) || (shadow[e_Id] == s32_Value)) {
+    return;
+  }
+
+  taskENTER_CRITICAL(&settings_lock);
+  if (dirty == 0U) {
+    dirty_since = xTaskGetTickCount();
+  }
+  shadow[e_Id] = s32_Value;
+  dirty |= 1UL << e_Id;
+  overdue = (xTaskGetTickCount() - dirty_since) >= pdMS_TO_TICKS(SETTINGS_MAX_DEFER_MS);
+  taskEXIT_CRITICAL(&settings_lock);
+
+  /* (re)starts the timer, a burst keeps pushing the commit out */
+  (void)xTimerChangePeriod(quiet_timer, overdue ? 1U : pdMS_TO_TICKS(SETTINGS_QUIET_MS), portMAX_DELAY);
+}
+
+/**
+ * @brief Write pending changes now, also used before sleep or power off.
+ *        One sector erase and one write per commit, the other sector keeps
+ *        the previous set until the new one is complete. A commit already
+ *        running in another task, e.g. the deferred one in Storage_task, is
+ *        waited for, so a true return means the set is in flash. Blocks,
+ *        not for timer callbacks.
+ * @return false if the write failed, the changes stay pending
+ */
+bool Settings_Commit(void)
+{
+  uint32_t rec[SETTINGS_REC_WORDS(SETTINGS_MAX)];
+  uint32_t offset;
+  uint32_t pending;
+  bool ok;
+
+  (void)xSemaphoreTake(commit_lock, portMAX_DELAY);
+  taskENTER_CRITICAL(&settings_lock);
+  pending = dirty;
+  dirty = 0;
+  (void)memcpy(&rec[SETTINGS_REC_HDR], shadow, sizeof(shadow));
+  taskEXIT_CRITICAL(&settings_lock);
+
+  if ((pending == 0U) || (port_ok == false)) {
+    (void)xSemaphoreGive(commit_lock);
+    return pending == 0U;
+  }
+  (void)xTimerStop(quiet_timer, 0);
+
+  offset = next_slot * FLASH_PORT_SECTOR_SIZE;
+
+  rec[0] = SETTINGS_MAGIC;
+  rec[1] = seq + 1U;
+  rec[2] = SETTINGS_MAX;
+  rec[SETTINGS_REC_HDR + SETTINGS_MAX] = Srvc_CalcCRC32(0, (const uint8_t *)rec, (SETTINGS_REC_HDR + SETTINGS_MAX) * 4U);
+
+  ok = FlashPort_Erase(&port, offset, FLASH_PORT_SECTOR_SIZE) &&
+       FlashPort_Write(&port, offset, rec, sizeof(rec));
+  if (ok != false) {
+    seq = rec[1];
+    next_slot = (next_slot + 1U) % SETTINGS_SLOTS;
+    commits++;
+  } else {
+    taskENTER_CRITICAL(&settings_lock);
+    if (dirty == 0U) {
+      dirty_since = xTaskGetTickCount();
+    }
+    dirty |= pending;
+    taskEXIT_CRITICAL(&settings_lock);
+    ESP_LOGE(TAG, "commit failed\n");
+  }
+  (void)xSemaphoreGive(commit_lock);
+  return ok;
+}
+
+/**
+ * @brief Number of commits written since Settings_Init
+ * @return count
+ */
+uint32_t Settings_GetCommits(void)
+{
+  return commits;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Read and check one slot
+ * @param u32_Slot : slot
+ * @param au32_Rec : record read
+ * @return number of values, 0 if the slot holds no complete record
+ */
+static uint32_t Settings_Load(uint32_t u32_Slot, Settings_Record_t au32_Rec)
+{
+  const uint32_t offset = u32_Slot * FLASH_PORT_SECTOR_SIZE;
+  uint32_t n;
+
+  if ((FlashPort_Read(&port, offset, au32_Rec, SETTINGS_REC_HDR * 4U) == false) ||
+      (au32_Rec[0] != SETTINGS_MAGIC) || (au32_Rec[2] == 0U) || (au32_Rec[2] > SETTINGS_STORE_MAX)) {
+    return 0;
+  }
+  n = au32_Rec[2];
+  if ((FlashPort_Read(&port, offset + (SETTINGS_REC_HDR * 4U), &au32_Rec[SETTINGS_REC_HDR], (n + 1U) * 4U) == false) ||
+      (au32_Rec[SETTINGS_REC_HDR + n] != Srvc_CalcCRC32(0, (const uint8_t *)au32_Rec, (SETTINGS_REC_HDR + n) * 4U))) {
+    return 0;
+  }
+  return n;
+}
+
+/**
+ * @brief Quiet period over, timer callback. The commit erases a sector and
+ *        waits for commit_lock, it runs in Storage_task instead of the
+ *        timer daemon. A full job queue tries again a quiet period later.
+ * @param timer
+ */
+static void Settings_QuietExpired(TimerHandle_t timer)
+{
+  if (Storage_Pend(Settings_CommitJob) == false) {
+    (void)xTimerReset(timer, 0);
+  }
+}
+
+/**
+ * @brief Deferred commit, runs in Storage_task
+ */
+static void Settings_CommitJob(void)
+{
+  (void)Settings_Commit();
+}
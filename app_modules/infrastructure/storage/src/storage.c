@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : storage
+ *  Description        : storage worker task. Timer callbacks run in the
+ *                       FreeRTOS timer daemon next to the 10 ms IR poll and
+ *                       must not block, so a deferred commit or flush only
+ *                       queues a job here and the erase and write run in
+ *                       Storage_task.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "storage.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+
+/******************************************************************************/
+/* EXTERN VARIABLE DEFINTIONS                                                 */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static QueueHandle_t jobs = NULL;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+/**
+ * @brief storage initialization function, call before the modules that
+ *        pend jobs are initialized
+ *
+ */
+void Storage_Init(void)
+{
+  if (jobs == NULL) {
+    jobs = xQueueCreate(STORAGE_JOBS, sizeof(Storage_Job_t));
+    assert(jobs);
+  }
+}
+
+/**
+ * @brief Queue a job for Storage_task, never waits, so timer callbacks can
+ *        use it
+ * @param pf_Job : job
+ * @return false if the queue is full, the caller has to try again later
+ */
+bool Storage_Pend(Storage_Job_t pf_Job)
+{
+  return xQueueSend(jobs, &pf_Job, 0) == pdTRUE;
+}
+
+/**
+ * @brief Low priority task, runs the queued jobs one after the other
+ * @param param
+ */
+void Storage_task(void *param)
+{
+  Storage_Job_t pf_Job;
+
+  (void)param;
+  while (1) {
+    if (xQueueReceive(jobs, &pf_Job, portMAX_DELAY) == pdTRUE) {
+      pf_Job();
+    }
+  }
+  vTaskDelete(NULL);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
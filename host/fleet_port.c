@@ -0,0 +1,657 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : fleet_port
+ *  Description        : what syssm.c, ir_switch.c and led.c call, for many
+ *                       devices in one process. The kernel runs the timer
+ *                       task and the state machine task of a device one
+ *                       after the other on the virtual clock of the device,
+ *                       the device is the one Fleet_Run selected on the
+ *                       calling thread. Settings, journal, audio and the
+ *                       RTC memory are stand-ins inside the device.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include "driver/gpio.h"
+#include "freertos/task.h"
+#include "boot.h"
+#include "dlog.h"
+#include "fleet_port.h"
+#include "input_trace.h"
+#include "period.h"
+#include "pin_config.h"
+#include "resume.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define FLEET_TICK_US              (1000000U / configTICK_RATE_HZ)
+#define FLEET_FNV_PRIME            16777619U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Fleet_Settle(Fleet_Dev_t *pst_Dev);
+static uint64_t Fleet_NextTimer(const Fleet_Dev_t *pst_Dev, Fleet_Timer_t **ppst_Timer);
+static void Fleet_Fire(Fleet_Timer_t *pst_Timer);
+static void Fleet_Level(Fleet_Dev_t *pst_Dev);
+static void Fleet_IrWoken(void *pv_Dev, uint32_t u32_Arg);
+static void Fleet_Hash(Fleet_Dev_t *pst_Dev, uint32_t u32_Word);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static __thread Fleet_Dev_t *fleet_cur = NULL;   // device of the calling worker
+
+/* the defaults of settings.c, a new device has a blank settings partition */
+static const int32_t fleet_settings_default[SETTINGS_MAX] = {
+  [SETTINGS_DRINK_TIMER_S] = 3600,
+  [SETTINGS_PLACE_TIMER_S] = 300,
+  [SETTINGS_CLEAN_TIMER_S] = 86400,
+};
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief A device out of the box: blank RTC memory and settings, no bottle,
+ *        not powered yet
+ * @param pst_Dev : device
+ */
+void Fleet_Init(Fleet_Dev_t *pst_Dev)
+{
+  (void)memset(pst_Dev, 0, sizeof(*pst_Dev));
+  (void)memcpy(pst_Dev->as32_Settings, fleet_settings_default, sizeof(pst_Dev->as32_Settings));
+  pst_Dev->u32_IrLevel = 1U;
+  pst_Dev->u64_InputUs = FLEET_NEVER;
+  pst_Dev->u32_Digest = 2166136261U;
+}
+
+/**
+ * @brief Power on or wake from deep sleep: the RAM is lost, the state
+ *        machine starts again and resumes from the RTC memory if it can
+ * @param pst_Dev : device
+ */
+void Fleet_Boot(Fleet_Dev_t *pst_Dev)
+{
+  Fleet_Dev_t *const prev = fleet_cur;
+
+  fleet_cur = pst_Dev;
+  if (pst_Dev->b_Asleep != false) {
+    pst_Dev->u64_DeepUs += pst_Dev->u64_NowUs - pst_Dev->u64_SinceUs;
+    pst_Dev->b_Asleep = false;
+  }
+  pst_Dev->u32_Timers = 0;
+  pst_Dev->b_QueueUsed = false;
+  pst_Dev->u32_PendHead = 0;
+  pst_Dev->u32_PendCount = 0;
+  pst_Dev->u32_HoldMask = 0;
+  pst_Dev->b_IrArmed = false;
+  pst_Dev->b_Light = false;
+  pst_Dev->u64_WokenUs = 0;
+  (void)memset(&pst_Dev->st_Sm, 0, sizeof(pst_Dev->st_Sm));
+  SysSm_Setup(&pst_Dev->st_Sm);
+  fleet_cur = prev;
+}
+
+/**
+ * @brief Run a device up to a time. Pended calls and queued events are
+ *        handled at once, then the clock jumps to the next user input,
+ *        timer expiry or deep sleep wakeup; inputs first at the same time.
+ * @param pst_Dev : device
+ * @param u64_UntilUs : end of the slice on the device clock
+ */
+void Fleet_Run(Fleet_Dev_t *pst_Dev, uint64_t u64_UntilUs)
+{
+  fleet_cur = pst_Dev;
+  while (1) {
+    Fleet_Timer_t *timer = NULL;
+
+    Fleet_Settle(pst_Dev);
+    const uint64_t due = (pst_Dev->b_Asleep != false) ? pst_Dev->u64_WakeUs : Fleet_NextTimer(pst_Dev, &timer);
+
+    if ((pst_Dev->u64_InputUs <= due) && (pst_Dev->u64_InputUs <= u64_UntilUs)) {
+      pst_Dev->u64_NowUs = pst_Dev->u64_InputUs;
+      Fleet_Input(pst_Dev);
+      Fleet_Level(pst_Dev);
+    } else if (due <= u64_UntilUs) {
+      pst_Dev->u64_NowUs = due;
+      if (pst_Dev->b_Asleep != false) {
+        Fleet_Boot(pst_Dev);
+      } else {
+        Fleet_Fire(timer);
+      }
+    } else {
+      pst_Dev->u64_NowUs = u64_UntilUs;
+      break;
+    }
+  }
+  fleet_cur = NULL;
+}
+
+/* kernel of the selected device. Nothing blocks: the timer task and the
+ * state machine task of a device never run at the same time, a full queue
+ * fails at once. */
+
+uint64_t Sim_NowUs(void)
+{
+  return (fleet_cur != NULL) ? fleet_cur->u64_NowUs : 0U;
+}
+
+/**
+ * @brief Wall clock of the device, replaces the C library time() like
+ *        sim_rtos.c does
+ * @param pt_Time : also set when not NULL
+ * @return seconds since the epoch
+ */
+time_t time(time_t *pt_Time)
+{
+  const time_t now = (time_t)FLEET_EPOCH + (time_t)(Sim_NowUs() / 1000000U);
+
+  if (pt_Time != NULL) {
+    *pt_Time = now;
+  }
+  return now;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+  return (TickType_t)(Sim_NowUs() / FLEET_TICK_US);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t u32_Len, UBaseType_t u32_ItemSize)
+{
+  Fleet_Queue_t *queue = &fleet_cur->st_Queue;
+
+  if ((fleet_cur->b_QueueUsed != false) || ((u32_Len * u32_ItemSize) > FLEET_QUEUE_BYTES)) {
+    return NULL;
+  }
+  fleet_cur->b_QueueUsed = true;
+  queue->u32_Len = u32_Len;
+  queue->u32_ItemSize = u32_ItemSize;
+  queue->u32_Head = 0;
+  queue->u32_Count = 0;
+  return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t x_Queue, const void *pv_Item, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  if (x_Queue->u32_Count == x_Queue->u32_Len) {
+    return pdFALSE;
+  }
+  const uint32_t slot = (x_Queue->u32_Head + x_Queue->u32_Count) % x_Queue->u32_Len;
+  (void)memcpy(&x_Queue->au8_Buf[slot * x_Queue->u32_ItemSize], pv_Item, x_Queue->u32_ItemSize);
+  x_Queue->u32_Count++;
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t x_Queue, void *pv_Item, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  if (x_Queue->u32_Count == 0U) {
+    return pdFALSE;
+  }
+  (void)memcpy(pv_Item, &x_Queue->au8_Buf[x_Queue->u32_Head * x_Queue->u32_ItemSize], x_Queue->u32_ItemSize);
+  x_Queue->u32_Head = (x_Queue->u32_Head + 1U) % x_Queue->u32_Len;
+  x_Queue->u32_Count--;
+  return pdTRUE;
+}
+
+TimerHandle_t xTimerCreate(const char *pc_Name, TickType_t x_Period, BaseType_t x_AutoReload, void *pv_Id,
+                           TimerCallbackFunction_t pf_Callback)
+{
+  (void)pc_Name;
+  if (fleet_cur->u32_Timers == FLEET_TIMERS) {
+    return NULL;
+  }
+  Fleet_Timer_t *timer = &fleet_cur->ast_Timer[fleet_cur->u32_Timers++];
+  timer->x_Period = x_Period;
+  timer->x_Expiry = 0;
+  timer->b_Reload = (x_AutoReload != pdFALSE);
+  timer->b_Active = false;
+  timer->pv_Id = pv_Id;
+  timer->pf_Callback = pf_Callback;
+  return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  x_Timer->x_Expiry = xTaskGetTickCount() + x_Timer->x_Period;
+  x_Timer->b_Active = true;
+  return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  x_Timer->b_Active = false;
+  return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  return xTimerStart(x_Timer, x_Wait);
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t x_Timer, TickType_t x_Period, TickType_t x_Wait)
+{
+  x_Timer->x_Period = x_Period;
+  return xTimerStart(x_Timer, x_Wait);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t x_Timer)
+{
+  return (x_Timer->b_Active != false) ? pdTRUE : pdFALSE;
+}
+
+TickType_t xTimerGetExpiryTime(TimerHandle_t x_Timer)
+{
+  return x_Timer->x_Expiry;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t x_Timer)
+{
+  return x_Timer->pv_Id;
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t pf_Func, void *pv_Arg, uint32_t u32_Arg, TickType_t x_Wait)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  (void)x_Wait;
+  if (dev->u32_PendCount == FLEET_PEND_LEN) {
+    dev->u32_Dropped++;
+    return pdFAIL;
+  }
+  Fleet_Pend_t *call = &dev->ast_Pend[(dev->u32_PendHead + dev->u32_PendCount) % FLEET_PEND_LEN];
+  call->pf_Func = pf_Func;
+  call->pv_Arg = pv_Arg;
+  call->u32_Arg = u32_Arg;
+  dev->u32_PendCount++;
+  return pdPASS;
+}
+
+/* HAL: the IR switch line is driven by the user model, LED changes are
+ * counted */
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+  (void)gpio_num;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+  (void)gpio_num;
+  (void)mode;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+  (void)gpio_num;
+  (void)pull;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  (void)level;
+  if (gpio_num == ON_BOARD_LED_GPIO) {
+    fleet_cur->u32_LedChanges++;
+  }
+  return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+  return (gpio_num == IR_SWITCH_GPIO) ? (int)fleet_cur->u32_IrLevel : 0;
+}
+
+void InputTrace_Sample(InputTrace_Source_t e_Src, uint32_t u32_Level)
+{
+  (void)e_Src;
+  (void)u32_Level;
+}
+
+/* power: light sleep is the time nothing is held, deep sleep stops the
+ * device until the IR switch or the timer wakes it, see Fleet_Run */
+
+void Power_Hold(Power_Client_t e_Client)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  if (dev->b_Light != false) {
+    dev->u64_LightUs += dev->u64_NowUs - dev->u64_SinceUs;
+    dev->b_Light = false;
+  }
+  dev->u32_HoldMask |= 1UL << e_Client;
+}
+
+void Power_Release(Power_Client_t e_Client)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  dev->u32_HoldMask &= ~(1UL << e_Client);
+  if ((dev->u32_HoldMask == 0U) && (dev->b_Light == false)) {
+    dev->b_Light = true;
+    dev->u64_SinceUs = dev->u64_NowUs;
+  }
+}
+
+/**
+ * @brief Level triggered like the GPIO wakeup, a bottle that is already
+ *        there wakes at once
+ */
+void Power_ArmIrWake(Power_WakeCb_t pf_Wake, void *pv_Arg)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  dev->pf_IrWake = pf_Wake;
+  dev->pv_IrWakeArg = pv_Arg;
+  dev->b_IrArmed = true;
+  Fleet_Level(dev);
+}
+
+void Power_Handled(void)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  if (dev->u64_WokenUs != 0U) {
+    dev->u64_WakeLatUs += dev->u64_NowUs - dev->u64_WokenUs;
+    dev->u32_Wakes++;
+    dev->u64_WokenUs = 0;
+  }
+}
+
+/**
+ * @brief The device stops: its RAM, timers and queue are gone when
+ *        Fleet_Boot wakes it, only the RTC memory and the settings stay
+ * @param u32_WakeMs : timer wakeup, 0: only the IR switch
+ */
+void Power_DeepSleep(uint32_t u32_WakeMs)
+{
+  Fleet_Dev_t *dev = fleet_cur;
+
+  if (dev->b_Light != false) {
+    dev->u64_LightUs += dev->u64_NowUs - dev->u64_SinceUs;
+    dev->b_Light = false;
+  }
+  dev->b_Asleep = true;
+  dev->u64_SinceUs = dev->u64_NowUs;
+  dev->u64_WakeUs = (u32_WakeMs != 0U) ? (dev->u64_NowUs + ((uint64_t)u32_WakeMs * 1000U)) : FLEET_NEVER;
+  dev->u32_DeepSleeps++;
+  dev->u32_PendCount = 0;
+  dev->st_Queue.u32_Count = 0;
+  for (uint32_t i = 0; i < dev->u32_Timers; i++) {
+    dev->ast_Timer[i].b_Active = false;
+  }
+}
+
+void Resume_Save(uint16_t u16_Version, const void *pv_Data, uint16_t u16_Len)
+{
+  assert(u16_Len <= FLEET_RESUME_MAX);
+  (void)memcpy(fleet_cur->au8_Resume, pv_Data, u16_Len);
+  fleet_cur->u16_ResumeVersion = u16_Version;
+  fleet_cur->u16_ResumeLen = u16_Len;
+}
+
+/**
+ * @brief The snapshot is consumed, as in resume.c
+ */
+bool Resume_Load(uint16_t u16_Version, void *pv_Data, uint16_t u16_Len)
+{
+  const bool ok = (fleet_cur->u16_ResumeLen == u16_Len) && (fleet_cur->u16_ResumeVersion == u16_Version);
+
+  if (ok != false) {
+    (void)memcpy(pv_Data, fleet_cur->au8_Resume, u16_Len);
+  }
+  fleet_cur->u16_ResumeLen = 0;
+  return ok;
+}
+
+uint32_t Resume_GetWakeUs(void)
+{
+  return 0;
+}
+
+/* storage: the settings and journal partitions of every device, the
+ * settings in RAM and the journal records handed to the user model */
+
+int32_t Settings_Get(Settings_Id_t e_Id)
+{
+  return (e_Id < SETTINGS_MAX) ? fleet_cur->as32_Settings[e_Id] : 0;
+}
+
+void Settings_Set(Settings_Id_t e_Id, int32_t s32_Value)
+{
+  if (e_Id < SETTINGS_MAX) {
+    fleet_cur->as32_Settings[e_Id] = s32_Value;
+  }
+}
+
+bool Settings_Commit(void)
+{
+  fleet_cur->u32_Commits++;
+  return true;
+}
+
+bool Journal_Append(Journal_Type_t e_Type, uint32_t u32_Time, uint16_t u16_Arg, uint32_t u32_Data)
+{
+  Fleet_Hash(fleet_cur, ((uint32_t)e_Type << 16) | u16_Arg);
+  Fleet_Hash(fleet_cur, u32_Time);
+  Fleet_Hash(fleet_cur, u32_Data);
+  Fleet_Journal(fleet_cur, e_Type, u32_Time);
+  return true;
+}
+
+bool Journal_Flush(void)
+{
+  return true;
+}
+
+/**
+ * @brief Sounds take no time, the model hears them when they start
+ */
+bool Audio_Play(Audio_Sound_t e_Sound)
+{
+  Fleet_Hash(fleet_cur, 0x50000U | (uint32_t)e_Sound);
+  Fleet_Hash(fleet_cur, (uint32_t)(fleet_cur->u64_NowUs / 1000U));
+  Fleet_Sound(fleet_cur, e_Sound);
+  return true;
+}
+
+bool Audio_IsIdle(void)
+{
+  return true;
+}
+
+/* period.c keeps a list of all monitors and the histograms for the
+ * console. The fleet only needs the measured interval of the IR poll. */
+
+void Period_Register(Period_Mon_t *pst_Mon, const char *pc_Name, uint32_t u32_PeriodUs, uint32_t u32_LateUs)
+{
+  (void)memset(pst_Mon, 0, sizeof(*pst_Mon));
+  pst_Mon->pc_Name = pc_Name;
+  pst_Mon->u32_PeriodUs = u32_PeriodUs;
+  pst_Mon->u32_LateUs = u32_LateUs;
+}
+
+/**
+ * @return ms since the last activation, the nominal period after a pause,
+ *         as Period_Begin of period.c
+ */
+uint32_t Period_Begin(Period_Mon_t *pst_Mon)
+{
+  const int64_t now = (int64_t)Sim_NowUs();
+  uint32_t dt_ms = pst_Mon->u32_PeriodUs / 1000U;
+
+  if (pst_Mon->b_Running != false) {
+    if ((uint32_t)(now - pst_Mon->s64_LastUs) > pst_Mon->u32_LateUs) {
+      pst_Mon->u32_Misses++;
+    }
+    dt_ms = (uint32_t)((now / 1000) - (pst_Mon->s64_LastUs / 1000));
+  }
+  pst_Mon->s64_LastUs = now;
+  pst_Mon->b_Running = true;
+  return dt_ms;
+}
+
+void Period_End(Period_Mon_t *pst_Mon)
+{
+  (void)pst_Mon;
+}
+
+void Period_Pause(Period_Mon_t *pst_Mon)
+{
+  pst_Mon->b_Running = false;
+}
+
+/* the log and the boot report are per process, the fleet has neither */
+
+void Dlog_Write(uint32_t u32_Hdr, const uint32_t *pu32_Arg)
+{
+  (void)u32_Hdr;
+  (void)pu32_Arg;
+}
+
+void Dlog_Flush(void)
+{
+}
+
+void Boot_Done(void)
+{
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Run what is ready: the pended calls of the timer task first, it
+ *        has the higher priority, then the events of the state machine
+ * @param pst_Dev : device
+ */
+static void Fleet_Settle(Fleet_Dev_t *pst_Dev)
+{
+  while (pst_Dev->b_Asleep == false) {
+    if (pst_Dev->u32_PendCount > 0U) {
+      const Fleet_Pend_t call = pst_Dev->ast_Pend[pst_Dev->u32_PendHead];
+      pst_Dev->u32_PendHead = (pst_Dev->u32_PendHead + 1U) % FLEET_PEND_LEN;
+      pst_Dev->u32_PendCount--;
+      call.pf_Func(call.pv_Arg, call.u32_Arg);
+    } else if (SysSm_Run(&pst_Dev->st_Sm, 0) == false) {
+      break;
+    } else {
+      /* the next event */
+    }
+  }
+}
+
+/**
+ * @brief Earliest active timer, the first created of those due in the same
+ *        tick
+ * @param pst_Dev : device
+ * @param ppst_Timer : the timer, NULL if none runs
+ * @return expiry in us, FLEET_NEVER if none runs
+ */
+static uint64_t Fleet_NextTimer(const Fleet_Dev_t *pst_Dev, Fleet_Timer_t **ppst_Timer)
+{
+  const Fleet_Timer_t *next = NULL;
+
+  for (uint32_t i = 0; i < pst_Dev->u32_Timers; i++) {
+    const Fleet_Timer_t *timer = &pst_Dev->ast_Timer[i];
+    if ((timer->b_Active != false) && ((next == NULL) || (timer->x_Expiry < next->x_Expiry))) {
+      next = timer;
+    }
+  }
+  *ppst_Timer = (Fleet_Timer_t *)next;
+  return (next != NULL) ? ((uint64_t)next->x_Expiry * FLEET_TICK_US) : FLEET_NEVER;
+}
+
+/**
+ * @brief Expire a timer, in the timer task
+ * @param pst_Timer : timer
+ */
+static void Fleet_Fire(Fleet_Timer_t *pst_Timer)
+{
+  if (pst_Timer->b_Reload != false) {
+    pst_Timer->x_Expiry += (pst_Timer->x_Period > 0U) ? pst_Timer->x_Period : 1U;
+  } else {
+    pst_Timer->b_Active = false;
+  }
+  pst_Timer->pf_Callback(pst_Timer);
+}
+
+/**
+ * @brief A bottle on the switch wakes a device from deep sleep or the IR
+ *        sampling from light sleep
+ * @param pst_Dev : device
+ */
+static void Fleet_Level(Fleet_Dev_t *pst_Dev)
+{
+  if (pst_Dev->u32_IrLevel != 0U) {
+    return;
+  }
+  if (pst_Dev->b_Asleep != false) {
+    Fleet_Boot(pst_Dev);
+    pst_Dev->u64_WokenUs = pst_Dev->u64_NowUs;
+  } else if (pst_Dev->b_IrArmed != false) {
+    pst_Dev->b_IrArmed = false;
+    (void)xTimerPendFunctionCall(Fleet_IrWoken, pst_Dev, 0U, 0U);
+  } else {
+    /* sampled */
+  }
+}
+
+/**
+ * @brief IR wakeup in the timer task, as Power_IrWoken of power.c
+ * @param pv_Dev : device
+ * @param u32_Arg
+ */
+static void Fleet_IrWoken(void *pv_Dev, uint32_t u32_Arg)
+{
+  Fleet_Dev_t *dev = pv_Dev;
+
+  (void)u32_Arg;
+  dev->u64_WokenUs = dev->u64_NowUs;
+  Power_Hold(POWER_CLIENT_SYSSM);
+  if (dev->pf_IrWake != NULL) {
+    dev->pf_IrWake(dev->pv_IrWakeArg);
+  }
+}
+
+/**
+ * @brief Add a word to the digest of the device
+ * @param pst_Dev : device
+ * @param u32_Word : word
+ */
+static void Fleet_Hash(Fleet_Dev_t *pst_Dev, uint32_t u32_Word)
+{
+  for (uint32_t i = 0; i < 4U; i++) {
+    pst_Dev->u32_Digest = (pst_Dev->u32_Digest ^ ((u32_Word >> (8U * i)) & 0xFFU)) * FLEET_FNV_PRIME;
+  }
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : fleet_port
+ *  Description        : one simulated device of the fleet simulator: the
+ *                       kernel, HAL and storage the state machine uses, all
+ *                       in the device, on the virtual clock of the device
+ ******************************************************************************/
+
+#ifndef FLEET_PORT_H
+#define FLEET_PORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "audio.h"
+#include "journal.h"
+#include "power.h"
+#include "settings.h"
+#include "syssm.h"
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define FLEET_TIMERS               8U        // the state machine creates 5
+#define FLEET_QUEUE_BYTES          32U       // the event queue holds 8 one byte events
+#define FLEET_PEND_LEN             8U
+#define FLEET_RESUME_MAX           64U       // RTC memory for the deep sleep snapshot
+#define FLEET_NEVER                UINT64_MAX
+#define FLEET_EPOCH                1748736000   // 2025-06-01 00:00 UTC, time() at 0 us
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef struct Sim_Timer_t
+{
+  TickType_t x_Period;
+  TickType_t x_Expiry;
+  bool b_Reload;
+  bool b_Active;
+  void *pv_Id;
+  TimerCallbackFunction_t pf_Callback;
+} Fleet_Timer_t;
+
+typedef struct Sim_Queue_t
+{
+  uint8_t au8_Buf[FLEET_QUEUE_BYTES];
+  uint32_t u32_Len;
+  uint32_t u32_ItemSize;
+  uint32_t u32_Head;
+  uint32_t u32_Count;
+} Fleet_Queue_t;
+
+typedef struct Fleet_Pend_t
+{
+  PendedFunction_t pf_Func;
+  void *pv_Arg;
+  uint32_t u32_Arg;
+} Fleet_Pend_t;
+
+/*
+ * @brief one device. Only the worker thread that runs the device touches
+ *        it, Fleet_Run selects it for the kernel and HAL functions.
+ */
+typedef struct Fleet_Dev_t
+{
+  SysSm_t st_Sm;
+  /* kernel, cleared by a deep sleep */
+  uint64_t u64_NowUs;
+  Fleet_Timer_t ast_Timer[FLEET_TIMERS];
+  uint32_t u32_Timers;
+  Fleet_Queue_t st_Queue;
+  bool b_QueueUsed;
+  Fleet_Pend_t ast_Pend[FLEET_PEND_LEN];
+  uint32_t u32_PendHead;
+  uint32_t u32_PendCount;
+  /* HAL and power */
+  uint32_t u32_IrLevel;                       // 1: no bottle, see IR_Switch_Filter
+  uint64_t u64_InputUs;                       // next Fleet_Input, FLEET_NEVER: none
+  uint32_t u32_HoldMask;
+  bool b_IrArmed;                             // IR wakeup from light sleep armed
+  Power_WakeCb_t pf_IrWake;
+  void *pv_IrWakeArg;
+  bool b_Light;                               // nothing held, IR sampling stopped
+  uint64_t u64_WokenUs;                       // IR wakeup not yet handled, 0: none
+  bool b_Asleep;                              // deep sleep
+  uint64_t u64_WakeUs;                        // deep sleep timer
+  uint64_t u64_SinceUs;                       // start of the current light or deep sleep
+  /* RTC memory and flash */
+  uint8_t au8_Resume[FLEET_RESUME_MAX];
+  uint16_t u16_ResumeVersion;
+  uint16_t u16_ResumeLen;                     // 0: no snapshot
+  int32_t as32_Settings[SETTINGS_MAX];
+  /* counters */
+  uint64_t u64_LightUs;                       // IR sampling stopped, light sleep allowed
+  uint64_t u64_DeepUs;
+  uint32_t u32_DeepSleeps;
+  uint32_t u32_Wakes;                         // IR wakeups from light or deep sleep
+  uint64_t u64_WakeLatUs;                     // sum of IR wakeup to Power_Handled
+  uint32_t u32_Commits;
+  uint32_t u32_Dropped;                       // pended calls that did not fit
+  uint32_t u32_LedChanges;
+  uint32_t u32_Digest;                        // journal records and sounds, FNV-1a
+  void *pv_Model;                             // user of the device, see frost_fleet.c
+} Fleet_Dev_t;
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+void Fleet_Init(Fleet_Dev_t *pst_Dev);
+void Fleet_Boot(Fleet_Dev_t *pst_Dev);
+void Fleet_Run(Fleet_Dev_t *pst_Dev, uint64_t u64_UntilUs);
+
+/* the user model, frost_fleet.c */
+void Fleet_Input(Fleet_Dev_t *pst_Dev);
+void Fleet_Sound(Fleet_Dev_t *pst_Dev, Audio_Sound_t e_Sound);
+void Fleet_Journal(Fleet_Dev_t *pst_Dev, Journal_Type_t e_Type, uint32_t u32_Time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLEET_PORT_H
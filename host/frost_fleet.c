@@ -0,0 +1,622 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : frost_fleet
+ *  Description        : runs many devices with the firmware state machine,
+ *                       each with its own SysSm_t and a simulated user, on
+ *                       virtual time as fast as the host can. A device runs
+ *                       in slices of simulated time, the slices go to worker
+ *                       threads through work-stealing deques. Prints the
+ *                       throughput and the hydration seen by the fleet.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "fleet_port.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define FLEET_MAX_THREADS          64U
+#define FLEET_MAX_DAYS             365U      // the 100 Hz tick count wraps after 497 days
+#define FLEET_US_PER_S             1000000ULL
+#define FLEET_DAY_S                86400U
+#define FLEET_DRINK_MAX_S          120U      // a lift this short is a drink
+#define FLEET_ANSWER_S             600U      // a lift this soon after a drink reminder answers it
+#define FLEET_ABSENT_PCT           3U        // lifts that take the bottle out for hours
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+/*
+ * @brief a device and its user. The habits are drawn once from the seed of
+ *        the device, so a device does the same whatever thread runs it.
+ */
+typedef struct Fleet_User_t
+{
+  Fleet_Dev_t st_Dev;
+  uint64_t u64_Rng;
+  /* habits */
+  uint32_t u32_WakeS;                         // time of day the user gets up
+  uint32_t u32_BedS;                          // time of day the user goes to bed
+  uint32_t u32_IntervalS;                     // mean time between drinks
+  uint32_t u32_AnswerPct;                     // drink reminders the user follows
+  bool b_ToBed;                               // the bottle leaves the switch at night
+  /* next input */
+  uint32_t u32_AwayS;                         // how long the next lift lasts
+  /* what the device journaled and played */
+  uint32_t u32_RemovedAt;                     // time() of the last removal, 0: bottle there
+  uint32_t u32_ReminderAt;                    // unanswered drink reminder, 0: none
+  uint32_t u32_Lifts;
+  uint32_t u32_Drinks;
+  uint32_t u32_Reminders;
+  uint32_t u32_Answered;
+  uint64_t u64_AnswerS;                       // sum of reminder to lift
+  uint32_t u32_Cleans;
+} Fleet_User_t;
+
+/*
+ * @brief devices of one worker. The worker takes from the hot end, thieves
+ *        from the cold end.
+ */
+typedef struct Fleet_Deque_t
+{
+  pthread_mutex_t x_Lock;
+  uint32_t *pu32_Slot;                        // device index, ring of dev_count
+  uint32_t u32_Cold;
+  uint32_t u32_Count;
+  uint32_t u32_Slices;
+  uint32_t u32_Steals;
+} Fleet_Deque_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Fleet_UserInit(Fleet_User_t *pst_User, uint32_t u32_Index);
+static void Fleet_PlanLift(Fleet_User_t *pst_User);
+static void Fleet_LiftAt(Fleet_User_t *pst_User, uint64_t u64_Us, uint32_t u32_AwayS);
+static uint64_t Fleet_Rand(Fleet_User_t *pst_User);
+static uint32_t Fleet_Uniform(Fleet_User_t *pst_User, uint32_t u32_Lo, uint32_t u32_Hi);
+static uint32_t Fleet_Exp(Fleet_User_t *pst_User, uint32_t u32_Mean);
+static void Fleet_Push(Fleet_Deque_t *pst_Q, uint32_t u32_Dev, bool b_Cold);
+static bool Fleet_Pop(Fleet_Deque_t *pst_Q, uint32_t *pu32_Dev, bool b_Cold);
+static void *Fleet_Worker(void *pv_Arg);
+static uint32_t Fleet_Verify(uint32_t u32_Count);
+static int Fleet_CmpDouble(const void *pv_A, const void *pv_B);
+static void Fleet_Report(double d_Wall);
+static void Fleet_Usage(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Fleet_User_t *users = NULL;
+static uint32_t dev_count = 1000;
+static uint32_t days = 1;
+static uint32_t slice_s = 6U * 3600U;
+static uint64_t seed = 1;
+static uint32_t threads = 0;
+static Fleet_Deque_t deque[FLEET_MAX_THREADS];
+static uint32_t remaining = 0;              // devices not at the end yet, atomic
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint32_t verify = 0;
+  pthread_t worker[FLEET_MAX_THREADS];
+  struct timespec t0;
+  struct timespec t1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:d:j:s:r:V:h")) != -1) {
+    switch (opt) {
+      case 'n':
+        dev_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'd':
+        days = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'j':
+        threads = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        slice_s = (uint32_t)(strtod(optarg, NULL) * 3600.0);
+        break;
+      case 'r':
+        seed = strtoull(optarg, NULL, 0);
+        break;
+      case 'V':
+        verify = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      default:
+        Fleet_Usage();
+        return (opt == 'h') ? 0 : 2;
+    }
+  }
+  if (threads == 0U) {
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (cpus > 0) ? (uint32_t)cpus : 1U;
+    threads = (threads > FLEET_MAX_THREADS) ? FLEET_MAX_THREADS : threads;
+  }
+  if ((dev_count == 0U) || (days == 0U) || (days > FLEET_MAX_DAYS) || (slice_s == 0U) ||
+      (threads > FLEET_MAX_THREADS) || (verify > dev_count) || (optind != argc)) {
+    Fleet_Usage();
+    return 2;
+  }
+
+  users = calloc(dev_count, sizeof(Fleet_User_t));
+  if (users == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+  for (uint32_t i = 0; i < dev_count; i++) {
+    Fleet_UserInit(&users[i], i);
+  }
+  /* the devices are dealt out in turn, the stealing evens out the rest */
+  for (uint32_t w = 0; w < threads; w++) {
+    (void)pthread_mutex_init(&deque[w].x_Lock, NULL);
+    deque[w].pu32_Slot = calloc(dev_count, sizeof(uint32_t));
+    if (deque[w].pu32_Slot == NULL) {
+      fprintf(stderr, "out of memory\n");
+      return 1;
+    }
+  }
+  for (uint32_t i = 0; i < dev_count; i++) {
+    Fleet_Push(&deque[i % threads], dev_count - 1U - i, false);
+  }
+  remaining = dev_count;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (uint32_t w = 0; w < threads; w++) {
+    (void)pthread_create(&worker[w], NULL, Fleet_Worker, &deque[w]);
+  }
+  for (uint32_t w = 0; w < threads; w++) {
+    (void)pthread_join(worker[w], NULL);
+  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+  Fleet_Report((double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) / 1e9));
+
+  if (verify > 0U) {
+    const uint32_t diffs = Fleet_Verify(verify);
+    fprintf(stderr, "verify   %u devices run alone in one slice, %u differ\n", verify, diffs);
+    return (diffs == 0U) ? 0 : 1;
+  }
+  return 0;
+}
+
+/* the user: lifts and places the bottle, the inputs of the device */
+
+/**
+ * @brief Next input of a device: the bottle is lifted or placed
+ * @param pst_Dev : device
+ */
+void Fleet_Input(Fleet_Dev_t *pst_Dev)
+{
+  Fleet_User_t *user = pst_Dev->pv_Model;
+
+  if (pst_Dev->u32_IrLevel == 0U) {
+    pst_Dev->u32_IrLevel = 1U;
+    pst_Dev->u64_InputUs = pst_Dev->u64_NowUs + ((uint64_t)user->u32_AwayS * FLEET_US_PER_S);
+  } else {
+    pst_Dev->u32_IrLevel = 0U;
+    Fleet_PlanLift(user);
+  }
+}
+
+/**
+ * @brief The device plays a sound. The user follows some drink reminders
+ *        with a drink and most clean reminders with a wash.
+ * @param pst_Dev : device
+ * @param e_Sound : sound
+ */
+void Fleet_Sound(Fleet_Dev_t *pst_Dev, Audio_Sound_t e_Sound)
+{
+  Fleet_User_t *user = pst_Dev->pv_Model;
+  const uint64_t now = pst_Dev->u64_NowUs;
+
+  if (e_Sound == AUDIO_SOUND_DRINK_REMINDER) {
+    user->u32_Reminders++;
+    user->u32_ReminderAt = (uint32_t)time(NULL);
+    if ((pst_Dev->u32_IrLevel == 0U) && (Fleet_Uniform(user, 0U, 99U) < user->u32_AnswerPct)) {
+      Fleet_LiftAt(user, now + ((uint64_t)Fleet_Uniform(user, 10U, 180U) * FLEET_US_PER_S),
+                   Fleet_Uniform(user, 5U, 40U));
+    }
+  } else if (e_Sound == AUDIO_SOUND_CLEAN_REMINDER) {
+    user->u32_Cleans++;
+    if ((pst_Dev->u32_IrLevel == 0U) && (Fleet_Uniform(user, 0U, 99U) < 80U)) {
+      Fleet_LiftAt(user, now + ((uint64_t)Fleet_Uniform(user, 60U, 1800U) * FLEET_US_PER_S),
+                   Fleet_Uniform(user, 120U, 600U));
+    }
+  } else {
+    /* confirmation */
+  }
+}
+
+/**
+ * @brief A journal record of the device: lifts, drinks and answered
+ *        reminders are counted from what the firmware saw
+ * @param pst_Dev : device
+ * @param e_Type : record
+ * @param u32_Time : time() of the record
+ */
+void Fleet_Journal(Fleet_Dev_t *pst_Dev, Journal_Type_t e_Type, uint32_t u32_Time)
+{
+  Fleet_User_t *user = pst_Dev->pv_Model;
+
+  if (e_Type == JOURNAL_BOTTLE_REMOVED) {
+    user->u32_Lifts++;
+    user->u32_RemovedAt = u32_Time;
+    if ((user->u32_ReminderAt != 0U) && ((u32_Time - user->u32_ReminderAt) <= FLEET_ANSWER_S)) {
+      user->u32_Answered++;
+      user->u64_AnswerS += u32_Time - user->u32_ReminderAt;
+    }
+    user->u32_ReminderAt = 0;
+  } else if (e_Type == JOURNAL_BOTTLE_PLACED) {
+    if ((user->u32_RemovedAt != 0U) && ((u32_Time - user->u32_RemovedAt) <= FLEET_DRINK_MAX_S)) {
+      user->u32_Drinks++;
+    }
+    user->u32_RemovedAt = 0;
+  } else {
+    /* not from the state machine */
+  }
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief A new device and its user. Some users set a shorter drink timer in
+ *        the app before the first use. The device is powered at midnight
+ *        and the bottle placed in the morning.
+ * @param pst_User : user
+ * @param u32_Index : device, selects the random stream
+ */
+static void Fleet_UserInit(Fleet_User_t *pst_User, uint32_t u32_Index)
+{
+  Fleet_Dev_t *dev = &pst_User->st_Dev;
+  uint32_t setting;
+
+  (void)memset(pst_User, 0, sizeof(*pst_User));
+  pst_User->u64_Rng = (seed * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)u32_Index << 32) ^ u32_Index;
+  pst_User->u32_WakeS = Fleet_Uniform(pst_User, 6U * 3600U, 9U * 3600U);
+  pst_User->u32_BedS = Fleet_Uniform(pst_User, 22U * 3600U, (23U * 3600U) + 3599U);
+  pst_User->u32_IntervalS = Fleet_Uniform(pst_User, 20U * 60U, 120U * 60U);
+  pst_User->u32_AnswerPct = Fleet_Uniform(pst_User, 20U, 95U);
+  pst_User->b_ToBed = (Fleet_Uniform(pst_User, 0U, 99U) < 40U);
+
+  Fleet_Init(dev);
+  dev->pv_Model = pst_User;
+  setting = Fleet_Uniform(pst_User, 0U, 99U);
+  if (setting < 20U) {
+    dev->as32_Settings[SETTINGS_DRINK_TIMER_S] = 1800;
+  } else if (setting < 30U) {
+    dev->as32_Settings[SETTINGS_DRINK_TIMER_S] = 2700;
+  } else {
+    /* default */
+  }
+  Fleet_Boot(dev);
+  dev->u64_InputUs = ((uint64_t)pst_User->u32_WakeS + Fleet_Uniform(pst_User, 0U, 1800U)) * FLEET_US_PER_S;
+}
+
+/**
+ * @brief The bottle was placed, when is it lifted next and for how long.
+ *        Awake the user drinks at random and now and then takes the bottle
+ *        out for hours; at bedtime some users take it away for the night,
+ *        the others leave it until the first drink in the morning.
+ * @param pst_User : user
+ */
+static void Fleet_PlanLift(Fleet_User_t *pst_User)
+{
+  const uint64_t now_s = pst_User->st_Dev.u64_NowUs / FLEET_US_PER_S;
+  const uint64_t day_s = now_s - (now_s % FLEET_DAY_S);
+  const uint64_t wake_s = day_s + pst_User->u32_WakeS;
+  const uint64_t bed_s = day_s + pst_User->u32_BedS;
+  const uint64_t morning_s = wake_s + FLEET_DAY_S + Fleet_Uniform(pst_User, 0U, 1800U);
+  uint64_t lift_s = now_s + Fleet_Exp(pst_User, pst_User->u32_IntervalS);
+  uint32_t away_s = Fleet_Uniform(pst_User, 5U, 40U);
+
+  if (now_s < wake_s) {
+    lift_s = wake_s + Fleet_Exp(pst_User, pst_User->u32_IntervalS / 2U);
+  } else if (lift_s >= bed_s) {
+    if (pst_User->b_ToBed != false) {
+      lift_s = (now_s > bed_s) ? now_s : (bed_s + Fleet_Uniform(pst_User, 0U, 1800U));
+      away_s = (uint32_t)(morning_s - lift_s);
+    } else {
+      lift_s = morning_s + Fleet_Exp(pst_User, pst_User->u32_IntervalS / 2U);
+    }
+  } else if (Fleet_Uniform(pst_User, 0U, 99U) < FLEET_ABSENT_PCT) {
+    away_s = Fleet_Uniform(pst_User, 3600U, 4U * 3600U);
+  } else {
+    /* a drink */
+  }
+  pst_User->st_Dev.u64_InputUs = lift_s * FLEET_US_PER_S;
+  pst_User->u32_AwayS = away_s;
+}
+
+/**
+ * @brief Lift the bottle earlier than planned
+ * @param pst_User : user
+ * @param u64_Us : time
+ * @param u32_AwayS : for how long
+ */
+static void Fleet_LiftAt(Fleet_User_t *pst_User, uint64_t u64_Us, uint32_t u32_AwayS)
+{
+  if (u64_Us < pst_User->st_Dev.u64_InputUs) {
+    pst_User->st_Dev.u64_InputUs = u64_Us;
+    pst_User->u32_AwayS = u32_AwayS;
+  }
+}
+
+/**
+ * @brief xorshift64* of the user
+ * @param pst_User : user
+ * @return 64 random bits
+ */
+static uint64_t Fleet_Rand(Fleet_User_t *pst_User)
+{
+  uint64_t x = pst_User->u64_Rng;
+
+  x = (x != 0U) ? x : 0x2545F4914F6CDD1DULL;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  pst_User->u64_Rng = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @return u32_Lo..u32_Hi, both included
+ */
+static uint32_t Fleet_Uniform(Fleet_User_t *pst_User, uint32_t u32_Lo, uint32_t u32_Hi)
+{
+  return u32_Lo + (uint32_t)((Fleet_Rand(pst_User) >> 32) % ((uint64_t)u32_Hi - u32_Lo + 1U));
+}
+
+/**
+ * @return exponentially distributed s, at least 1
+ */
+static uint32_t Fleet_Exp(Fleet_User_t *pst_User, uint32_t u32_Mean)
+{
+  const double u = (double)(Fleet_Rand(pst_User) >> 11) / 9007199254740992.0;
+  const double s = -(double)u32_Mean * log(1.0 - u);
+
+  return (s < 1.0) ? 1U : (uint32_t)s;
+}
+
+/**
+ * @brief Add a device to a deque
+ * @param pst_Q : deque
+ * @param u32_Dev : device
+ * @param b_Cold : at the cold end, else at the hot end
+ */
+static void Fleet_Push(Fleet_Deque_t *pst_Q, uint32_t u32_Dev, bool b_Cold)
+{
+  (void)pthread_mutex_lock(&pst_Q->x_Lock);
+  if (b_Cold != false) {
+    pst_Q->u32_Cold = (pst_Q->u32_Cold + dev_count - 1U) % dev_count;
+    pst_Q->pu32_Slot[pst_Q->u32_Cold] = u32_Dev;
+  } else {
+    pst_Q->pu32_Slot[(pst_Q->u32_Cold + pst_Q->u32_Count) % dev_count] = u32_Dev;
+  }
+  pst_Q->u32_Count++;
+  (void)pthread_mutex_unlock(&pst_Q->x_Lock);
+}
+
+/**
+ * @brief Take a device from a deque
+ * @param pst_Q : deque
+ * @param pu32_Dev : device
+ * @param b_Cold : from the cold end, else from the hot end
+ * @return false if it is empty
+ */
+static bool Fleet_Pop(Fleet_Deque_t *pst_Q, uint32_t *pu32_Dev, bool b_Cold)
+{
+  bool ok = false;
+
+  (void)pthread_mutex_lock(&pst_Q->x_Lock);
+  if (pst_Q->u32_Count > 0U) {
+    pst_Q->u32_Count--;
+    if (b_Cold != false) {
+      *pu32_Dev = pst_Q->pu32_Slot[pst_Q->u32_Cold];
+      pst_Q->u32_Cold = (pst_Q->u32_Cold + 1U) % dev_count;
+    } else {
+      *pu32_Dev = pst_Q->pu32_Slot[(pst_Q->u32_Cold + pst_Q->u32_Count) % dev_count];
+    }
+    ok = true;
+  }
+  (void)pthread_mutex_unlock(&pst_Q->x_Lock);
+  return ok;
+}
+
+/**
+ * @brief Worker thread. Runs a device for a slice and puts it back at the
+ *        cold end, so a worker goes round its devices and they all advance
+ *        together. With its own deque empty it steals from the cold end of
+ *        the others, until every device has reached the end.
+ * @param pv_Arg : own deque
+ * @return NULL
+ */
+static void *Fleet_Worker(void *pv_Arg)
+{
+  Fleet_Deque_t *own = pv_Arg;
+  const uint32_t self = (uint32_t)(own - deque);
+  const uint64_t end_us = (uint64_t)days * FLEET_DAY_S * FLEET_US_PER_S;
+  uint32_t dev;
+
+  while (__atomic_load_n(&remaining, __ATOMIC_ACQUIRE) > 0U) {
+    bool got = Fleet_Pop(own, &dev, false);
+
+    for (uint32_t k = 1; (got == false) && (k < threads); k++) {
+      got = Fleet_Pop(&deque[(self + k) % threads], &dev, true);
+      own->u32_Steals += (got != false) ? 1U : 0U;
+    }
+    if (got == false) {
+      (void)sched_yield();
+      continue;
+    }
+
+    Fleet_Dev_t *d = &users[dev].st_Dev;
+    const uint64_t until = d->u64_NowUs + ((uint64_t)slice_s * FLEET_US_PER_S);
+    Fleet_Run(d, (until < end_us) ? until : end_us);
+    own->u32_Slices++;
+    if (d->u64_NowUs < end_us) {
+      Fleet_Push(own, dev, true);
+    } else {
+      (void)__atomic_sub_fetch(&remaining, 1U, __ATOMIC_RELEASE);
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Run some devices again, each alone and in one slice, and compare
+ *        with the fleet run. A device that shared state with another one
+ *        or with its worker thread comes out different.
+ * @param u32_Count : devices, spread over the fleet
+ * @return devices that differ
+ */
+static uint32_t Fleet_Verify(uint32_t u32_Count)
+{
+  const uint64_t end_us = (uint64_t)days * FLEET_DAY_S * FLEET_US_PER_S;
+  Fleet_User_t *alone = malloc(sizeof(Fleet_User_t));
+  uint32_t diffs = 0;
+
+  if (alone == NULL) {
+    return u32_Count;
+  }
+  for (uint32_t k = 0; k < u32_Count; k++) {
+    const uint32_t i = (uint32_t)(((uint64_t)k * dev_count) / u32_Count);
+
+    Fleet_UserInit(alone, i);
+    Fleet_Run(&alone->st_Dev, end_us);
+    if ((alone->st_Dev.u32_Digest != users[i].st_Dev.u32_Digest) || (alone->u32_Drinks != users[i].u32_Drinks)) {
+      if (diffs++ < 10U) {
+        fprintf(stderr, "device %u: digest 0x%08x alone, 0x%08x in the fleet\n", i, alone->st_Dev.u32_Digest,
+                users[i].st_Dev.u32_Digest);
+      }
+    }
+  }
+  free(alone);
+  return diffs;
+}
+
+static int Fleet_CmpDouble(const void *pv_A, const void *pv_B)
+{
+  const double a = *(const double *)pv_A;
+  const double b = *(const double *)pv_B;
+
+  return (a > b) - (a < b);
+}
+
+/**
+ * @brief Print throughput, scheduling and what the fleet saw, per device
+ *        day
+ * @param d_Wall : run time in s
+ */
+static void Fleet_Report(double d_Wall)
+{
+  const double dev_days = (double)dev_count * days;
+  const double span_us = (double)days * FLEET_DAY_S * FLEET_US_PER_S * dev_count;
+  double *drinks = malloc(dev_count * sizeof(double));
+  uint64_t sum[8] = { 0 };
+  uint64_t light_us = 0;
+  uint64_t deep_us = 0;
+  uint64_t lat_us = 0;
+  uint32_t steals = 0;
+  uint32_t slices_min = UINT32_MAX;
+  uint32_t slices_max = 0;
+  uint32_t digest = 2166136261U;
+
+  if (drinks == NULL) {
+    return;
+  }
+  for (uint32_t i = 0; i < dev_count; i++) {
+    const Fleet_User_t *u = &users[i];
+    const Fleet_Dev_t *d = &u->st_Dev;
+
+    drinks[i] = (double)u->u32_Drinks / days;
+    sum[0] += u->u32_Drinks;
+    sum[1] += u->u32_Lifts;
+    sum[2] += u->u32_Reminders;
+    sum[3] += u->u32_Answered;
+    sum[4] += u->u64_AnswerS;
+    sum[5] += u->u32_Cleans;
+    sum[6] += d->u32_DeepSleeps;
+    sum[7] += d->u32_Wakes;
+    light_us += d->u64_LightUs + ((d->b_Light != false) ? (d->u64_NowUs - d->u64_SinceUs) : 0U);
+    deep_us += d->u64_DeepUs + ((d->b_Asleep != false) ? (d->u64_NowUs - d->u64_SinceUs) : 0U);
+    lat_us += d->u64_WakeLatUs;
+    if (d->u32_Dropped != 0U) {
+      fprintf(stderr, "device %u: %u pended calls dropped\n", i, d->u32_Dropped);
+    }
+    for (uint32_t b = 0; b < 4U; b++) {
+      digest = (digest ^ ((d->u32_Digest >> (8U * b)) & 0xFFU)) * 16777619U;
+    }
+  }
+  for (uint32_t w = 0; w < threads; w++) {
+    steals += deque[w].u32_Steals;
+    slices_min = (deque[w].u32_Slices < slices_min) ? deque[w].u32_Slices : slices_min;
+    slices_max = (deque[w].u32_Slices > slices_max) ? deque[w].u32_Slices : slices_max;
+  }
+  qsort(drinks, dev_count, sizeof(double), Fleet_CmpDouble);
+
+  const double hours = dev_days * 24.0;
+  fprintf(stderr, "fleet    %u devices, %u days, %u threads, %.1f h slices, %.1f instance x simulated hours in %.3f s\n",
+          dev_count, days, threads, slice_s / 3600.0, hours, d_Wall);
+  fprintf(stderr, "rate     %.0f instance x simulated hours/s, %u steals, %u..%u slices per worker\n",
+          (d_Wall > 0.0) ? (hours / d_Wall) : 0.0, steals, slices_min, slices_max);
+  fprintf(stderr, "drinks   %.2f per device day (p10 %.1f, p50 %.1f, p90 %.1f), %.2f lifts\n",
+          (double)sum[0] / dev_days, drinks[dev_count / 10U], drinks[dev_count / 2U],
+          drinks[(dev_count * 9U) / 10U], (double)sum[1] / dev_days);
+  fprintf(stderr, "remind   %.2f drink reminders per device day, %.1f %% answered within %u s after %.0f s on "
+          "average, %.2f clean reminders\n", (double)sum[2] / dev_days,
+          (sum[2] > 0U) ? (100.0 * (double)sum[3] / (double)sum[2]) : 0.0, FLEET_ANSWER_S,
+          (sum[3] > 0U) ? ((double)sum[4] / (double)sum[3]) : 0.0, (double)sum[5] / dev_days);
+  fprintf(stderr, "power    IR sampling stopped %.1f %% of the time, deep sleep %.1f %%, %.2f deep sleeps per "
+          "device day, IR wakeup to bottle handled %.1f ms\n", 100.0 * (double)light_us / span_us,
+          100.0 * (double)deep_us / span_us, (double)sum[6] / dev_days,
+          (sum[7] > 0U) ? ((double)lat_us / (double)sum[7] / 1000.0) : 0.0);
+  fprintf(stderr, "digest   0x%08x\n", digest);
+  free(drinks);
+}
+
+/**
+ * @brief Print the command line options
+ *
+ */
+static void Fleet_Usage(void)
+{
+  fprintf(stderr,
+          "usage: frost_fleet [-n devices] [-d days] [-j threads] [-s hours] [-r seed] [-V devices]\n"
+          "  -n devices devices in the fleet, default 1000\n"
+          "  -d days    simulated days, at most %u, default 1\n"
+          "  -j threads worker threads, default one per CPU\n"
+          "  -s hours   simulated time a device runs before it goes back to the deque, default 6\n"
+          "  -r seed    seed of the user habits, default 1\n"
+          "  -V devices run this many devices again alone, exit 1 if one differs\n", FLEET_MAX_DAYS);
+}
@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : frost_render
+ *  Description        : renders melodies and clips to WAV on the host
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_clip.h"
+#include "audio_mix.h"
+#include "audio_out.h"
+#include "audio_seq.h"
+#include "audio_sink.h"
+#include "melody_data.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define RENDER_AMPLITUDE           1000      // same as AUDIO_AMPLITUDE of the audio service
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Render_Voice_t
+{
+  bool b_Clip;              // clip instead of melody
+  uint16_t u16_Id;          // melody or clip index
+} Render_Voice_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool Render_Run(const char *pc_Path, double *pd_Seconds);
+static int32_t Render_FindMelody(const char *pc_Name);
+static void Render_Usage(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Render_Voice_t voices[AUDIO_MIX_VOICES];
+static uint32_t voice_count = 0;
+static int16_t volume = AUDIO_MIX_GAIN_UNITY;
+
+static AudioMix_t mixer;
+static AudioSeq_t voice_seq[AUDIO_MIX_VOICES];
+static AudioClip_t voice_clip[AUDIO_MIX_VOICES];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+  const char *out = NULL;
+  const char *expect = NULL;
+  uint32_t bench = 0;
+  double wall = 0.0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "m:c:v:o:d:b:x:lh")) != -1) {
+    switch (opt) {
+      case 'm':
+      case 'c':
+        if (voice_count == AUDIO_MIX_VOICES) {
+          fprintf(stderr, "at most %u voices\n", AUDIO_MIX_VOICES);
+          return 2;
+        }
+        voices[voice_count].b_Clip = (opt == 'c');
+        if (opt == 'm') {
+          const int32_t id = Render_FindMelody(optarg);
+          if (id < 0) {
+            fprintf(stderr, "unknown melody %s\n", optarg);
+            return 2;
+          }
+          voices[voice_count].u16_Id = (uint16_t)id;
+        } else {
+          voices[voice_count].u16_Id = (uint16_t)strtoul(optarg, NULL, 0);
+        }
+        voice_count++;
+        break;
+      case 'v':
+        volume = (int16_t)((strtoul(optarg, NULL, 0) > 100U ? 100U : strtoul(optarg, NULL, 0)) * AUDIO_MIX_GAIN_UNITY / 100U);
+        break;
+      case 'o':
+        out = optarg;
+        break;
+      case 'd':
+        (void)setenv("FROST_FLASH_DIR", optarg, 1);
+        break;
+      case 'b':
+        bench = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'x':
+        expect = optarg;
+        break;
+      case 'l':
+        for (uint32_t i = 0; i < MELODY_COUNT; i++) {
+          printf("%u %s %u ms\n", i, melody_names[i], AudioSeq_GetLengthMs((uint8_t)i));
+        }
+        return 0;
+      default:
+        Render_Usage();
+        return (opt == 'h') ? 0 : 2;
+    }
+  }
+
+  if (voice_count == 0U) {
+    Render_Usage();
+    return 2;
+  }
+
+  AudioOut_Init(&AudioSink_Wav);
+  if (Render_Run(out, &wall) == false) {
+    return 1;
+  }
+
+  const uint32_t samples = AudioSinkWav_GetSamples();
+  const uint32_t checksum = AudioSinkWav_GetChecksum();
+  const double seconds = (double)samples / AUDIO_SAMPLE_RATE_HZ;
+
+  printf("samples  %u (%.3f s)\n", samples, seconds);
+  printf("checksum 0x%08x\n", checksum);
+
+  /* throughput, repeated renders without file output */
+  if (bench > 0U) {
+    double total = 0.0;
+    for (uint32_t i = 0; i < bench; i++) {
+      double run = 0.0;
+      (void)Render_Run(NULL, &run);
+      total += run;
+    }
+    wall = total / bench;
+  }
+  printf("realtime %.1fx (%.3f ms wall)\n", (wall > 0.0) ? (seconds / wall) : 0.0, wall * 1000.0);
+
+  if ((expect != NULL) && (strtoul(expect, NULL, 16) != checksum)) {
+    fprintf(stderr, "checksum mismatch, expected %s\n", expect);
+    return 1;
+  }
+  return 0;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Render the selected voices through the mixer and output stage
+ * @param pc_Path : WAV file, NULL to render without writing
+ * @param pd_Seconds : returns the wall clock time of the render
+ * @return false if the output or a voice could not be started
+ */
+static bool Render_Run(const char *pc_Path, double *pd_Seconds)
+{
+  struct timespec t0;
+  struct timespec t1;
+
+  if (AudioSinkWav_Open(pc_Path) == false) {
+    fprintf(stderr, "can not create %s\n", pc_Path);
+    return false;
+  }
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+
+  AudioMix_Init(&mixer);
+  AudioEnv_RampInit(&mixer.st_Volume, volume);
+  for (uint32_t v = 0; v < voice_count; v++) {
+    bool ok;
+
+    if (voices[v].b_Clip != false) {
+      ok = AudioClip_Start(&voice_clip[v], voices[v].u16_Id);
+      AudioMix_Start(&mixer, v, AudioClip_Fill, &voice_clip[v], AUDIO_MIX_GAIN_UNITY);
+    } else {
+      ok = AudioSeq_Start(&voice_seq[v], (uint8_t)voices[v].u16_Id, RENDER_AMPLITUDE);
+      AudioMix_Start(&mixer, v, AudioSeq_Fill, &voice_seq[v], AUDIO_MIX_GAIN_UNITY);
+    }
+    if (ok == false) {
+      fprintf(stderr, "voice %u can not be played\n", v);
+      AudioSinkWav_Close();
+      return false;
+    }
+  }
+
+  (void)AudioOut_Start();
+  while (AudioOut_Pump(AudioMix_Fill, &mixer, 0) != false) {
+  }
+  AudioOut_Stop();
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+  AudioSinkWav_Close();
+
+  *pd_Seconds = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+  return true;
+}
+
+/**
+ * @brief Look up a melody by name or index
+ * @param pc_Name : MELODY name without prefix, or its number
+ * @return melody index, -1 if unknown
+ */
+static int32_t Render_FindMelody(const char *pc_Name)
+{
+  char *end;
+  const unsigned long id = strtoul(pc_Name, &end, 0);
+
+  if ((*end == '\0') && (end != pc_Name)) {
+    return (id < MELODY_COUNT) ? (int32_t)id : -1;
+  }
+  for (uint32_t i = 0; i < MELODY_COUNT; i++) {
+    if (strcmp(pc_Name, melody_names[i]) == 0) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+static void Render_Usage(void)
+{
+  fprintf(stderr,
+          "usage: frost_render [-m melody] [-c clip] [-v volume%%] [-o out.wav]\n"
+          "                    [-d flash dir] [-b runs] [-x checksum] [-l]\n"
+          "  -m/-c  add a melody (name or number) or clip voice, up to %u are mixed\n"
+          "  -d     directory holding clips.bin, default $FROST_FLASH_DIR or .\n"
+          "  -b     render this many extra times to measure the realtime factor\n"
+          "  -x     expected checksum, exit code 1 on mismatch\n"
+          "  -l     list the melodies\n", AUDIO_MIX_VOICES);
+}
@@ -0,0 +1,411 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : frost_replay
+ *  Description        : replays recorded IR switch traces through the debounce
+ *                       of the firmware as fast as the host can. Every trace
+ *                       is one device with its own IR_Switch_t, the devices
+ *                       are shared out to worker threads. The debounced edges
+ *                       can be written and compared with those of another
+ *                       firmware version.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "driver/gpio.h"
+#include "ir_switch.h"
+#include "sim.h"
+#include "trace_file.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define REPLAY_MAX_THREADS         64U
+#define REPLAY_MS_PER_DAY          (24.0 * 3600.0 * 1000.0)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Replay_Edge_t
+{
+  uint64_t u64_Ms;
+  uint8_t u8_State;          // IRSwitch_State after the edge
+} Replay_Edge_t;
+
+/*
+ * @brief one replayed device
+ */
+typedef struct Replay_Dev_t
+{
+  const TraceFile_t *pst_Trace;
+  Replay_Edge_t *pst_Edges;
+  uint32_t u32_Edges;
+  uint32_t u32_EdgeCap;
+  uint64_t u64_Samples;
+  uint64_t u64_SpanMs;       // first to last sample
+  uint64_t u64_PresentMs;    // time with the bottle on the switch
+  uint32_t u32_Lifts;
+} Replay_Dev_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void *Replay_Worker(void *pv_Arg);
+static void Replay_Device(Replay_Dev_t *pst_Dev);
+static void Replay_Edge(Replay_Dev_t *pst_Dev, uint64_t u64_Ms, uint8_t u8_State);
+static bool Replay_Write(FILE *pst_File);
+static uint32_t Replay_Compare(FILE *pst_Out, const char *pc_Ref);
+static void Replay_Report(double d_Wall);
+static void Replay_Usage(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static TraceFile_t *traces = NULL;
+static Replay_Dev_t *devs = NULL;
+static uint32_t dev_count = 0;
+static uint32_t next_dev = 0;        // next device for a worker, atomic
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+  const char *out_path = NULL;
+  const char *ref_path = NULL;
+  uint32_t threads = 1;
+  uint32_t trace_count;
+  pthread_t worker[REPLAY_MAX_THREADS];
+  struct timespec t0;
+  struct timespec t1;
+  int ret = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:j:o:c:h")) != -1) {
+    switch (opt) {
+      case 'n':
+        dev_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'j':
+        threads = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'o':
+        out_path = optarg;
+        break;
+      case 'c':
+        ref_path = optarg;
+        break;
+      default:
+        Replay_Usage();
+        return (opt == 'h') ? 0 : 2;
+    }
+  }
+  trace_count = (uint32_t)(argc - optind);
+  if ((trace_count == 0U) || (threads == 0U) || (threads > REPLAY_MAX_THREADS)) {
+    Replay_Usage();
+    return 2;
+  }
+
+  traces = calloc(trace_count, sizeof(TraceFile_t));
+  for (uint32_t i = 0; i < trace_count; i++) {
+    if (TraceFile_Load(argv[optind + (int)i], &traces[i]) == false) {
+      return 1;
+    }
+  }
+  /* -n repeats the traces, default one device per trace */
+  if (dev_count == 0U) {
+    dev_count = trace_count;
+  }
+  devs = calloc(dev_count, sizeof(Replay_Dev_t));
+  for (uint32_t i = 0; i < dev_count; i++) {
+    devs[i].pst_Trace = &traces[i % trace_count];
+  }
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (uint32_t i = 0; i < threads; i++) {
+    (void)pthread_create(&worker[i], NULL, Replay_Worker, NULL);
+  }
+  for (uint32_t i = 0; i < threads; i++) {
+    (void)pthread_join(worker[i], NULL);
+  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+  Replay_Report((double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) / 1e9));
+
+  if (out_path != NULL) {
+    FILE *out = fopen(out_path, "w");
+    if ((out == NULL) || (Replay_Write(out) == false) || (fclose(out) != 0)) {
+      fprintf(stderr, "can not write %s\n", out_path);
+      return 1;
+    }
+  }
+  if (ref_path != NULL) {
+    FILE *out = tmpfile();
+    uint32_t diffs;
+
+    if ((out == NULL) || (Replay_Write(out) == false)) {
+      fprintf(stderr, "can not compare\n");
+      return 1;
+    }
+    rewind(out);
+    diffs = Replay_Compare(out, ref_path);
+    (void)fclose(out);
+    fprintf(stderr, "compare  %u lines differ from %s\n", diffs, ref_path);
+    ret = (diffs == 0U) ? 0 : 1;
+  }
+  return ret;
+}
+
+/* ir_switch.c reads the pin in GetIRswitchStatus and extended_services.c
+ * the clock for its software timers. The replay feeds IR_Switch_Filter
+ * directly and only needs these to link. */
+uint64_t Sim_NowUs(void)
+{
+  return 0;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+  (void)gpio_num;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+  (void)gpio_num;
+  (void)mode;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+  (void)gpio_num;
+  (void)pull;
+  return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+  (void)gpio_num;
+  return 1;
+}
+
+void InputTrace_Sample(InputTrace_Source_t e_Src, uint32_t u32_Level)
+{
+  (void)e_Src;
+  (void)u32_Level;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Worker thread, takes the next device until all are done. Devices
+ *        differ in length, taking one at a time keeps the threads busy.
+ * @param pv_Arg
+ * @return NULL
+ */
+static void *Replay_Worker(void *pv_Arg)
+{
+  uint32_t i;
+
+  (void)pv_Arg;
+  while ((i = __atomic_fetch_add(&next_dev, 1U, __ATOMIC_RELAXED)) < dev_count) {
+    Replay_Device(&devs[i]);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Replay the IR samples of one device through the firmware debounce,
+ *        with the recorded time step of every sample, as measured by the
+ *        IR poll that took it
+ * @param pst_Dev : device
+ */
+static void Replay_Device(Replay_Dev_t *pst_Dev)
+{
+  IR_Switch_t sw;
+  TraceFile_Iter_t it;
+  TraceFile_Sample_t sample;
+  uint8_t state = (uint8_t)IR_SWITCH_RESET;
+  uint64_t first_ms = 0;
+  uint64_t since_ms = 0;
+
+  IR_Switch_Setup(&sw);
+  TraceFile_Begin(pst_Dev->pst_Trace, &it);
+  while (TraceFile_Next(&it, &sample) != false) {
+    if (sample.e_Src != INPUT_TRACE_SRC_IR) {
+      continue;
+    }
+    if (pst_Dev->u64_Samples++ == 0U) {
+      first_ms = sample.u64_Ms;
+    }
+    /* after a gap the poll was stopped for sleep, it restarts with the nominal step */
+    const uint32_t dt = (sample.u32_DtMs != 0U) ? sample.u32_DtMs : IR_SWITCH_SAMPLE_MS;
+    const uint8_t out = IR_Switch_Filter(&sw, sample.u32_Level, (int32_t)dt);
+    if (out != state) {
+      if (out == (uint8_t)IR_SWITCH_RESET) {
+        pst_Dev->u64_PresentMs += sample.u64_Ms - since_ms;
+        pst_Dev->u32_Lifts++;
+      }
+      since_ms = sample.u64_Ms;
+      state = out;
+      Replay_Edge(pst_Dev, sample.u64_Ms, out);
+    }
+  }
+  if (pst_Dev->u64_Samples > 0U) {
+    pst_Dev->u64_SpanMs = it.u64_Ms - first_ms;
+    if (state == (uint8_t)IR_SWITCH_SET) {
+      pst_Dev->u64_PresentMs += it.u64_Ms - since_ms;
+    }
+  }
+}
+
+/**
+ * @brief Keep a debounced edge
+ * @param pst_Dev : device
+ * @param u64_Ms : sample time
+ * @param u8_State : IRSwitch_State after the edge
+ */
+static void Replay_Edge(Replay_Dev_t *pst_Dev, uint64_t u64_Ms, uint8_t u8_State)
+{
+  if (pst_Dev->u32_Edges == pst_Dev->u32_EdgeCap) {
+    pst_Dev->u32_EdgeCap = (pst_Dev->u32_EdgeCap == 0U) ? 64U : (pst_Dev->u32_EdgeCap * 2U);
+    pst_Dev->pst_Edges = realloc(pst_Dev->pst_Edges, pst_Dev->u32_EdgeCap * sizeof(Replay_Edge_t));
+    if (pst_Dev->pst_Edges == NULL) {
+      fprintf(stderr, "out of memory\n");
+      exit(1);
+    }
+  }
+  pst_Dev->pst_Edges[pst_Dev->u32_Edges].u64_Ms = u64_Ms;
+  pst_Dev->pst_Edges[pst_Dev->u32_Edges].u8_State = u8_State;
+  pst_Dev->u32_Edges++;
+}
+
+/**
+ * @brief Write the edges of all devices as "<device> <ms> placed|removed"
+ * @param pst_File : output
+ * @return false on a write error
+ */
+static bool Replay_Write(FILE *pst_File)
+{
+  for (uint32_t i = 0; i < dev_count; i++) {
+    for (uint32_t e = 0; e < devs[i].u32_Edges; e++) {
+      fprintf(pst_File, "%u %" PRIu64 " %s\n", i, devs[i].pst_Edges[e].u64_Ms,
+              (devs[i].pst_Edges[e].u8_State == (uint8_t)IR_SWITCH_SET) ? "placed" : "removed");
+    }
+  }
+  return ferror(pst_File) == 0;
+}
+
+/**
+ * @brief Compare the edges line by line with a file of an earlier run, the
+ *        first differences are printed
+ * @param pst_Out : edges of this run
+ * @param pc_Ref : edges of the reference run
+ * @return lines that differ, missing lines included
+ */
+static uint32_t Replay_Compare(FILE *pst_Out, const char *pc_Ref)
+{
+  char line[128];
+  char ref_line[128];
+  uint32_t n = 0;
+  uint32_t diffs = 0;
+  FILE *ref = fopen(pc_Ref, "r");
+
+  if (ref == NULL) {
+    fprintf(stderr, "can not open %s\n", pc_Ref);
+    return 1;
+  }
+  while (1) {
+    const bool have = (fgets(line, sizeof(line), pst_Out) != NULL);
+    const bool have_ref = (fgets(ref_line, sizeof(ref_line), ref) != NULL);
+
+    if ((have == false) && (have_ref == false)) {
+      break;
+    }
+    n++;
+    if ((have != have_ref) || (strcmp(line, ref_line) != 0)) {
+      if (diffs++ < 10U) {
+        fprintf(stderr, "line %u: %s", n, (have_ref != false) ? ref_line : "(missing)\n");
+        fprintf(stderr, "     now: %s", (have != false) ? line : "(missing)\n");
+      }
+    }
+  }
+  (void)fclose(ref);
+  return diffs;
+}
+
+/**
+ * @brief Print throughput and what the devices saw
+ * @param d_Wall : replay time in s
+ */
+static void Replay_Report(double d_Wall)
+{
+  uint64_t samples = 0;
+  uint64_t span_ms = 0;
+  uint64_t present_ms = 0;
+  uint32_t lifts = 0;
+  double min_day = 0.0;
+  double max_day = 0.0;
+
+  for (uint32_t i = 0; i < dev_count; i++) {
+    const double days = (double)devs[i].u64_SpanMs / REPLAY_MS_PER_DAY;
+    const double per_day = (days > 0.0) ? ((double)devs[i].u32_Lifts / days) : 0.0;
+
+    samples += devs[i].u64_Samples;
+    span_ms += devs[i].u64_SpanMs;
+    present_ms += devs[i].u64_PresentMs;
+    lifts += devs[i].u32_Lifts;
+    if ((i == 0U) || (per_day < min_day)) {
+      min_day = per_day;
+    }
+    if ((i == 0U) || (per_day > max_day)) {
+      max_day = per_day;
+    }
+  }
+
+  const double hours = (double)span_ms / 3600000.0;
+  fprintf(stderr, "replayed %u devices, %" PRIu64 " samples, %.1f device hours in %.3f s\n", dev_count, samples,
+          hours, d_Wall);
+  fprintf(stderr, "rate     %.3g samples/s, %.3g device hours/s\n", (d_Wall > 0.0) ? ((double)samples / d_Wall) : 0.0,
+          (d_Wall > 0.0) ? (hours / d_Wall) : 0.0);
+  fprintf(stderr, "bottle   %u lifts, %.1f per device day (min %.1f, max %.1f), on the switch %.1f %% of the time\n",
+          lifts, (span_ms > 0U) ? ((double)lifts * REPLAY_MS_PER_DAY / (double)span_ms) : 0.0, min_day, max_day,
+          (span_ms > 0U) ? (100.0 * (double)present_ms / (double)span_ms) : 0.0);
+}
+
+/**
+ * @brief Print the command line options
+ *
+ */
+static void Replay_Usage(void)
+{
+  fprintf(stderr,
+          "usage: frost_replay [-n devices] [-j threads] [-o edges] [-c edges] trace...\n"
+          "  trace      input trace from tools/trace_extract.py, one device each\n"
+          "  -n devices replay this many devices, the traces are repeated\n"
+          "  -j threads worker threads, default 1\n"
+          "  -o edges   write the debounced edges as '<device> <ms> placed|removed'\n"
+          "  -c edges   compare the edges with an earlier -o file, exit 1 if they differ\n");
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : i2s_pdm
+ *  Description        : ESP-IDF I2S PDM TX driver for the host simulation. The
+ *                       DMA sends one descriptor per frame time of simulated
+ *                       time, the sent samples are recorded.
+ ******************************************************************************/
+
+#ifndef DRIVER_I2S_PDM_H
+#define DRIVER_I2S_PDM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+
+typedef struct Sim_I2s_t *i2s_chan_handle_t;
+
+typedef enum { I2S_NUM_0 = 0, I2S_NUM_AUTO } i2s_port_t;
+typedef enum { I2S_ROLE_MASTER = 0, I2S_ROLE_SLAVE } i2s_role_t;
+typedef enum { I2S_DATA_BIT_WIDTH_16BIT = 16 } i2s_data_bit_width_t;
+typedef enum { I2S_SLOT_MODE_MONO = 1, I2S_SLOT_MODE_STEREO } i2s_slot_mode_t;
+
+typedef struct
+{
+  i2s_port_t id;
+  i2s_role_t role;
+  uint32_t dma_desc_num;
+  uint32_t dma_frame_num;
+  bool auto_clear;
+} i2s_chan_config_t;
+
+typedef struct
+{
+  uint32_t sample_rate_hz;
+} i2s_pdm_tx_clk_config_t;
+
+typedef struct
+{
+  i2s_data_bit_width_t data_bit_width;
+  i2s_slot_mode_t slot_mode;
+} i2s_pdm_tx_slot_config_t;
+
+typedef struct
+{
+  gpio_num_t clk;
+  gpio_num_t dout;
+  struct {
+    uint32_t clk_inv : 1;
+  } invert_flags;
+} i2s_pdm_tx_gpio_config_t;
+
+typedef struct
+{
+  i2s_pdm_tx_clk_config_t clk_cfg;
+  i2s_pdm_tx_slot_config_t slot_cfg;
+  i2s_pdm_tx_gpio_config_t gpio_cfg;
+} i2s_pdm_tx_config_t;
+
+typedef struct
+{
+  void *data;
+  size_t size;
+} i2s_event_data_t;
+
+typedef bool (*i2s_isr_callback_t)(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+
+typedef struct
+{
+  i2s_isr_callback_t on_recv;
+  i2s_isr_callback_t on_recv_q_ovf;
+  i2s_isr_callback_t on_sent;
+  i2s_isr_callback_t on_send_q_ovf;
+} i2s_event_callbacks_t;
+
+#define I2S_CHANNEL_DEFAULT_CONFIG(port, chan_role)  { .id = (port), .role = (chan_role), .dma_desc_num = 6, \
+                                                       .dma_frame_num = 240, .auto_clear = false }
+#define I2S_PDM_TX_CLK_DEFAULT_CONFIG(rate)          { .sample_rate_hz = (rate) }
+#define I2S_PDM_TX_SLOT_DEFAULT_CONFIG(bits, mode)   { .data_bit_width = (bits), .slot_mode = (mode) }
+
+esp_err_t i2s_new_channel(const i2s_chan_config_t *chan_cfg, i2s_chan_handle_t *ret_tx_handle,
+                          i2s_chan_handle_t *ret_rx_handle);
+esp_err_t i2s_channel_init_pdm_tx_mode(i2s_chan_handle_t handle, const i2s_pdm_tx_config_t *pdm_tx_cfg);
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t *callback,
+                                              void *user_data);
+esp_err_t i2s_channel_enable(i2s_chan_handle_t handle);
+esp_err_t i2s_channel_disable(i2s_chan_handle_t handle);
+esp_err_t i2s_channel_write(i2s_chan_handle_t handle, const void *src, size_t size, size_t *bytes_written,
+                            uint32_t timeout_ms);
+
+#endif // DRIVER_I2S_PDM_H
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : esp_check
+ *  Description        : ESP-IDF error check macros for the host simulation
+ ******************************************************************************/
+
+#ifndef ESP_CHECK_H
+#define ESP_CHECK_H
+
+#include "esp_err.h"
+#include "esp_log.h"
+
+#define ESP_RETURN_ON_ERROR(x, tag, fmt, ...)                                    \
+  do {                                                                           \
+    const esp_err_t err_rc_ = (x);                                               \
+    if (err_rc_ != ESP_OK) {                                                     \
+      ESP_LOGE(tag, "%s(%d): " fmt "\n", __func__, __LINE__, ##__VA_ARGS__);     \
+      return err_rc_;                                                            \
+    }                                                                            \
+  } while (0)
+
+#endif // ESP_CHECK_H
@@ -0,0 +1,37 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : esp_cpu
+ *  Description        : ESP-IDF CPU helpers for the host simulation. The cycle
+ *                       counter runs at SIM_CPU_MHZ of host time, so cycle
+ *                       statistics read like on the target.
+ ******************************************************************************/
+
+#ifndef ESP_CPU_H
+#define ESP_CPU_H
+
+#include <stdint.h>
+#include "sim.h"
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+static inline esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+  return (esp_cpu_cycle_count_t)Sim_Cycles();
+}
+
+static inline int esp_cpu_get_core_id(void)
+{
+  return 0;
+}
+
+#endif // ESP_CPU_H
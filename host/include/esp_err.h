@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : esp_err
+ *  Description        : ESP-IDF error codes for the host simulation
+ ******************************************************************************/
+
+#ifndef ESP_ERR_H
+#define ESP_ERR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int32_t esp_err_t;
+
+#define ESP_OK                     0
+#define ESP_FAIL                   -1
+#define ESP_ERR_NO_MEM             0x101
+#define ESP_ERR_INVALID_ARG        0x102
+#define ESP_ERR_INVALID_STATE      0x103
+#define ESP_ERR_NOT_FOUND          0x105
+
+#define ESP_ERROR_CHECK(x)                                                       \
+  do {                                                                           \
+    const esp_err_t err_rc_ = (x);                                               \
+    if (err_rc_ != ESP_OK) {                                                     \
+      fprintf(stderr, "ESP_ERROR_CHECK failed: %d at %s:%d\n", (int)err_rc_,     \
+              __FILE__, __LINE__);                                               \
+      abort();                                                                   \
+    }                                                                            \
+  } while (0)
+
+#endif // ESP_ERR_H
@@ -0,0 +1,29 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : esp_log
+ *  Description        : ESP-IDF logging macros for the plain CMake host build
+ ******************************************************************************/
+
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+#include <stdio.h>
+
+/* logs go to stderr so tool output on stdout stays parseable */
+#define ESP_LOGE(tag, fmt, ...)    fprintf(stderr, "E %s: " fmt, tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)    fprintf(stderr, "W %s: " fmt, tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)    fprintf(stderr, "I %s: " fmt, tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...)    do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, fmt, ...)    do { (void)(tag); } while (0)
+
+#endif // ESP_LOG_H
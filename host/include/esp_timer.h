@@ -0,0 +1,29 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : esp_timer
+ *  Description        : ESP-IDF high resolution time for the host simulation,
+ *                       the simulated time since start
+ ******************************************************************************/
+
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+#include "sim.h"
+
+static inline int64_t esp_timer_get_time(void)
+{
+  return (int64_t)Sim_NowUs();
+}
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : FreeRTOS
+ *  Description        : FreeRTOS kernel types for the host simulation, the kernel
+ *                       is emulated with POSIX threads, see host/sim
+ ******************************************************************************/
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "sim.h"
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+
+#define pdTRUE                     ((BaseType_t)1)
+#define pdFALSE                    ((BaseType_t)0)
+#define pdPASS                     pdTRUE
+#define pdFAIL                     pdFALSE
+
+#define configTICK_RATE_HZ         CONFIG_FREERTOS_HZ
+#define portTICK_PERIOD_MS         ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY              ((TickType_t)0xFFFFFFFFUL)
+#define portNUM_PROCESSORS         1
+#define configGENERATE_RUN_TIME_STATS          1
+#define configUSE_STATS_FORMATTING_FUNCTIONS   1
+#define pdMS_TO_TICKS(ms)          ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+
+/* one simulated core: a critical section is one recursive lock, in tasks
+ * and in the simulated ISRs alike */
+typedef struct { int s32_Unused; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portENTER_CRITICAL(mux)        do { (void)(mux); Sim_EnterCritical(); } while (0)
+#define portEXIT_CRITICAL(mux)         do { (void)(mux); Sim_ExitCritical(); } while (0)
+#define portENTER_CRITICAL_SAFE(mux)   portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_SAFE(mux)    portEXIT_CRITICAL(mux)
+#define portYIELD_FROM_ISR(woken)      do { (void)(woken); } while (0)
+
+#endif // FREERTOS_H
@@ -0,0 +1,34 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : event_groups
+ *  Description        : FreeRTOS event group API for the host simulation,
+ *                       24 usable bits as in the kernel with 32 bit ticks
+ ******************************************************************************/
+
+#ifndef FREERTOS_EVENT_GROUPS_H
+#define FREERTOS_EVENT_GROUPS_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct Sim_Group_t *EventGroupHandle_t;
+typedef TickType_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+void vEventGroupDelete(EventGroupHandle_t x_Group);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t x_Group, EventBits_t x_Bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t x_Group, EventBits_t x_Bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t x_Group);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t x_Group, EventBits_t x_Bits, BaseType_t x_Clear, BaseType_t x_All,
+                                TickType_t x_Wait);
+
+#endif // FREERTOS_EVENT_GROUPS_H
@@ -0,0 +1,31 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : queue
+ *  Description        : FreeRTOS queue API for the host simulation
+ ******************************************************************************/
+
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct Sim_Queue_t *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t u32_Len, UBaseType_t u32_ItemSize);
+void vQueueDelete(QueueHandle_t x_Queue);
+BaseType_t xQueueSend(QueueHandle_t x_Queue, const void *pv_Item, TickType_t x_Wait);
+BaseType_t xQueueSendFromISR(QueueHandle_t x_Queue, const void *pv_Item, BaseType_t *px_Woken);
+BaseType_t xQueueReceive(QueueHandle_t x_Queue, void *pv_Item, TickType_t x_Wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t x_Queue);
+
+#endif // FREERTOS_QUEUE_H
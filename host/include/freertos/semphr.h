@@ -0,0 +1,30 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : semphr
+ *  Description        : FreeRTOS semaphore API for the host simulation, a mutex is a
+ *                       queue of one empty item as in the kernel
+ ******************************************************************************/
+
+#ifndef FREERTOS_SEMPHR_H
+#define FREERTOS_SEMPHR_H
+
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+#define xSemaphoreTake(sem, wait)  xQueueReceive((sem), NULL, (wait))
+#define xSemaphoreGive(sem)        xQueueSend((sem), NULL, 0)
+#define vSemaphoreDelete(sem)      vQueueDelete(sem)
+
+#endif // FREERTOS_SEMPHR_H
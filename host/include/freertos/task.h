@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : task
+ *  Description        : FreeRTOS task API for the host simulation
+ ******************************************************************************/
+
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct Sim_Task_t *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define taskENTER_CRITICAL(mux)        portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)         portEXIT_CRITICAL(mux)
+#define taskENTER_CRITICAL_ISR(mux)    portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL_ISR(mux)     portEXIT_CRITICAL(mux)
+
+/* the stack size and priority are accepted but not used, every task is a thread */
+BaseType_t xTaskCreate(TaskFunction_t pf_Task, const char *pc_Name, uint32_t u32_Stack, void *pv_Arg,
+                       UBaseType_t u32_Prio, TaskHandle_t *px_Task);
+void vTaskDelete(TaskHandle_t x_Task);
+void vTaskDelay(TickType_t x_Ticks);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+uint32_t ulTaskNotifyTake(BaseType_t x_Clear, TickType_t x_Wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t x_Task);
+void vTaskNotifyGiveFromISR(TaskHandle_t x_Task, BaseType_t *px_Woken);
+/* run time in us of host CPU time of the task threads */
+void vTaskGetRunTimeStats(char *pc_Buf);
+
+#endif // FREERTOS_TASK_H
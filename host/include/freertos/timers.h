@@ -0,0 +1,41 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : timers
+ *  Description        : FreeRTOS software timer API for the host simulation. The
+ *                       callbacks and pended functions run in one timer
+ *                       task, as in the kernel.
+ ******************************************************************************/
+
+#ifndef FREERTOS_TIMERS_H
+#define FREERTOS_TIMERS_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct Sim_Timer_t *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+typedef void (*PendedFunction_t)(void *, uint32_t);
+
+TimerHandle_t xTimerCreate(const char *pc_Name, TickType_t x_Period, BaseType_t x_AutoReload, void *pv_Id,
+                           TimerCallbackFunction_t pf_Callback);
+BaseType_t xTimerStart(TimerHandle_t x_Timer, TickType_t x_Wait);
+BaseType_t xTimerStop(TimerHandle_t x_Timer, TickType_t x_Wait);
+BaseType_t xTimerReset(TimerHandle_t x_Timer, TickType_t x_Wait);
+BaseType_t xTimerChangePeriod(TimerHandle_t x_Timer, TickType_t x_Period, TickType_t x_Wait);
+BaseType_t xTimerIsTimerActive(TimerHandle_t x_Timer);
+TickType_t xTimerGetExpiryTime(TimerHandle_t x_Timer);
+void *pvTimerGetTimerID(TimerHandle_t x_Timer);
+BaseType_t xTimerPendFunctionCall(PendedFunction_t pf_Func, void *pv_Arg, uint32_t u32_Arg, TickType_t x_Wait);
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t pf_Func, void *pv_Arg, uint32_t u32_Arg,
+                                         BaseType_t *px_Woken);
+
+#endif // FREERTOS_TIMERS_H
@@ -0,0 +1,21 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : gpio_hal
+ *  Description        : ESP-IDF GPIO HAL for the host simulation, nothing of it is
+ *                       used
+ ******************************************************************************/
+
+#ifndef HAL_GPIO_HAL_H
+#define HAL_GPIO_HAL_H
+
+#endif // HAL_GPIO_HAL_H
@@ -0,0 +1,26 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sdkconfig
+ *  Description        : configuration of the plain CMake host build
+ ******************************************************************************/
+
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+#ifndef CONFIG_IDF_TARGET_LINUX
+#define CONFIG_IDF_TARGET_LINUX    1
+#endif
+
+#define CONFIG_FREERTOS_HZ         100
+
+#endif // SDKCONFIG_H
@@ -0,0 +1,282 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : frost_sim
+ *  Description        : runs the whole application on the host. The tasks of
+ *                       app_main run as threads on the simulated kernel, a
+ *                       scenario script drives the inputs, the GPIO levels
+ *                       and the I2S output are recorded. The virtual clock
+ *                       skips idle time, days of device time run in seconds.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "dlog.h"
+#include "pin_config.h"
+#include "sim.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define FROST_SIM_FLASH_DIR        "frost_flash"
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct FrostSim_Part_t
+{
+  const char *pc_Label;
+  uint32_t u32_Size;
+} FrostSim_Part_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+void app_main(void);
+static bool FrostSim_Flash(const char *pc_Dir);
+static void FrostSim_Main(void *pv_Arg);
+static void FrostSim_Finish(void);
+static void FrostSim_Usage(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* data partitions of partitions.csv */
+static const FrostSim_Part_t parts[] = {
+  { "clips", 512U * 1024U },
+  { "settings", 8U * 1024U },
+  { "journal", 64U * 1024U },
+};
+
+static bool script = false;
+static uint64_t duration_us = 0;
+static pthread_mutex_t done_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+static bool done = false;
+static uint64_t end_us = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+  const char *trace_path = NULL;
+  const char *wav_path = NULL;
+  const char *flash_dir = FROST_SIM_FLASH_DIR;
+  bool interactive = false;
+  bool real_time = false;
+  FILE *trace = NULL;
+  struct timespec t0;
+  struct timespec t1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "s:t:w:d:T:irh")) != -1) {
+    switch (opt) {
+      case 's':
+        script = Sim_ScenarioLoad(optarg);
+        if (script == false) {
+          return 2;
+        }
+        break;
+      case 't':
+        trace_path = optarg;
+        break;
+      case 'w':
+        wav_path = optarg;
+        break;
+      case 'd':
+        flash_dir = optarg;
+        break;
+      case 'T':
+        duration_us = (uint64_t)strtoull(optarg, NULL, 0) * 1000U;
+        break;
+      case 'i':
+        interactive = true;
+        break;
+      case 'r':
+        real_time = true;
+        break;
+      default:
+        FrostSim_Usage();
+        return (opt == 'h') ? 0 : 2;
+    }
+  }
+  if ((script == false) && (interactive == false) && (duration_us == 0U)) {
+    FrostSim_Usage();
+    return 2;
+  }
+
+  if (FrostSim_Flash(flash_dir) == false) {
+    return 1;
+  }
+  if (trace_path != NULL) {
+    trace = fopen(trace_path, "w");
+    if (trace == NULL) {
+      fprintf(stderr, "can not create %s\n", trace_path);
+      return 1;
+    }
+    Sim_GpioTrace(trace);
+  }
+  if (Sim_I2sRecord(wav_path) == false) {
+    fprintf(stderr, "can not create %s\n", wav_path);
+    return 1;
+  }
+  if (interactive != false) {
+    Sim_ConsoleStdin();
+  }
+
+  /* commands typed in do not stop the virtual clock, run them in real time */
+  (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+  Sim_Start((real_time == false) && (interactive == false));
+  (void)xTaskCreate(FrostSim_Main, "main", 0, NULL, 1, NULL);
+
+  (void)pthread_mutex_lock(&done_lock);
+  while (done == false) {
+    (void)pthread_cond_wait(&done_cond, &done_lock);
+  }
+  (void)pthread_mutex_unlock(&done_lock);
+  (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  /* the application threads are left running, exit ends them */
+  uint32_t samples;
+  uint32_t checksum;
+  uint32_t underruns;
+  const double sim_s = (double)end_us / 1e6;
+  const double wall_s = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) / 1e9);
+
+  Dlog_Flush();
+  Sim_GpioTrace(NULL);
+  if (trace != NULL) {
+    (void)fclose(trace);
+  }
+  Sim_I2sFinish(&samples, &checksum, &underruns);
+  (void)fflush(stdout);
+
+  fprintf(stderr, "simulated %.3f s in %.3f s wall, %.1f simulated s per wall s, %" PRIu64 " clock steps\n", sim_s,
+          wall_s, (wall_s > 0.0) ? (sim_s / wall_s) : 0.0, Sim_Steps());
+  fprintf(stderr, "gpio     %u changes\n", Sim_GpioChanges());
+  fprintf(stderr, "audio    %u samples, checksum 0x%08x, %u underruns\n", samples, checksum, underruns);
+  return 0;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Create the flash directory and the erased partitions that are missing
+ * @param pc_Dir : directory, becomes FROST_FLASH_DIR of flash_port
+ * @return false on a file error
+ */
+static bool FrostSim_Flash(const char *pc_Dir)
+{
+  char path[256];
+  static uint8_t erased[4096];
+
+  if ((mkdir(pc_Dir, 0755) != 0) && (errno != EEXIST)) {
+    fprintf(stderr, "can not create %s\n", pc_Dir);
+    return false;
+  }
+  (void)setenv("FROST_FLASH_DIR", pc_Dir, 1);
+  (void)memset(erased, 0xFF, sizeof(erased));
+
+  for (uint32_t i = 0; i < (sizeof(parts) / sizeof(parts[0])); i++) {
+    struct stat st;
+    FILE *file;
+
+    (void)snprintf(path, sizeof(path), "%s/%s.bin", pc_Dir, parts[i].pc_Label);
+    if (stat(path, &st) == 0) {
+      continue;
+    }
+    file = fopen(path, "wb");
+    if (file == NULL) {
+      fprintf(stderr, "can not create %s\n", path);
+      return false;
+    }
+    for (uint32_t n = 0; n < parts[i].u32_Size; n += sizeof(erased)) {
+      (void)fwrite(erased, 1, sizeof(erased), file);
+    }
+    (void)fclose(file);
+  }
+  return true;
+}
+
+/**
+ * @brief The main task of the application, like on the target it runs
+ *        app_main. Then it plays the scenario and waits for the remaining
+ *        duration or the end of the interactive session.
+ * @param pv_Arg
+ */
+static void FrostSim_Main(void *pv_Arg)
+{
+  (void)pv_Arg;
+  Sim_GpioDrive(IR_SWITCH_GPIO, 1);   // no bottle at power on
+  app_main();
+
+  if (script != false) {
+    (void)Sim_ScenarioRun();
+  }
+  if (duration_us != 0U) {
+    Sim_SleepUntil(duration_us);
+  } else if (script == false) {
+    Sim_SleepUntil(SIM_NEVER);   // interactive, ends with the process
+  }
+  end_us = Sim_NowUs();
+  Sim_Halt();
+  FrostSim_Finish();
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Let main print the results and exit
+ *
+ */
+static void FrostSim_Finish(void)
+{
+  (void)pthread_mutex_lock(&done_lock);
+  done = true;
+  (void)pthread_cond_signal(&done_cond);
+  (void)pthread_mutex_unlock(&done_lock);
+}
+
+/**
+ * @brief Print the command line options
+ *
+ */
+static void FrostSim_Usage(void)
+{
+  fprintf(stderr,
+          "usage: frost_sim [-s script] [-T ms] [-t trace] [-w wav] [-d dir] [-i] [-r]\n"
+          "  -s script  scenario, lines '<time>|+<time> place|lift|drink <time>|gpio <pin> <level>|cmd <line>|\n"
+          "             replay <trace>|end' and blocks 'repeat <n>' ... 'done', see sim_scenario.c\n"
+          "  -T ms      run until this simulated time, also after the script\n"
+          "  -t trace   record GPIO level changes as '<us> in|out <pin> <level>'\n"
+          "  -w wav     record the I2S output\n"
+          "  -d dir     flash partition files, default " FROST_SIM_FLASH_DIR "\n"
+          "  -i         console commands from stdin, implies -r\n"
+          "  -r         real time instead of the virtual clock\n");
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim
+ *  Description        : host simulation of the FROST hardware and kernel. The
+ *                       FreeRTOS API runs on POSIX threads, all blocking goes
+ *                       through one kernel lock and the simulated clock.
+ ******************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define SIM_NEVER                  UINT64_MAX   // deadline of a wait without timeout
+#define SIM_CPU_MHZ                240U         // rate of the simulated cycle counter
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+/* clock and kernel, sim_rtos.c */
+void Sim_Start(bool b_Virtual);
+uint64_t Sim_NowUs(void);
+uint64_t Sim_Steps(void);
+void Sim_Halt(void);
+uint64_t Sim_Cycles(void);
+void Sim_Lock(void);
+void Sim_Unlock(void);
+bool Sim_WaitUntil(uint64_t u64_Us);
+void Sim_WakeAll(void);
+void Sim_SleepUntil(uint64_t u64_Us);
+void Sim_EnterCritical(void);
+void Sim_ExitCritical(void);
+
+/* GPIO, sim_gpio.c */
+void Sim_GpioDrive(uint32_t u32_Pin, uint32_t u32_Level);
+void Sim_GpioTrace(FILE *pst_File);
+uint32_t Sim_GpioChanges(void);
+
+/* I2S, sim_i2s.c */
+bool Sim_I2sRecord(const char *pc_Path);
+void Sim_I2sFinish(uint32_t *pu32_Samples, uint32_t *pu32_Checksum, uint32_t *pu32_Underruns);
+
+/* scenario scripts, sim_scenario.c */
+bool Sim_ScenarioLoad(const char *pc_Path);
+uint64_t Sim_ScenarioRun(void);
+
+/* console, sim_console.c */
+void Sim_ConsoleStdin(void);
+int Sim_ConsoleRun(const char *pc_Line);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_H
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim_console
+ *  Description        : esp_console for the host simulation. The registered
+ *                       commands run from the scenario script, or from stdin
+ *                       when the REPL is enabled with Sim_ConsoleStdin.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_console.h"
+#include "sim.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define SIM_CONSOLE_MAX_CMDS       32U
+#define SIM_CONSOLE_MAX_ARGS       16U
+#define SIM_CONSOLE_LINE           256U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+struct esp_console_repl_s
+{
+  const char *pc_Prompt;
+};
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static int Sim_ConsoleHelp(int argc, char **argv);
+static void *Sim_ConsoleRepl(void *pv_Repl);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static esp_console_cmd_t cmds[SIM_CONSOLE_MAX_CMDS];
+static uint32_t cmd_count = 0;
+static pthread_mutex_t console_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool use_stdin = false;
+static struct esp_console_repl_s repl_uart;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Read commands from stdin once the application starts the REPL
+ *
+ */
+void Sim_ConsoleStdin(void)
+{
+  use_stdin = true;
+}
+
+/**
+ * @brief Run a command line, its output goes to stdout
+ * @param pc_Line : command and arguments separated by blanks
+ * @return return code of the command, -1 if unknown
+ */
+int Sim_ConsoleRun(const char *pc_Line)
+{
+  int ret = -1;
+
+  if (esp_console_run(pc_Line, &ret) == ESP_ERR_NOT_FOUND) {
+    printf("unknown command: %s\n", pc_Line);
+  }
+  (void)fflush(stdout);
+  return ret;
+}
+
+esp_err_t esp_console_new_repl_uart(const esp_console_dev_uart_config_t *dev_config,
+                                    const esp_console_repl_config_t *repl_config, esp_console_repl_t **ret_repl)
+{
+  (void)dev_config;
+  repl_uart.pc_Prompt = (repl_config->prompt != NULL) ? repl_config->prompt : ">";
+  *ret_repl = &repl_uart;
+  return ESP_OK;
+}
+
+esp_err_t esp_console_register_help_command(void)
+{
+  const esp_console_cmd_t help = {
+    .command = "help",
+    .help = "Print the list of registered commands",
+    .hint = NULL,
+    .func = &Sim_ConsoleHelp,
+  };
+  return esp_console_cmd_register(&help);
+}
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t *cmd)
+{
+  esp_err_t err = ESP_ERR_NO_MEM;
+
+  (void)pthread_mutex_lock(&console_lock);
+  if (cmd_count < SIM_CONSOLE_MAX_CMDS) {
+    cmds[cmd_count++] = *cmd;
+    err = ESP_OK;
+  }
+  (void)pthread_mutex_unlock(&console_lock);
+  return err;
+}
+
+esp_err_t esp_console_start_repl(esp_console_repl_t *repl)
+{
+  pthread_t thread;
+
+  if (use_stdin == false) {
+    return ESP_OK;
+  }
+  if (pthread_create(&thread, NULL, Sim_ConsoleRepl, repl) != 0) {
+    return ESP_FAIL;
+  }
+  (void)pthread_detach(thread);
+  return ESP_OK;
+}
+
+esp_err_t esp_console_run(const char *cmdline, int *cmd_ret)
+{
+  char line[SIM_CONSOLE_LINE];
+  char *argv[SIM_CONSOLE_MAX_ARGS];
+  char *save = NULL;
+  int argc = 0;
+  esp_console_cmd_func_t func = NULL;
+
+  (void)snprintf(line, sizeof(line), "%s", cmdline);
+  for (char *tok = strtok_r(line, " \t\r\n", &save); (tok != NULL) && (argc < (int)SIM_CONSOLE_MAX_ARGS);
+       tok = strtok_r(NULL, " \t\r\n", &save)) {
+    argv[argc++] = tok;
+  }
+  if (argc == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  (void)pthread_mutex_lock(&console_lock);
+  for (uint32_t i = 0; i < cmd_count; i++) {
+    if (strcmp(cmds[i].command, argv[0]) == 0) {
+      func = cmds[i].func;
+      break;
+    }
+  }
+  (void)pthread_mutex_unlock(&console_lock);
+
+  if (func == NULL) {
+    return ESP_ERR_NOT_FOUND;
+  }
+  *cmd_ret = func(argc, argv);
+  return ESP_OK;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief help command
+ * @param argc : argument count
+ * @param argv : arguments
+ * @return 0 on success
+ */
+static int Sim_ConsoleHelp(int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+  for (uint32_t i = 0; i < cmd_count; i++) {
+    printf("%s %s\n  %s\n", cmds[i].command, (cmds[i].hint != NULL) ? cmds[i].hint : "", cmds[i].help);
+  }
+  return 0;
+}
+
+/**
+ * @brief REPL thread on stdin, ends with the input
+ * @param pv_Repl : esp_console_repl_s
+ * @return NULL
+ */
+static void *Sim_ConsoleRepl(void *pv_Repl)
+{
+  const struct esp_console_repl_s *repl = pv_Repl;
+  char line[SIM_CONSOLE_LINE];
+
+  while (1) {
+    printf("%s ", repl->pc_Prompt);
+    (void)fflush(stdout);
+    if (fgets(line, sizeof(line), stdin) == NULL) {
+      break;
+    }
+    if (strspn(line, " \t\r\n") != strlen(line)) {
+      (void)Sim_ConsoleRun(line);
+    }
+  }
+  return NULL;
+}
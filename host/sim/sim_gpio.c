@@ -0,0 +1,328 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim_gpio
+ *  Description        : simulated GPIO. An input reads the level driven by the
+ *                       scenario, or its pull when nothing drives it. Level
+ *                       and edge interrupts call the handler in the context
+ *                       that caused them, like an ISR on the one core.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include "driver/gpio.h"
+#include "sim.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Sim_Pin_t
+{
+  gpio_mode_t e_Mode;
+  gpio_pull_mode_t e_Pull;
+  gpio_int_type_t e_Intr;
+  bool b_IntrEnabled;
+  bool b_Driven;             // driven from outside, else the pull sets the level
+  uint32_t u32_In;           // level driven from outside
+  uint32_t u32_Out;          // output latch
+  gpio_isr_t pf_Isr;
+  void *pv_IsrArg;
+} Sim_Pin_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool Sim_GpioValid(gpio_num_t e_Pin);
+static uint32_t Sim_GpioLevel(const Sim_Pin_t *pst_Pin);
+static void Sim_GpioRecord(const char *pc_Dir, uint32_t u32_Pin, uint32_t u32_Level);
+static void Sim_GpioCheckIntr(gpio_num_t e_Pin, int32_t s32_Old);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static pthread_mutex_t gpio_lock = PTHREAD_MUTEX_INITIALIZER;
+static Sim_Pin_t pins[GPIO_NUM_MAX];
+static FILE *trace = NULL;
+static uint32_t changes = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Drive an input from the scenario, interrupts are raised as on the pin
+ * @param u32_Pin : GPIO number
+ * @param u32_Level : 0 or 1
+ */
+void Sim_GpioDrive(uint32_t u32_Pin, uint32_t u32_Level)
+{
+  int32_t old;
+
+  if (Sim_GpioValid((gpio_num_t)u32_Pin) == false) {
+    return;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  old = (int32_t)Sim_GpioLevel(&pins[u32_Pin]);
+  pins[u32_Pin].b_Driven = true;
+  pins[u32_Pin].u32_In = (u32_Level != 0U) ? 1U : 0U;
+  (void)pthread_mutex_unlock(&gpio_lock);
+
+  if ((uint32_t)old != ((u32_Level != 0U) ? 1U : 0U)) {
+    Sim_GpioRecord("in", u32_Pin, (u32_Level != 0U) ? 1U : 0U);
+  }
+  Sim_GpioCheckIntr((gpio_num_t)u32_Pin, old);
+}
+
+/**
+ * @brief Record every level change to a file as "<us> in|out <pin> <level>"
+ * @param pst_File : trace file, NULL stops recording
+ */
+void Sim_GpioTrace(FILE *pst_File)
+{
+  (void)pthread_mutex_lock(&gpio_lock);
+  trace = pst_File;
+  (void)pthread_mutex_unlock(&gpio_lock);
+}
+
+/**
+ * @brief Level changes so far, inputs and outputs
+ * @return count
+ */
+uint32_t Sim_GpioChanges(void)
+{
+  return changes;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  pins[gpio_num].e_Mode = GPIO_MODE_INPUT;
+  pins[gpio_num].e_Pull = GPIO_PULLUP_ONLY;
+  pins[gpio_num].e_Intr = GPIO_INTR_DISABLE;
+  pins[gpio_num].b_IntrEnabled = false;
+  (void)pthread_mutex_unlock(&gpio_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pins[gpio_num].e_Mode = mode;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pins[gpio_num].e_Pull = pull;
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  bool changed;
+
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  level = (level != 0U) ? 1U : 0U;
+  (void)pthread_mutex_lock(&gpio_lock);
+  changed = (pins[gpio_num].u32_Out != level);
+  pins[gpio_num].u32_Out = level;
+  (void)pthread_mutex_unlock(&gpio_lock);
+
+  if (changed != false) {
+    Sim_GpioRecord("out", (uint32_t)gpio_num, level);
+  }
+  return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+  int level;
+
+  if (Sim_GpioValid(gpio_num) == false) {
+    return 0;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  level = (int)Sim_GpioLevel(&pins[gpio_num]);
+  (void)pthread_mutex_unlock(&gpio_lock);
+  return level;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pins[gpio_num].e_Intr = intr_type;
+  return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+  (void)intr_alloc_flags;
+  return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  pins[gpio_num].pf_Isr = isr_handler;
+  pins[gpio_num].pv_IsrArg = args;
+  (void)pthread_mutex_unlock(&gpio_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  pins[gpio_num].b_IntrEnabled = true;
+  (void)pthread_mutex_unlock(&gpio_lock);
+  Sim_GpioCheckIntr(gpio_num, -1);   // a level interrupt fires at once
+  return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+  if (Sim_GpioValid(gpio_num) == false) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  (void)pthread_mutex_lock(&gpio_lock);
+  pins[gpio_num].b_IntrEnabled = false;
+  (void)pthread_mutex_unlock(&gpio_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  /* as in the driver, the wakeup level is also the interrupt type */
+  return gpio_set_intr_type(gpio_num, intr_type);
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
+{
+  return gpio_set_intr_type(gpio_num, GPIO_INTR_DISABLE);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Check a pin number
+ * @param e_Pin : GPIO number
+ * @return false if out of range
+ */
+static bool Sim_GpioValid(gpio_num_t e_Pin)
+{
+  return (e_Pin >= GPIO_NUM_0) && (e_Pin < GPIO_NUM_MAX);
+}
+
+/**
+ * @brief Level seen at a pin, gpio_lock held
+ * @param pst_Pin : pin
+ * @return 0 or 1
+ */
+static uint32_t Sim_GpioLevel(const Sim_Pin_t *pst_Pin)
+{
+  if ((pst_Pin->e_Mode == GPIO_MODE_OUTPUT) || (pst_Pin->e_Mode == GPIO_MODE_INPUT_OUTPUT)) {
+    return pst_Pin->u32_Out;
+  }
+  if (pst_Pin->b_Driven != false) {
+    return pst_Pin->u32_In;
+  }
+  return (pst_Pin->e_Pull == GPIO_PULLUP_ONLY) ? 1U : 0U;
+}
+
+/**
+ * @brief Write a level change to the trace
+ * @param pc_Dir : "in" or "out"
+ * @param u32_Pin : GPIO number
+ * @param u32_Level : new level
+ */
+static void Sim_GpioRecord(const char *pc_Dir, uint32_t u32_Pin, uint32_t u32_Level)
+{
+  (void)pthread_mutex_lock(&gpio_lock);
+  changes++;
+  if (trace != NULL) {
+    fprintf(trace, "%" PRIu64 " %s %u %u\n", Sim_NowUs(), pc_Dir, u32_Pin, u32_Level);
+  }
+  (void)pthread_mutex_unlock(&gpio_lock);
+}
+
+/**
+ * @brief Call the handler if the pin interrupt condition holds
+ * @param e_Pin : GPIO number
+ * @param s32_Old : level before the change, -1 when only the level counts
+ */
+static void Sim_GpioCheckIntr(gpio_num_t e_Pin, int32_t s32_Old)
+{
+  gpio_isr_t isr = NULL;
+  void *arg = NULL;
+  bool fire = false;
+
+  (void)pthread_mutex_lock(&gpio_lock);
+  const Sim_Pin_t *pin = &pins[e_Pin];
+  const int32_t level = (int32_t)Sim_GpioLevel(pin);
+  if ((pin->b_IntrEnabled != false) && (pin->pf_Isr != NULL)) {
+    switch (pin->e_Intr) {
+      case GPIO_INTR_LOW_LEVEL:
+        fire = (level == 0);
+        break;
+      case GPIO_INTR_HIGH_LEVEL:
+        fire = (level == 1);
+        break;
+      case GPIO_INTR_POSEDGE:
+        fire = (s32_Old == 0) && (level == 1);
+        break;
+      case GPIO_INTR_NEGEDGE:
+        fire = (s32_Old == 1) && (level == 0);
+        break;
+      case GPIO_INTR_ANYEDGE:
+        fire = (s32_Old >= 0) && (s32_Old != level);
+        break;
+      default:
+        break;
+    }
+    isr = pin->pf_Isr;
+    arg = pin->pv_IsrArg;
+  }
+  (void)pthread_mutex_unlock(&gpio_lock);
+
+  if (fire != false) {
+    isr(arg);
+  }
+}
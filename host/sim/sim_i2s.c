@@ -0,0 +1,240 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim_i2s
+ *  Description        : simulated I2S PDM TX channel. A DMA task sends one
+ *                       descriptor of dma_frame_num samples per frame time
+ *                       while the channel is enabled, silence when the
+ *                       producer fell behind, and calls the sent callback
+ *                       like the I2S ISR. Sent samples can be recorded.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "driver/i2s_pdm.h"
+#include "freertos/task.h"
+#include "audio_sink.h"
+#include "sim.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Sim_I2s_t
+{
+  i2s_chan_config_t st_Cfg;
+  uint32_t u32_RateHz;
+  i2s_event_callbacks_t st_Cbs;
+  void *pv_User;
+  bool b_Enabled;
+  uint64_t u64_NextUs;       // end of the descriptor being sent
+  int16_t *ps16_Fifo;        // dma_desc_num descriptors of samples
+  uint32_t u32_FifoLen;
+  uint32_t u32_FifoHead;
+  uint32_t u32_FifoCount;
+} Sim_I2s_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Sim_I2sDma(void *pv_Chan);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static bool recording = false;
+static uint32_t underruns = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Record the sent samples, silence of underruns included
+ * @param pc_Path : WAV file, NULL to only count and checksum
+ * @return false if the file can not be created
+ */
+bool Sim_I2sRecord(const char *pc_Path)
+{
+  recording = AudioSinkWav_Open(pc_Path) && AudioSink_Wav.pf_Enable();
+  return recording;
+}
+
+/**
+ * @brief Finish the recording
+ * @param pu32_Samples : samples sent
+ * @param pu32_Checksum : checksum of the samples, see AudioSinkWav_GetChecksum
+ * @param pu32_Underruns : descriptors sent without data
+ */
+void Sim_I2sFinish(uint32_t *pu32_Samples, uint32_t *pu32_Checksum, uint32_t *pu32_Underruns)
+{
+  Sim_Lock();
+  recording = false;
+  Sim_Unlock();
+  AudioSinkWav_Close();
+  *pu32_Samples = AudioSinkWav_GetSamples();
+  *pu32_Checksum = AudioSinkWav_GetChecksum();
+  *pu32_Underruns = underruns;
+}
+
+esp_err_t i2s_new_channel(const i2s_chan_config_t *chan_cfg, i2s_chan_handle_t *ret_tx_handle,
+                          i2s_chan_handle_t *ret_rx_handle)
+{
+  Sim_I2s_t *chan = calloc(1, sizeof(Sim_I2s_t));
+
+  (void)ret_rx_handle;
+  if (chan == NULL) {
+    return ESP_ERR_NO_MEM;
+  }
+  chan->st_Cfg = *chan_cfg;
+  chan->u32_FifoLen = chan_cfg->dma_desc_num * chan_cfg->dma_frame_num;
+  chan->ps16_Fifo = calloc(chan->u32_FifoLen, sizeof(int16_t));
+  if ((chan->ps16_Fifo == NULL) || (xTaskCreate(Sim_I2sDma, "i2s_dma", 0, chan, 24, NULL) != pdPASS)) {
+    free(chan->ps16_Fifo);
+    free(chan);
+    return ESP_ERR_NO_MEM;
+  }
+  *ret_tx_handle = chan;
+  return ESP_OK;
+}
+
+esp_err_t i2s_channel_init_pdm_tx_mode(i2s_chan_handle_t handle, const i2s_pdm_tx_config_t *pdm_tx_cfg)
+{
+  if ((pdm_tx_cfg->slot_cfg.data_bit_width != I2S_DATA_BIT_WIDTH_16BIT) ||
+      (pdm_tx_cfg->slot_cfg.slot_mode != I2S_SLOT_MODE_MONO) || (pdm_tx_cfg->clk_cfg.sample_rate_hz == 0U)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  handle->u32_RateHz = pdm_tx_cfg->clk_cfg.sample_rate_hz;
+  return ESP_OK;
+}
+
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t *callback,
+                                              void *user_data)
+{
+  if (handle->b_Enabled != false) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  handle->st_Cbs = *callback;
+  handle->pv_User = user_data;
+  return ESP_OK;
+}
+
+esp_err_t i2s_channel_enable(i2s_chan_handle_t handle)
+{
+  esp_err_t err = ESP_OK;
+
+  Sim_Lock();
+  if ((handle->b_Enabled != false) || (handle->u32_RateHz == 0U)) {
+    err = ESP_ERR_INVALID_STATE;
+  } else {
+    handle->b_Enabled = true;
+    handle->u32_FifoCount = 0;
+    handle->u64_NextUs = Sim_NowUs() + (((uint64_t)handle->st_Cfg.dma_frame_num * 1000000U) / handle->u32_RateHz);
+    Sim_WakeAll();
+  }
+  Sim_Unlock();
+  return err;
+}
+
+esp_err_t i2s_channel_disable(i2s_chan_handle_t handle)
+{
+  esp_err_t err = ESP_OK;
+
+  Sim_Lock();
+  if (handle->b_Enabled == false) {
+    err = ESP_ERR_INVALID_STATE;
+  }
+  handle->b_Enabled = false;
+  Sim_Unlock();
+  return err;
+}
+
+esp_err_t i2s_channel_write(i2s_chan_handle_t handle, const void *src, size_t size, size_t *bytes_written,
+                            uint32_t timeout_ms)
+{
+  const int16_t *samples = src;
+  uint32_t n = (uint32_t)(size / sizeof(int16_t));
+
+  (void)timeout_ms;   // the audio sink only writes into free descriptors
+  Sim_Lock();
+  if (n > (handle->u32_FifoLen - handle->u32_FifoCount)) {
+    n = handle->u32_FifoLen - handle->u32_FifoCount;
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    handle->ps16_Fifo[(handle->u32_FifoHead + handle->u32_FifoCount) % handle->u32_FifoLen] = samples[i];
+    handle->u32_FifoCount++;
+  }
+  Sim_Unlock();
+  *bytes_written = n * sizeof(int16_t);
+  return ESP_OK;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief DMA of one channel, a task waiting on the simulated clock
+ * @param pv_Chan : Sim_I2s_t
+ */
+static void Sim_I2sDma(void *pv_Chan)
+{
+  Sim_I2s_t *chan = pv_Chan;
+  int16_t *block = calloc(chan->st_Cfg.dma_frame_num, sizeof(int16_t));
+  i2s_event_data_t event = { .data = block, .size = chan->st_Cfg.dma_frame_num * sizeof(int16_t) };
+
+  Sim_Lock();
+  while (1) {
+    if (chan->b_Enabled == false) {
+      (void)Sim_WaitUntil(SIM_NEVER);
+      continue;
+    }
+    if (Sim_WaitUntil(chan->u64_NextUs) != false) {
+      continue;
+    }
+
+    /* descriptor sent: take the next one, silence if the producer is late */
+    const bool late = (chan->u32_FifoCount < chan->st_Cfg.dma_frame_num);
+    for (uint32_t i = 0; i < chan->st_Cfg.dma_frame_num; i++) {
+      block[i] = 0;
+      if (chan->u32_FifoCount > 0U) {
+        block[i] = chan->ps16_Fifo[chan->u32_FifoHead];
+        chan->u32_FifoHead = (chan->u32_FifoHead + 1U) % chan->u32_FifoLen;
+        chan->u32_FifoCount--;
+      }
+    }
+    chan->u64_NextUs += ((uint64_t)chan->st_Cfg.dma_frame_num * 1000000U) / chan->u32_RateHz;
+    if (late != false) {
+      underruns++;
+    }
+    if ((recording != false) && (chan->st_Cfg.dma_frame_num == AUDIO_BLOCK_SAMPLES)) {
+      (void)AudioSink_Wav.pf_Write(block);
+    }
+    Sim_Unlock();
+
+    if ((late != false) && (chan->st_Cbs.on_send_q_ovf != NULL)) {
+      (void)chan->st_Cbs.on_send_q_ovf(chan, &event, chan->pv_User);
+    }
+    if (chan->st_Cbs.on_sent != NULL) {
+      (void)chan->st_Cbs.on_sent(chan, &event, chan->pv_User);
+    }
+    Sim_Lock();
+  }
+}
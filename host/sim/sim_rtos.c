@@ -0,0 +1,939 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim_rtos
+ *  Description        : FreeRTOS kernel API on POSIX threads. Every task is a
+ *                       thread, priorities are not modelled. Queues, notifies,
+ *                       event groups and timers share one kernel lock and one condition,
+ *                       a blocked call waits on it until its deadline on the
+ *                       simulated clock. Timer callbacks and pended functions
+ *                       run in one timer task like in the kernel.
+ *                       The clock is the host clock, or a virtual clock. With
+ *                       the virtual clock one task runs at a time like on a
+ *                       single core, the highest priority ready one first,
+ *                       and the clock jumps to the next deadline when every
+ *                       task is blocked: idle time costs nothing and runs
+ *                       are repeatable. Running tasks are not preempted.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/timers.h"
+#include "sim.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define SIM_TICK_US                (1000000U / configTICK_RATE_HZ)
+#define SIM_PEND_LEN               16U      // pended function calls, timer command queue length
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Sim_Task_t
+{
+  const char *pc_Name;
+  TaskFunction_t pf_Task;
+  void *pv_Arg;
+  pthread_t x_Thread;
+  bool b_Task;               // created by xTaskCreate, scheduled with the virtual clock
+  uint32_t u32_Prio;
+  bool b_Waiting;
+  uint64_t u64_WaitUs;       // deadline while waiting
+  bool b_Ready;
+  uint64_t u64_ReadySeq;     // order of becoming ready, FIFO within a priority
+  pthread_cond_t x_Cond;     // signalled when the task gets the CPU
+  uint32_t u32_Notify;
+  bool b_Started;            // thread running, its CPU time clock can be read
+  bool b_Ended;
+  uint64_t u64_CpuUs;        // thread CPU time when it ended
+  struct Sim_Task_t *pst_Next;
+} Sim_Task_t;
+
+typedef struct Sim_Queue_t
+{
+  uint8_t *pu8_Buf;
+  uint32_t u32_Len;
+  uint32_t u32_ItemSize;
+  uint32_t u32_Head;
+  uint32_t u32_Count;
+} Sim_Queue_t;
+
+typedef struct Sim_Group_t
+{
+  EventBits_t x_Bits;
+} Sim_Group_t;
+
+typedef struct Sim_Timer_t
+{
+  const char *pc_Name;
+  TickType_t x_Period;
+  TickType_t x_Expiry;
+  bool b_Reload;
+  bool b_Active;
+  void *pv_Id;
+  TimerCallbackFunction_t pf_Callback;
+  struct Sim_Timer_t *pst_Next;
+} Sim_Timer_t;
+
+typedef struct Sim_Pend_t
+{
+  PendedFunction_t pf_Func;
+  void *pv_Arg;
+  uint32_t u32_Arg;
+} Sim_Pend_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void *Sim_TaskMain(void *pv_Task);
+static Sim_Task_t *Sim_Current(void);
+static uint64_t Sim_Deadline(TickType_t x_Wait);
+static void Sim_Dispatch(void);
+static void Sim_Advance(void);
+static void Sim_Ready(Sim_Task_t *pst_Task);
+static void Sim_TaskEnd(void);
+static void Sim_TimerTask(void *pv_Arg);
+static uint64_t Sim_CpuUs(clockid_t x_Clock);
+
+/* the bits an event group wait asks for are set, all or any of them */
+#define SIM_BITS_MET(have, want, all) (((all) != pdFALSE) ? (((have) & (want)) == (want)) : (((have) & (want)) != 0U))
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static struct timespec start;
+static time_t start_epoch = 0;
+static bool virtual_clock = false;
+static uint64_t virtual_us = 0;          // read without the kernel lock, written with it
+static Sim_Task_t *cpu = NULL;           // task running with the virtual clock
+static uint64_t ready_seq = 0;
+static bool halted = false;
+static uint64_t steps = 0;               // virtual clock jumps
+static pthread_mutex_t kernel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t kernel_cond;
+static pthread_mutex_t critical_lock;
+static __thread Sim_Task_t *current = NULL;
+static Sim_Task_t *task_list = NULL;
+static Sim_Timer_t *timer_list = NULL;
+static Sim_Pend_t pend[SIM_PEND_LEN];
+static uint32_t pend_head = 0;
+static uint32_t pend_count = 0;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Start the clock and the timer task, call before anything else
+ * @param b_Virtual : virtual clock, else simulated time is host time. All
+ *                    work must then run in tasks, a thread that is not a
+ *                    task does not stop the clock.
+ */
+void Sim_Start(bool b_Virtual)
+{
+  pthread_condattr_t cond_attr;
+  pthread_mutexattr_t mutex_attr;
+  struct timespec epoch;
+
+  virtual_clock = b_Virtual;
+  (void)clock_gettime(CLOCK_MONOTONIC, &start);
+  (void)clock_gettime(CLOCK_REALTIME, &epoch);
+  start_epoch = epoch.tv_sec;
+  (void)pthread_condattr_init(&cond_attr);
+  (void)pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+  (void)pthread_cond_init(&kernel_cond, &cond_attr);
+  (void)pthread_mutexattr_init(&mutex_attr);
+  (void)pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+  (void)pthread_mutex_init(&critical_lock, &mutex_attr);
+
+  (void)xTaskCreate(Sim_TimerTask, "Tmr Svc", 0, NULL, 1, NULL);
+}
+
+/**
+ * @brief Simulated time since Sim_Start
+ * @return microseconds
+ */
+uint64_t Sim_NowUs(void)
+{
+  struct timespec now;
+
+  if (virtual_clock != false) {
+    return __atomic_load_n(&virtual_us, __ATOMIC_ACQUIRE);
+  }
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000U) + (uint64_t)((now.tv_nsec - start.tv_nsec) / 1000);
+}
+
+/**
+ * @brief Virtual clock jumps so far
+ * @return count, 0 with the host clock
+ */
+uint64_t Sim_Steps(void)
+{
+  return steps;
+}
+
+/**
+ * @brief Stop the virtual clock, no task gets the CPU after the caller
+ *        blocks. Results can then be read from a consistent state.
+ *
+ */
+void Sim_Halt(void)
+{
+  Sim_Lock();
+  halted = true;
+  Sim_Unlock();
+}
+
+/**
+ * @brief Cycle counter, host time at SIM_CPU_MHZ
+ * @return cycles
+ */
+uint64_t Sim_Cycles(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec) * SIM_CPU_MHZ / 1000U;
+}
+
+/**
+ * @brief Take the kernel lock, for simulated devices that block like tasks
+ *
+ */
+void Sim_Lock(void)
+{
+  (void)pthread_mutex_lock(&kernel_lock);
+}
+
+/**
+ * @brief Give the kernel lock back
+ *
+ */
+void Sim_Unlock(void)
+{
+  (void)pthread_mutex_unlock(&kernel_lock);
+}
+
+/**
+ * @brief Wait for a change of the kernel state or a deadline, with the
+ *        kernel lock held. Callers check their condition again afterwards.
+ * @param u64_Us : deadline in simulated time, SIM_NEVER for none
+ * @return false once the deadline has passed
+ */
+bool Sim_WaitUntil(uint64_t u64_Us)
+{
+  if (virtual_clock != false) {
+    Sim_Task_t *task = Sim_Current();
+
+    if (virtual_us >= u64_Us) {
+      return false;
+    }
+    if (task->b_Task == false) {
+      (void)pthread_cond_wait(&kernel_cond, &kernel_lock);
+      return virtual_us < u64_Us;
+    }
+    task->b_Waiting = true;
+    task->u64_WaitUs = u64_Us;
+    cpu = NULL;
+    Sim_Dispatch();
+    while (cpu != task) {
+      (void)pthread_cond_wait(&task->x_Cond, &kernel_lock);
+    }
+    return virtual_us < u64_Us;
+  }
+  if (u64_Us == SIM_NEVER) {
+    (void)pthread_cond_wait(&kernel_cond, &kernel_lock);
+    return true;
+  }
+  if (Sim_NowUs() >= u64_Us) {
+    return false;
+  }
+
+  struct timespec at = start;
+  at.tv_sec += (time_t)(u64_Us / 1000000U);
+  at.tv_nsec += (long)((u64_Us % 1000000U) * 1000U);
+  if (at.tv_nsec >= 1000000000L) {
+    at.tv_sec++;
+    at.tv_nsec -= 1000000000L;
+  }
+  (void)pthread_cond_timedwait(&kernel_cond, &kernel_lock, &at);
+  return Sim_NowUs() < u64_Us;
+}
+
+/**
+ * @brief Wake every waiter to check its condition, kernel lock held
+ *
+ */
+void Sim_WakeAll(void)
+{
+  /* the blocked tasks check their condition when they get the CPU */
+  for (Sim_Task_t *task = task_list; task != NULL; task = task->pst_Next) {
+    Sim_Ready(task);
+  }
+  (void)pthread_cond_broadcast(&kernel_cond);
+}
+
+/**
+ * @brief Block the caller until a point in simulated time
+ * @param u64_Us : time
+ */
+void Sim_SleepUntil(uint64_t u64_Us)
+{
+  Sim_Lock();
+  while (Sim_WaitUntil(u64_Us) != false) {
+    /* woken for someone else */
+  }
+  Sim_Unlock();
+}
+
+/**
+ * @brief Critical section, nests like on the target
+ *
+ */
+void Sim_EnterCritical(void)
+{
+  (void)pthread_mutex_lock(&critical_lock);
+}
+
+void Sim_ExitCritical(void)
+{
+  (void)pthread_mutex_unlock(&critical_lock);
+}
+
+/* tasks ******************************************************************* */
+
+BaseType_t xTaskCreate(TaskFunction_t pf_Task, const char *pc_Name, uint32_t u32_Stack, void *pv_Arg,
+                       UBaseType_t u32_Prio, TaskHandle_t *px_Task)
+{
+  Sim_Task_t *task = calloc(1, sizeof(Sim_Task_t));
+
+  (void)u32_Stack;
+  if (task == NULL) {
+    return pdFAIL;
+  }
+  task->pc_Name = pc_Name;
+  task->pf_Task = pf_Task;
+  task->pv_Arg = pv_Arg;
+  task->b_Task = true;
+  task->u32_Prio = u32_Prio;
+  (void)pthread_cond_init(&task->x_Cond, NULL);
+
+  Sim_Lock();
+  task->pst_Next = task_list;
+  task_list = task;
+  if (virtual_clock != false) {
+    task->b_Waiting = true;
+    Sim_Ready(task);
+    if (cpu == NULL) {
+      Sim_Dispatch();   // created before the first task runs
+    }
+  }
+  Sim_Unlock();
+
+  if (px_Task != NULL) {
+    *px_Task = task;
+  }
+  if (pthread_create(&task->x_Thread, NULL, Sim_TaskMain, task) != 0) {
+    return pdFAIL;
+  }
+  (void)pthread_detach(task->x_Thread);
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t x_Task)
+{
+  /* only a task ending itself is supported */
+  if ((x_Task == NULL) || (x_Task == Sim_Current())) {
+    Sim_TaskEnd();
+    pthread_exit(NULL);
+  }
+}
+
+/**
+ * @brief Run time stats like the kernel formats them, one line per task
+ *        with its CPU time in us and its share of the process CPU time
+ * @param pc_Buf : at least 48 bytes per task
+ */
+void vTaskGetRunTimeStats(char *pc_Buf)
+{
+  const uint64_t u64_Total = Sim_CpuUs(CLOCK_PROCESS_CPUTIME_ID);
+
+  pc_Buf[0] = '\0';
+  Sim_Lock();
+  for (Sim_Task_t *task = task_list; task != NULL; task = task->pst_Next) {
+    uint64_t u64_Us = task->u64_CpuUs;
+    clockid_t x_Clock;
+
+    /* an ended thread is gone, its time was taken in Sim_TaskEnd */
+    if ((task->b_Started != false) && (task->b_Ended == false) && (pthread_getcpuclockid(task->x_Thread, &x_Clock) == 0)) {
+      u64_Us = Sim_CpuUs(x_Clock);
+    }
+    pc_Buf += sprintf(pc_Buf, "%-15.15s\t%llu\t\t%llu%%\r\n", task->pc_Name, (unsigned long long)u64_Us,
+                      (unsigned long long)((u64_Total != 0U) ? ((u64_Us * 100U) / u64_Total) : 0U));
+  }
+  Sim_Unlock();
+}
+
+void vTaskDelay(TickType_t x_Ticks)
+{
+  Sim_SleepUntil(Sim_Deadline(x_Ticks));
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+  return (TickType_t)(Sim_NowUs() / SIM_TICK_US);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return Sim_Current();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t x_Clear, TickType_t x_Wait)
+{
+  Sim_Task_t *task = Sim_Current();
+  const uint64_t deadline = Sim_Deadline(x_Wait);
+  uint32_t value;
+
+  Sim_Lock();
+  while ((task->u32_Notify == 0U) && (x_Wait != 0U) && (Sim_WaitUntil(deadline) != false)) {
+    /* wait for a give */
+  }
+  value = task->u32_Notify;
+  if (value > 0U) {
+    task->u32_Notify = (x_Clear != pdFALSE) ? 0U : (value - 1U);
+  }
+  Sim_Unlock();
+  return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t x_Task)
+{
+  Sim_Lock();
+  x_Task->u32_Notify++;
+  Sim_WakeAll();
+  Sim_Unlock();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t x_Task, BaseType_t *px_Woken)
+{
+  (void)xTaskNotifyGive(x_Task);
+  if (px_Woken != NULL) {
+    *px_Woken = pdTRUE;
+  }
+}
+
+/* queues and mutexes ****************************************************** */
+
+QueueHandle_t xQueueCreate(UBaseType_t u32_Len, UBaseType_t u32_ItemSize)
+{
+  Sim_Queue_t *queue = calloc(1, sizeof(Sim_Queue_t));
+
+  if (queue != NULL) {
+    queue->u32_Len = u32_Len;
+    queue->u32_ItemSize = u32_ItemSize;
+    queue->pu8_Buf = calloc(u32_Len, (u32_ItemSize > 0U) ? u32_ItemSize : 1U);
+    if (queue->pu8_Buf == NULL) {
+      free(queue);
+      queue = NULL;
+    }
+  }
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t x_Queue)
+{
+  if (x_Queue != NULL) {
+    free(x_Queue->pu8_Buf);
+    free(x_Queue);
+  }
+}
+
+BaseType_t xQueueSend(QueueHandle_t x_Queue, const void *pv_Item, TickType_t x_Wait)
+{
+  const uint64_t deadline = Sim_Deadline(x_Wait);
+  BaseType_t ret = pdFAIL;
+
+  Sim_Lock();
+  while ((x_Queue->u32_Count == x_Queue->u32_Len) && (x_Wait != 0U) && (Sim_WaitUntil(deadline) != false)) {
+    /* wait for space */
+  }
+  if (x_Queue->u32_Count < x_Queue->u32_Len) {
+    const uint32_t slot = (x_Queue->u32_Head + x_Queue->u32_Count) % x_Queue->u32_Len;
+    if (x_Queue->u32_ItemSize > 0U) {
+      (void)memcpy(&x_Queue->pu8_Buf[slot * x_Queue->u32_ItemSize], pv_Item, x_Queue->u32_ItemSize);
+    }
+    x_Queue->u32_Count++;
+    Sim_WakeAll();
+    ret = pdPASS;
+  }
+  Sim_Unlock();
+  return ret;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t x_Queue, const void *pv_Item, BaseType_t *px_Woken)
+{
+  if (px_Woken != NULL) {
+    *px_Woken = pdTRUE;
+  }
+  return xQueueSend(x_Queue, pv_Item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t x_Queue, void *pv_Item, TickType_t x_Wait)
+{
+  const uint64_t deadline = Sim_Deadline(x_Wait);
+  BaseType_t ret = pdFAIL;
+
+  Sim_Lock();
+  while ((x_Queue->u32_Count == 0U) && (x_Wait != 0U) && (Sim_WaitUntil(deadline) != false)) {
+    /* wait for an item */
+  }
+  if (x_Queue->u32_Count > 0U) {
+    if (x_Queue->u32_ItemSize > 0U) {
+      (void)memcpy(pv_Item, &x_Queue->pu8_Buf[x_Queue->u32_Head * x_Queue->u32_ItemSize], x_Queue->u32_ItemSize);
+    }
+    x_Queue->u32_Head = (x_Queue->u32_Head + 1U) % x_Queue->u32_Len;
+    x_Queue->u32_Count--;
+    Sim_WakeAll();
+    ret = pdPASS;
+  }
+  Sim_Unlock();
+  return ret;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t x_Queue)
+{
+  UBaseType_t count;
+
+  Sim_Lock();
+  count = x_Queue->u32_Count;
+  Sim_Unlock();
+  return count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  QueueHandle_t mutex = xQueueCreate(1, 0);
+
+  if (mutex != NULL) {
+    mutex->u32_Count = 1U;   // available
+  }
+  return mutex;
+}
+
+/* event groups ************************************************************ */
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+  return calloc(1, sizeof(Sim_Group_t));
+}
+
+void vEventGroupDelete(EventGroupHandle_t x_Group)
+{
+  free(x_Group);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t x_Group, EventBits_t x_Bits)
+{
+  EventBits_t bits;
+
+  Sim_Lock();
+  x_Group->x_Bits |= x_Bits;
+  bits = x_Group->x_Bits;
+  Sim_WakeAll();
+  Sim_Unlock();
+  return bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t x_Group, EventBits_t x_Bits)
+{
+  EventBits_t bits;
+
+  Sim_Lock();
+  bits = x_Group->x_Bits;
+  x_Group->x_Bits &= ~x_Bits;
+  Sim_Unlock();
+  return bits;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t x_Group)
+{
+  EventBits_t bits;
+
+  Sim_Lock();
+  bits = x_Group->x_Bits;
+  Sim_Unlock();
+  return bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t x_Group, EventBits_t x_Bits, BaseType_t x_Clear, BaseType_t x_All,
+                                TickType_t x_Wait)
+{
+  const uint64_t deadline = Sim_Deadline(x_Wait);
+  EventBits_t bits;
+
+  Sim_Lock();
+  while ((SIM_BITS_MET(x_Group->x_Bits, x_Bits, x_All) == false) && (x_Wait != 0U) &&
+         (Sim_WaitUntil(deadline) != false)) {
+    /* wait for a set */
+  }
+  bits = x_Group->x_Bits;
+  if (SIM_BITS_MET(bits, x_Bits, x_All) && (x_Clear != pdFALSE)) {
+    x_Group->x_Bits &= ~x_Bits;
+  }
+  Sim_Unlock();
+  return bits;
+}
+
+/* timers ****************************************************************** */
+
+TimerHandle_t xTimerCreate(const char *pc_Name, TickType_t x_Period, BaseType_t x_AutoReload, void *pv_Id,
+                           TimerCallbackFunction_t pf_Callback)
+{
+  Sim_Timer_t *timer = calloc(1, sizeof(Sim_Timer_t));
+
+  if (timer != NULL) {
+    timer->pc_Name = pc_Name;
+    timer->x_Period = x_Period;
+    timer->b_Reload = (x_AutoReload != pdFALSE);
+    timer->pv_Id = pv_Id;
+    timer->pf_Callback = pf_Callback;
+    Sim_Lock();
+    timer->pst_Next = timer_list;
+    timer_list = timer;
+    Sim_Unlock();
+  }
+  return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  Sim_Lock();
+  x_Timer->x_Expiry = xTaskGetTickCount() + x_Timer->x_Period;
+  x_Timer->b_Active = true;
+  Sim_WakeAll();
+  Sim_Unlock();
+  return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  (void)x_Wait;
+  Sim_Lock();
+  x_Timer->b_Active = false;
+  Sim_Unlock();
+  return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t x_Timer, TickType_t x_Wait)
+{
+  return xTimerStart(x_Timer, x_Wait);
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t x_Timer, TickType_t x_Period, TickType_t x_Wait)
+{
+  Sim_Lock();
+  x_Timer->x_Period = x_Period;
+  Sim_Unlock();
+  return xTimerStart(x_Timer, x_Wait);
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t x_Timer)
+{
+  BaseType_t active;
+
+  Sim_Lock();
+  active = (x_Timer->b_Active != false) ? pdTRUE : pdFALSE;
+  Sim_Unlock();
+  return active;
+}
+
+TickType_t xTimerGetExpiryTime(TimerHandle_t x_Timer)
+{
+  return x_Timer->x_Expiry;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t x_Timer)
+{
+  return x_Timer->pv_Id;
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t pf_Func, void *pv_Arg, uint32_t u32_Arg, TickType_t x_Wait)
+{
+  const uint64_t deadline = Sim_Deadline(x_Wait);
+  BaseType_t ret = pdFAIL;
+
+  Sim_Lock();
+  while ((pend_count == SIM_PEND_LEN) && (x_Wait != 0U) && (Sim_WaitUntil(deadline) != false)) {
+    /* wait for the timer task */
+  }
+  if (pend_count < SIM_PEND_LEN) {
+    Sim_Pend_t *call = &pend[(pend_head + pend_count) % SIM_PEND_LEN];
+    call->pf_Func = pf_Func;
+    call->pv_Arg = pv_Arg;
+    call->u32_Arg = u32_Arg;
+    pend_count++;
+    Sim_WakeAll();
+    ret = pdPASS;
+  }
+  Sim_Unlock();
+  return ret;
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t pf_Func, void *pv_Arg, uint32_t u32_Arg,
+                                         BaseType_t *px_Woken)
+{
+  if (px_Woken != NULL) {
+    *px_Woken = pdTRUE;
+  }
+  return xTimerPendFunctionCall(pf_Func, pv_Arg, u32_Arg, 0);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Thread body of a task
+ * @param pv_Task : Sim_Task_t
+ * @return NULL
+ */
+static void *Sim_TaskMain(void *pv_Task)
+{
+  Sim_Task_t *task = pv_Task;
+
+  current = task;
+  Sim_Lock();
+  task->b_Started = true;
+  while ((virtual_clock != false) && (cpu != task)) {
+    (void)pthread_cond_wait(&task->x_Cond, &kernel_lock);
+  }
+  Sim_Unlock();
+  task->pf_Task(task->pv_Arg);
+  Sim_TaskEnd();
+  return NULL;
+}
+
+/**
+ * @brief Task of the calling thread, threads not created by xTaskCreate
+ *        (main, the console reader) get one on first use
+ * @return task
+ */
+static Sim_Task_t *Sim_Current(void)
+{
+  if (current == NULL) {
+    current = calloc(1, sizeof(Sim_Task_t));
+    current->pc_Name = "thread";
+    current->x_Thread = pthread_self();
+  }
+  return current;
+}
+
+/**
+ * @brief Deadline of a wait in ticks, at a tick boundary like the kernel
+ * @param x_Wait : ticks, portMAX_DELAY for none
+ * @return simulated time
+ */
+static uint64_t Sim_Deadline(TickType_t x_Wait)
+{
+  if (x_Wait == portMAX_DELAY) {
+    return SIM_NEVER;
+  }
+  return ((uint64_t)xTaskGetTickCount() + x_Wait) * SIM_TICK_US;
+}
+
+/**
+ * @brief Give the CPU to the highest priority ready task, the one ready
+ *        first among equals. With none ready, the virtual clock moves to the
+ *        earliest deadline. Kernel lock held, CPU free.
+ *
+ */
+static void Sim_Dispatch(void)
+{
+  Sim_Task_t *next = NULL;
+
+  if (halted != false) {
+    return;
+  }
+  for (uint32_t pass = 0; (pass < 2U) && (next == NULL); pass++) {
+    if (pass > 0U) {
+      Sim_Advance();
+    }
+    for (Sim_Task_t *task = task_list; task != NULL; task = task->pst_Next) {
+      if ((task->b_Ready != false) &&
+          ((next == NULL) || (task->u32_Prio > next->u32_Prio) ||
+           ((task->u32_Prio == next->u32_Prio) && (task->u64_ReadySeq < next->u64_ReadySeq)))) {
+        next = task;
+      }
+    }
+  }
+  if (next == NULL) {
+    return;   // nothing will ever happen
+  }
+  next->b_Ready = false;
+  cpu = next;
+  if (next != current) {
+    (void)pthread_cond_signal(&next->x_Cond);
+  }
+}
+
+/**
+ * @brief Every task is blocked: move the virtual clock to the earliest
+ *        deadline and make the tasks due ready. Kernel lock held.
+ *
+ */
+static void Sim_Advance(void)
+{
+  uint64_t next = SIM_NEVER;
+
+  for (const Sim_Task_t *task = task_list; task != NULL; task = task->pst_Next) {
+    if ((task->b_Waiting != false) && (task->u64_WaitUs < next)) {
+      next = task->u64_WaitUs;
+    }
+  }
+  if (next == SIM_NEVER) {
+    return;
+  }
+  if (next > virtual_us) {
+    __atomic_store_n(&virtual_us, next, __ATOMIC_RELEASE);
+    steps++;
+  }
+  for (Sim_Task_t *task = task_list; task != NULL; task = task->pst_Next) {
+    if ((task->b_Waiting != false) && (task->u64_WaitUs <= next)) {
+      Sim_Ready(task);
+    }
+  }
+}
+
+/**
+ * @brief A blocked task may run again, kernel lock held
+ * @param pst_Task : task
+ */
+static void Sim_Ready(Sim_Task_t *pst_Task)
+{
+  if (pst_Task->b_Waiting != false) {
+    pst_Task->b_Waiting = false;
+    pst_Task->b_Ready = true;
+    pst_Task->u64_ReadySeq = ready_seq++;
+  }
+}
+
+/**
+ * @brief A task ends and gives the CPU away
+ *
+ */
+static void Sim_TaskEnd(void)
+{
+  Sim_Lock();
+  Sim_Task_t *task = Sim_Current();
+  task->u64_CpuUs = Sim_CpuUs(CLOCK_THREAD_CPUTIME_ID);
+  task->b_Ended = true;
+  if ((virtual_clock != false) && (task->b_Task != false)) {
+    task->b_Task = false;
+    cpu = NULL;
+    Sim_Dispatch();
+  }
+  Sim_Unlock();
+}
+
+/**
+ * @brief Timer task, runs the pended functions in order and the timer
+ *        callbacks when they expire, the earliest first
+ * @param pv_Arg
+ */
+static void Sim_TimerTask(void *pv_Arg)
+{
+  (void)pv_Arg;
+  Sim_Lock();
+  while (1) {
+    Sim_Timer_t *next = NULL;
+
+    if (pend_count > 0U) {
+      const Sim_Pend_t call = pend[pend_head];
+      pend_head = (pend_head + 1U) % SIM_PEND_LEN;
+      pend_count--;
+      Sim_WakeAll();
+      Sim_Unlock();
+      call.pf_Func(call.pv_Arg, call.u32_Arg);
+      Sim_Lock();
+      continue;
+    }
+
+    for (Sim_Timer_t *timer = timer_list; timer != NULL; timer = timer->pst_Next) {
+      if ((timer->b_Active != false) && ((next == NULL) || (timer->x_Expiry < next->x_Expiry))) {
+        next = timer;
+      }
+    }
+
+    if ((next != NULL) && (next->x_Expiry <= xTaskGetTickCount())) {
+      if (next->b_Reload != false) {
+        next->x_Expiry += (next->x_Period > 0U) ? next->x_Period : 1U;
+      } else {
+        next->b_Active = false;
+      }
+      Sim_Unlock();
+      next->pf_Callback(next);
+      Sim_Lock();
+    } else {
+      (void)Sim_WaitUntil((next != NULL) ? ((uint64_t)next->x_Expiry * SIM_TICK_US) : SIM_NEVER);
+    }
+  }
+}
+
+/**
+ * @brief Wall clock of the device, host time at Sim_Start plus simulated
+ *        time. Replaces the C library time() for the application, syssm
+ *        stamps journal records and deep sleep snapshots with it.
+ * @param pt_Time : also set when not NULL
+ * @return seconds since the epoch
+ */
+time_t time(time_t *pt_Time)
+{
+  const time_t now = start_epoch + (time_t)(Sim_NowUs() / 1000000U);
+
+  if (pt_Time != NULL) {
+    *pt_Time = now;
+  }
+  return now;
+}
+
+/**
+ * @brief CPU time of a clock
+ * @param x_Clock : CPU time clock
+ * @return us
+ */
+static uint64_t Sim_CpuUs(clockid_t x_Clock)
+{
+  struct timespec now;
+
+  if (clock_gettime(x_Clock, &now) != 0) {
+    return 0;
+  }
+  return ((uint64_t)now.tv_sec * 1000000U) + ((uint64_t)now.tv_nsec / 1000U);
+}
@@ -0,0 +1,410 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : sim_scenario
+ *  Description        : scenario scripts of the host simulation. One action
+ *                       per line at an absolute time or after the previous
+ *                       line, blocks of lines can be repeated:
+ *
+ *                         # a week of drinking, cleaned every evening
+ *                         0           place
+ *                         repeat 7
+ *                           repeat 10
+ *                             +90m    drink 20s
+ *                           done
+ *                           +9h       lift
+ *                           +20m      place
+ *                         done
+ *
+ *                       Times are a number with the units d, h, m, s or ms,
+ *                       also combined like 1h30m, a plain number is ms.
+ *                       'replay <trace>' plays a recorded input trace into
+ *                       the IR switch, the next line follows its end.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_switch.h"
+#include "pin_config.h"
+#include "sim.h"
+#include "trace_file.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define SIM_SCENARIO_LINE          256U
+#define SIM_SCENARIO_MAX_STEPS     1024U
+#define SIM_SCENARIO_MAX_DEPTH     8U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef enum Sim_Op_t
+{
+  SIM_OP_PLACE = 0,
+  SIM_OP_LIFT,
+  SIM_OP_GPIO,
+  SIM_OP_CMD,
+  SIM_OP_REPLAY,
+  SIM_OP_END,
+  SIM_OP_REPEAT,
+  SIM_OP_DONE,
+} Sim_Op_t;
+
+typedef struct Sim_Step_t
+{
+  Sim_Op_t e_Op;
+  bool b_Relative;           // time after the previous step
+  uint64_t u64_Us;           // time
+  uint32_t u32_Arg1;         // GPIO pin, repeat count
+  uint32_t u32_Arg2;         // GPIO level, step of the done closing a repeat
+  char *pc_Cmd;              // console line
+  TraceFile_t *pst_Trace;    // input trace to replay
+  uint32_t u32_Line;
+} Sim_Step_t;
+
+typedef struct Sim_Loop_t
+{
+  uint32_t u32_Start;        // first step of the block
+  uint32_t u32_Left;         // passes still to run
+} Sim_Loop_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static bool Sim_ScenarioParse(char *pc_Line, uint32_t u32_Line, uint32_t *pu32_Open, uint32_t *pu32_Depth);
+static bool Sim_ScenarioTime(const char *pc_Tok, uint64_t *pu64_Us);
+static void Sim_ScenarioBottle(bool b_Present);
+static uint64_t Sim_ScenarioReplay(const TraceFile_t *pst_Trace, uint64_t u64_At);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Sim_Step_t steps[SIM_SCENARIO_MAX_STEPS];
+static uint32_t step_count = 0;
+static uint32_t open_blocks[SIM_SCENARIO_MAX_DEPTH];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Read and check a scenario, errors are printed with the line number
+ * @param pc_Path : script file
+ * @return false if the file can not be read or has an error
+ */
+bool Sim_ScenarioLoad(const char *pc_Path)
+{
+  char line[SIM_SCENARIO_LINE];
+  uint32_t n = 0;
+  uint32_t depth = 0;
+  bool ok = true;
+  FILE *file = fopen(pc_Path, "r");
+
+  if (file == NULL) {
+    fprintf(stderr, "can not open %s\n", pc_Path);
+    return false;
+  }
+  while ((ok != false) && (fgets(line, sizeof(line), file) != NULL)) {
+    n++;
+    ok = Sim_ScenarioParse(line, n, open_blocks, &depth);
+  }
+  (void)fclose(file);
+
+  if ((ok != false) && (depth > 0U)) {
+    fprintf(stderr, "line %u: repeat without done\n", steps[open_blocks[depth - 1U]].u32_Line);
+    ok = false;
+  }
+  return ok;
+}
+
+/**
+ * @brief Run the loaded scenario in the calling task, each step waits for
+ *        its time on the simulated clock
+ * @return simulated time of the last step
+ */
+uint64_t Sim_ScenarioRun(void)
+{
+  Sim_Loop_t loops[SIM_SCENARIO_MAX_DEPTH];
+  uint32_t depth = 0;
+  uint64_t at = 0;
+  uint32_t i = 0;
+
+  while (i < step_count) {
+    const Sim_Step_t *step = &steps[i];
+
+    if (step->e_Op == SIM_OP_REPEAT) {
+      if (step->u32_Arg1 == 0U) {
+        i = step->u32_Arg2 + 1U;    // skip the block
+      } else {
+        loops[depth].u32_Start = i + 1U;
+        loops[depth].u32_Left = step->u32_Arg1;
+        depth++;
+        i++;
+      }
+      continue;
+    }
+    if (step->e_Op == SIM_OP_DONE) {
+      loops[depth - 1U].u32_Left--;
+      if (loops[depth - 1U].u32_Left > 0U) {
+        i = loops[depth - 1U].u32_Start;
+      } else {
+        depth--;
+        i++;
+      }
+      continue;
+    }
+
+    at = (step->b_Relative != false) ? (at + step->u64_Us) : step->u64_Us;
+    Sim_SleepUntil(at);
+
+    switch (step->e_Op) {
+      case SIM_OP_PLACE:
+        Sim_ScenarioBottle(true);
+        break;
+      case SIM_OP_LIFT:
+        Sim_ScenarioBottle(false);
+        break;
+      case SIM_OP_GPIO:
+        Sim_GpioDrive(step->u32_Arg1, step->u32_Arg2);
+        break;
+      case SIM_OP_CMD:
+        printf("[%" PRIu64 " ms] %s\n", Sim_NowUs() / 1000U, step->pc_Cmd);
+        (void)Sim_ConsoleRun(step->pc_Cmd);
+        break;
+      case SIM_OP_REPLAY:
+        at = Sim_ScenarioReplay(step->pst_Trace, at);
+        break;
+      default:
+        break;
+    }
+    if (step->e_Op == SIM_OP_END) {
+      break;
+    }
+    i++;
+  }
+  return at;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Parse one line into the step table
+ * @param pc_Line : line, modified
+ * @param u32_Line : line number for errors
+ * @param pu32_Open : steps of the repeat blocks not closed yet
+ * @param pu32_Depth : number of open blocks
+ * @return false on an error
+ */
+static bool Sim_ScenarioParse(char *pc_Line, uint32_t u32_Line, uint32_t *pu32_Open, uint32_t *pu32_Depth)
+{
+  char *save = NULL;
+  char *tok;
+  char *rest;
+  Sim_Step_t step = { .u32_Line = u32_Line };
+
+  pc_Line[strcspn(pc_Line, "#\r\n")] = '\0';
+  tok = strtok_r(pc_Line, " \t", &save);
+  if (tok == NULL) {
+    return true;
+  }
+  if (step_count == SIM_SCENARIO_MAX_STEPS) {
+    fprintf(stderr, "line %u: more than %u steps\n", u32_Line, SIM_SCENARIO_MAX_STEPS);
+    return false;
+  }
+
+  /* block lines have no time */
+  if (strcmp(tok, "repeat") == 0) {
+    tok = strtok_r(NULL, " \t", &save);
+    if ((tok == NULL) || (*pu32_Depth == SIM_SCENARIO_MAX_DEPTH)) {
+      fprintf(stderr, "line %u: repeat <count>, at most %u deep\n", u32_Line, SIM_SCENARIO_MAX_DEPTH);
+      return false;
+    }
+    step.e_Op = SIM_OP_REPEAT;
+    step.u32_Arg1 = (uint32_t)strtoul(tok, NULL, 0);
+    pu32_Open[(*pu32_Depth)++] = step_count;
+    steps[step_count++] = step;
+    return true;
+  }
+  if (strcmp(tok, "done") == 0) {
+    if (*pu32_Depth == 0U) {
+      fprintf(stderr, "line %u: done without repeat\n", u32_Line);
+      return false;
+    }
+    step.e_Op = SIM_OP_DONE;
+    steps[pu32_Open[--(*pu32_Depth)]].u32_Arg2 = step_count;
+    steps[step_count++] = step;
+    return true;
+  }
+
+  step.b_Relative = (tok[0] == '+');
+  if (Sim_ScenarioTime(step.b_Relative ? &tok[1] : tok, &step.u64_Us) == false) {
+    fprintf(stderr, "line %u: bad time %s\n", u32_Line, tok);
+    return false;
+  }
+  if ((step.b_Relative == false) && (*pu32_Depth > 0U)) {
+    fprintf(stderr, "line %u: times in a repeat block are relative\n", u32_Line);
+    return false;
+  }
+  tok = strtok_r(NULL, " \t", &save);
+  rest = strtok_r(NULL, "", &save);
+  if (tok == NULL) {
+    fprintf(stderr, "line %u: missing action\n", u32_Line);
+    return false;
+  }
+
+  if (strcmp(tok, "place") == 0) {
+    step.e_Op = SIM_OP_PLACE;
+  } else if (strcmp(tok, "lift") == 0) {
+    step.e_Op = SIM_OP_LIFT;
+  } else if (strcmp(tok, "end") == 0) {
+    step.e_Op = SIM_OP_END;
+  } else if (strcmp(tok, "drink") == 0) {
+    /* lift now, place back after the duration, expands into two steps */
+    uint64_t sip_us;
+    if ((rest == NULL) || (Sim_ScenarioTime(strtok_r(rest, " \t", &save), &sip_us) == false) ||
+        (step_count + 1U == SIM_SCENARIO_MAX_STEPS)) {
+      fprintf(stderr, "line %u: drink <duration>\n", u32_Line);
+      return false;
+    }
+    step.e_Op = SIM_OP_LIFT;
+    steps[step_count++] = step;
+    step.e_Op = SIM_OP_PLACE;
+    step.b_Relative = true;
+    step.u64_Us = sip_us;
+  } else if (strcmp(tok, "gpio") == 0) {
+    unsigned pin;
+    unsigned level;
+    if ((rest == NULL) || (sscanf(rest, "%u %u", &pin, &level) != 2)) {
+      fprintf(stderr, "line %u: gpio <pin> <level>\n", u32_Line);
+      return false;
+    }
+    step.e_Op = SIM_OP_GPIO;
+    step.u32_Arg1 = pin;
+    step.u32_Arg2 = level;
+  } else if (strcmp(tok, "replay") == 0) {
+    step.e_Op = SIM_OP_REPLAY;
+    step.pst_Trace = calloc(1, sizeof(TraceFile_t));
+    if ((rest == NULL) || (step.pst_Trace == NULL) ||
+        (TraceFile_Load(strtok_r(rest, " \t", &save), step.pst_Trace) == false)) {
+      fprintf(stderr, "line %u: replay <trace>\n", u32_Line);
+      return false;
+    }
+  } else if ((strcmp(tok, "cmd") == 0) && (rest != NULL)) {
+    step.e_Op = SIM_OP_CMD;
+    step.pc_Cmd = strdup(rest);
+  } else {
+    fprintf(stderr, "line %u: unknown action %s\n", u32_Line, tok);
+    return false;
+  }
+  steps[step_count++] = step;
+  return true;
+}
+
+/**
+ * @brief Parse a time like 90m, 1h30m, 2d or 500 (ms)
+ * @param pc_Tok : text
+ * @param pu64_Us : microseconds
+ * @return false if not a time
+ */
+static bool Sim_ScenarioTime(const char *pc_Tok, uint64_t *pu64_Us)
+{
+  uint64_t us = 0;
+
+  if ((pc_Tok == NULL) || (*pc_Tok == '\0')) {
+    return false;
+  }
+  while (*pc_Tok != '\0') {
+    char *end;
+    const uint64_t value = strtoull(pc_Tok, &end, 10);
+
+    if (end == pc_Tok) {
+      return false;
+    }
+    if ((strncmp(end, "ms", 2) == 0) || (*end == '\0')) {
+      us += value * 1000U;
+      end += (*end != '\0') ? 2 : 0;
+    } else if (*end == 's') {
+      us += value * 1000000U;
+      end++;
+    } else if (*end == 'm') {
+      us += value * 60U * 1000000U;
+      end++;
+    } else if (*end == 'h') {
+      us += value * 3600U * 1000000U;
+      end++;
+    } else if (*end == 'd') {
+      us += value * 86400U * 1000000U;
+      end++;
+    } else {
+      return false;
+    }
+    pc_Tok = end;
+  }
+  *pu64_Us = us;
+  return true;
+}
+
+/**
+ * @brief Put the bottle on the IR switch or take it away, the switch pulls
+ *        the line low while a bottle is present, see GetIRswitchStatus
+ * @param b_Present : bottle placed
+ */
+static void Sim_ScenarioBottle(bool b_Present)
+{
+  Sim_GpioDrive(IR_SWITCH_GPIO, (b_Present != false) ? 0U : 1U);
+}
+
+/**
+ * @brief Drive the IR switch with the levels of a trace. A sample only shows
+ *        that the level changed since the previous one, it is driven one
+ *        poll before the sample, or right after the previous sample when
+ *        they are closer. That also wakes the firmware from light sleep at
+ *        the time it did when the trace was recorded.
+ * @param pst_Trace : input trace
+ * @param u64_At : simulated time of the first word
+ * @return simulated time of the last sample
+ */
+static uint64_t Sim_ScenarioReplay(const TraceFile_t *pst_Trace, uint64_t u64_At)
+{
+  TraceFile_Iter_t it;
+  TraceFile_Sample_t sample;
+  uint64_t prev_ms = pst_Trace->u32_FirstMs;
+  uint32_t level = 2U;   // none yet
+
+  TraceFile_Begin(pst_Trace, &it);
+  while (TraceFile_Next(&it, &sample) != false) {
+    if (sample.e_Src != INPUT_TRACE_SRC_IR) {
+      continue;
+    }
+    if (sample.u32_Level != level) {
+      uint64_t ms = sample.u64_Ms - IR_SWITCH_SAMPLE_MS;
+
+      if ((sample.u64_Ms < IR_SWITCH_SAMPLE_MS) || (ms <= prev_ms)) {
+        ms = prev_ms + 1U;
+      }
+      level = sample.u32_Level;
+      Sim_SleepUntil(u64_At + ((ms - pst_Trace->u32_FirstMs) * 1000U));
+      Sim_GpioDrive(IR_SWITCH_GPIO, level);
+    }
+    prev_ms = sample.u64_Ms;
+  }
+  return u64_At + ((it.u64_Ms - pst_Trace->u32_FirstMs) * 1000U);
+}
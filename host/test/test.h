@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test
+ *  Description        : checks and timing for the host tests, one test
+ *                       program per module, run by ctest. A failed check
+ *                       prints its line and makes the program exit 1.
+ ******************************************************************************/
+
+#ifndef TEST_H
+#define TEST_H
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/******************************************************************************/
+/* PUBLIC DEFINITIONS                                                         */
+/******************************************************************************/
+#define TEST_CHECK(cond, ...)                                                                   \
+  do {                                                                                          \
+    if (!(cond)) {                                                                              \
+      Test_Fail(__FILE__, __LINE__, __VA_ARGS__);                                               \
+    }                                                                                           \
+  } while (0)
+
+/******************************************************************************/
+/* PUBLIC DATA DECLARATIONS                                                   */
+/******************************************************************************/
+static uint32_t test_failed = 0;
+static volatile int32_t test_sink = 0;   // keeps benchmarked results alive
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Report a failed check, see TEST_CHECK
+ * @param pc_File : source file
+ * @param s32_Line : line
+ * @param pc_Fmt : printf format of the message
+ */
+static inline void Test_Fail(const char *pc_File, int s32_Line, const char *pc_Fmt, ...)
+{
+  va_list args;
+
+  printf("FAIL %s:%d: ", pc_File, s32_Line);
+  va_start(args, pc_Fmt);
+  vprintf(pc_Fmt, args);
+  va_end(args);
+  printf("\n");
+  test_failed++;
+}
+
+/**
+ * @brief Host monotonic clock
+ * @return s
+ */
+static inline double Test_Now(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/**
+ * @brief Summary line and exit code of main
+ * @param pc_Name : test
+ * @return 0 if every check passed
+ */
+static inline int Test_Exit(const char *pc_Name)
+{
+  printf("%s: %s\n", pc_Name, (test_failed == 0U) ? "pass" : "FAIL");
+  return (test_failed == 0U) ? 0 : 1;
+}
+
+#endif // TEST_H
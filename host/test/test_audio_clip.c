@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_audio_clip
+ *  Description        : IMA-ADPCM clips packed by tools/clip_packer.py and
+ *                       decoded by audio_clip: error against the source
+ *                       WAV, exact length, same output for any block size,
+ *                       and the decode throughput as CPU share at 16 kHz
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_clip.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_RATE_HZ              16000U
+#define TEST_BLOCK                256U
+#define TEST_WAV_HDR              44U       // canonical header of the python wave module
+#define TEST_MAX_SAMPLES          (4U * TEST_RATE_HZ)
+#define TEST_MIN_SNR_DB           20.0      // 4 bit ADPCM, a packer/decoder mismatch is far below
+#define TEST_BENCH_SAMPLES        (64U * 1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Test_ReadWav(const char *pc_Name, int16_t *ps16_Buf);
+static uint32_t Test_Decode(uint16_t u16_Clip, uint32_t u32_Block, int16_t *ps16_Buf);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* clip ids in the order test_clips.py packs them */
+static const char *const test_wav[] = { "tone.wav", "sweep.wav" };
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  int16_t *ref = malloc(TEST_MAX_SAMPLES * sizeof(int16_t));
+  int16_t *out = malloc(TEST_MAX_SAMPLES * sizeof(int16_t));
+  int16_t *odd = malloc(TEST_MAX_SAMPLES * sizeof(int16_t));
+  const uint16_t clips = sizeof(test_wav) / sizeof(test_wav[0]);
+
+  (void)setenv("FROST_FLASH_DIR", TEST_CLIP_DIR, 1);
+  TEST_CHECK(AudioClip_Open() != false, "no clip image in %s", TEST_CLIP_DIR);
+  TEST_CHECK(AudioClip_GetCount() == clips, "%u clips", AudioClip_GetCount());
+
+  for (uint16_t c = 0; (c < clips) && (test_failed == 0U); c++) {
+    const uint32_t n = Test_ReadWav(test_wav[c], ref);
+    const uint32_t got = Test_Decode(c, TEST_BLOCK, out);
+    double err = 0.0;
+    double sig = 0.0;
+
+    TEST_CHECK(got == n, "clip %u: %u samples, source %u", c, got, n);
+    for (uint32_t i = 0; i < n; i++) {
+      err += ((double)out[i] - ref[i]) * ((double)out[i] - ref[i]);
+      sig += (double)ref[i] * ref[i];
+    }
+    err = sqrt(err / n);
+    sig = sqrt(sig / n);
+    printf("clip %u %s: %u samples, rms error %.1f LSB of %.0f (%.2f %%, SNR %.1f dB)\n", c, test_wav[c], n, err,
+           sig, 100.0 * err / sig, 20.0 * log10(sig / err));
+    TEST_CHECK((20.0 * log10(sig / err)) > TEST_MIN_SNR_DB, "clip %u: rms error %.1f LSB", c, err);
+
+    (void)Test_Decode(c, 1U, odd);
+    TEST_CHECK(memcmp(out, odd, n * sizeof(int16_t)) == 0, "clip %u: differs in 1 sample blocks", c);
+    (void)Test_Decode(c, 37U, odd);
+    TEST_CHECK(memcmp(out, odd, n * sizeof(int16_t)) == 0, "clip %u: differs in 37 sample blocks", c);
+  }
+
+  AudioClip_t clip;
+  TEST_CHECK(AudioClip_Start(&clip, clips) == false, "clip %u past the end opened", clips);
+  free(ref);
+  free(out);
+  free(odd);
+
+  if (test_failed == 0U) {
+    Test_Bench();
+  }
+  return Test_Exit("audio_clip");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Samples of a source WAV of test_clips.py
+ * @param pc_Name : file in TEST_CLIP_DIR
+ * @param ps16_Buf : TEST_MAX_SAMPLES samples
+ * @return sample count
+ */
+static uint32_t Test_ReadWav(const char *pc_Name, int16_t *ps16_Buf)
+{
+  char path[256];
+  FILE *f;
+  uint32_t n = 0;
+
+  (void)snprintf(path, sizeof(path), "%s/%s", TEST_CLIP_DIR, pc_Name);
+  f = fopen(path, "rb");
+  TEST_CHECK(f != NULL, "%s missing", path);
+  if (f != NULL) {
+    if (fseek(f, TEST_WAV_HDR, SEEK_SET) == 0) {
+      n = (uint32_t)fread(ps16_Buf, sizeof(int16_t), TEST_MAX_SAMPLES, f);
+    }
+    (void)fclose(f);
+  }
+  return n;
+}
+
+/**
+ * @brief Decode a whole clip in blocks like the audio output does
+ * @param u16_Clip : clip id
+ * @param u32_Block : block size
+ * @param ps16_Buf : TEST_MAX_SAMPLES samples
+ * @return samples decoded
+ */
+static uint32_t Test_Decode(uint16_t u16_Clip, uint32_t u32_Block, int16_t *ps16_Buf)
+{
+  AudioClip_t clip;
+  uint32_t at = 0;
+  uint32_t num;
+
+  if (AudioClip_Start(&clip, u16_Clip) == false) {
+    return 0;
+  }
+  do {
+    num = (u32_Block < (TEST_MAX_SAMPLES - at)) ? u32_Block : (TEST_MAX_SAMPLES - at);
+    num = AudioClip_Fill(&ps16_Buf[at], num, &clip);
+    at += num;
+  } while ((num == u32_Block) && (at < TEST_MAX_SAMPLES));
+  return at;
+}
+
+/**
+ * @brief Decode speed in 256 sample blocks, and the share of one host core
+ *        a 16 kHz stream takes
+ */
+static void Test_Bench(void)
+{
+  int16_t block[TEST_BLOCK];
+  AudioClip_t clip;
+  uint32_t done = 0;
+  double t0;
+  double s;
+
+  t0 = Test_Now();
+  while (done < TEST_BENCH_SAMPLES) {
+    uint32_t num;
+
+    (void)AudioClip_Start(&clip, 1U);
+    do {
+      num = AudioClip_Fill(block, TEST_BLOCK, &clip);
+      test_sink += block[0];
+      done += num;
+    } while (num == TEST_BLOCK);
+  }
+  s = Test_Now() - t0;
+
+  printf("bench: adpcm decode %.1f Msamples/s, a 16 kHz stream is %.4f %% of a core\n", done / s / 1e6,
+         100.0 * TEST_RATE_HZ * s / done);
+}
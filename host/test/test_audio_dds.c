@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_audio_dds
+ *  Description        : pitch accuracy of the DDS oscillator at the tone[]
+ *                       frequencies of the original Audio_task, against the
+ *                       whole-sample period it replaced, and samples/s
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include "audio_dds.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_RATE_HZ              16000U
+#define TEST_SECONDS              10U
+#define TEST_BLOCK                256U
+#define TEST_AMP                  1000
+#define TEST_MAX_ERR_HZ           0.01     // measured pitch against the nominal one
+#define TEST_BENCH_SAMPLES        (64U * 1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static double Test_Pitch(const int16_t *ps16_Buf, uint32_t u32_N);
+static int32_t Test_Fold(const int16_t *ps16_Buf);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+/* do, re, mi, fa, so, la, si of the original Audio_task */
+static const uint32_t tone[7] = { 262, 294, 330, 349, 392, 440, 494 };
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  const uint32_t n = TEST_RATE_HZ * TEST_SECONDS;
+  int16_t *buf = malloc(n * sizeof(int16_t));
+
+  for (uint32_t i = 0; i < (sizeof(tone) / sizeof(tone[0])); i++) {
+    AudioDds_t dds;
+    const uint32_t period = (uint32_t)(((double)TEST_RATE_HZ / tone[i]) + 0.5);
+
+    AudioDds_Init(&dds, TEST_AMP);
+    AudioDds_SetFreq(&dds, tone[i], TEST_RATE_HZ);
+    for (uint32_t at = 0; at < n; at += TEST_BLOCK) {
+      AudioDds_Fill(&dds, &buf[at], TEST_BLOCK);
+    }
+    const double pitch = Test_Pitch(buf, n);
+    const double old = (double)TEST_RATE_HZ / period;
+
+    printf("%3u Hz: dds %9.4f Hz, whole sample period %9.4f Hz\n", tone[i], pitch, old);
+    TEST_CHECK(fabs(pitch - tone[i]) < TEST_MAX_ERR_HZ, "%u Hz measured %.4f Hz", tone[i], pitch);
+  }
+  free(buf);
+
+  Test_Bench();
+  return Test_Exit("audio_dds");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Frequency from the rising zero crossings, interpolated between
+ *        the samples around each crossing
+ * @param ps16_Buf : samples
+ * @param u32_N : count
+ * @return Hz
+ */
+static double Test_Pitch(const int16_t *ps16_Buf, uint32_t u32_N)
+{
+  double first = -1.0;
+  double last = 0.0;
+  uint32_t periods = 0;
+
+  for (uint32_t i = 1; i < u32_N; i++) {
+    if ((ps16_Buf[i - 1] < 0) && (ps16_Buf[i] >= 0)) {
+      const double at = (i - 1) + ((double)-ps16_Buf[i - 1] / (ps16_Buf[i] - ps16_Buf[i - 1]));
+      if (first < 0.0) {
+        first = at;
+      } else {
+        periods++;
+      }
+      last = at;
+    }
+  }
+  return (periods != 0U) ? ((periods * (double)TEST_RATE_HZ) / (last - first)) : 0.0;
+}
+
+/**
+ * @brief Sum of a block, so every rendered sample is used
+ * @param ps16_Buf : TEST_BLOCK samples
+ * @return sum
+ */
+static int32_t Test_Fold(const int16_t *ps16_Buf)
+{
+  int32_t sum = 0;
+
+  for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+    sum += ps16_Buf[i];
+  }
+  return sum;
+}
+
+/**
+ * @brief Samples/s of AudioDds_Fill in blocks, and of the per-sample sin()
+ *        of the original Audio_task for comparison
+ */
+static void Test_Bench(void)
+{
+  int16_t block[TEST_BLOCK];
+  AudioDds_t dds;
+  double t0;
+  double dds_s;
+  double sin_s;
+
+  AudioDds_Init(&dds, TEST_AMP);
+  AudioDds_SetFreq(&dds, 440, TEST_RATE_HZ);
+  t0 = Test_Now();
+  for (uint32_t at = 0; at < TEST_BENCH_SAMPLES; at += TEST_BLOCK) {
+    AudioDds_Fill(&dds, block, TEST_BLOCK);
+    test_sink += Test_Fold(block);
+  }
+  dds_s = Test_Now() - t0;
+
+  t0 = Test_Now();
+  for (uint32_t at = 0; at < (TEST_BENCH_SAMPLES / 16U); at += TEST_BLOCK) {
+    for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+      block[i] = (int16_t)(sin(2.0 * 3.1416 * (double)(at + i) / 36.0) * TEST_AMP);
+    }
+    test_sink += Test_Fold(block);
+  }
+  sin_s = (Test_Now() - t0) * 16.0;
+
+  printf("bench: dds %.1f Msamples/s, sin() %.1f Msamples/s\n", TEST_BENCH_SAMPLES / dds_s / 1e6,
+         TEST_BENCH_SAMPLES / sin_s / 1e6);
+}
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_audio_env
+ *  Description        : continuity of the envelope gain at note on, note
+ *                       off and a note retriggered in its release, the
+ *                       release length, independence of the block size,
+ *                       and the cost of a block
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "audio_env.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_DC                   16384    // input level, the output is the gain in Q14
+#define TEST_SAMPLES              16000U   // 1 s at 16 kHz
+#define TEST_BLOCK                256U
+#define TEST_MAX_JUMP             ((TEST_DC / (int32_t)AUDIO_ENV_TICK_SAMPLES) + 1)  // full scale over a tick
+#define TEST_BENCH_BLOCKS         (256U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Test_Event_t
+{
+  uint32_t u32_At;              // sample
+  bool b_On;
+  uint8_t u8_Shape;
+}Test_Event_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_Render(const Test_Event_t *pst_Ev, uint32_t u32_Events, uint32_t u32_Block, int16_t *ps16_Out);
+static int32_t Test_MaxJump(const int16_t *ps16_Buf, uint32_t u32_N);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  int16_t *out = malloc(TEST_SAMPLES * sizeof(int16_t));
+  int16_t *odd = malloc(TEST_SAMPLES * sizeof(int16_t));
+
+  for (uint8_t shape = 0; shape < AUDIO_ENV_SHAPES; shape++) {
+    const uint32_t rel = AudioEnv_GetReleaseSamples(shape);
+    /* note off in the middle of a tick, then retriggered in the release
+     * of the second note */
+    const uint32_t off = 4000U + 13U;
+    const uint32_t off2 = 7000U + 21U;
+    const uint32_t retrig = off2 + (rel / 2U);
+    const Test_Event_t ev[] = {
+      { 1000U, true, shape },
+      { off, false, shape },
+      { 6000U, true, shape },
+      { off2, false, shape },
+      { retrig, true, shape },
+      { 12000U, false, shape },
+    };
+    const uint32_t events = sizeof(ev) / sizeof(ev[0]);
+    int32_t jump;
+    bool silent = true;
+
+    Test_Render(ev, events, TEST_BLOCK, out);
+
+    jump = Test_MaxJump(out, TEST_SAMPLES);
+    printf("shape %u: largest step %d of %d, release %u samples\n", shape, jump, TEST_DC, rel);
+    TEST_CHECK(jump <= TEST_MAX_JUMP, "shape %u: gain steps by %d", shape, jump);
+    TEST_CHECK(out[1000] == 0, "shape %u: attack starts at %d", shape, out[1000]);
+    TEST_CHECK(out[1000U + TEST_BLOCK] > 0, "shape %u: no attack", shape);
+    for (uint32_t i = off + rel; i < 6000U; i++) {
+      silent = silent && (out[i] == 0);
+    }
+    TEST_CHECK(silent, "shape %u: not silent %u samples after the note off", shape, rel);
+    TEST_CHECK(out[retrig] > 0, "shape %u: retrigger restarts from silence", shape);
+    TEST_CHECK(out[retrig] <= out[off2], "shape %u: retrigger jumps up", shape);
+
+    /* the block size only decides where the work is split */
+    Test_Render(ev, events, 1U, odd);
+    TEST_CHECK(memcmp(out, odd, TEST_SAMPLES * sizeof(int16_t)) == 0, "shape %u: differs in 1 sample blocks", shape);
+    Test_Render(ev, events, 37U, odd);
+    TEST_CHECK(memcmp(out, odd, TEST_SAMPLES * sizeof(int16_t)) == 0, "shape %u: differs in 37 sample blocks", shape);
+  }
+  free(out);
+  free(odd);
+
+  Test_Bench();
+  return Test_Exit("audio_env");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Envelope of a DC input with note events, in blocks of at most
+ *        u32_Block samples split at the events
+ * @param pst_Ev : events in time order
+ * @param u32_Events : count
+ * @param u32_Block : block size
+ * @param ps16_Out : TEST_SAMPLES output samples
+ */
+static void Test_Render(const Test_Event_t *pst_Ev, uint32_t u32_Events, uint32_t u32_Block, int16_t *ps16_Out)
+{
+  AudioEnv_t env;
+  uint32_t next = 0;
+  uint32_t at = 0;
+
+  (void)memset(&env, 0, sizeof(env));
+  while (at < TEST_SAMPLES) {
+    uint32_t num = TEST_SAMPLES - at;
+
+    while ((next < u32_Events) && (pst_Ev[next].u32_At == at)) {
+      if (pst_Ev[next].b_On != false) {
+        AudioEnv_NoteOn(&env, pst_Ev[next].u8_Shape);
+      } else {
+        AudioEnv_NoteOff(&env);
+      }
+      next++;
+    }
+    if (num > u32_Block) {
+      num = u32_Block;
+    }
+    if ((next < u32_Events) && (num > (pst_Ev[next].u32_At - at))) {
+      num = pst_Ev[next].u32_At - at;
+    }
+
+    /* skip the idle envelope like AudioSeq_Fill */
+    if (AudioEnv_IsIdle(&env) != false) {
+      (void)memset(&ps16_Out[at], 0, num * sizeof(int16_t));
+    } else {
+      for (uint32_t i = 0; i < num; i++) {
+        ps16_Out[at + i] = TEST_DC;
+      }
+      AudioEnv_Apply(&env, &ps16_Out[at], num);
+    }
+    at += num;
+  }
+}
+
+/**
+ * @brief Largest change between neighbouring samples
+ * @param ps16_Buf : samples
+ * @param u32_N : count
+ * @return absolute step
+ */
+static int32_t Test_MaxJump(const int16_t *ps16_Buf, uint32_t u32_N)
+{
+  int32_t max = 0;
+
+  for (uint32_t i = 1; i < u32_N; i++) {
+    const int32_t step = abs((int32_t)ps16_Buf[i] - ps16_Buf[i - 1]);
+    if (step > max) {
+      max = step;
+    }
+  }
+  return max;
+}
+
+/**
+ * @brief Time of AudioEnv_Apply on a block while the gain moves every tick
+ *        (attack and decay of the soft shape) and while it sits on the sustain
+ *        level
+ */
+static void Test_Bench(void)
+{
+  int16_t block[TEST_BLOCK];
+  AudioEnv_t env;
+  double t0;
+  double ramp_s;
+  double hold_s;
+
+  for (uint32_t i = 0; i < TEST_BLOCK; i++) {
+    block[i] = TEST_DC;
+  }
+
+  (void)memset(&env, 0, sizeof(env));
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < TEST_BENCH_BLOCKS; n++) {
+    if ((n & 63U) == 0U) {
+      AudioEnv_NoteOn(&env, 2U);
+    }
+    AudioEnv_Apply(&env, block, TEST_BLOCK);
+    test_sink += block[n & (TEST_BLOCK - 1U)];
+  }
+  ramp_s = Test_Now() - t0;
+
+  (void)memset(&env, 0, sizeof(env));
+  AudioEnv_NoteOn(&env, 0U);
+  for (uint32_t n = 0; n < 64U; n++) {
+    AudioEnv_Apply(&env, block, TEST_BLOCK);
+  }
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < TEST_BENCH_BLOCKS; n++) {
+    AudioEnv_Apply(&env, block, TEST_BLOCK);
+    test_sink += block[n & (TEST_BLOCK - 1U)];
+  }
+  hold_s = Test_Now() - t0;
+
+  printf("bench: %u sample block %.0f ns in attack/decay, %.0f ns on sustain, %.1f Msamples/s\n", TEST_BLOCK,
+         ramp_s / TEST_BENCH_BLOCKS * 1e9, hold_s / TEST_BENCH_BLOCKS * 1e9,
+         (double)TEST_BENCH_BLOCKS * TEST_BLOCK / ramp_s / 1e6);
+}
@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_audio_mix
+ *  Description        : mixer gains, the soft clip above the knee, freeing
+ *                       of finished voices, the master volume ramp, and the
+ *                       cost of a block per active voice
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "audio_mix.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_HALF                 16384     // Q15 gain of 0.5
+#define TEST_BENCH_BLOCKS         (16U * 1024U)
+#define TEST_BENCH_RUNS           5U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+/*
+ * @brief source playing a constant level for a number of samples
+ */
+typedef struct Test_Src_t
+{
+  int16_t s16_Level;
+  uint32_t u32_Left;
+}Test_Src_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Test_Source(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Ctx);
+static int16_t Test_Mix1(int16_t s16_Level, int16_t s16_Gain);
+static double Test_BlockNs(uint32_t u32_Voices);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static AudioMix_t test_mix;
+static int16_t test_out[AUDIO_BLOCK_SAMPLES];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Test_Src_t src[AUDIO_MIX_VOICES];
+  int16_t prev = 0;
+  bool rising = true;
+
+  /* gains: unity passes through, half halves, voices add up */
+  TEST_CHECK(abs(Test_Mix1(10000, AUDIO_MIX_GAIN_UNITY) - 10000) <= 1, "unity gain");
+  TEST_CHECK(abs(Test_Mix1(10000, TEST_HALF) - 5000) <= 1, "half gain");
+  TEST_CHECK(abs(Test_Mix1(-10000, TEST_HALF) + 5000) <= 1, "half gain, negative");
+
+  AudioMix_Init(&test_mix);
+  for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+    src[v].s16_Level = 2000;
+    src[v].u32_Left = (v + 1U) * 100U;
+    AudioMix_Start(&test_mix, v, Test_Source, &src[v], AUDIO_MIX_GAIN_UNITY);
+  }
+  TEST_CHECK(AudioMix_GetFreeVoice(&test_mix) == -1, "free voice while all play");
+  TEST_CHECK(AudioMix_Fill(test_out, AUDIO_BLOCK_SAMPLES, &test_mix) == AUDIO_BLOCK_SAMPLES, "short block");
+  TEST_CHECK(abs(test_out[50] - (int16_t)(2000 * AUDIO_MIX_VOICES)) <= (int32_t)AUDIO_MIX_VOICES,
+             "%u voices sum to %d", AUDIO_MIX_VOICES, test_out[50]);
+  TEST_CHECK(abs(test_out[150] - (int16_t)(2000 * (AUDIO_MIX_VOICES - 1U))) <= (int32_t)AUDIO_MIX_VOICES,
+             "finished voice still mixed, %d", test_out[150]);
+  TEST_CHECK((AudioMix_IsActive(&test_mix, 0U) == false) && (AudioMix_IsActive(&test_mix, 1U) == false) &&
+             (AudioMix_IsActive(&test_mix, 2U) != false), "voices freed wrong");
+  TEST_CHECK(AudioMix_GetFreeVoice(&test_mix) == 0, "first free voice %d", AudioMix_GetFreeVoice(&test_mix));
+
+  /* soft clip: exact below the knee, rising and bounded above it */
+  AudioMix_Init(&test_mix);
+  for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+    AudioMix_Start(&test_mix, v, Test_Source, &src[v], AUDIO_MIX_GAIN_UNITY);
+  }
+  for (int32_t level = 0; level <= INT16_MAX; level += 61) {
+    const int32_t sum = level * (int32_t)AUDIO_MIX_VOICES;
+
+    for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+      src[v].s16_Level = (int16_t)level;
+      src[v].u32_Left = UINT32_MAX;
+    }
+    (void)AudioMix_Fill(test_out, 1U, &test_mix);
+    if (sum <= AUDIO_MIX_KNEE) {
+      TEST_CHECK(abs(test_out[0] - sum) <= (int32_t)AUDIO_MIX_VOICES, "below the knee %d -> %d", sum, test_out[0]);
+    }
+    rising = rising && (test_out[0] >= prev);
+    prev = test_out[0];
+  }
+  TEST_CHECK(rising, "soft clip not monotonic");
+  TEST_CHECK(prev < INT16_MAX, "soft clip reaches full scale at 4x, %d", prev);
+  printf("soft clip: %d x %u voices -> %d\n", INT16_MAX, AUDIO_MIX_VOICES, prev);
+
+  /* master volume ramps to half over 2^AUDIO_ENV_RAMP_SHIFT samples */
+  AudioMix_Init(&test_mix);
+  src[0].s16_Level = 10000;
+  src[0].u32_Left = UINT32_MAX;
+  AudioMix_Start(&test_mix, 0U, Test_Source, &src[0], AUDIO_MIX_GAIN_UNITY);
+  AudioMix_SetVolume(&test_mix, TEST_HALF);
+  prev = INT16_MAX;
+  rising = false;
+  for (uint32_t n = 0; n < ((1UL << AUDIO_ENV_RAMP_SHIFT) / AUDIO_BLOCK_SAMPLES); n++) {
+    (void)AudioMix_Fill(test_out, AUDIO_BLOCK_SAMPLES, &test_mix);
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+      rising = rising || (test_out[i] > prev);
+      prev = test_out[i];
+    }
+  }
+  (void)AudioMix_Fill(test_out, AUDIO_BLOCK_SAMPLES, &test_mix);
+  TEST_CHECK(rising == false, "volume ramp goes up");
+  TEST_CHECK(abs(test_out[0] - 5000) <= 2, "volume ramp ends at %d", test_out[0]);
+
+  Test_Bench();
+  return Test_Exit("audio_mix");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Sample source (AudioOut_Source_t) of a constant level
+ * @param ps16_Buf : destination
+ * @param u32_Samples : samples requested
+ * @param pv_Ctx : Test_Src_t
+ * @return samples rendered
+ */
+static uint32_t Test_Source(int16_t *ps16_Buf, uint32_t u32_Samples, void *pv_Ctx)
+{
+  Test_Src_t *src = (Test_Src_t *)pv_Ctx;
+  const uint32_t num = (u32_Samples < src->u32_Left) ? u32_Samples : src->u32_Left;
+
+  for (uint32_t i = 0; i < num; i++) {
+    ps16_Buf[i] = src->s16_Level;
+  }
+  src->u32_Left -= num;
+  return num;
+}
+
+/**
+ * @brief Mix one constant voice for one block
+ * @param s16_Level : source level
+ * @param s16_Gain : Q15 voice gain
+ * @return first output sample
+ */
+static int16_t Test_Mix1(int16_t s16_Level, int16_t s16_Gain)
+{
+  Test_Src_t src = { s16_Level, AUDIO_BLOCK_SAMPLES };
+
+  AudioMix_Init(&test_mix);
+  AudioMix_Start(&test_mix, 0U, Test_Source, &src, s16_Gain);
+  (void)AudioMix_Fill(test_out, AUDIO_BLOCK_SAMPLES, &test_mix);
+  return test_out[0];
+}
+
+/**
+ * @brief Time of a mixer block, best of TEST_BENCH_RUNS runs
+ * @param u32_Voices : active voices, 0 times the constant source alone
+ * @return ns per block
+ */
+static double Test_BlockNs(uint32_t u32_Voices)
+{
+  Test_Src_t src[AUDIO_MIX_VOICES];
+  double best = 1e9;
+
+  AudioMix_Init(&test_mix);
+  for (uint32_t v = 0; v < AUDIO_MIX_VOICES; v++) {
+    src[v].s16_Level = 3000;
+    src[v].u32_Left = UINT32_MAX;
+    if (v < u32_Voices) {
+      AudioMix_Start(&test_mix, v, Test_Source, &src[v], TEST_HALF);
+    }
+  }
+
+  for (uint32_t run = 0; run < TEST_BENCH_RUNS; run++) {
+    const double t0 = Test_Now();
+    double ns;
+
+    for (uint32_t n = 0; n < TEST_BENCH_BLOCKS; n++) {
+      if (u32_Voices == 0U) {
+        (void)Test_Source(test_out, AUDIO_BLOCK_SAMPLES, &src[0]);
+      } else {
+        (void)AudioMix_Fill(test_out, AUDIO_BLOCK_SAMPLES, &test_mix);
+      }
+      test_sink += test_out[n & (AUDIO_BLOCK_SAMPLES - 1U)];
+    }
+    ns = (Test_Now() - t0) / TEST_BENCH_BLOCKS * 1e9;
+    best = (ns < best) ? ns : best;
+  }
+  return best;
+}
+
+/**
+ * @brief Cost of a block with 1 to AUDIO_MIX_VOICES active voices, without
+ *        the time the sources take on their own. The step from one voice
+ *        to the next is the mixing cost of a voice.
+ */
+static void Test_Bench(void)
+{
+  const double src_ns = Test_BlockNs(0U);
+  double prev_ns = 0.0;
+
+  printf("bench: constant source %.0f ns per %u sample block\n", src_ns, AUDIO_BLOCK_SAMPLES);
+  for (uint32_t voices = 1; voices <= AUDIO_MIX_VOICES; voices++) {
+    const double ns = Test_BlockNs(voices) - (voices * src_ns);
+
+    printf("bench: %u voices, mixer %.0f ns per block", voices, ns);
+    if (voices > 1U) {
+      printf(", +%.0f ns for this voice", ns - prev_ns);
+    }
+    printf("\n");
+    prev_ns = ns;
+  }
+}
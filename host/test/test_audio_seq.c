@@ -0,0 +1,302 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_audio_seq
+ *  Description        : renders every melody of the compiled blob and checks
+ *                       its timing against melodies.txt: length to the
+ *                       sample, silent rests, the pitch of every note, the
+ *                       same output for any block size. Prints the render
+ *                       speed.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_seq.h"
+#include "audio_sink.h"
+#include "melody_data.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_AMP                  1000
+#define TEST_MAX_NOTES            64U
+#define TEST_MAX_SAMPLES          (AUDIO_SAMPLE_RATE_HZ * 60U)
+#define TEST_REST_MAX             (TEST_AMP / 100)    // rest after its first half
+#define TEST_NOTE_MIN             (TEST_AMP / 4)      // peak of a note
+#define TEST_PITCH_TOL            0.01                // relative
+#define TEST_BENCH_RUNS           200U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Test_Note_t
+{
+  double d_Hz;               // 0 for a rest
+  uint32_t u32_Units;
+} Test_Note_t;
+
+typedef struct Test_Melody_t
+{
+  char ac_Name[32];
+  uint32_t u32_UnitMs;
+  uint32_t u32_Notes;
+  Test_Note_t ast_Note[TEST_MAX_NOTES];
+} Test_Melody_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Test_Parse(const char *pc_Path, Test_Melody_t *pst_Mel, uint32_t u32_Max);
+static bool Test_Token(const char *pc_Tok, Test_Note_t *pst_Note);
+static uint32_t Test_Render(uint8_t u8_Melody, int16_t *ps16_Buf, bool b_OddBlocks);
+static void Test_Check(uint8_t u8_Melody, const Test_Melody_t *pst_Mel, const int16_t *ps16_Buf, uint32_t u32_N);
+static double Test_Pitch(const int16_t *ps16_Buf, uint32_t u32_N);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Test_Melody_t melodies[MELODY_COUNT + 1U];
+static int16_t buf[TEST_MAX_SAMPLES];
+static int16_t odd[TEST_MAX_SAMPLES];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  const uint32_t count = Test_Parse(FROST_MELODIES, melodies, MELODY_COUNT + 1U);
+  uint32_t total = 0;
+  double t0;
+
+  TEST_CHECK(count == MELODY_COUNT, "%u melodies in melodies.txt, %u in the blob", count, MELODY_COUNT);
+  for (uint8_t m = 0; (m < MELODY_COUNT) && (m < count); m++) {
+    const uint32_t n = Test_Render(m, buf, false);
+
+    TEST_CHECK(strcmp(melodies[m].ac_Name, melody_names[m]) == 0, "melody %u is %s, expected %s", m, melody_names[m],
+               melodies[m].ac_Name);
+    TEST_CHECK((Test_Render(m, odd, true) == n) && (memcmp(buf, odd, n * sizeof(int16_t)) == 0),
+               "%s: output depends on the block size", melody_names[m]);
+    Test_Check(m, &melodies[m], buf, n);
+    total += n;
+  }
+
+  t0 = Test_Now();
+  for (uint32_t r = 0; r < TEST_BENCH_RUNS; r++) {
+    for (uint8_t m = 0; m < MELODY_COUNT; m++) {
+      test_sink += (int32_t)Test_Render(m, buf, false);
+    }
+  }
+  const double s = Test_Now() - t0;
+  printf("bench: %u melodies, %.2f s of audio rendered %.0fx faster than real time, %.1f Msamples/s\n",
+         MELODY_COUNT, (double)total / AUDIO_SAMPLE_RATE_HZ,
+         ((double)total * TEST_BENCH_RUNS / AUDIO_SAMPLE_RATE_HZ) / s, (double)total * TEST_BENCH_RUNS / s / 1e6);
+  return Test_Exit("audio_seq");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Read the melodies of the text notation, independent of
+ *        tools/melody_compiler.py
+ * @param pc_Path : melodies.txt
+ * @param pst_Mel : result
+ * @param u32_Max : size of pst_Mel
+ * @return melodies read
+ */
+static uint32_t Test_Parse(const char *pc_Path, Test_Melody_t *pst_Mel, uint32_t u32_Max)
+{
+  FILE *f = fopen(pc_Path, "r");
+  char line[256];
+  uint32_t n = 0;
+  Test_Melody_t *cur = NULL;
+
+  TEST_CHECK(f != NULL, "can not open %s", pc_Path);
+  if (f == NULL) {
+    return 0;
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *hash = strchr(line, '#');
+    char *tok;
+
+    if (hash != NULL) {
+      *hash = '\0';
+    }
+    tok = strtok(line, " \t\r\n");
+    if (tok == NULL) {
+      continue;
+    }
+    if (strcmp(tok, "melody") == 0) {
+      cur = (n < u32_Max) ? &pst_Mel[n++] : NULL;
+      if (cur != NULL) {
+        (void)snprintf(cur->ac_Name, sizeof(cur->ac_Name), "%s", strtok(NULL, " \t\r\n"));
+        cur->u32_UnitMs = (uint32_t)strtoul(strtok(NULL, " \t\r\n") + strlen("unit="), NULL, 10);
+        cur->u32_Notes = 0;
+      }
+    } else if (strcmp(tok, "end") == 0) {
+      cur = NULL;
+    } else {
+      for (; (tok != NULL) && (cur != NULL) && (cur->u32_Notes < TEST_MAX_NOTES); tok = strtok(NULL, " \t\r\n")) {
+        TEST_CHECK(Test_Token(tok, &cur->ast_Note[cur->u32_Notes++]), "%s: bad note %s", cur->ac_Name, tok);
+      }
+    }
+  }
+  (void)fclose(f);
+  return n;
+}
+
+/**
+ * @brief One note of the notation
+ * @param pc_Tok : e.g. "C#5/2@1" or "R/3"
+ * @param pst_Note : result
+ * @return false if it is not a note
+ */
+static bool Test_Token(const char *pc_Tok, Test_Note_t *pst_Note)
+{
+  static const int32_t offset[7] = { 9, 11, 0, 2, 4, 5, 7 };   // A..G
+  const char *p = pc_Tok;
+
+  pst_Note->d_Hz = 0.0;
+  pst_Note->u32_Units = 1;
+  if (*p == 'R') {
+    p++;
+  } else if ((*p >= 'A') && (*p <= 'G')) {
+    int32_t midi = offset[*p++ - 'A'];
+    if ((*p == '#') || (*p == 'b')) {
+      midi += (*p++ == '#') ? 1 : -1;
+    }
+    if (isdigit((unsigned char)*p) == 0) {
+      return false;
+    }
+    midi += 12 * ((*p++ - '0') + 1);
+    pst_Note->d_Hz = 440.0 * pow(2.0, (midi - 69) / 12.0);
+  } else {
+    return false;
+  }
+  if (*p == '/') {
+    pst_Note->u32_Units = (uint32_t)strtoul(p + 1, (char **)&p, 10);
+  }
+  if (*p == '@') {
+    p += 2;
+  }
+  return *p == '\0';
+}
+
+/**
+ * @brief Render a melody to its end
+ * @param u8_Melody : MELODY_xxx
+ * @param ps16_Buf : TEST_MAX_SAMPLES
+ * @param b_OddBlocks : blocks of 1..300 samples instead of AUDIO_BLOCK_SAMPLES
+ * @return samples
+ */
+static uint32_t Test_Render(uint8_t u8_Melody, int16_t *ps16_Buf, bool b_OddBlocks)
+{
+  AudioSeq_t seq;
+  uint32_t n = 0;
+  uint32_t step = 1;
+  uint32_t got;
+
+  (void)AudioSeq_Start(&seq, u8_Melody, TEST_AMP);
+  do {
+    uint32_t want = b_OddBlocks ? step : AUDIO_BLOCK_SAMPLES;
+    step = (step * 7U) % 301U;
+    if (want > (TEST_MAX_SAMPLES - n)) {
+      want = TEST_MAX_SAMPLES - n;
+    }
+    got = AudioSeq_Fill(&ps16_Buf[n], want, &seq);
+    n += got;
+  } while ((got != 0U) && (n < TEST_MAX_SAMPLES));
+  return n;
+}
+
+/**
+ * @brief Timing of a rendered melody against its notation
+ * @param u8_Melody : MELODY_xxx
+ * @param pst_Mel : notation
+ * @param ps16_Buf : samples
+ * @param u32_N : count
+ */
+static void Test_Check(uint8_t u8_Melody, const Test_Melody_t *pst_Mel, const int16_t *ps16_Buf, uint32_t u32_N)
+{
+  const uint32_t unit = (pst_Mel->u32_UnitMs * AUDIO_SAMPLE_RATE_HZ) / 1000U;
+  uint32_t units = 0;
+  uint32_t at = 0;
+
+  for (uint32_t i = 0; i < pst_Mel->u32_Notes; i++) {
+    units += pst_Mel->ast_Note[i].u32_Units;
+  }
+  TEST_CHECK(u32_N == (units * unit), "%s: %u samples, expected %u", pst_Mel->ac_Name, u32_N, units * unit);
+  TEST_CHECK(AudioSeq_GetLengthMs(u8_Melody) == (units * pst_Mel->u32_UnitMs), "%s: length %u ms, expected %u ms",
+             pst_Mel->ac_Name, AudioSeq_GetLengthMs(u8_Melody), units * pst_Mel->u32_UnitMs);
+
+  for (uint32_t i = 0; (i < pst_Mel->u32_Notes) && (at < u32_N); i++) {
+    const Test_Note_t *note = &pst_Mel->ast_Note[i];
+    const uint32_t len = note->u32_Units * unit;
+    int32_t peak = 0;
+
+    if (note->d_Hz == 0.0) {
+      /* the release of the note before may reach into the rest, not past its middle */
+      for (uint32_t s = at + (len / 2U); (s < (at + len)) && (s < u32_N); s++) {
+        peak = (abs(ps16_Buf[s]) > peak) ? abs(ps16_Buf[s]) : peak;
+      }
+      TEST_CHECK(peak <= TEST_REST_MAX, "%s: rest %u at %u ms not silent, peak %d", pst_Mel->ac_Name, i,
+                 (at * 1000U) / AUDIO_SAMPLE_RATE_HZ, peak);
+    } else {
+      const double hz = Test_Pitch(&ps16_Buf[at + (len / 8U)], len / 2U);
+
+      for (uint32_t s = at; (s < (at + len)) && (s < u32_N); s++) {
+        peak = (abs(ps16_Buf[s]) > peak) ? abs(ps16_Buf[s]) : peak;
+      }
+      TEST_CHECK(peak >= TEST_NOTE_MIN, "%s: note %u at %u ms too quiet, peak %d", pst_Mel->ac_Name, i,
+                 (at * 1000U) / AUDIO_SAMPLE_RATE_HZ, peak);
+      TEST_CHECK(fabs(hz - note->d_Hz) < (note->d_Hz * TEST_PITCH_TOL), "%s: note %u at %u ms is %.1f Hz, expected %.1f Hz",
+                 pst_Mel->ac_Name, i, (at * 1000U) / AUDIO_SAMPLE_RATE_HZ, hz, note->d_Hz);
+    }
+    at += len;
+  }
+}
+
+/**
+ * @brief Frequency from the rising zero crossings, interpolated
+ * @param ps16_Buf : samples
+ * @param u32_N : count
+ * @return Hz, 0 without two crossings
+ */
+static double Test_Pitch(const int16_t *ps16_Buf, uint32_t u32_N)
+{
+  double first = -1.0;
+  double last = 0.0;
+  uint32_t periods = 0;
+
+  for (uint32_t i = 1; i < u32_N; i++) {
+    if ((ps16_Buf[i - 1] < 0) && (ps16_Buf[i] >= 0)) {
+      const double at = (i - 1) + ((double)-ps16_Buf[i - 1] / (ps16_Buf[i] - ps16_Buf[i - 1]));
+      if (first < 0.0) {
+        first = at;
+      } else {
+        periods++;
+      }
+      last = at;
+    }
+  }
+  return (periods != 0U) ? ((periods * (double)AUDIO_SAMPLE_RATE_HZ) / (last - first)) : 0.0;
+}
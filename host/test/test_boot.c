@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_boot
+ *  Description        : lazy drivers on the simulated kernel with the
+ *                       virtual clock: two drivers started by their first
+ *                       users, later users block until their own driver is
+ *                       ready and wake at that instant, without the clock
+ *                       stepping for them while they wait, and the end of
+ *                       the boot
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "boot.h"
+#include "sim.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_INIT_A_TICKS         50U
+#define TEST_INIT_B_TICKS         20U
+#define TEST_USERS                6U
+#define TEST_TICK_US              (1000000U / configTICK_RATE_HZ)
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef struct Test_User_t
+{
+  Boot_Drv_t *pst_Drv;
+  uint32_t u32_StartTicks;   // first use after this many ticks
+  uint64_t u64_ReadyUs;      // expected return of Boot_Use
+  uint64_t u64_DoneUs;       // actual return of Boot_Use
+  bool b_Done;
+} Test_User_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_InitA(void);
+static void Test_InitB(void);
+static void Test_Main(void *pv_Arg);
+static void Test_User(void *pv_User);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Boot_Drv_t test_drv_a = BOOT_DRV("a", Test_InitA);
+static Boot_Drv_t test_drv_b = BOOT_DRV("b", Test_InitB);
+static uint32_t test_inits_a = 0;
+static uint32_t test_inits_b = 0;
+
+/* A is started at tick 0 and ready at 50, B at tick 1 and ready at 21. The
+ * others arrive while their driver starts */
+static Test_User_t test_user[TEST_USERS] = {
+  { &test_drv_a, 0U, TEST_INIT_A_TICKS * TEST_TICK_US, 0U, false },
+  { &test_drv_b, 1U, (1U + TEST_INIT_B_TICKS) * TEST_TICK_US, 0U, false },
+  { &test_drv_a, 2U, TEST_INIT_A_TICKS * TEST_TICK_US, 0U, false },
+  { &test_drv_a, 3U, TEST_INIT_A_TICKS * TEST_TICK_US, 0U, false },
+  { &test_drv_b, 4U, (1U + TEST_INIT_B_TICKS) * TEST_TICK_US, 0U, false },
+  { &test_drv_a, 5U, TEST_INIT_A_TICKS * TEST_TICK_US, 0U, false },
+};
+
+static pthread_mutex_t test_done_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_done_cond = PTHREAD_COND_INITIALIZER;
+static bool test_done = false;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Sim_Start(true);
+  (void)xTaskCreate(Test_Main, "test", 0, NULL, 1, NULL);
+  (void)pthread_mutex_lock(&test_done_lock);
+  while (test_done == false) {
+    (void)pthread_cond_wait(&test_done_cond, &test_done_lock);
+  }
+  (void)pthread_mutex_unlock(&test_done_lock);
+  return Test_Exit("boot");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+static void Test_InitA(void)
+{
+  test_inits_a++;
+  vTaskDelay(TEST_INIT_A_TICKS);
+}
+
+static void Test_InitB(void)
+{
+  test_inits_b++;
+  vTaskDelay(TEST_INIT_B_TICKS);
+}
+
+/**
+ * @brief Start the users, let both drivers get ready and check who returned
+ *        when
+ * @param pv_Arg
+ */
+static void Test_Main(void *pv_Arg)
+{
+  const uint64_t steps = Sim_Steps();
+  uint64_t jumps;
+
+  (void)pv_Arg;
+  for (uint32_t i = 0; i < TEST_USERS; i++) {
+    (void)xTaskCreate(Test_User, "user", 0, &test_user[i], 2, NULL);
+  }
+  vTaskDelay(2U * TEST_INIT_A_TICKS);
+  jumps = Sim_Steps() - steps;
+
+  TEST_CHECK((test_inits_a == 1U) && (test_inits_b == 1U), "inits: a %u, b %u", test_inits_a, test_inits_b);
+  TEST_CHECK(Boot_IsReady(&test_drv_a) && Boot_IsReady(&test_drv_b), "drivers not ready");
+  TEST_CHECK(test_drv_a.u32_ReadyBit != test_drv_b.u32_ReadyBit, "drivers share the ready bit");
+  for (uint32_t i = 0; i < TEST_USERS; i++) {
+    TEST_CHECK(test_user[i].b_Done && (test_user[i].u64_DoneUs == test_user[i].u64_ReadyUs),
+               "user %u of %s: returned %d at %llu us, ready at %llu us", i, test_user[i].pst_Drv->pc_Name,
+               test_user[i].b_Done, (unsigned long long)test_user[i].u64_DoneUs,
+               (unsigned long long)test_user[i].u64_ReadyUs);
+  }
+  /* one jump per user start, one per driver ready and one for this task */
+  printf("%u users of 2 drivers, %u waiting up to %u ms: %llu clock jumps\n", TEST_USERS, TEST_USERS - 2U,
+         (TEST_INIT_A_TICKS * TEST_TICK_US) / 1000U, (unsigned long long)jumps);
+  TEST_CHECK(jumps <= (TEST_USERS + 2U), "%llu clock jumps, the waiters poll", (unsigned long long)jumps);
+
+  /* the console prints the report unasked once the boot is done */
+  TEST_CHECK(Boot_IsDone() == false, "boot done before Boot_Done");
+  Boot_Done();
+  TEST_CHECK(Boot_IsDone() != false, "boot not done after Boot_Done");
+
+  Sim_Halt();
+  (void)pthread_mutex_lock(&test_done_lock);
+  test_done = true;
+  (void)pthread_cond_signal(&test_done_cond);
+  (void)pthread_mutex_unlock(&test_done_lock);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Use a driver at a given tick and note when it is usable
+ * @param pv_User : Test_User_t
+ */
+static void Test_User(void *pv_User)
+{
+  Test_User_t *user = pv_User;
+
+  if (user->u32_StartTicks > 0U) {
+    vTaskDelay(user->u32_StartTicks);
+  }
+  Boot_Use(user->pst_Drv);
+  user->u64_DoneUs = Sim_NowUs();
+  user->b_Done = true;
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : test_clips.py
+#  Description        : reference prompts of test_audio_clip, packed with
+#                       tools/clip_packer.py
+#
+#  Writes tone.wav (440 Hz), sweep.wav (100 Hz to 4 kHz) and clips.bin with
+#  both clips into the output directory. The test compares the decoded clips
+#  against the WAV files.
+
+import math
+import os
+import struct
+import subprocess
+import sys
+import wave
+
+RATE = 16000
+
+
+def write_wav(path, samples):
+    with wave.open(path, 'wb') as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(struct.pack('<%dh' % len(samples), *samples))
+
+
+def main():
+    out = sys.argv[1]
+    packer = sys.argv[2]
+    os.makedirs(out, exist_ok=True)
+
+    tone = [int(round(8000 * math.sin(2 * math.pi * 440 * n / RATE))) for n in range(RATE)]
+    # exponential sweep over 2 s, the phase is the integral of the frequency
+    f0, f1, secs = 100.0, 4000.0, 2.0
+    k = math.log(f1 / f0) / secs
+    sweep = [int(round(12000 * math.sin(2 * math.pi * f0 * (math.exp(k * n / RATE) - 1) / k)))
+             for n in range(int(RATE * secs))]
+
+    write_wav(os.path.join(out, 'tone.wav'), tone)
+    write_wav(os.path.join(out, 'sweep.wav'), sweep)
+    subprocess.check_call([sys.executable, packer, os.path.join(out, 'clips.bin'),
+                           os.path.join(out, 'tone.wav'), os.path.join(out, 'sweep.wav')],
+                          stdout=subprocess.DEVNULL)
+
+
+if __name__ == '__main__':
+    main()
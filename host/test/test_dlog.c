@@ -0,0 +1,437 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_dlog
+ *  Description        : dlog records back from the base64 output, drops on a
+ *                       full ring, records across the ring end and a flush
+ *                       during a flush, and the cost per call and UART bytes
+ *                       per record against the ESP_LOGI line of the firmware
+ ******************************************************************************/
+
+#define _GNU_SOURCE                         // fopencookie
+#define DLOG_FILE_ID              1000
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "dlog.h"
+#include "period.h"
+#include "sim.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_MAX_WORDS            (64U * 1024U)
+#define TEST_WRAP_ROUNDS          1000U
+#define TEST_RACE_RECORDS         40U       // 3 words each, 8 lines, fit the ring
+#define TEST_RACE_HOLD_MS         20U       // first line of the second flusher held in the console
+#define TEST_BENCH_BATCH          32U       // records between two flushes, 5 words each fit the ring
+#define TEST_BENCH_ROUNDS         (32U * 1024U)
+#define TEST_UART_BAUD            115200U   // CONFIG_ESP_CONSOLE_UART_BAUDRATE, 10 bits per byte
+
+/* ESP_LOGI as the firmware prints it with CONFIG_LOG_COLORS */
+#define TEST_ESP_LOGI(tag, fmt, ...)                                                          \
+  fprintf(test_uart, "\033[0;32mI (%lu) %s: " fmt "\033[0m\n", (unsigned long)(Sim_NowUs() / 1000U), tag, \
+          ##__VA_ARGS__)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static uint32_t Test_Capture(void (*pf_Run)(void));
+static uint32_t Test_Flush(void);
+static uint32_t Test_Expect(uint32_t u32_At, uint32_t u32_Level, uint32_t u32_Line, uint32_t u32_N,
+                            const uint32_t *pu32_Arg);
+static void Test_Records(void);
+static void Test_Drop(void);
+static void Test_Wrap(void);
+static ssize_t Test_RaceWrite(void *pv_Cookie, const char *pc_Buf, size_t x_Len);
+static void *Test_Flusher(void *pv_Arg);
+static void Test_RaceRun(void);
+static void Test_Race(void);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static uint32_t test_words[TEST_MAX_WORDS];   // decoded output of the last Test_Flush
+static uint32_t test_n_words;
+static uint32_t test_out_bytes;               // console bytes of the last Test_Flush
+static FILE *test_uart;
+static volatile bool test_race_held;          // the second flusher is inside its first line
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Test_Records();
+  Test_Drop();
+  Test_Wrap();
+  Test_Bench();
+  Test_Race();    // last, once a thread ran the process stays on the locked paths of libc
+  return Test_Exit("dlog");
+}
+
+/* Dlog_task is not run here, its kernel and period monitor calls only have
+ * to link */
+void vTaskDelay(TickType_t x_Ticks)
+{
+  (void)x_Ticks;
+}
+
+void vTaskDelete(TaskHandle_t x_Task)
+{
+  (void)x_Task;
+}
+
+void Period_Register(Period_Mon_t *pst_Mon, const char *pc_Name, uint32_t u32_PeriodUs, uint32_t u32_LateUs)
+{
+  (void)pst_Mon;
+}
+
+uint32_t Period_Begin(Period_Mon_t *pst_Mon)
+{
+  return 0;
+}
+
+void Period_End(Period_Mon_t *pst_Mon)
+{
+  (void)pst_Mon;
+}
+
+uint64_t Sim_NowUs(void)
+{
+  return (uint64_t)(Test_Now() * 1e6);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Run pf_Run with stdout in a temporary file, then the "~D0:" lines
+ *        back into words in test_words
+ * @param pf_Run : what prints the lines
+ * @return lines written
+ */
+static uint32_t Test_Capture(void (*pf_Run)(void))
+{
+  static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  FILE *const console = stdout;
+  char line[256];
+  uint32_t lines = 0;
+
+  stdout = tmpfile();
+  pf_Run();
+  (void)fflush(stdout);
+  rewind(stdout);
+  test_n_words = 0;
+  test_out_bytes = 0;
+  while (fgets(line, sizeof(line), stdout) != NULL) {
+    uint32_t acc = 0;
+    uint32_t bits = 0;
+    uint32_t bytes = 0;
+
+    test_out_bytes += (uint32_t)strlen(line);
+    lines++;
+    TEST_CHECK(strncmp(line, "~D0:", 4) == 0, "line %u starts with %.4s", lines, line);
+    for (const char *pc = &line[4]; (*pc != '\n') && (*pc != '='); pc++) {
+      acc = (acc << 6) | (uint32_t)(strchr(b64, *pc) - b64);
+      bits += 6U;
+      if (bits >= 8U) {
+        bits -= 8U;
+        test_words[test_n_words] = (bytes == 0U) ? 0U : test_words[test_n_words];
+        test_words[test_n_words] |= ((acc >> bits) & 0xFFU) << (bytes * 8U);
+        bytes++;
+        if (bytes == 4U) {
+          bytes = 0;
+          test_n_words++;
+        }
+      }
+    }
+    TEST_CHECK(bytes == 0U, "line %u: %u bytes left over", lines, bytes);
+  }
+  (void)fclose(stdout);
+  stdout = console;
+  return lines;
+}
+
+/**
+ * @brief Dlog_Flush into test_words
+ * @return lines written
+ */
+static uint32_t Test_Flush(void)
+{
+  return Test_Capture(Dlog_Flush);
+}
+
+/**
+ * @brief Compare one record of test_words
+ * @param u32_At : word index of the record
+ * @param u32_Level : DLOG_LEVEL_x
+ * @param u32_Line : line, 0 for a drop record
+ * @param u32_N : argument count
+ * @param pu32_Arg : arguments
+ * @return word index of the next record
+ */
+static uint32_t Test_Expect(uint32_t u32_At, uint32_t u32_Level, uint32_t u32_Line, uint32_t u32_N,
+                            const uint32_t *pu32_Arg)
+{
+  const uint32_t file = (u32_Line == 0U) ? 0U : DLOG_FILE_ID;
+  const uint32_t hdr = (file << DLOG_HDR_FILE_SHIFT) | (u32_Level << DLOG_HDR_LEVEL_SHIFT) |
+                       (u32_N << DLOG_HDR_NARG_SHIFT) | u32_Line;
+
+  if ((u32_At + 2U + u32_N) > test_n_words) {
+    Test_Fail(__FILE__, __LINE__, "record at word %u missing, %u words decoded", u32_At, test_n_words);
+    return test_n_words;
+  }
+  TEST_CHECK(test_words[u32_At] == hdr, "word %u: header 0x%08x, expected 0x%08x", u32_At, test_words[u32_At], hdr);
+  for (uint32_t i = 0; i < u32_N; i++) {
+    TEST_CHECK(test_words[u32_At + 2U + i] == pu32_Arg[i], "word %u: argument %u is %u, expected %u", u32_At, i,
+               test_words[u32_At + 2U + i], pu32_Arg[i]);
+  }
+  return u32_At + 2U + u32_N;
+}
+
+/**
+ * @brief One record of each level and argument count, timestamps in order
+ */
+static void Test_Records(void)
+{
+  static const uint32_t arg[DLOG_MAX_ARGS] = { 7U, 0xFFFFFFFFU, 0x80000000U, 12345678U };
+  uint32_t at = 0;
+
+  Dlog_Init();
+  const uint32_t line = __LINE__ + 1U;
+  DLOG_E("no arguments");
+  DLOG_W("one %u", arg[0]);
+  DLOG_I("two %u %d", arg[0], (int32_t)arg[1]);
+  DLOG_I("three %u %d %x", arg[0], (int32_t)arg[1], arg[2]);
+  DLOG_I("four %u %d %x %u", arg[0], (int32_t)arg[1], arg[2], arg[3]);
+  (void)Test_Flush();
+
+  at = Test_Expect(at, DLOG_LEVEL_ERROR, line, 0U, arg);
+  at = Test_Expect(at, DLOG_LEVEL_WARN, line + 1U, 1U, arg);
+  at = Test_Expect(at, DLOG_LEVEL_INFO, line + 2U, 2U, arg);
+  at = Test_Expect(at, DLOG_LEVEL_INFO, line + 3U, 3U, arg);
+  at = Test_Expect(at, DLOG_LEVEL_INFO, line + 4U, 4U, arg);
+  TEST_CHECK(at == test_n_words, "%u words decoded, %u expected", test_n_words, at);
+  TEST_CHECK((test_words[1] <= test_words[3]) && (test_words[3] <= test_words[6]), "timestamps out of order");
+  TEST_CHECK(Test_Flush() == 0U, "second flush printed again");
+  TEST_CHECK(Dlog_GetDropped() == 0U, "%u dropped", Dlog_GetDropped());
+}
+
+/**
+ * @brief A full ring drops and counts whole records, the flush reports the
+ *        drops once and hands the space back
+ */
+static void Test_Drop(void)
+{
+  const uint32_t fit = DLOG_BUF_WORDS / 6U;
+  const uint32_t extra = 9U;
+  uint32_t at = 0;
+
+  Dlog_Init();
+  for (uint32_t i = 0; i < (fit + extra); i++) {
+    DLOG_I("%u %u %u %u", i, 1U, 2U, 3U);
+  }
+  const uint32_t line = __LINE__ - 2U;
+  TEST_CHECK(Dlog_GetDropped() == extra, "%u dropped, expected %u", Dlog_GetDropped(), extra);
+  (void)Test_Flush();
+  for (uint32_t i = 0; i < fit; i++) {
+    const uint32_t arg[4] = { i, 1U, 2U, 3U };
+
+    at = Test_Expect(at, DLOG_LEVEL_INFO, line, 4U, arg);
+  }
+  at = Test_Expect(at, 0U, 0U, 1U, &extra);
+  TEST_CHECK(at == test_n_words, "%u words decoded, %u expected", test_n_words, at);
+
+  DLOG_W("after the drop");
+  (void)Test_Flush();
+  TEST_CHECK((test_n_words == 2U) && (Dlog_GetDropped() == extra), "%u words after the drop, %u dropped",
+             test_n_words, Dlog_GetDropped());
+}
+
+/**
+ * @brief Records of every length across the end of the ring, many rounds
+ */
+static void Test_Wrap(void)
+{
+  uint32_t bad = 0;
+
+  Dlog_Init();
+  for (uint32_t r = 0; r < TEST_WRAP_ROUNDS; r++) {
+    const uint32_t arg[3] = { r, ~r, r * 2654435761U };
+    const uint32_t line = __LINE__ + 1U;
+    DLOG_I("%u", arg[0]);
+    DLOG_I("%u %u %u", arg[0], arg[1], arg[2]);
+    DLOG_E("empty");
+    uint32_t at = 0;
+
+    (void)Test_Flush();
+    at = Test_Expect(at, DLOG_LEVEL_INFO, line, 1U, arg);
+    at = Test_Expect(at, DLOG_LEVEL_INFO, line + 1U, 3U, arg);
+    at = Test_Expect(at, DLOG_LEVEL_ERROR, line + 2U, 0U, arg);
+    bad += (at != test_n_words) ? 1U : 0U;
+  }
+  TEST_CHECK((bad == 0U) && (Dlog_GetDropped() == 0U), "wrap: %u rounds wrong, %u dropped", bad, Dlog_GetDropped());
+  printf("records 0..4 arguments, drops and %u rounds across the ring end decoded\n", TEST_WRAP_ROUNDS);
+}
+
+/**
+ * @brief Console of the race, holds the first write, that of the second
+ *        flusher, so the writer's flush runs while that one is half done
+ * @param pv_Cookie : file the lines go to
+ * @param pc_Buf : bytes
+ * @param x_Len : byte count
+ * @return bytes written
+ */
+static ssize_t Test_RaceWrite(void *pv_Cookie, const char *pc_Buf, size_t x_Len)
+{
+  if (test_race_held == false) {
+    const struct timespec hold = { 0, TEST_RACE_HOLD_MS * 1000000L };
+
+    test_race_held = true;
+    (void)nanosleep(&hold, NULL);
+  }
+  return (ssize_t)fwrite(pc_Buf, 1, x_Len, (FILE *)pv_Cookie);
+}
+
+/**
+ * @brief Second flusher, as Dlog_task next to the last flush of
+ *        SysSm_DeepSleep
+ */
+static void *Test_Flusher(void *pv_Arg)
+{
+  (void)pv_Arg;
+  Dlog_Flush();
+  return NULL;
+}
+
+/**
+ * @brief Numbered records, the writer flushes while the second flusher is
+ *        stuck in its first line
+ */
+static void Test_RaceRun(void)
+{
+  static const cookie_io_functions_t io = { .write = Test_RaceWrite };
+  FILE *const file = stdout;
+  pthread_t flusher;
+
+  stdout = fopencookie(file, "w", io);
+  (void)setvbuf(stdout, NULL, _IONBF, 0);
+  for (uint32_t i = 0; i < TEST_RACE_RECORDS; i++) {
+    DLOG_I("%u", i);
+  }
+  test_race_held = false;
+  TEST_CHECK(pthread_create(&flusher, NULL, Test_Flusher, NULL) == 0, "flusher thread");
+  while (test_race_held == false) {
+    (void)sched_yield();
+  }
+  Dlog_Flush();
+  (void)pthread_join(flusher, NULL);
+  (void)fclose(stdout);
+  stdout = file;
+}
+
+/**
+ * @brief A flush while another is halfway sends every record once and in
+ *        order
+ */
+static void Test_Race(void)
+{
+  uint32_t bad = 0;
+
+  Dlog_Init();
+  (void)Test_Capture(Test_RaceRun);
+  for (uint32_t i = 0; (i < TEST_RACE_RECORDS) && (((i * 3U) + 2U) < test_n_words); i++) {
+    bad += (test_words[(i * 3U) + 2U] != i) ? 1U : 0U;
+  }
+  TEST_CHECK((test_n_words == (TEST_RACE_RECORDS * 3U)) && (bad == 0U),
+             "race: %u words for %u records, %u out of place", test_n_words, TEST_RACE_RECORDS, bad);
+  printf("flush during a flush: %u records sent once and in order\n", TEST_RACE_RECORDS);
+}
+
+/**
+ * @brief ns per call and console bytes per record of the SysSM transition
+ *        line as dlog and as ESP_LOGI, and the time the UART needs for it
+ */
+static void Test_Bench(void)
+{
+  uint32_t dlog_bytes = 0;
+  uint32_t esp_bytes = 0;
+  double write_s = 0.0;
+  double flush_s = 0.0;
+  double esp_s;
+  double t0;
+
+  Dlog_Init();
+  for (uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++) {
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < TEST_BENCH_BATCH; i++) {
+      DLOG_I("ev %d: state %d -> %d, handled %d", (int32_t)(i & 7U), (int32_t)(r & 7U), (int32_t)(i & 3U), 1);
+    }
+    write_s += Test_Now() - t0;
+    if ((r & 0x3FFU) == 0U) {
+      (void)Test_Flush();
+      dlog_bytes += test_out_bytes;
+    } else {
+      FILE *const console = stdout;
+
+      stdout = fopen("/dev/null", "w");
+      t0 = Test_Now();
+      Dlog_Flush();
+      (void)fflush(stdout);
+      flush_s += Test_Now() - t0;
+      (void)fclose(stdout);
+      stdout = console;
+    }
+  }
+  TEST_CHECK(Dlog_GetDropped() == 0U, "bench dropped %u", Dlog_GetDropped());
+
+  /* only the formatting, the firmware then waits for the UART */
+  test_uart = fopen("/dev/null", "w");
+  t0 = Test_Now();
+  for (uint32_t r = 0; r < (TEST_BENCH_ROUNDS / 4U); r++) {
+    for (uint32_t i = 0; i < TEST_BENCH_BATCH; i++) {
+      const int n = TEST_ESP_LOGI("SysSM", "ev %d: state %d -> %d, handled %d", (int)(i & 7U), (int)(r & 7U),
+                                  (int)(i & 3U), 1);
+
+      esp_bytes += (r < 32U) ? (uint32_t)n : 0U;
+    }
+  }
+  esp_s = (Test_Now() - t0) / ((TEST_BENCH_ROUNDS / 4U) * TEST_BENCH_BATCH);
+  (void)fclose(test_uart);
+
+  const uint32_t n_rec = TEST_BENCH_ROUNDS * TEST_BENCH_BATCH;
+  const uint32_t n_sampled = 32U * TEST_BENCH_BATCH;
+  const double dlog_per = (double)dlog_bytes / n_sampled;
+  const double esp_per = (double)esp_bytes / n_sampled;
+  const double uart_bps = TEST_UART_BAUD / 10.0;
+
+  printf("bench: per call: DLOG_I %.1f ns, ESP_LOGI formatting %.1f ns, Dlog_Flush %.1f ns per record\n",
+         write_s / n_rec * 1e9, esp_s * 1e9, flush_s / (n_rec - n_sampled) * 1e9);
+  printf("bench: console bytes per record: dlog %.1f, ESP_LOGI %.1f; at %u baud %.0f vs %.0f records/s, "
+         "%.0f vs %.0f us of UART each\n", dlog_per, esp_per, TEST_UART_BAUD, uart_bps / dlog_per,
+         uart_bps / esp_per, dlog_per / uart_bps * 1e6, esp_per / uart_bps * 1e6);
+  TEST_CHECK(dlog_per < esp_per, "dlog %.1f bytes per record, ESP_LOGI %.1f", dlog_per, esp_per);
+}
@@ -0,0 +1,361 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_filter_resp
+ *  Description        : frequency response of the EMA and biquad low-pass
+ *                       filters measured with sines against the analytic
+ *                       response of the quantized coefficients, banks
+ *                       against the single filters, and ns per sample
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+#include "filter_library.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_BINS                 4096U     // the test frequencies are k / TEST_BINS of fs
+#define TEST_SETTLE               (4U * TEST_BINS)
+#define TEST_AMP                  8000.0
+#define TEST_FLOOR_DB             (-40.0)   // responses below are not compared
+#define TEST_MAX_ERR_S16_DB       0.05
+#define TEST_MAX_ERR_S32_DB       0.001
+#define TEST_BUTTER_FC            0.05      // biquad cutoff in fs
+#define TEST_CH                   16U
+#define TEST_BENCH_SAMPLES        (4U * 1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+typedef void (*Test_Run_t)(double *pd_Buf, uint32_t u32_N, bool b_Reset);
+
+static double Test_Gain(Test_Run_t pf_Run, uint32_t u32_Bin);
+static double Test_Check(const char *pc_Name, Test_Run_t pf_Run, const double *pd_B, const double *pd_A,
+                         double d_MaxErrDb);
+static void Test_RunEma(double *pd_Buf, uint32_t u32_N, bool b_Reset);
+static void Test_RunBiqS16(double *pd_Buf, uint32_t u32_N, bool b_Reset);
+static void Test_RunBiqS32(double *pd_Buf, uint32_t u32_N, bool b_Reset);
+static void Test_Banks(void);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static uint8_t test_ema_shift;
+static Srvc_EmaS16_t test_ema;
+static Srvc_BiquadCoefS16_t test_coef16;
+static Srvc_BiquadCoefS32_t test_coef32;
+static Srvc_BiquadS16_t test_biq16;
+static Srvc_BiquadS32_t test_biq32;
+static double test_buf[TEST_SETTLE + TEST_BINS];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  /* RBJ low-pass, Q = 1/sqrt(2): second order Butterworth */
+  const double w0 = 2.0 * M_PI * TEST_BUTTER_FC;
+  const double alpha = sin(w0) / sqrt(2.0);
+  const double a0 = 1.0 + alpha;
+  const double b0 = (1.0 - cos(w0)) / 2.0 / a0;
+  const double a1 = -2.0 * cos(w0) / a0;
+  const double a2 = (1.0 - alpha) / a0;
+  double b[3];
+  double a[3];
+
+  /* the runtime values go through the same rounding as constant coefficients */
+  test_coef16 = (Srvc_BiquadCoefS16_t){ SRVC_BIQ_Q14(b0), SRVC_BIQ_Q14(2.0 * b0), SRVC_BIQ_Q14(b0),
+                                        SRVC_BIQ_Q14(a1), SRVC_BIQ_Q14(a2) };
+  test_coef32 = (Srvc_BiquadCoefS32_t){ SRVC_BIQ_Q30(b0), SRVC_BIQ_Q30(2.0 * b0), SRVC_BIQ_Q30(b0),
+                                        SRVC_BIQ_Q30(a1), SRVC_BIQ_Q30(a2) };
+
+  b[0] = test_coef16.s16_B0 / 16384.0;
+  b[1] = test_coef16.s16_B1 / 16384.0;
+  b[2] = test_coef16.s16_B2 / 16384.0;
+  a[0] = 1.0;
+  a[1] = test_coef16.s16_A1 / 16384.0;
+  a[2] = test_coef16.s16_A2 / 16384.0;
+  printf("biquad S16: DC gain of the Q14 coefficients %.4f dB\n", 20.0 * log10((b[0] + b[1] + b[2]) / (1.0 + a[1] + a[2])));
+  (void)Test_Check("biquad S16", Test_RunBiqS16, b, a, TEST_MAX_ERR_S16_DB);
+
+  b[0] = test_coef32.s32_B0 / 1073741824.0;
+  b[1] = test_coef32.s32_B1 / 1073741824.0;
+  b[2] = test_coef32.s32_B2 / 1073741824.0;
+  a[1] = test_coef32.s32_A1 / 1073741824.0;
+  a[2] = test_coef32.s32_A2 / 1073741824.0;
+  (void)Test_Check("biquad S32", Test_RunBiqS32, b, a, TEST_MAX_ERR_S32_DB);
+
+  for (test_ema_shift = 1; test_ema_shift <= 8U; test_ema_shift++) {
+    char name[16];
+    const double k = 1.0 / (double)(1UL << test_ema_shift);
+
+    b[0] = k;
+    b[1] = 0.0;
+    b[2] = 0.0;
+    a[1] = -(1.0 - k);
+    a[2] = 0.0;
+    (void)snprintf(name, sizeof(name), "ema 2^%u", test_ema_shift);
+    (void)Test_Check(name, Test_RunEma, b, a, TEST_MAX_ERR_S16_DB);
+  }
+
+  Test_Banks();
+  Test_Bench();
+  return Test_Exit("filter_resp");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Steady state gain at one frequency: a sine runs through the
+ *        filter, the last TEST_BINS samples are correlated with the input
+ * @param pf_Run : filter under test
+ * @param u32_Bin : frequency in fs / TEST_BINS
+ * @return gain
+ */
+static double Test_Gain(Test_Run_t pf_Run, uint32_t u32_Bin)
+{
+  const uint32_t n = TEST_SETTLE + TEST_BINS;
+  double complex acc = 0.0;
+
+  for (uint32_t i = 0; i < n; i++) {
+    test_buf[i] = round(TEST_AMP * sin(2.0 * M_PI * u32_Bin * (i % TEST_BINS) / TEST_BINS));
+  }
+  pf_Run(test_buf, n, true);
+  for (uint32_t i = TEST_SETTLE; i < n; i++) {
+    acc += test_buf[i] * cexp(-I * 2.0 * M_PI * u32_Bin * (i % TEST_BINS) / TEST_BINS);
+  }
+  return cabs(acc) * 2.0 / TEST_BINS / TEST_AMP;
+}
+
+/**
+ * @brief Measured response against the analytic one from DC to fs/2
+ * @param pc_Name : filter
+ * @param pf_Run : filter under test
+ * @param pd_B : numerator b0..b2
+ * @param pd_A : denominator 1, a1, a2
+ * @param d_MaxErrDb : allowed error above TEST_FLOOR_DB
+ * @return largest error in dB
+ */
+static double Test_Check(const char *pc_Name, Test_Run_t pf_Run, const double *pd_B, const double *pd_A,
+                         double d_MaxErrDb)
+{
+  double max = 0.0;
+  double at = 0.0;
+  double cut = 0.0;
+
+  for (uint32_t bin = 1; bin < (TEST_BINS / 2U); bin += (bin < 64U) ? 1U : ((bin < 512U) ? 3U : 61U)) {
+    const double complex z1 = cexp(-I * 2.0 * M_PI * bin / TEST_BINS);
+    const double complex h = (pd_B[0] + pd_B[1] * z1 + pd_B[2] * z1 * z1) / (pd_A[0] + pd_A[1] * z1 + pd_A[2] * z1 * z1);
+    const double ref_db = 20.0 * log10(cabs(h));
+    const double got_db = 20.0 * log10(Test_Gain(pf_Run, bin));
+
+    if ((cut == 0.0) && (got_db < -3.0103)) {
+      cut = (double)bin / TEST_BINS;
+    }
+    if ((ref_db > TEST_FLOOR_DB) && (fabs(got_db - ref_db) > max)) {
+      max = fabs(got_db - ref_db);
+      at = (double)bin / TEST_BINS;
+    }
+  }
+  printf("%-11s: first point below -3 dB %.4f fs, max error %.4f dB at %.4f fs above %.0f dB\n", pc_Name, cut, max, at,
+         TEST_FLOOR_DB);
+  TEST_CHECK(max <= d_MaxErrDb, "%s: response off by %.4f dB", pc_Name, max);
+  return max;
+}
+
+static void Test_RunEma(double *pd_Buf, uint32_t u32_N, bool b_Reset)
+{
+  int16_t blk[256];
+
+  if (b_Reset != false) {
+    Srvc_EmaInit_S16(&test_ema, test_ema_shift, 0);
+  }
+  for (uint32_t at = 0; at < u32_N; at += 256U) {
+    const uint32_t num = ((u32_N - at) < 256U) ? (u32_N - at) : 256U;
+
+    for (uint32_t i = 0; i < num; i++) {
+      blk[i] = (int16_t)pd_Buf[at + i];
+    }
+    Srvc_Ema_S16_Blk(&test_ema, blk, (uint16_t)num);
+    for (uint32_t i = 0; i < num; i++) {
+      pd_Buf[at + i] = blk[i];
+    }
+  }
+}
+
+static void Test_RunBiqS16(double *pd_Buf, uint32_t u32_N, bool b_Reset)
+{
+  int16_t blk[256];
+
+  if (b_Reset != false) {
+    Srvc_BiquadInit_S16(&test_biq16);
+  }
+  for (uint32_t at = 0; at < u32_N; at += 256U) {
+    const uint32_t num = ((u32_N - at) < 256U) ? (u32_N - at) : 256U;
+
+    for (uint32_t i = 0; i < num; i++) {
+      blk[i] = (int16_t)pd_Buf[at + i];
+    }
+    Srvc_Biquad_S16_Blk(&test_coef16, &test_biq16, blk, (uint16_t)num);
+    for (uint32_t i = 0; i < num; i++) {
+      pd_Buf[at + i] = blk[i];
+    }
+  }
+}
+
+/* S32 data at 2^16 times the S16 level */
+static void Test_RunBiqS32(double *pd_Buf, uint32_t u32_N, bool b_Reset)
+{
+  int32_t blk[256];
+
+  if (b_Reset != false) {
+    Srvc_BiquadInit_S32(&test_biq32);
+  }
+  for (uint32_t at = 0; at < u32_N; at += 256U) {
+    const uint32_t num = ((u32_N - at) < 256U) ? (u32_N - at) : 256U;
+
+    for (uint32_t i = 0; i < num; i++) {
+      blk[i] = (int32_t)pd_Buf[at + i] * 65536;
+    }
+    Srvc_Biquad_S32_Blk(&test_coef32, &test_biq32, blk, (uint16_t)num);
+    for (uint32_t i = 0; i < num; i++) {
+      pd_Buf[at + i] = blk[i] / 65536.0;
+    }
+  }
+}
+
+/**
+ * @brief Every bank channel gives the same output as a single filter on
+ *        the same input
+ */
+static void Test_Banks(void)
+{
+  Srvc_EmaBankS16_t ema_bank;
+  Srvc_BiquadBankS16_t biq_bank;
+  int32_t ema_state[TEST_CH];
+  int16_t biq_hist[4U * TEST_CH];
+  Srvc_EmaS16_t ema[TEST_CH];
+  Srvc_BiquadS16_t biq[TEST_CH];
+  int16_t in[TEST_CH];
+  int16_t out_ema[TEST_CH];
+  int16_t out_biq[TEST_CH];
+  uint32_t bad = 0;
+  uint32_t h = 7;
+
+  Srvc_EmaBankInit_S16(&ema_bank, ema_state, TEST_CH, 4U);
+  Srvc_BiquadBankInit_S16(&biq_bank, &test_coef16, biq_hist, TEST_CH);
+  for (uint32_t c = 0; c < TEST_CH; c++) {
+    Srvc_EmaInit_S16(&ema[c], 4U, 0);
+    Srvc_BiquadInit_S16(&biq[c]);
+  }
+
+  for (uint32_t i = 0; i < 10000U; i++) {
+    for (uint32_t c = 0; c < TEST_CH; c++) {
+      h = (h * 1103515245U) + 12345U;
+      in[c] = (int16_t)(h >> 16);
+    }
+    Srvc_EmaBank_S16(&ema_bank, in, out_ema);
+    Srvc_BiquadBank_S16(&biq_bank, in, out_biq);
+    for (uint32_t c = 0; c < TEST_CH; c++) {
+      int16_t x = in[c];
+      int16_t y = in[c];
+
+      Srvc_Ema_S16_Blk(&ema[c], &x, 1U);
+      Srvc_Biquad_S16_Blk(&test_coef16, &biq[c], &y, 1U);
+      bad += ((x != out_ema[c]) || (y != out_biq[c])) ? 1U : 0U;
+    }
+  }
+  printf("banks of %u channels: %u differences to the single filters\n", TEST_CH, bad);
+  TEST_CHECK(bad == 0U, "banks differ from the single filters in %u samples", bad);
+}
+
+/**
+ * @brief ns per sample of the block filters and per channel of the banks
+ */
+static void Test_Bench(void)
+{
+  static int16_t blk16[256];
+  static int32_t blk32[256];
+  int32_t ema_state[TEST_CH];
+  int16_t biq_hist[4U * TEST_CH];
+  int16_t row[TEST_CH];
+  Srvc_EmaBankS16_t ema_bank;
+  Srvc_BiquadBankS16_t biq_bank;
+  double ns[5];
+  double t0;
+
+  for (uint32_t i = 0; i < 256U; i++) {
+    blk16[i] = (int16_t)(i * 97U);
+    blk32[i] = (int32_t)(i * 97U) * 65536;
+  }
+  for (uint32_t c = 0; c < TEST_CH; c++) {
+    row[c] = (int16_t)(c * 1000U);
+  }
+
+  Srvc_EmaInit_S16(&test_ema, 4U, 0);
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < (TEST_BENCH_SAMPLES / 256U); n++) {
+    Srvc_Ema_S16_Blk(&test_ema, blk16, 256U);
+    test_sink += blk16[n & 255U];
+  }
+  ns[0] = Test_Now() - t0;
+
+  Srvc_BiquadInit_S16(&test_biq16);
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < (TEST_BENCH_SAMPLES / 256U); n++) {
+    Srvc_Biquad_S16_Blk(&test_coef16, &test_biq16, blk16, 256U);
+    test_sink += blk16[n & 255U];
+  }
+  ns[1] = Test_Now() - t0;
+
+  Srvc_BiquadInit_S32(&test_biq32);
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < (TEST_BENCH_SAMPLES / 256U); n++) {
+    Srvc_Biquad_S32_Blk(&test_coef32, &test_biq32, blk32, 256U);
+    test_sink += blk32[n & 255U];
+  }
+  ns[2] = Test_Now() - t0;
+
+  Srvc_EmaBankInit_S16(&ema_bank, ema_state, TEST_CH, 4U);
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < (TEST_BENCH_SAMPLES / TEST_CH); n++) {
+    Srvc_EmaBank_S16(&ema_bank, row, row);
+    test_sink += row[n & (TEST_CH - 1U)];
+  }
+  ns[3] = Test_Now() - t0;
+
+  Srvc_BiquadBankInit_S16(&biq_bank, &test_coef16, biq_hist, TEST_CH);
+  t0 = Test_Now();
+  for (uint32_t n = 0; n < (TEST_BENCH_SAMPLES / TEST_CH); n++) {
+    Srvc_BiquadBank_S16(&biq_bank, row, row);
+    test_sink += row[n & (TEST_CH - 1U)];
+  }
+  ns[4] = Test_Now() - t0;
+
+  for (uint32_t i = 0; i < 5U; i++) {
+    ns[i] = ns[i] / TEST_BENCH_SAMPLES * 1e9;
+  }
+  printf("bench: ns per sample: ema %.2f, biquad S16 %.2f, biquad S32 %.2f, banks of %u: ema %.2f, biquad %.2f\n",
+         ns[0], ns[1], ns[2], TEST_CH, ns[3], ns[4]);
+}
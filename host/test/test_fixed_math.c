@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_fixed_math
+ *  Description        : error of the fixed point sin/cos, sqrt, log2 and exp2
+ *                       against libm doubles, checked against the bounds in
+ *                       fixed_math_library.c, and ns per call of both
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <math.h>
+#include "fixed_math_library.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+/* documented bounds, in LSB of the result */
+#define TEST_SINCOS_MAX_LSB       1.5
+#define TEST_LOG2_MAX_LSB         1.0
+#define TEST_EXP2_MAX_LSB         1.0
+#define TEST_EXP2_MAX_REL         5e-7
+
+#define TEST_Q15                  32768.0
+#define TEST_Q16                  65536.0
+#define TEST_BENCH_CALLS          (4U * 1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_SinCos(void);
+static void Test_Sqrt(void);
+static void Test_Log2(void);
+static void Test_Exp2(void);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Test_SinCos();
+  Test_Sqrt();
+  Test_Log2();
+  Test_Exp2();
+  Test_Bench();
+  return Test_Exit("fixed_math");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Every angle of a turn, the reference saturates like the Q15 result
+ */
+static void Test_SinCos(void)
+{
+  double max = 0.0;
+  uint32_t worst = 0;
+
+  for (uint32_t a = 0; a <= UINT16_MAX; a++) {
+    const double rad = 2.0 * M_PI * a / 65536.0;
+    const double ref_s = fmin(sin(rad) * TEST_Q15, INT16_MAX);
+    const double ref_c = fmin(cos(rad) * TEST_Q15, INT16_MAX);
+    int16_t s;
+    int16_t c;
+
+    Srvc_SinCos_Q15((uint16_t)a, &s, &c);
+    TEST_CHECK((s == Srvc_Sin_Q15((uint16_t)a)) && (c == Srvc_Cos_Q15((uint16_t)a)), "angle 0x%04x: sin/cos differ", a);
+    if (fabs(s - ref_s) > max) {
+      max = fabs(s - ref_s);
+      worst = a;
+    }
+    if (fabs(c - ref_c) > max) {
+      max = fabs(c - ref_c);
+      worst = a;
+    }
+  }
+  printf("sin/cos: max error %.3f LSB at angle 0x%04x, bound %.1f\n", max, worst, TEST_SINCOS_MAX_LSB);
+  TEST_CHECK(max <= TEST_SINCOS_MAX_LSB, "sin/cos error %.3f LSB", max);
+}
+
+/**
+ * @brief All radicands up to 2^24, both sides of every square and the top
+ */
+static void Test_Sqrt(void)
+{
+  uint32_t bad = 0;
+
+  for (uint32_t x = 0; x < (1UL << 24); x++) {
+    bad += (Srvc_Sqrt_U32_U16(x) != (uint16_t)sqrt((double)x)) ? 1U : 0U;
+  }
+  for (uint32_t r = 1; r <= UINT16_MAX; r++) {
+    const uint32_t sq = r * r;
+
+    bad += (Srvc_Sqrt_U32_U16(sq) != r) ? 1U : 0U;
+    bad += (Srvc_Sqrt_U32_U16(sq - 1U) != (r - 1U)) ? 1U : 0U;
+    bad += (Srvc_Sqrt_U32_U16(sq + r) != r) ? 1U : 0U;
+  }
+  bad += (Srvc_Sqrt_U32_U16(UINT32_MAX) != UINT16_MAX) ? 1U : 0U;
+  printf("sqrt: %u wrong results\n", bad);
+  TEST_CHECK(bad == 0U, "sqrt: %u wrong results", bad);
+}
+
+/**
+ * @brief All values up to 2^20 and a stride over the rest of the range
+ */
+static void Test_Log2(void)
+{
+  double max = 0.0;
+  uint32_t worst = 0;
+  uint32_t x = 1;
+
+  TEST_CHECK(Srvc_Log2_U32_Q16(0U) == INT32_MIN, "log2(0) does not saturate");
+  while (x != 0U) {
+    const double err = fabs(Srvc_Log2_U32_Q16(x) - (log2(x / TEST_Q16) * TEST_Q16));
+
+    if (err > max) {
+      max = err;
+      worst = x;
+    }
+    x += (x < (1UL << 20)) ? 1U : 4093U;
+    if (x < 4093U) {
+      break;
+    }
+  }
+  x = UINT32_MAX;
+  if (fabs(Srvc_Log2_U32_Q16(x) - (log2(x / TEST_Q16) * TEST_Q16)) > max) {
+    max = fabs(Srvc_Log2_U32_Q16(x) - (log2(x / TEST_Q16) * TEST_Q16));
+    worst = x;
+  }
+  printf("log2: max error %.3f LSB at 0x%08x, bound %.1f\n", max, worst, TEST_LOG2_MAX_LSB);
+  TEST_CHECK(max <= TEST_LOG2_MAX_LSB, "log2 error %.3f LSB", max);
+}
+
+/**
+ * @brief Every Q16 exponent from below 1 LSB of result to the overflow,
+ *        the error may be 1 LSB or 5e-7 relative, whichever is larger
+ */
+static void Test_Exp2(void)
+{
+  double max_lsb = 0.0;
+  double max_rel = 0.0;
+  uint32_t over = 0;
+
+  for (int32_t x = -17 * 65536; x < (16 * 65536); x++) {
+    const double ref = exp2(x / TEST_Q16) * TEST_Q16;
+    const double err = fabs(Srvc_Exp2_S32_Q16(x) - ref);
+
+    if (err > fmax(TEST_EXP2_MAX_LSB, ref * TEST_EXP2_MAX_REL)) {
+      over++;
+    }
+    if (ref < (1.0 / TEST_EXP2_MAX_REL)) {
+      max_lsb = fmax(max_lsb, err);
+    } else {
+      max_rel = fmax(max_rel, err / ref);
+    }
+  }
+  TEST_CHECK(Srvc_Exp2_S32_Q16(16 * 65536) == UINT32_MAX, "exp2(16) does not saturate");
+  printf("exp2: max error %.3f LSB below 2^21 LSB, %.2e relative above, %u out of bounds\n", max_lsb, max_rel, over);
+  TEST_CHECK(over == 0U, "exp2: %u results out of bounds", over);
+}
+
+/**
+ * @brief ns per call of the fixed point functions and of libm in double
+ */
+static void Test_Bench(void)
+{
+  double t0;
+  double fx[4];
+  double fl[4];
+  volatile double sink = 0.0;
+
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    test_sink += Srvc_Sin_Q15((uint16_t)(i * 40503U));
+  }
+  fx[0] = Test_Now() - t0;
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    sink += sin((double)(uint16_t)(i * 40503U) * (2.0 * M_PI / 65536.0));
+  }
+  fl[0] = Test_Now() - t0;
+
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    test_sink += Srvc_Sqrt_U32_U16(i * 2654435761U);
+  }
+  fx[1] = Test_Now() - t0;
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    sink += sqrt((double)(i * 2654435761U));
+  }
+  fl[1] = Test_Now() - t0;
+
+  t0 = Test_Now();
+  for (uint32_t i = 1; i <= TEST_BENCH_CALLS; i++) {
+    test_sink += Srvc_Log2_U32_Q16(i * 2654435761U);
+  }
+  fx[2] = Test_Now() - t0;
+  t0 = Test_Now();
+  for (uint32_t i = 1; i <= TEST_BENCH_CALLS; i++) {
+    sink += log2((double)(i * 2654435761U));
+  }
+  fl[2] = Test_Now() - t0;
+
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    test_sink += (int32_t)Srvc_Exp2_S32_Q16((int32_t)((i * 40503U) & 0xFFFFFU) - (8 * 65536));
+  }
+  fx[3] = Test_Now() - t0;
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < TEST_BENCH_CALLS; i++) {
+    sink += exp2((double)((int32_t)((i * 40503U) & 0xFFFFFU) - (8 * 65536)) / TEST_Q16);
+  }
+  fl[3] = Test_Now() - t0;
+
+  printf("bench: ns per call, fixed / libm double: sin %.1f / %.1f, sqrt %.1f / %.1f, log2 %.1f / %.1f, "
+         "exp2 %.1f / %.1f\n", fx[0] / TEST_BENCH_CALLS * 1e9, fl[0] / TEST_BENCH_CALLS * 1e9,
+         fx[1] / TEST_BENCH_CALLS * 1e9, fl[1] / TEST_BENCH_CALLS * 1e9, fx[2] / TEST_BENCH_CALLS * 1e9,
+         fl[2] / TEST_BENCH_CALLS * 1e9, fx[3] / TEST_BENCH_CALLS * 1e9, fl[3] / TEST_BENCH_CALLS * 1e9);
+  (void)sink;
+}
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_hsm
+ *  Description        : transition harness of the table driven HSM: order
+ *                       of exits, action and entries for child, sibling,
+ *                       self, ancestor and cross-tree transitions, guards,
+ *                       internal and unhandled events, and events/s with
+ *                       the spread of the dispatch time
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <string.h>
+#include "hsm.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+/*
+ * A              B
+ * +- A1          +- B1
+ * |  +- A11
+ * +- A2
+ */
+#define ST_A                      0U
+#define ST_A1                     1U
+#define ST_A2                     2U
+#define ST_A11                    3U
+#define ST_B                      4U
+#define ST_B1                     5U
+#define ST_COUNT                  6U
+
+#define EV_SIBLING                0U        // A11 -> A2
+#define EV_SELF                   1U        // A2 -> A2
+#define EV_UP                     2U        // A11 -> A
+#define EV_CROSS                  3U        // A11 -> B1
+#define EV_PARENT                 4U        // handled by A: -> B
+#define EV_GUARDED                5U        // A11 guarded -> A2, else A internal
+#define EV_INTERNAL               6U        // A11 internal
+#define EV_NONE                   7U        // nobody
+#define EV_BACK                   8U        // B -> A11
+#define EV_COUNT                  9U
+
+#define TEST_TRACE_LEN            128U
+#define TEST_BENCH_EVENTS         (16U * 1024U * 1024U)
+#define TEST_LAT_EVENTS           (1024U * 1024U)
+#define TEST_LAT_MAX_NS           10000U    // 1 ns latency buckets
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_Log(const char *pc_Txt);
+static void Test_Expect(uint8_t u8_Event, bool b_Handled, uint8_t u8_State, const char *pc_Trace);
+static uint32_t Test_Percentile(double d_Q);
+static void Test_Bench(void);
+
+#define TEST_HOOKS(S)                                                         \
+  static void Test_Entry##S(void *pv_Ctx) { (void)pv_Ctx; Test_Log(">" #S); } \
+  static void Test_Exit##S(void *pv_Ctx) { (void)pv_Ctx; Test_Log("<" #S); }
+
+TEST_HOOKS(A)
+TEST_HOOKS(A1)
+TEST_HOOKS(A2)
+TEST_HOOKS(A11)
+TEST_HOOKS(B)
+TEST_HOOKS(B1)
+
+static void Test_Action(void *pv_Ctx) { (void)pv_Ctx; Test_Log("!"); }
+static bool Test_Guard(void *pv_Ctx) { return *(bool *)pv_Ctx; }
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static const Hsm_State_t test_states[ST_COUNT] = {
+  [ST_A]   = { HSM_NO_PARENT, Test_EntryA, Test_ExitA, "A" },
+  [ST_A1]  = { ST_A, Test_EntryA1, Test_ExitA1, "A1" },
+  [ST_A2]  = { ST_A, Test_EntryA2, Test_ExitA2, "A2" },
+  [ST_A11] = { ST_A1, Test_EntryA11, Test_ExitA11, "A11" },
+  [ST_B]   = { HSM_NO_PARENT, Test_EntryB, Test_ExitB, "B" },
+  [ST_B1]  = { ST_B, Test_EntryB1, Test_ExitB1, "B1" },
+};
+
+static const Hsm_Trans_t test_trans[ST_COUNT][EV_COUNT] = {
+  [ST_A] = {
+    [EV_PARENT]  = HSM_GOTO(ST_B, NULL, Test_Action),
+    [EV_GUARDED] = HSM_STAY(NULL, Test_Action),
+  },
+  [ST_A2] = {
+    [EV_SELF]    = HSM_GOTO(ST_A2, NULL, Test_Action),
+  },
+  [ST_A11] = {
+    [EV_SIBLING]  = HSM_GOTO(ST_A2, NULL, Test_Action),
+    [EV_UP]       = HSM_GOTO(ST_A, NULL, Test_Action),
+    [EV_CROSS]    = HSM_GOTO(ST_B1, NULL, Test_Action),
+    [EV_GUARDED]  = HSM_GOTO(ST_A2, Test_Guard, Test_Action),
+    [EV_INTERNAL] = HSM_STAY(NULL, Test_Action),
+  },
+  [ST_B] = {
+    [EV_BACK]    = HSM_GOTO(ST_A11, NULL, NULL),
+  },
+};
+
+static const Hsm_Def_t test_def = {
+  .pst_States = test_states,
+  .pst_Trans = &test_trans[0][0],
+  .u8_States = ST_COUNT,
+  .u8_Events = EV_COUNT,
+  .u8_Initial = ST_A11,
+};
+
+static Hsm_t test_hsm;
+static bool test_guard = false;
+static bool test_quiet = false;
+static char test_trace[TEST_TRACE_LEN];
+static uint32_t test_lat[TEST_LAT_MAX_NS];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Hsm_Init(&test_hsm, &test_def, &test_guard);
+  TEST_CHECK(strcmp(test_trace, ">A>A1>A11") == 0, "init entered %s", test_trace);
+  TEST_CHECK(Hsm_IsIn(&test_hsm, ST_A) && Hsm_IsIn(&test_hsm, ST_A1) && !Hsm_IsIn(&test_hsm, ST_A2), "IsIn");
+  TEST_CHECK(strcmp(Hsm_GetStateName(&test_hsm), "A11") == 0, "name %s", Hsm_GetStateName(&test_hsm));
+
+  Test_Expect(EV_SIBLING, true, ST_A2, "<A11<A1!>A2");
+  Test_Expect(EV_SELF, true, ST_A2, "<A2!>A2");
+  Test_Expect(EV_PARENT, true, ST_B, "<A2<A!>B");
+  Test_Expect(EV_BACK, true, ST_A11, "<B>A>A1>A11");
+  Test_Expect(EV_UP, true, ST_A, "<A11<A1<A!>A");
+
+  Hsm_Restore(&test_hsm, &test_def, &test_guard, ST_A11);
+  TEST_CHECK(test_trace[0] == '\0', "restore ran %s", test_trace);
+  Test_Expect(EV_CROSS, true, ST_B1, "<A11<A1<A!>B>B1");
+  Test_Expect(EV_BACK, true, ST_A11, "<B1<B>A>A1>A11");
+  Test_Expect(EV_INTERNAL, true, ST_A11, "!");
+  Test_Expect(EV_NONE, false, ST_A11, "");
+
+  /* a blocked guard asks the parent, A handles it internally */
+  test_guard = false;
+  Test_Expect(EV_GUARDED, true, ST_A11, "!");
+  test_guard = true;
+  Test_Expect(EV_GUARDED, true, ST_A2, "<A11<A1!>A2");
+
+  Test_Bench();
+  return Test_Exit("hsm");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+static void Test_Log(const char *pc_Txt)
+{
+  if (test_quiet == false) {
+    (void)strncat(test_trace, pc_Txt, TEST_TRACE_LEN - strlen(test_trace) - 1U);
+  }
+}
+
+/**
+ * @brief Dispatch an event and compare the hooks run, the result and the
+ *        new state
+ * @param u8_Event : event
+ * @param b_Handled : expected result of Hsm_Dispatch
+ * @param u8_State : expected state afterwards
+ * @param pc_Trace : expected hooks, <exit >entry !action
+ */
+static void Test_Expect(uint8_t u8_Event, bool b_Handled, uint8_t u8_State, const char *pc_Trace)
+{
+  const uint8_t from = Hsm_GetState(&test_hsm);
+  bool handled;
+
+  test_trace[0] = '\0';
+  handled = Hsm_Dispatch(&test_hsm, u8_Event);
+  TEST_CHECK(handled == b_Handled, "event %u in %s: handled %d", u8_Event, test_states[from].pc_Name, handled);
+  TEST_CHECK(Hsm_GetState(&test_hsm) == u8_State, "event %u in %s: ends in %s", u8_Event, test_states[from].pc_Name,
+             Hsm_GetStateName(&test_hsm));
+  TEST_CHECK(strcmp(test_trace, pc_Trace) == 0, "event %u in %s: hooks %s, expected %s", u8_Event,
+             test_states[from].pc_Name, test_trace, pc_Trace);
+  test_trace[0] = '\0';
+}
+
+/**
+ * @brief Latency below which a share of the timed dispatches fell
+ * @param d_Q : share 0..1
+ * @return ns
+ */
+static uint32_t Test_Percentile(double d_Q)
+{
+  const uint32_t target = (uint32_t)(d_Q * TEST_LAT_EVENTS);
+  uint32_t sum = 0;
+
+  for (uint32_t ns = 0; ns < TEST_LAT_MAX_NS; ns++) {
+    sum += test_lat[ns];
+    if (sum >= target) {
+      return ns + 1U;
+    }
+  }
+  return TEST_LAT_MAX_NS;
+}
+
+/**
+ * @brief Events/s for an internal event, one handled two levels up and a
+ *        round trip across the tree, and the spread of single dispatches
+ */
+static void Test_Bench(void)
+{
+  static const struct { const char *pc_Name; uint8_t au8_Ev[2]; } mix[] = {
+    { "internal at the leaf", { EV_INTERNAL, EV_INTERNAL } },
+    { "handled by the root", { EV_GUARDED, EV_GUARDED } },
+    { "A11 <-> B1 round trip", { EV_CROSS, EV_BACK } },
+  };
+  double worst = 0.0;
+
+  test_quiet = true;
+  test_guard = false;
+  for (uint32_t m = 0; m < (sizeof(mix) / sizeof(mix[0])); m++) {
+    double t0;
+    double s;
+
+    Hsm_Restore(&test_hsm, &test_def, &test_guard, ST_A11);
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < TEST_BENCH_EVENTS; i++) {
+      test_sink += Hsm_Dispatch(&test_hsm, mix[m].au8_Ev[i & 1U]) ? 1 : 0;
+    }
+    s = Test_Now() - t0;
+    printf("bench: %-22s %.1f M events/s, %.1f ns per event\n", mix[m].pc_Name, TEST_BENCH_EVENTS / s / 1e6,
+           s / TEST_BENCH_EVENTS * 1e9);
+  }
+
+  /* the deepest exit and entry chain, timed one dispatch at a time. The
+   * maximum on the host is a preemption, the high percentiles are not */
+  Hsm_Restore(&test_hsm, &test_def, &test_guard, ST_A11);
+  (void)memset(test_lat, 0, sizeof(test_lat));
+  for (uint32_t i = 0; i < TEST_LAT_EVENTS; i++) {
+    const double t0 = Test_Now();
+    (void)Hsm_Dispatch(&test_hsm, ((i & 1U) == 0U) ? EV_CROSS : EV_BACK);
+    const double dt = (Test_Now() - t0) * 1e9;
+    test_lat[(dt < (TEST_LAT_MAX_NS - 1U)) ? (uint32_t)dt : (TEST_LAT_MAX_NS - 1U)]++;
+    worst = (dt > worst) ? dt : worst;
+  }
+  test_quiet = false;
+  printf("bench: cross-tree dispatch incl. clock read: median %u ns, 99.99 %% %u ns, max %.0f ns\n",
+         Test_Percentile(0.5), Test_Percentile(0.9999), worst);
+}
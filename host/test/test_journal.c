@@ -0,0 +1,576 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_journal
+ *  Description        : journal harness on the simulated kernel. Every boot
+ *                       is a child process on the same flash file: fill
+ *                       past the end of the ring, reload, a page torn by a
+ *                       power loss, failing writes, and at the end seek,
+ *                       export compression ratio and throughput. The flash
+ *                       port is wrapped to count, tear and fail, and to
+ *                       check that the timer daemon never writes.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "flash_port.h"
+#include "journal.h"
+#include "storage.h"
+#include "timeseries_library.h"
+#include "sim.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_SECTORS              8U
+#define TEST_REC_PER_SECTOR       ((FLASH_PORT_SECTOR_SIZE / sizeof(Journal_Rec_t)) - 1U)   // slot 0 is the header
+#define TEST_FILL                 3000U     // records of the first boot, the ring holds 8 * 255
+#define TEST_MORE                 100U
+#define TEST_FAIL_APPENDS         40U
+#define TEST_MAX_GAPS             4U
+#define TEST_MAX_RECS             (TEST_SECTORS * TEST_REC_PER_SECTOR + 64U)
+#define TEST_SEEKS                2000U
+#define TEST_BLOCK                244U      // one BLE notification at the largest MTU
+#define TEST_EXPORT_ROUNDS        200U
+#define TEST_T0                   1750000000UL
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+/* kept by the parent across the boots */
+typedef struct Test_Shared_t
+{
+  uint32_t u32_Next;                        // index of the next record to append
+  uint32_t u32_Gaps;
+  uint32_t au32_GapFrom[TEST_MAX_GAPS];     // records lost, [from, to)
+  uint32_t au32_GapTo[TEST_MAX_GAPS];
+} Test_Shared_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+bool __real_FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len);
+bool __real_FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len);
+
+static void Test_Boot(const char *pc_Name, void (*pf_Boot)(void));
+static void Test_Task(void *pv_Arg);
+static uint32_t Test_Stray(void);
+static void Test_Gen(uint32_t u32_I, Journal_Rec_t *pst_Rec);
+static uint32_t Test_IndexOf(uint32_t u32_Time);
+static bool Test_Append(uint32_t u32_N);
+static uint32_t Test_SkipLost(uint32_t u32_I);
+static uint32_t Test_Verify(uint32_t u32_First);
+static void Test_Fill(void);
+static void Test_Reload(void);
+static void Test_Torn(void);
+static void Test_Recover(void);
+static void Test_WriteFail(void);
+static void Test_Final(void);
+static void Test_Seek(void);
+static void Test_Export(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static Test_Shared_t *shared;
+static char test_dir[] = "/tmp/frost_journal_XXXXXX";
+static char test_path[sizeof(test_dir) + 16U];
+
+/* state of one boot */
+static void (*test_boot)(void);
+static uint32_t test_erases = 0;
+static uint32_t test_writes = 0;
+static bool test_tear = false;            // next record page write is cut short, then power is lost
+static bool test_fail_writes = false;
+static uint32_t test_appending;           // index of the record in Journal_Append
+static TaskHandle_t test_main = NULL;
+static TaskHandle_t test_storage = NULL;
+static uint32_t test_strays = 0;          // erases and writes in other tasks
+static uint32_t test_present[TEST_MAX_RECS];   // indices read back by the last Test_Verify
+static uint32_t test_n_present;
+static pthread_mutex_t test_done_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_done_cond = PTHREAD_COND_INITIALIZER;
+static bool test_done = false;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  static uint8_t erased[TEST_SECTORS * FLASH_PORT_SECTOR_SIZE];
+  FILE *file;
+
+  shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  TEST_CHECK((shared != MAP_FAILED) && (mkdtemp(test_dir) != NULL), "no shared memory or flash directory");
+  (void)memset(shared, 0, sizeof(*shared));
+  (void)snprintf(test_path, sizeof(test_path), "%s/%s.bin", test_dir, JOURNAL_PARTITION);
+  (void)memset(erased, 0xFF, sizeof(erased));
+  file = fopen(test_path, "wb");
+  TEST_CHECK((file != NULL) && (fwrite(erased, 1, sizeof(erased), file) == sizeof(erased)), "can not create %s",
+             test_path);
+  (void)fclose(file);
+  (void)setenv("FROST_FLASH_DIR", test_dir, 1);
+  (void)fflush(stdout);
+
+  Test_Boot("fill", Test_Fill);
+  Test_Boot("reload", Test_Reload);
+  Test_Boot("torn", Test_Torn);
+  Test_Boot("recover", Test_Recover);
+  Test_Boot("fail", Test_WriteFail);
+  Test_Boot("final", Test_Final);
+
+  (void)unlink(test_path);
+  (void)rmdir(test_dir);
+  return Test_Exit("journal");
+}
+
+/**
+ * @brief Counted erase
+ */
+bool __wrap_FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len)
+{
+  test_erases++;
+  test_strays += Test_Stray();
+  return __real_FlashPort_Erase(pst_Port, u32_Offset, u32_Len);
+}
+
+/**
+ * @brief Counted write. With test_tear the first record write only gets
+ *        half its records and half of the next one into flash, then the
+ *        power is gone: the boot ends here.
+ */
+bool __wrap_FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len)
+{
+  if (test_fail_writes != false) {
+    return false;
+  }
+  test_writes++;
+  test_strays += Test_Stray();
+  if ((test_tear != false) && ((u32_Offset % FLASH_PORT_SECTOR_SIZE) != 0U) && (u32_Len >= (2U * sizeof(Journal_Rec_t)))) {
+    const Journal_Rec_t *rec = pv_Src;
+    const uint32_t kept = (u32_Len / sizeof(Journal_Rec_t)) / 2U;
+
+    (void)__real_FlashPort_Write(pst_Port, u32_Offset, pv_Src, (kept * sizeof(Journal_Rec_t)) + 8U);
+    shared->au32_GapFrom[shared->u32_Gaps] = Test_IndexOf(rec[0].u32_Time) + kept;
+    shared->au32_GapTo[shared->u32_Gaps] = test_appending + 1U;
+    shared->u32_Gaps++;
+    shared->u32_Next = test_appending + 1U;
+    printf("torn: page of %u records cut after %u and a half, %u records lost\n",
+           u32_Len / (uint32_t)sizeof(Journal_Rec_t), kept, test_appending + 1U - (Test_IndexOf(rec[0].u32_Time) + kept));
+    (void)fflush(stdout);
+    _exit((test_failed == 0U) ? 0 : 1);
+  }
+  return __real_FlashPort_Write(pst_Port, u32_Offset, pv_Src, u32_Len);
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Run one boot in a child process, fresh journal state on the same
+ *        flash file
+ * @param pc_Name : boot
+ * @param pf_Boot : checks, run in a task
+ */
+static void Test_Boot(const char *pc_Name, void (*pf_Boot)(void))
+{
+  pid_t pid;
+  int status = 0;
+
+  (void)fflush(stdout);
+  pid = fork();
+  if (pid == 0) {
+    test_boot = pf_Boot;
+    Sim_Start(true);
+    (void)xTaskCreate(Test_Task, pc_Name, 0, NULL, 1, &test_main);
+    (void)pthread_mutex_lock(&test_done_lock);
+    while (test_done == false) {
+      (void)pthread_cond_wait(&test_done_cond, &test_done_lock);
+    }
+    (void)pthread_mutex_unlock(&test_done_lock);
+    (void)fflush(stdout);
+    _exit((test_failed == 0U) ? 0 : 1);
+  }
+  TEST_CHECK((pid > 0) && (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0),
+             "boot %s failed, status 0x%x", pc_Name, status);
+}
+
+/**
+ * @brief The boot checks, in a task so the virtual clock runs
+ * @param pv_Arg
+ */
+static void Test_Task(void *pv_Arg)
+{
+  (void)pv_Arg;
+  Storage_Init();
+  (void)xTaskCreate(Storage_task, "storage", 0, NULL, 1, &test_storage);
+  test_boot();
+  TEST_CHECK(test_strays == 0U, "%u flash erases and writes outside the storage task and the test", test_strays);
+  Sim_Halt();
+  (void)pthread_mutex_lock(&test_done_lock);
+  test_done = true;
+  (void)pthread_cond_signal(&test_done_cond);
+  (void)pthread_mutex_unlock(&test_done_lock);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Check the task of a flash operation
+ * @return 1 if neither the storage task nor the test runs it
+ */
+static uint32_t Test_Stray(void)
+{
+  const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+  return ((task != test_storage) && (task != test_main)) ? 1U : 0U;
+}
+
+/**
+ * @brief Record number i: bottle events about every 90 s, alternating
+ *        placed and removed, with a slowly changing amount
+ * @param u32_I : index
+ * @param pst_Rec : record, CRC not set
+ */
+static void Test_Gen(uint32_t u32_I, Journal_Rec_t *pst_Rec)
+{
+  const uint32_t h = (u32_I * 2654435761U) >> 8;
+
+  pst_Rec->u32_Time = TEST_T0 + (u32_I * 90U) + (h % 60U);
+  pst_Rec->u16_Type = ((u32_I & 1U) == 0U) ? JOURNAL_BOTTLE_PLACED : JOURNAL_BOTTLE_REMOVED;
+  pst_Rec->u16_Arg = (uint16_t)((h >> 12) & 3U);
+  pst_Rec->u32_Data = 400U + ((u32_I * 7U) % 300U);
+}
+
+/**
+ * @brief Index of the generated record with a time, times are increasing
+ * @param u32_Time : time
+ * @return index of the first record at or after the time
+ */
+static uint32_t Test_IndexOf(uint32_t u32_Time)
+{
+  uint32_t lo = 0;
+  uint32_t hi = shared->u32_Next + TEST_FAIL_APPENDS + TEST_MORE;
+
+  while (lo < hi) {
+    const uint32_t mid = (lo + hi) / 2U;
+    Journal_Rec_t rec;
+
+    Test_Gen(mid, &rec);
+    if (rec.u32_Time < u32_Time) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * @brief Append the next records
+ * @param u32_N : count
+ * @return false if any Journal_Append returned false
+ */
+static bool Test_Append(uint32_t u32_N)
+{
+  bool ok = true;
+
+  for (uint32_t k = 0; k < u32_N; k++) {
+    Journal_Rec_t rec;
+
+    test_appending = shared->u32_Next;
+    Test_Gen(test_appending, &rec);
+    ok = Journal_Append((Journal_Type_t)rec.u16_Type, rec.u32_Time, rec.u16_Arg, rec.u32_Data) && ok;
+    shared->u32_Next++;
+  }
+  return ok;
+}
+
+/**
+ * @brief Step over records lost at a tear or refused
+ * @param u32_I : index
+ * @return u32_I, or the first index after its gap
+ */
+static uint32_t Test_SkipLost(uint32_t u32_I)
+{
+  for (uint32_t g = 0; g < shared->u32_Gaps; g++) {
+    if ((u32_I >= shared->au32_GapFrom[g]) && (u32_I < shared->au32_GapTo[g])) {
+      u32_I = shared->au32_GapTo[g];
+    }
+  }
+  return u32_I;
+}
+
+/**
+ * @brief Read the whole journal: generated records in order, only the lost
+ *        ones missing, ending with the last one appended. Fills test_present.
+ * @param u32_First : expected first index, UINT32_MAX if not known
+ * @return records read
+ */
+static uint32_t Test_Verify(uint32_t u32_First)
+{
+  Journal_Iter_t it;
+  Journal_Rec_t rec;
+  uint32_t expect = UINT32_MAX;
+  uint32_t bad = 0;
+
+  test_n_present = 0;
+  Journal_Seek(&it, 0);
+  while (Journal_Next(&it, &rec) && (test_n_present < TEST_MAX_RECS)) {
+    Journal_Rec_t ref;
+
+    if (expect == UINT32_MAX) {
+      expect = Test_IndexOf(rec.u32_Time);
+      TEST_CHECK((u32_First == UINT32_MAX) || (expect == u32_First), "journal starts at record %u, expected %u",
+                 expect, u32_First);
+    }
+    expect = Test_SkipLost(expect);
+    Test_Gen(expect, &ref);
+    if ((rec.u32_Time != ref.u32_Time) || (rec.u16_Type != ref.u16_Type) || (rec.u16_Arg != ref.u16_Arg) ||
+        (rec.u32_Data != ref.u32_Data)) {
+      bad++;
+    }
+    test_present[test_n_present++] = expect;
+    expect++;
+  }
+  TEST_CHECK(bad == 0U, "%u records differ", bad);
+  expect = Test_SkipLost(expect);
+  TEST_CHECK(expect == shared->u32_Next, "journal ends before record %u, %u appended", expect, shared->u32_Next);
+  return test_n_present;
+}
+
+/**
+ * @brief First boot on erased flash: more records than the ring holds
+ */
+static void Test_Fill(void)
+{
+  const uint32_t opened = (TEST_FILL + TEST_REC_PER_SECTOR - 1U) / TEST_REC_PER_SECTOR;
+  const uint32_t first = (opened - TEST_SECTORS) * TEST_REC_PER_SECTOR;
+  uint32_t n;
+
+  TEST_CHECK(Test_Append(TEST_FILL), "append failed");
+  TEST_CHECK(Journal_Flush(), "flush failed");
+  n = Test_Verify(first);
+  printf("fill: %u records, %u kept in %u sectors: %u erases, %u writes, %.3f writes per record\n", TEST_FILL, n,
+         TEST_SECTORS, test_erases, test_writes, (double)test_writes / TEST_FILL);
+  TEST_CHECK((test_erases == opened) && (Journal_GetErases() == opened), "%u erases, %u sectors opened", test_erases,
+             opened);
+  /* one write per page of records and one per sector header */
+  TEST_CHECK(test_writes <= (((TEST_FILL * sizeof(Journal_Rec_t)) / JOURNAL_PAGE_SIZE) + (2U * opened)),
+             "%u writes for %u records", test_writes, TEST_FILL);
+  TEST_CHECK(n == (TEST_FILL - first), "%u records kept", n);
+}
+
+/**
+ * @brief Second boot: the same records, then new ones read from RAM before
+ *        the storage task writes them JOURNAL_FLUSH_MS later. Starting
+ *        needs no erase.
+ */
+static void Test_Reload(void)
+{
+  uint32_t writes;
+
+  (void)Test_Verify(UINT32_MAX);
+  TEST_CHECK(test_erases == 0U, "boot erased %u sectors", test_erases);
+  TEST_CHECK(Test_Append(TEST_MORE), "append failed");
+  /* the last records are only in RAM, Test_Verify reads up to the last one */
+  (void)Test_Verify(UINT32_MAX);
+  writes = test_writes;
+  vTaskDelay(pdMS_TO_TICKS(JOURNAL_FLUSH_MS + 100U));
+  TEST_CHECK(test_writes > writes, "the RAM batch was not written %u ms later", JOURNAL_FLUSH_MS);
+  writes = test_writes;
+  TEST_CHECK(Journal_Flush() && (test_writes == writes), "the deferred flush left %u writes behind",
+             test_writes - writes);
+  printf("reload: the last %u records written %u ms later by the storage task\n",
+         TEST_MORE % (JOURNAL_PAGE_SIZE / (uint32_t)sizeof(Journal_Rec_t)), JOURNAL_FLUSH_MS);
+}
+
+/**
+ * @brief Third boot: the power goes while a page of records is written
+ */
+static void Test_Torn(void)
+{
+  test_tear = true;
+  (void)Test_Append(2U * JOURNAL_PAGE_SIZE / sizeof(Journal_Rec_t));
+  Test_Fail(__FILE__, __LINE__, "no record page was written");
+}
+
+/**
+ * @brief Fourth boot: the complete records of the torn page are there, the
+ *        torn one is skipped, appending continues after it
+ */
+static void Test_Recover(void)
+{
+  const uint32_t n = Test_Verify(UINT32_MAX);
+
+  TEST_CHECK(Test_Append(TEST_MORE) && Journal_Flush(), "append after the tear failed");
+  (void)Test_Verify(UINT32_MAX);
+  printf("recover: %u records up to the torn one read back, appending continues after it\n", n);
+}
+
+/**
+ * @brief Fifth boot: every write fails. The RAM batch holds one page, more
+ *        records are refused, once writes work again the batch is written.
+ */
+static void Test_WriteFail(void)
+{
+  const uint32_t batch = JOURNAL_PAGE_SIZE / sizeof(Journal_Rec_t);
+  const uint32_t from = shared->u32_Next;
+  uint32_t refused = 0;
+
+  (void)Test_Verify(UINT32_MAX);
+  test_fail_writes = true;
+  for (uint32_t k = 0; k < TEST_FAIL_APPENDS; k++) {
+    refused += Test_Append(1U) ? 0U : 1U;
+  }
+  TEST_CHECK(Journal_Flush() == false, "flush with failing writes");
+  test_fail_writes = false;
+  TEST_CHECK(Journal_Flush(), "flush failed after the writes work again");
+
+  shared->au32_GapFrom[shared->u32_Gaps] = from + batch;
+  shared->au32_GapTo[shared->u32_Gaps] = shared->u32_Next;
+  shared->u32_Gaps++;
+  (void)Test_Verify(UINT32_MAX);
+  printf("fail: %u appends with failing writes, %u held in RAM and written later, %u refused\n", TEST_FAIL_APPENDS,
+         batch, TEST_FAIL_APPENDS - batch);
+  TEST_CHECK(refused >= (TEST_FAIL_APPENDS - batch), "%u appends refused", refused);
+}
+
+/**
+ * @brief Last boot: everything still there, seek and export
+ */
+static void Test_Final(void)
+{
+  (void)Test_Verify(UINT32_MAX);
+  Test_Seek();
+  Test_Export();
+}
+
+/**
+ * @brief Seek to times before, between, on and after the records
+ */
+static void Test_Seek(void)
+{
+  Journal_Rec_t first;
+  Journal_Rec_t last;
+  uint32_t bad = 0;
+
+  Test_Gen(test_present[0], &first);
+  Test_Gen(test_present[test_n_present - 1U], &last);
+  const uint32_t span = last.u32_Time - first.u32_Time + 200U;
+
+  for (uint32_t k = 0; k < TEST_SEEKS; k++) {
+    const uint32_t t = first.u32_Time - 100U + (uint32_t)(((uint64_t)k * 2654435761U) % span);
+    Journal_Iter_t it;
+    Journal_Rec_t rec;
+    uint32_t i = 0;
+
+    Journal_Seek(&it, t);
+    while (i < test_n_present) {
+      Journal_Rec_t ref;
+
+      Test_Gen(test_present[i], &ref);
+      if (ref.u32_Time >= t) {
+        break;
+      }
+      i++;
+    }
+    if (Journal_Next(&it, &rec) != (i < test_n_present)) {
+      bad++;
+    } else if (i < test_n_present) {
+      bad += (Test_IndexOf(rec.u32_Time) != test_present[i]) ? 1U : 0U;
+    }
+  }
+  printf("seek: %u positions over %u records checked\n", TEST_SEEKS, test_n_present);
+  TEST_CHECK(bad == 0U, "seek: %u wrong positions", bad);
+}
+
+/**
+ * @brief Export the journal in BLE sized blocks, decode them and compare,
+ *        compression against the 16 byte flash records and records/s
+ */
+static void Test_Export(void)
+{
+  static uint8_t blocks[TEST_MAX_RECS][TEST_BLOCK];
+  static uint16_t lens[TEST_MAX_RECS];
+  static uint8_t scratch[TEST_BLOCK];
+  uint32_t n_blocks = 0;
+  uint32_t bytes = 0;
+  uint32_t n = 0;
+  uint32_t bad = 0;
+  Journal_Iter_t it;
+  double t_enc;
+  double t_dec;
+  double t0;
+
+  Journal_Seek(&it, 0);
+  while ((lens[n_blocks] = Journal_Export(&it, blocks[n_blocks], TEST_BLOCK)) != 0U) {
+    bytes += lens[n_blocks];
+    n_blocks++;
+  }
+  for (uint32_t b = 0; b < n_blocks; b++) {
+    Srvc_TsDec_t dec;
+    uint32_t time;
+    uint32_t val[JOURNAL_EXPORT_VALS];
+
+    TEST_CHECK(Srvc_TsDecInit(&dec, blocks[b], lens[b]), "block %u does not decode", b);
+    while (Srvc_TsDecGet(&dec, &time, val) && (n < test_n_present)) {
+      Journal_Rec_t ref;
+
+      Test_Gen(test_present[n++], &ref);
+      bad += ((time != ref.u32_Time) || (val[0] != (((uint32_t)ref.u16_Type << 16) | ref.u16_Arg)) ||
+              (val[1] != ref.u32_Data)) ? 1U : 0U;
+    }
+  }
+  TEST_CHECK((bad == 0U) && (n == test_n_present), "export: %u of %u records decoded, %u differ", n,
+             test_n_present, bad);
+
+  t0 = Test_Now();
+  for (uint32_t r = 0; r < TEST_EXPORT_ROUNDS; r++) {
+    Journal_Seek(&it, 0);
+    while (Journal_Export(&it, scratch, TEST_BLOCK) != 0U) {
+    }
+  }
+  t_enc = (Test_Now() - t0) / TEST_EXPORT_ROUNDS;
+  t0 = Test_Now();
+  for (uint32_t r = 0; r < TEST_EXPORT_ROUNDS; r++) {
+    for (uint32_t b = 0; b < n_blocks; b++) {
+      Srvc_TsDec_t dec;
+      uint32_t time;
+      uint32_t val[JOURNAL_EXPORT_VALS];
+
+      (void)Srvc_TsDecInit(&dec, blocks[b], lens[b]);
+      while (Srvc_TsDecGet(&dec, &time, val)) {
+        test_sink += (int32_t)time;
+      }
+    }
+  }
+  t_dec = (Test_Now() - t0) / TEST_EXPORT_ROUNDS;
+
+  printf("bench: export %u records in %u blocks of %u bytes: %u bytes, %.2f bytes per record, ratio %.2f\n", n,
+         n_blocks, TEST_BLOCK, bytes, (double)bytes / n, (double)(n * sizeof(Journal_Rec_t)) / bytes);
+  printf("bench: Journal_Export %.2f M records/s incl. flash reads, decode %.2f M records/s\n", n / t_enc / 1e6,
+         n / t_dec / 1e6);
+}
@@ -0,0 +1,221 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_order_stat
+ *  Description        : sliding min/max and streaming median of the filter
+ *                       library against a scan and a sort of the zero filled
+ *                       window, and ns per sample of both
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "filter_library.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_SAMPLES              20000U
+#define TEST_MAX_N                600U      // longest min/max window checked
+#define TEST_BENCH_SAMPLES        (1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_MinMax(uint16_t u16_N);
+static void Test_Median(uint8_t u8_N);
+static int Test_Cmp(const void *pv_A, const void *pv_B);
+static int16_t Test_NaiveMedian(const int16_t *ps16_Win, uint32_t u32_N);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static int16_t test_in[TEST_SAMPLES];
+static int16_t test_win[TEST_MAX_N];          // reference window, ring
+static int16_t test_val16[TEST_MAX_N];
+static int32_t test_val32[TEST_MAX_N];
+static uint32_t test_idx[TEST_MAX_N];
+static uint32_t test_idx2[TEST_MAX_N];
+static int16_t test_ring[SRVC_MEDIAN_MAX_N];
+static int16_t test_sorted[SRVC_MEDIAN_MAX_N];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  uint32_t h = 1;
+
+  /* noise with plateaus and ramps, so ties and long monotonic runs occur */
+  for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+    h = (h * 1103515245U) + 12345U;
+    switch ((i >> 9) & 3U) {
+      case 0:  test_in[i] = (int16_t)(h >> 16); break;
+      case 1:  test_in[i] = (int16_t)((h >> 28) * 100); break;
+      case 2:  test_in[i] = (int16_t)((int32_t)(i & 511U) * 64 - 16384); break;
+      default: test_in[i] = (int16_t)(16384 - (int32_t)(i & 511U) * 64); break;
+    }
+  }
+
+  for (uint16_t n = 1; n <= 40U; n++) {
+    Test_MinMax(n);
+  }
+  Test_MinMax(255U);
+  Test_MinMax(TEST_MAX_N);
+  for (uint8_t n = 1; n <= SRVC_MEDIAN_MAX_N; n++) {
+    Test_Median(n);
+  }
+  printf("min/max windows 1..40, 255, %u and median windows 1..%u checked on %u samples\n", TEST_MAX_N,
+         SRVC_MEDIAN_MAX_N, TEST_SAMPLES);
+
+  Test_Bench();
+  return Test_Exit("order_stat");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief S16 and S32, minimum and maximum, against a scan of the window
+ * @param u16_N : window length
+ */
+static void Test_MinMax(uint16_t u16_N)
+{
+  Srvc_SlidMinMaxS16_t max16;
+  Srvc_SlidMinMaxS32_t min32;
+  uint32_t bad = 0;
+
+  Srvc_SlidingMinMaxInit_S16(&max16, test_val16, test_idx, u16_N, true);
+  Srvc_SlidingMinMaxInit_S32(&min32, test_val32, test_idx2, u16_N, false);
+  (void)memset(test_win, 0, sizeof(test_win));
+
+  for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+
+    test_win[i % u16_N] = test_in[i];
+    for (uint32_t k = 0; k < u16_N; k++) {
+      lo = (test_win[k] < lo) ? test_win[k] : lo;
+      hi = (test_win[k] > hi) ? test_win[k] : hi;
+    }
+    bad += (Srvc_SlidingMinMax_S16(&max16, test_in[i]) != hi) ? 1U : 0U;
+    bad += (Srvc_SlidingMinMax_S32(&min32, (int32_t)test_in[i] * 65536) != ((int32_t)lo * 65536)) ? 1U : 0U;
+  }
+  TEST_CHECK(bad == 0U, "min/max window %u: %u wrong results", u16_N, bad);
+}
+
+/**
+ * @brief Median against qsort of the window
+ * @param u8_N : window length
+ */
+static void Test_Median(uint8_t u8_N)
+{
+  Srvc_MedianS16_t med;
+  uint32_t bad = 0;
+
+  Srvc_MedianInit_S16(&med, test_ring, test_sorted, u8_N);
+  (void)memset(test_win, 0, sizeof(test_win));
+
+  for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+    test_win[i % u8_N] = test_in[i];
+    bad += (Srvc_Median_S16(&med, test_in[i]) != Test_NaiveMedian(test_win, u8_N)) ? 1U : 0U;
+  }
+  TEST_CHECK(bad == 0U, "median window %u: %u wrong results", u8_N, bad);
+}
+
+static int Test_Cmp(const void *pv_A, const void *pv_B)
+{
+  return (int)*(const int16_t *)pv_A - (int)*(const int16_t *)pv_B;
+}
+
+/**
+ * @brief Median by copy and sort, the upper middle one for even windows
+ * @param ps16_Win : window
+ * @param u32_N : length
+ * @return median
+ */
+static int16_t Test_NaiveMedian(const int16_t *ps16_Win, uint32_t u32_N)
+{
+  int16_t tmp[SRVC_MEDIAN_MAX_N];
+
+  (void)memcpy(tmp, ps16_Win, u32_N * sizeof(int16_t));
+  qsort(tmp, u32_N, sizeof(int16_t), Test_Cmp);
+  return tmp[u32_N >> 1];
+}
+
+/**
+ * @brief ns per sample of the min/max deque against a window scan, and of
+ *        the median against copy and sort
+ */
+static void Test_Bench(void)
+{
+  static const uint16_t mm_win[] = { 8, 64, 512 };
+  static const uint8_t med_win[] = { 3, 5, 9, 15, 31 };
+  double t0;
+  double fast;
+  double naive;
+
+  for (uint32_t w = 0; w < (sizeof(mm_win) / sizeof(mm_win[0])); w++) {
+    const uint16_t n = mm_win[w];
+    Srvc_SlidMinMaxS16_t mm;
+
+    Srvc_SlidingMinMaxInit_S16(&mm, test_val16, test_idx, n, true);
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < TEST_BENCH_SAMPLES; i++) {
+      test_sink += Srvc_SlidingMinMax_S16(&mm, test_in[i % TEST_SAMPLES]);
+    }
+    fast = (Test_Now() - t0) / TEST_BENCH_SAMPLES * 1e9;
+
+    (void)memset(test_win, 0, sizeof(test_win));
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < (TEST_BENCH_SAMPLES / 16U); i++) {
+      int16_t hi = INT16_MIN;
+
+      test_win[i % n] = test_in[i % TEST_SAMPLES];
+      for (uint32_t k = 0; k < n; k++) {
+        hi = (test_win[k] > hi) ? test_win[k] : hi;
+      }
+      test_sink += hi;
+    }
+    naive = (Test_Now() - t0) / (TEST_BENCH_SAMPLES / 16U) * 1e9;
+    printf("bench: max window %3u: deque %.1f ns, scan %.1f ns per sample\n", n, fast, naive);
+  }
+
+  for (uint32_t w = 0; w < (sizeof(med_win) / sizeof(med_win[0])); w++) {
+    const uint8_t n = med_win[w];
+    Srvc_MedianS16_t med;
+
+    Srvc_MedianInit_S16(&med, test_ring, test_sorted, n);
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < TEST_BENCH_SAMPLES; i++) {
+      test_sink += Srvc_Median_S16(&med, test_in[i % TEST_SAMPLES]);
+    }
+    fast = (Test_Now() - t0) / TEST_BENCH_SAMPLES * 1e9;
+
+    (void)memset(test_win, 0, sizeof(test_win));
+    t0 = Test_Now();
+    for (uint32_t i = 0; i < (TEST_BENCH_SAMPLES / 16U); i++) {
+      test_win[i % n] = test_in[i % TEST_SAMPLES];
+      test_sink += Test_NaiveMedian(test_win, n);
+    }
+    naive = (Test_Now() - t0) / (TEST_BENCH_SAMPLES / 16U) * 1e9;
+    printf("bench: median window %2u: %.1f ns, copy and qsort %.1f ns per sample\n", n, fast, naive);
+  }
+}
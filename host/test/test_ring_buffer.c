@@ -0,0 +1,352 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_ring_buffer
+ *  Description        : ring buffer instrumentation, built with
+ *                       RING_BUFFER_STATS_ENABLE: bytes in and out, peak
+ *                       fill, overflows and drops against a model of the
+ *                       buffer for known and random push/read sequences,
+ *                       latency histogram bucket edges on a test cycle
+ *                       counter, and ns per byte
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <string.h>
+#include "ring_buffer.h"
+#include "sim.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_SIZE                 64U
+#define TEST_RANDOM_OPS           200000U
+#define TEST_BENCH_BYTES          (16U * 1024U * 1024U)
+#define TEST_BENCH_CHUNK          48U       // bytes pushed before each read
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+
+/*
+ * @brief what the counters of one buffer must read
+ */
+typedef struct Test_Model_t
+{
+  uint32_t u32_Fill;                  // unread bytes
+  uint32_t u32_In;
+  uint32_t u32_Out;
+  uint32_t u32_Peak;
+  uint32_t u32_Overflows;
+  uint32_t u32_Drops;
+  uint8_t u8_Next;                    // value of the next pushed byte
+  uint8_t u8_Expect;                  // value of the next byte read
+} Test_Model_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_Push(enum ringbufferIndex e_Idx, Test_Model_t *pst_Model, uint32_t u32_N);
+static uint32_t Test_Read(enum ringbufferIndex e_Idx, Test_Model_t *pst_Model);
+static void Test_Compare(const char *pc_Name, enum ringbufferIndex e_Idx, const Test_Model_t *pst_Model);
+static void Test_Known(void);
+static void Test_Random(void);
+static void Test_Latency(void);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static uint8_t test_mem[RING_BUFFER_MAX_IDX][TEST_SIZE];
+static uint32_t test_cycles;                  // Sim_Cycles, esp_cpu_get_cycle_count of the module
+static uint32_t test_bad;                     // bytes read with a wrong value
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Test_Known();
+  Test_Random();
+  Test_Latency();
+  Test_Bench();
+  return Test_Exit("ring_buffer");
+}
+
+uint64_t Sim_Cycles(void)
+{
+  return test_cycles;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Push bytes and update the model. A push into a buffer holding
+ *        size - 1 bytes is an overflow that loses everything.
+ * @param e_Idx : buffer
+ * @param pst_Model : model of the buffer
+ * @param u32_N : bytes
+ */
+static void Test_Push(enum ringbufferIndex e_Idx, Test_Model_t *pst_Model, uint32_t u32_N)
+{
+  for (uint32_t i = 0; i < u32_N; i++) {
+    RingBuffer_Push(e_Idx, pst_Model->u8_Next);
+    pst_Model->u8_Next++;
+    pst_Model->u32_In++;
+    if ((pst_Model->u32_Fill + 1U) >= TEST_SIZE) {
+      pst_Model->u32_Overflows++;
+      pst_Model->u32_Drops += pst_Model->u32_Fill + 1U;
+      pst_Model->u32_Fill = 0;
+      pst_Model->u8_Expect = pst_Model->u8_Next;
+    } else {
+      pst_Model->u32_Fill++;
+      if (pst_Model->u32_Fill > pst_Model->u32_Peak) {
+        pst_Model->u32_Peak = pst_Model->u32_Fill;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Read the contiguous part like the console does and check the bytes
+ * @param e_Idx : buffer
+ * @param pst_Model : model of the buffer
+ * @return bytes read
+ */
+static uint32_t Test_Read(enum ringbufferIndex e_Idx, Test_Model_t *pst_Model)
+{
+  const uint16_t n = RingBuffer_GetFilledCount(e_Idx);
+  const uint8_t *const p = RingBuffer_ReadPtr(e_Idx);
+
+  for (uint16_t i = 0; i < n; i++) {
+    test_bad += (p[i] != pst_Model->u8_Expect) ? 1U : 0U;
+    pst_Model->u8_Expect++;
+  }
+  RingBuffer_UpdateReadPtr(e_Idx);
+  pst_Model->u32_Fill -= n;
+  pst_Model->u32_Out += n;
+  return n;
+}
+
+/**
+ * @brief Counters of a buffer against its model
+ * @param pc_Name : sequence
+ * @param e_Idx : buffer
+ * @param pst_Model : model of the buffer
+ */
+static void Test_Compare(const char *pc_Name, enum ringbufferIndex e_Idx, const Test_Model_t *pst_Model)
+{
+  RingBuffer_Stats_t st;
+
+  RingBuffer_GetStats(e_Idx, &st);
+  TEST_CHECK(st.u16_Size == TEST_SIZE, "%s: size %u", pc_Name, st.u16_Size);
+  TEST_CHECK((st.u32_BytesIn == pst_Model->u32_In) && (st.u32_BytesOut == pst_Model->u32_Out),
+             "%s: in %u out %u, expected %u %u", pc_Name, st.u32_BytesIn, st.u32_BytesOut, pst_Model->u32_In,
+             pst_Model->u32_Out);
+  TEST_CHECK(st.u16_PeakFill == pst_Model->u32_Peak, "%s: peak %u, expected %u", pc_Name, st.u16_PeakFill,
+             pst_Model->u32_Peak);
+  TEST_CHECK((st.u32_Overflows == pst_Model->u32_Overflows) && (st.u32_Drops == pst_Model->u32_Drops),
+             "%s: %u overflows %u drops, expected %u %u", pc_Name, st.u32_Overflows, st.u32_Drops,
+             pst_Model->u32_Overflows, pst_Model->u32_Drops);
+  TEST_CHECK(test_bad == 0U, "%s: %u bytes read back wrong", pc_Name, test_bad);
+}
+
+/**
+ * @brief Hand written sequences: fill and read, a read split by the wrap
+ *        around, the largest fill, the overflow and the reset
+ */
+static void Test_Known(void)
+{
+  const enum ringbufferIndex idx = RING_BUFFER_CONSOLE;
+  Test_Model_t model = { 0 };
+  RingBuffer_Stats_t st;
+
+  RingBuffer_vInit(idx, test_mem[idx], TEST_SIZE);
+  test_bad = 0;
+
+  Test_Push(idx, &model, 10U);
+  TEST_CHECK(Test_Read(idx, &model) == 10U, "10 bytes pushed, not read in one piece");
+  Test_Compare("push 10, read 10", idx, &model);
+
+  /* 40 bytes from offset 10, then 30 from offset 50: 14 up to the end and
+     16 from the start, read in two pieces */
+  Test_Push(idx, &model, 40U);
+  TEST_CHECK(Test_Read(idx, &model) == 40U, "40 bytes pushed, not read in one piece");
+  Test_Push(idx, &model, 30U);
+  TEST_CHECK(Test_Read(idx, &model) == 14U, "the read before the wrap around is not 14 bytes");
+  TEST_CHECK(Test_Read(idx, &model) == 16U, "the read after the wrap around is not 16 bytes");
+  Test_Compare("read across the wrap around", idx, &model);
+
+  /* size - 1 bytes is the most the buffer holds */
+  Test_Push(idx, &model, TEST_SIZE - 1U);
+  TEST_CHECK(model.u32_Peak == (TEST_SIZE - 1U), "model peak %u", model.u32_Peak);
+  Test_Compare("fill to size - 1", idx, &model);
+
+  /* one more catches the read pointer: the buffer reads as empty */
+  Test_Push(idx, &model, 1U);
+  TEST_CHECK(RingBuffer_GetFilledCount(idx) == 0U, "%u bytes readable after the overflow",
+             RingBuffer_GetFilledCount(idx));
+  TEST_CHECK((model.u32_Overflows == 1U) && (model.u32_Drops == TEST_SIZE), "model %u overflows %u drops",
+             model.u32_Overflows, model.u32_Drops);
+  Test_Compare("overflow", idx, &model);
+  Test_Push(idx, &model, 3U);
+  TEST_CHECK(Test_Read(idx, &model) == 3U, "3 bytes pushed after the overflow, not read");
+  Test_Compare("push after the overflow", idx, &model);
+
+  RingBuffer_ResetStats(idx);
+  RingBuffer_GetStats(idx, &st);
+  TEST_CHECK((st.u16_Size == TEST_SIZE) && (st.u32_BytesIn == 0U) && (st.u16_PeakFill == 0U) &&
+             (st.u32_Overflows == 0U) && (st.u32_LatMax == 0U), "reset does not clear the counters or keep the size");
+  printf("known: in/out, peak %u of %u, 1 overflow dropping %u bytes, reset\n", model.u32_Peak, TEST_SIZE,
+         model.u32_Drops);
+}
+
+/**
+ * @brief Random bursts of pushes and reads on two buffers at once
+ */
+static void Test_Random(void)
+{
+  Test_Model_t model[2] = { { 0 }, { 0 } };
+  const enum ringbufferIndex idx[2] = { RING_BUFFER_SHELL, RING_BUFFER_TOUCH_COMMS };
+  uint32_t h = 2463534242U;
+
+  test_bad = 0;
+  for (uint32_t b = 0; b < 2U; b++) {
+    RingBuffer_vInit(idx[b], test_mem[idx[b]], TEST_SIZE);
+  }
+  for (uint32_t i = 0; i < TEST_RANDOM_OPS; i++) {
+    h ^= h << 13;
+    h ^= h >> 17;
+    h ^= h << 5;
+    const uint32_t b = h & 1U;
+    if (((h >> 1) % 3U) == 0U) {
+      (void)Test_Read(idx[b], &model[b]);
+    } else {
+      /* bursts of up to 40 bytes, every 16th op or so runs into the reader */
+      Test_Push(idx[b], &model[b], (h >> 8) % 41U);
+    }
+  }
+  Test_Compare("random, shell", idx[0], &model[0]);
+  Test_Compare("random, touch_comms", idx[1], &model[1]);
+  printf("random: %u ops, %u + %u overflows, peaks %u and %u\n", TEST_RANDOM_OPS, model[0].u32_Overflows,
+         model[1].u32_Overflows, model[0].u32_Peak, model[1].u32_Peak);
+}
+
+/**
+ * @brief Latencies on both edges of every bucket, a read behind the wrap
+ *        around that keeps the age of the oldest byte, and a cycle counter
+ *        that wraps between push and read
+ */
+static void Test_Latency(void)
+{
+  const enum ringbufferIndex idx = RING_BUFFER_SHELL;
+  uint32_t expect[RING_BUFFER_LAT_BUCKETS] = { 0 };
+  Test_Model_t model = { 0 };
+  RingBuffer_Stats_t st;
+  uint32_t lat_max = 0;
+
+  test_bad = 0;
+  RingBuffer_vInit(idx, test_mem[idx], TEST_SIZE);
+  for (uint32_t b = 0; b < RING_BUFFER_LAT_BUCKETS; b++) {
+    /* bucket b holds [2^(b + MIN_SHIFT), 2^(b + 1 + MIN_SHIFT)), the first
+       one also below, the last one also above */
+    const uint32_t lo = (b == 0U) ? 0U : (1UL << (b + RING_BUFFER_LAT_MIN_SHIFT));
+    const uint32_t hi = (b == (RING_BUFFER_LAT_BUCKETS - 1U)) ? UINT32_MAX
+                                                               : ((1UL << (b + 1U + RING_BUFFER_LAT_MIN_SHIFT)) - 1U);
+    const uint32_t edge[2] = { lo, hi };
+
+    for (uint32_t e = 0; e < 2U; e++) {
+      const uint32_t t0 = 0xFFFFF000U + (b * 977U);     // most of them wrap the counter
+      test_cycles = t0;
+      Test_Push(idx, &model, 1U + (b % 5U));
+      test_cycles = t0 + (edge[e] / 2U);
+      Test_Push(idx, &model, 2U);                         // younger bytes do not count
+      test_cycles = t0 + edge[e];
+      /* a block behind the buffer wrap around is a second read of the same age */
+      while (model.u32_Fill != 0U) {
+        (void)Test_Read(idx, &model);
+        expect[b]++;
+      }
+      lat_max = (edge[e] > lat_max) ? edge[e] : lat_max;
+    }
+  }
+  RingBuffer_GetStats(idx, &st);
+  for (uint32_t b = 0; b < RING_BUFFER_LAT_BUCKETS; b++) {
+    TEST_CHECK(st.au32_LatHist[b] == expect[b], "bucket %u holds %u, expected %u", b, st.au32_LatHist[b], expect[b]);
+  }
+  TEST_CHECK(st.u32_LatMax == lat_max, "max latency %u, expected %u", st.u32_LatMax, lat_max);
+
+  /* 20 bytes up to the end, 10 behind the wrap around: the second read is
+     measured from the first push, an upper bound */
+  RingBuffer_vInit(idx, test_mem[idx], TEST_SIZE);
+  model = (Test_Model_t){ 0 };
+  test_cycles = 100000U;
+  Test_Push(idx, &model, TEST_SIZE - 20U);
+  (void)Test_Read(idx, &model);                           // latency 0, bucket 0
+  Test_Push(idx, &model, 30U);
+  test_cycles += 3000U;
+  TEST_CHECK(Test_Read(idx, &model) == 20U, "the read before the wrap around is not 20 bytes");
+  test_cycles += 5000U;
+  TEST_CHECK(Test_Read(idx, &model) == 10U, "the read after the wrap around is not 10 bytes");
+  RingBuffer_GetStats(idx, &st);
+  TEST_CHECK((st.au32_LatHist[1] == 1U) && (st.au32_LatHist[2] == 1U) && (st.u32_LatMax == 8000U),
+             "split read: buckets 1 and 2 hold %u and %u, max %u, expected 1, 1 and 8000", st.au32_LatHist[1],
+             st.au32_LatHist[2], st.u32_LatMax);
+
+  /* drained, the next push starts a new age: bucket 0 again, not 2^20 */
+  test_cycles += 1000000U;
+  Test_Push(idx, &model, 1U);
+  test_cycles += 100U;
+  (void)Test_Read(idx, &model);
+  RingBuffer_GetStats(idx, &st);
+  TEST_CHECK(st.au32_LatHist[0] == 2U, "after the drain the age carried on, bucket 0 holds %u", st.au32_LatHist[0]);
+  Test_Compare("latency", idx, &model);
+
+  printf("latency: both edges of %u log2 buckets from 2^%u cycles, wrapping counter, split read\n",
+         RING_BUFFER_LAT_BUCKETS, RING_BUFFER_LAT_MIN_SHIFT + 1U);
+  RingBuffer_PrintStats();
+}
+
+/**
+ * @brief ns per byte for a push and its share of a read, statistics on
+ */
+static void Test_Bench(void)
+{
+  const enum ringbufferIndex idx = RING_BUFFER_CONSOLE;
+  const uint8_t *const base = test_mem[idx];
+  uint32_t sum = 0;
+  double t0;
+
+  RingBuffer_vInit(idx, test_mem[idx], TEST_SIZE);
+  t0 = Test_Now();
+  for (uint32_t i = 0; i < (TEST_BENCH_BYTES / TEST_BENCH_CHUNK); i++) {
+    test_cycles += 64U;
+    for (uint32_t k = 0; k < TEST_BENCH_CHUNK; k++) {
+      RingBuffer_Push(idx, (uint8_t)k);
+    }
+    while (RingBuffer_GetFilledCount(idx) != 0U) {
+      sum += (uint32_t)(RingBuffer_ReadPtr(idx) - base);
+      RingBuffer_UpdateReadPtr(idx);
+    }
+  }
+  const double s = Test_Now() - t0;
+  test_sink += (int32_t)sum;
+  printf("bench: %.2f ns per byte pushed and read, %u byte bursts, statistics on\n", s * 1e9 / TEST_BENCH_BYTES,
+         TEST_BENCH_CHUNK);
+}
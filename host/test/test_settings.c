@@ -0,0 +1,289 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_settings
+ *  Description        : settings on the simulated kernel with the virtual
+ *                       clock: flash erases and writes for bursts of
+ *                       changes, reload, and a commit that has to wait for
+ *                       the deferred one has in flight. The flash port is
+ *                       wrapped to count, to take the time of a sector
+ *                       erase and to check that only the storage task and
+ *                       the test write, never the timer daemon.
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "flash_port.h"
+#include "settings.h"
+#include "storage.h"
+#include "sim.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_ERASE_MS             40U       // 4 KiB sector erase of the ESP32 flash, typical
+#define TEST_BURST_SETS           100U
+#define TEST_BURST_GAP_MS         10U
+#define TEST_STREAM_S             95U       // one change per second, never quiet
+#define TEST_POLL_MS              10U       // the IR poll timer of the state machine
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+bool __real_FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len);
+bool __real_FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len);
+
+static uint32_t Test_Stray(void);
+static void Test_Poll(TimerHandle_t timer);
+static void Test_Main(void *pv_Arg);
+static void Test_Burst(void);
+static void Test_Stream(void);
+static void Test_Reload(void);
+static void Test_InFlight(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static uint32_t test_erases = 0;
+static uint32_t test_writes = 0;
+static volatile bool test_busy = false;   // inside a wrapped erase or write
+static TaskHandle_t test_main = NULL;
+static TaskHandle_t test_storage = NULL;
+static uint32_t test_strays = 0;          // erases and writes in other tasks
+static TickType_t test_poll_last = 0;
+static TickType_t test_poll_gap = 0;      // longest time between two polls
+static char test_dir[] = "/tmp/frost_settings_XXXXXX";
+static char test_path[sizeof(test_dir) + 16U];
+static pthread_mutex_t test_done_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_done_cond = PTHREAD_COND_INITIALIZER;
+static bool test_done = false;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  static uint8_t erased[2U * FLASH_PORT_SECTOR_SIZE];
+  FILE *file;
+
+  TEST_CHECK(mkdtemp(test_dir) != NULL, "can not create %s", test_dir);
+  (void)snprintf(test_path, sizeof(test_path), "%s/%s.bin", test_dir, SETTINGS_PARTITION);
+  (void)memset(erased, 0xFF, sizeof(erased));
+  file = fopen(test_path, "wb");
+  TEST_CHECK((file != NULL) && (fwrite(erased, 1, sizeof(erased), file) == sizeof(erased)), "can not create %s",
+             test_path);
+  (void)fclose(file);
+  (void)setenv("FROST_FLASH_DIR", test_dir, 1);
+
+  Sim_Start(true);
+  (void)xTaskCreate(Test_Main, "test", 0, NULL, 1, &test_main);
+  (void)pthread_mutex_lock(&test_done_lock);
+  while (test_done == false) {
+    (void)pthread_cond_wait(&test_done_cond, &test_done_lock);
+  }
+  (void)pthread_mutex_unlock(&test_done_lock);
+
+  (void)unlink(test_path);
+  (void)rmdir(test_dir);
+  return Test_Exit("settings");
+}
+
+/**
+ * @brief Counted erase that blocks the calling task for the erase time
+ */
+bool __wrap_FlashPort_Erase(FlashPort_t *pst_Port, uint32_t u32_Offset, uint32_t u32_Len)
+{
+  bool ok;
+
+  test_busy = true;
+  test_erases++;
+  test_strays += Test_Stray();
+  vTaskDelay(pdMS_TO_TICKS(TEST_ERASE_MS));
+  ok = __real_FlashPort_Erase(pst_Port, u32_Offset, u32_Len);
+  test_busy = false;
+  return ok;
+}
+
+/**
+ * @brief Counted write, a record is written within a tick
+ */
+bool __wrap_FlashPort_Write(FlashPort_t *pst_Port, uint32_t u32_Offset, const void *pv_Src, uint32_t u32_Len)
+{
+  bool ok;
+
+  test_busy = true;
+  test_writes++;
+  test_strays += Test_Stray();
+  vTaskDelay(1);
+  ok = __real_FlashPort_Write(pst_Port, u32_Offset, pv_Src, u32_Len);
+  test_busy = false;
+  return ok;
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Check the task of a flash operation
+ * @return 1 if neither the storage task nor the test runs it
+ */
+static uint32_t Test_Stray(void)
+{
+  const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+  return ((task != test_storage) && (task != test_main)) ? 1U : 0U;
+}
+
+/**
+ * @brief Stand-in for the IR poll in the timer daemon, records the longest
+ *        time between two calls
+ * @param timer
+ */
+static void Test_Poll(TimerHandle_t timer)
+{
+  const TickType_t now = xTaskGetTickCount();
+
+  (void)timer;
+  if ((now - test_poll_last) > test_poll_gap) {
+    test_poll_gap = now - test_poll_last;
+  }
+  test_poll_last = now;
+}
+
+/**
+ * @brief The checks, in a task so the virtual clock runs
+ * @param pv_Arg
+ */
+static void Test_Main(void *pv_Arg)
+{
+  (void)pv_Arg;
+  Storage_Init();
+  (void)xTaskCreate(Storage_task, "storage", 0, NULL, 1, &test_storage);
+  test_poll_last = xTaskGetTickCount();
+  (void)xTimerStart(xTimerCreate("poll", pdMS_TO_TICKS(TEST_POLL_MS), pdTRUE, NULL, Test_Poll), 0);
+  Settings_Init();
+  TEST_CHECK((Settings_Get(SETTINGS_DRINK_TIMER_S) == 3600) && (test_erases == 0U),
+             "blank flash: drink timer %d, %u erases", Settings_Get(SETTINGS_DRINK_TIMER_S), test_erases);
+
+  Test_Burst();
+  Test_Stream();
+  Test_Reload();
+  Test_InFlight();
+  TEST_CHECK(test_strays == 0U, "%u flash erases and writes outside the storage task and the test", test_strays);
+  printf("%u ms poll timer next to %u commits: longest gap %u ms\n", TEST_POLL_MS, Settings_GetCommits(),
+         (uint32_t)(test_poll_gap * portTICK_PERIOD_MS));
+  TEST_CHECK(test_poll_gap <= pdMS_TO_TICKS(TEST_POLL_MS), "the poll timer stalled for %u ms",
+             (uint32_t)(test_poll_gap * portTICK_PERIOD_MS));
+
+  Sim_Halt();
+  (void)pthread_mutex_lock(&test_done_lock);
+  test_done = true;
+  (void)pthread_cond_signal(&test_done_cond);
+  (void)pthread_mutex_unlock(&test_done_lock);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief A burst of changes ends in one commit, values set again to what
+ *        they are cost nothing
+ */
+static void Test_Burst(void)
+{
+  for (uint32_t i = 0; i < TEST_BURST_SETS; i++) {
+    Settings_Set((Settings_Id_t)(i % SETTINGS_MAX), (int32_t)(100U + i));
+    vTaskDelay(pdMS_TO_TICKS(TEST_BURST_GAP_MS));
+  }
+  vTaskDelay(pdMS_TO_TICKS(SETTINGS_QUIET_MS + 100U));
+  printf("burst of %u changes in %u ms: %u erases, %u writes, %u commits\n", TEST_BURST_SETS,
+         TEST_BURST_SETS * TEST_BURST_GAP_MS, test_erases, test_writes, Settings_GetCommits());
+  TEST_CHECK((test_erases == 1U) && (test_writes == 1U) && (Settings_GetCommits() == 1U),
+             "burst: %u erases, %u writes, %u commits", test_erases, test_writes, Settings_GetCommits());
+
+  for (uint32_t i = 0; i < TEST_BURST_SETS; i++) {
+    Settings_Set(SETTINGS_DRINK_TIMER_S, Settings_Get(SETTINGS_DRINK_TIMER_S));
+  }
+  vTaskDelay(pdMS_TO_TICKS(SETTINGS_QUIET_MS + 100U));
+  TEST_CHECK((test_erases == 1U) && Settings_Commit(), "unchanged values: %u erases", test_erases);
+}
+
+/**
+ * @brief Changes that never pause are written every SETTINGS_MAX_DEFER_MS
+ */
+static void Test_Stream(void)
+{
+  const uint32_t before = test_erases;
+  const uint32_t least = (TEST_STREAM_S * 1000U) / (SETTINGS_MAX_DEFER_MS + 1000U);
+  const uint32_t most = ((TEST_STREAM_S * 1000U) / SETTINGS_MAX_DEFER_MS) + 1U;
+  uint32_t n;
+
+  for (uint32_t s = 0; s < TEST_STREAM_S; s++) {
+    Settings_Set(SETTINGS_CLEAN_TIMER_S, (int32_t)(1000U + s));
+    vTaskDelay(pdMS_TO_TICKS(1000U));
+  }
+  vTaskDelay(pdMS_TO_TICKS(SETTINGS_QUIET_MS + 100U));
+  n = test_erases - before;
+  printf("a change every second for %u s: %u erases, %u writes\n", TEST_STREAM_S, n, test_writes - before);
+  TEST_CHECK((n >= least) && (n <= most) && (test_writes == test_erases), "stream: %u erases, %u to %u expected", n,
+             least, most);
+}
+
+/**
+ * @brief The newest record comes back after a restart
+ */
+static void Test_Reload(void)
+{
+  const int32_t drink = Settings_Get(SETTINGS_DRINK_TIMER_S);
+  const int32_t place = Settings_Get(SETTINGS_PLACE_TIMER_S);
+  const int32_t clean = Settings_Get(SETTINGS_CLEAN_TIMER_S);
+
+  Settings_Init();
+  TEST_CHECK((Settings_Get(SETTINGS_DRINK_TIMER_S) == drink) && (Settings_Get(SETTINGS_PLACE_TIMER_S) == place) &&
+             (Settings_Get(SETTINGS_CLEAN_TIMER_S) == clean), "reload: %d %d %d, expected %d %d %d",
+             Settings_Get(SETTINGS_DRINK_TIMER_S), Settings_Get(SETTINGS_PLACE_TIMER_S),
+             Settings_Get(SETTINGS_CLEAN_TIMER_S), drink, place, clean);
+}
+
+/**
+ * @brief Settings_Commit before deep sleep while the deferred commit in
+ *        the storage task erases the sector: it returns once that record is in flash and
+ *        does not write a second one
+ */
+static void Test_InFlight(void)
+{
+  const uint32_t before = test_writes;
+  bool ok;
+
+  Settings_Set(SETTINGS_PLACE_TIMER_S, 42);
+  vTaskDelay(pdMS_TO_TICKS(SETTINGS_QUIET_MS + TEST_BURST_GAP_MS));
+  TEST_CHECK(test_busy != false, "the quiet commit is not in flight");
+  ok = Settings_Commit();
+  TEST_CHECK(ok && (test_busy == false) && (test_writes == (before + 1U)),
+             "commit during a commit: returned %d with %s flash, %u writes", ok, test_busy ? "busy" : "idle",
+             test_writes - before);
+
+  Settings_Init();
+  TEST_CHECK(Settings_Get(SETTINGS_PLACE_TIMER_S) == 42, "in flight record lost: %d",
+             Settings_Get(SETTINGS_PLACE_TIMER_S));
+}
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_sliding_avg
+ *  Description        : sliding averages of the multiplication library, the
+ *                       S16 shift and divide paths, S32 and the bank, against
+ *                       a plain sum over the window for windows 4 to 256,
+ *                       and ns per sample of each
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "multiplication_library.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_MAX_N                256U
+#define TEST_SAMPLES              4096U
+#define TEST_CH                   16U      // channels of the bank
+#define TEST_BENCH_SAMPLES        (1024U * 1024U)
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_Window(uint16_t u16_N);
+static int16_t Test_Input(uint32_t u32_I, uint32_t u32_Ch);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static int16_t test_in[TEST_CH][TEST_SAMPLES];
+static int16_t test_hist16[TEST_MAX_N];
+static int16_t test_hist16b[TEST_MAX_N];
+static int32_t test_hist32[TEST_MAX_N];
+static int16_t test_bank_hist[TEST_MAX_N * TEST_CH];
+static int32_t test_bank_sum[TEST_CH];
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  for (uint32_t c = 0; c < TEST_CH; c++) {
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+      test_in[c][i] = Test_Input(i, c);
+    }
+  }
+
+  for (uint16_t n = 4; n <= TEST_MAX_N; n++) {
+    Test_Window(n);
+  }
+  printf("windows 4..%u: S16 shift and divide, S32, array and bank of %u channels checked\n", TEST_MAX_N, TEST_CH);
+
+  Test_Bench();
+  return Test_Exit("sliding_avg");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Full scale pseudo random input with a slow offset, so the sums
+ *        cover both signs and large magnitudes
+ * @param u32_I : sample
+ * @param u32_Ch : channel
+ * @return value
+ */
+static int16_t Test_Input(uint32_t u32_I, uint32_t u32_Ch)
+{
+  const uint32_t h = ((u32_I * 2654435761U) ^ (u32_Ch * 40503U)) * 2246822519U;
+  const int32_t noise = (int32_t)(h >> 16) - 32768;
+  const int32_t offset = ((int32_t)((u32_I >> 6) & 0xFFU) - 128) * 128;
+  const int32_t v = (noise / 2) + offset;
+
+  return (int16_t)((v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : v));
+}
+
+/**
+ * @brief Every variant against sum(last N) / N, the window starts zero
+ *        filled
+ * @param u16_N : window length
+ */
+static void Test_Window(uint16_t u16_N)
+{
+  Srvc_AvrgsldngS16_t s16;
+  Srvc_AvrgsldngS16_t s16_div;
+  Srvc_AvrgsldngS32_t s32;
+  Srvc_AvrgBankS16_t bank;
+  int16_t row[TEST_CH];
+  uint32_t bad = 0;
+
+  if (u16_N <= UINT8_MAX) {
+    Srvc_AverageSlidingInit_S16(&s16, test_hist16, (uint8_t)u16_N);
+    Srvc_AverageSlidingInit_S32(&s32, test_hist32, (uint8_t)u16_N);
+    /* a struct set up by hand has u8_Shift 0 and always divides */
+    Srvc_AverageSlidingInit_S16(&s16_div, test_hist16b, (uint8_t)u16_N);
+    s16_div.u8_Shift = 0U;
+  }
+  Srvc_AverageBankInit_S16(&bank, test_bank_sum, test_bank_hist, TEST_CH, u16_N);
+
+  for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+    int32_t sum = 0;
+
+    for (uint32_t k = 0; (k < u16_N) && (k <= i); k++) {
+      sum += test_in[0][i - k];
+    }
+    const int32_t ref = sum / (int32_t)u16_N;
+
+    if (u16_N <= UINT8_MAX) {
+      bad += (Srvc_AverageSliding_S16(&s16, test_in[0][i], 1, 1) != ref) ? 1U : 0U;
+      bad += (Srvc_AverageSliding_S16(&s16_div, test_in[0][i], 1, 1) != ref) ? 1U : 0U;
+      bad += (Srvc_AverageSliding_S32(&s32, (int32_t)test_in[0][i] * 65536) != (sum * 65536LL) / u16_N) ? 1U : 0U;
+      if (i >= u16_N) {
+        bad += (Srvc_AverageArray_S16(&test_in[0][i + 1U - u16_N], (uint8_t)u16_N) != ref) ? 1U : 0U;
+      }
+    }
+
+    for (uint32_t c = 0; c < TEST_CH; c++) {
+      row[c] = test_in[c][i];
+    }
+    Srvc_AverageBank_S16(&bank, row, row);
+    bad += (row[0] != ref) ? 1U : 0U;
+    for (uint32_t c = 1; (c < TEST_CH) && (i == (TEST_SAMPLES - 1U)); c++) {
+      sum = 0;
+      for (uint32_t k = 0; k < u16_N; k++) {
+        sum += test_in[c][i - k];
+      }
+      bad += (row[c] != (sum / (int32_t)u16_N)) ? 1U : 0U;
+    }
+  }
+  TEST_CHECK(bad == 0U, "window %u: %u wrong averages", u16_N, bad);
+}
+
+/**
+ * @brief ns per sample of a single S16 average and per channel of the
+ *        bank, for a power of two window (shift) and one below (divide)
+ */
+static void Test_Bench(void)
+{
+  static const uint16_t win[] = { 4, 16, 64, 128, 256 };
+  int16_t row[TEST_CH];
+
+  for (uint32_t w = 0; w < (sizeof(win) / sizeof(win[0])); w++) {
+    double ns[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    for (uint32_t v = 0; v < 2U; v++) {
+      const uint16_t n = (uint16_t)(win[w] - v);   // v 1 is the division path
+      Srvc_AvrgsldngS16_t s16;
+      Srvc_AvrgBankS16_t bank;
+      double t0;
+
+      if (n <= UINT8_MAX) {
+        Srvc_AverageSlidingInit_S16(&s16, test_hist16, (uint8_t)n);
+        t0 = Test_Now();
+        for (uint32_t i = 0; i < TEST_BENCH_SAMPLES; i++) {
+          test_sink += Srvc_AverageSliding_S16(&s16, test_in[0][i & (TEST_SAMPLES - 1U)], 1, 1);
+        }
+        ns[v] = (Test_Now() - t0) / TEST_BENCH_SAMPLES * 1e9;
+      }
+
+      Srvc_AverageBankInit_S16(&bank, test_bank_sum, test_bank_hist, TEST_CH, n);
+      t0 = Test_Now();
+      for (uint32_t i = 0; i < (TEST_BENCH_SAMPLES / TEST_CH); i++) {
+        Srvc_AverageBank_S16(&bank, &test_in[0][(i * TEST_CH) & (TEST_SAMPLES - 1U)], row);
+        test_sink += row[i & (TEST_CH - 1U)];
+      }
+      ns[2U + v] = (Test_Now() - t0) / TEST_BENCH_SAMPLES * 1e9;
+    }
+
+    if (win[w] <= UINT8_MAX) {
+      printf("bench: window %3u: single %.2f ns (shift) %.2f ns (divide by %u), ", win[w], ns[0], ns[1], win[w] - 1U);
+    } else {
+      printf("bench: window %3u: single n/a, ", win[w]);
+    }
+    printf("bank %.2f / %.2f ns per channel\n", ns[2], ns[3]);
+  }
+}
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : test_timeseries
+ *  Description        : timeseries block codec round trip for wrapping and
+ *                       full range times and values, also run built with
+ *                       the undefined behaviour sanitizer, and compression
+ *                       ratio and records/s for sensor, event and random
+ *                       series
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <string.h>
+#include "timeseries_library.h"
+#include "test.h"
+
+/******************************************************************************/
+/* PRIVATE DEFINITIONS                                                        */
+/******************************************************************************/
+#define TEST_RECS                 100000U
+#define TEST_BLOCK                244U      // one BLE notification at the largest MTU
+#define TEST_MAX_BLOCKS           (TEST_RECS)
+#define TEST_VALS                 2U
+#define TEST_ROUNDS               20U
+
+/******************************************************************************/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/******************************************************************************/
+typedef enum Test_Series_t
+{
+  TEST_SENSOR = 0,          // every 60 s, slowly changing values
+  TEST_JITTER,              // every 60 s +-2 s, noisy values
+  TEST_EVENTS,              // bottle events 30..150 s apart, like the journal export
+  TEST_RANDOM,              // full range times and values
+  TEST_SERIES_MAX
+} Test_Series_t;
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
+/******************************************************************************/
+static void Test_Gen(Test_Series_t e_Series, uint32_t u32_N);
+static uint32_t Test_Encode(uint32_t u32_N, uint8_t u8_Vals, uint16_t u16_Block);
+static uint32_t Test_Decode(uint32_t u32_Blocks, uint8_t u8_Vals);
+static void Test_RoundTrip(const char *pc_Name, uint32_t u32_N, uint8_t u8_Vals, uint16_t u16_Block);
+static void Test_Edges(void);
+static void Test_Bench(void);
+
+/******************************************************************************/
+/* PRIVATE DATA DEFINTIONS                                                    */
+/******************************************************************************/
+static const char *const test_name[TEST_SERIES_MAX] = { "sensor 60 s", "sensor 60 s +-2 s", "bottle events",
+                                                        "random" };
+static uint32_t test_time[TEST_RECS];
+static uint32_t test_val[TEST_RECS][SRVC_TS_MAX_VALS];
+static uint8_t test_buf[TEST_MAX_BLOCKS][TEST_BLOCK];
+static uint16_t test_len[TEST_MAX_BLOCKS];
+static uint32_t test_bytes;               // block bytes of the last Test_Encode
+static uint32_t test_bad;                 // records that differ in the last Test_Decode
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+int main(void)
+{
+  Test_Edges();
+  for (uint32_t s = 0; s < TEST_SERIES_MAX; s++) {
+    Test_Gen((Test_Series_t)s, TEST_RECS);
+    Test_RoundTrip(test_name[s], TEST_RECS, TEST_VALS, TEST_BLOCK);
+  }
+  Test_Gen(TEST_RANDOM, TEST_RECS);
+  /* the worst record, 36 bits of time and 4 * 41 of values, only just fits */
+  Test_RoundTrip("random, 4 values, 29 byte blocks", TEST_RECS, SRVC_TS_MAX_VALS, 29U);
+  Test_Bench();
+  return Test_Exit("timeseries");
+}
+
+/******************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/******************************************************************************/
+
+/**
+ * @brief Fill test_time and test_val with a series
+ * @param e_Series : kind
+ * @param u32_N : records
+ */
+static void Test_Gen(Test_Series_t e_Series, uint32_t u32_N)
+{
+  uint32_t h = 12345U;
+  uint32_t t = 1750000000U;
+  int32_t temp = 2150;                    // 0.01 degC
+  uint32_t mv = 4150U;
+
+  for (uint32_t i = 0; i < u32_N; i++) {
+    h = (h * 1103515245U) + 12345U;
+    switch (e_Series) {
+      case TEST_SENSOR:
+        t += 60U;
+        temp += (int32_t)((h >> 16) % 3U) - 1;
+        mv -= ((i % 50U) == 0U) ? 1U : 0U;
+        break;
+      case TEST_JITTER:
+        t += 58U + ((h >> 16) % 5U);
+        temp += (int32_t)((h >> 16) % 41U) - 20;
+        mv = 4000U + ((h >> 20) % 64U);
+        break;
+      case TEST_EVENTS:
+        t += 30U + ((h >> 16) % 121U);
+        temp = (int32_t)((((i & 1U) + 1U) << 16) | ((h >> 12) & 3U));
+        mv = 400U + ((i * 7U) % 300U);
+        break;
+      default:
+        t = h;
+        h = (h * 1103515245U) + 12345U;
+        temp = (int32_t)h;
+        mv = (h * 2654435761U) ^ (h >> 7);
+        break;
+    }
+    test_time[i] = t;
+    test_val[i][0] = (uint32_t)temp;
+    test_val[i][1] = mv;
+    test_val[i][2] = ~mv;
+    test_val[i][3] = (uint32_t)temp * 2246822519U;
+  }
+}
+
+/**
+ * @brief Encode test_time/test_val into test_buf, one block after the other
+ * @param u32_N : records
+ * @param u8_Vals : values per record
+ * @param u16_Block : block size
+ * @return blocks
+ */
+static uint32_t Test_Encode(uint32_t u32_N, uint8_t u8_Vals, uint16_t u16_Block)
+{
+  Srvc_TsEnc_t enc;
+  uint32_t b = 0;
+
+  test_bytes = 0;
+  Srvc_TsEncInit(&enc, test_buf[0], u16_Block, u8_Vals);
+  for (uint32_t i = 0; i < u32_N; i++) {
+    if (Srvc_TsEncPut(&enc, test_time[i], test_val[i]) == false) {
+      test_len[b] = Srvc_TsEncFinish(&enc);
+      test_bytes += test_len[b];
+      b++;
+      Srvc_TsEncInit(&enc, test_buf[b], u16_Block, u8_Vals);
+      if (Srvc_TsEncPut(&enc, test_time[i], test_val[i]) == false) {
+        Test_Fail(__FILE__, __LINE__, "record %u does not fit an empty block of %u bytes", i, u16_Block);
+        return b;
+      }
+    }
+  }
+  test_len[b] = Srvc_TsEncFinish(&enc);
+  test_bytes += test_len[b];
+  return b + 1U;
+}
+
+/**
+ * @brief Decode test_buf and compare with test_time/test_val
+ * @param u32_Blocks : blocks
+ * @param u8_Vals : values per record
+ * @return records decoded
+ */
+static uint32_t Test_Decode(uint32_t u32_Blocks, uint8_t u8_Vals)
+{
+  uint32_t n = 0;
+
+  test_bad = 0;
+  for (uint32_t b = 0; b < u32_Blocks; b++) {
+    Srvc_TsDec_t dec;
+    uint32_t time;
+    uint32_t val[SRVC_TS_MAX_VALS];
+
+    if (Srvc_TsDecInit(&dec, test_buf[b], test_len[b]) == false) {
+      test_bad++;
+      continue;
+    }
+    while (Srvc_TsDecGet(&dec, &time, val) && (n < TEST_RECS)) {
+      test_bad += ((time != test_time[n]) || (memcmp(val, test_val[n], u8_Vals * sizeof(uint32_t)) != 0)) ? 1U : 0U;
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief Encode, decode and compare a series
+ * @param pc_Name : series
+ * @param u32_N : records
+ * @param u8_Vals : values per record
+ * @param u16_Block : block size
+ */
+static void Test_RoundTrip(const char *pc_Name, uint32_t u32_N, uint8_t u8_Vals, uint16_t u16_Block)
+{
+  const uint32_t blocks = Test_Encode(u32_N, u8_Vals, u16_Block);
+  const uint32_t n = Test_Decode(blocks, u8_Vals);
+
+  TEST_CHECK((n == u32_N) && (test_bad == 0U), "%s: %u of %u records decoded, %u differ", pc_Name, n, u32_N,
+             test_bad);
+}
+
+/**
+ * @brief Times and values that wrap and deltas whose difference does not
+ *        fit an int32_t, in one block
+ */
+static void Test_Edges(void)
+{
+  static const uint32_t t[] = { 0U, 0x7FFFFFFFU, 0xFFFFFFFFU, 0U, 0x80000000U, 0x80000000U, 0U, 1U,
+                                0xFFFFFFFFU, 0x7FFFFFFFU, 0x80000001U, 5U, 5U, 5U, 0xFFFFFFFEU, 0U };
+  static const uint32_t v[] = { 0U, 0x80000000U, 0x7FFFFFFFU, 0xFFFFFFFFU, 0U, 0x80000000U, 1U, 0xFFFFFFFFU };
+  const uint32_t n = sizeof(t) / sizeof(t[0]);
+
+  for (uint32_t i = 0; i < n; i++) {
+    test_time[i] = t[i];
+    for (uint32_t k = 0; k < SRVC_TS_MAX_VALS; k++) {
+      test_val[i][k] = v[(i + k) % (sizeof(v) / sizeof(v[0]))];
+    }
+  }
+  TEST_CHECK(Test_Encode(n, SRVC_TS_MAX_VALS, TEST_BLOCK) == 1U, "edge records need more than one block");
+  TEST_CHECK((Test_Decode(1U, SRVC_TS_MAX_VALS) == n) && (test_bad == 0U), "edges: %u records differ", test_bad);
+
+  /* the same interval again costs one bit, and one more per unchanged value */
+  for (uint32_t i = 0; i < 500U; i++) {
+    test_time[i] = 0xFFFFF000U + (i * 7U);
+    test_val[i][0] = 0;
+  }
+  TEST_CHECK(Test_Encode(100U, 1U, TEST_BLOCK) == 1U, "regular series does not fit a block");
+  const uint32_t short_bytes = test_bytes;
+  TEST_CHECK(Test_Encode(500U, 1U, TEST_BLOCK) == 1U, "regular series does not fit a block");
+  TEST_CHECK((test_bytes - short_bytes) == ((400U * 2U) / 8U), "400 regular records cost %u bytes",
+             test_bytes - short_bytes);
+  TEST_CHECK((Test_Decode(1U, 1U) == 500U) && (test_bad == 0U), "regular series: %u records differ", test_bad);
+  printf("edges: wrapping times, deltas of +-2^31 and full range values round trip\n");
+}
+
+/**
+ * @brief Bytes per record against the raw 4 byte time and values, and
+ *        records/s of encoder and decoder, per series
+ */
+static void Test_Bench(void)
+{
+  for (uint32_t s = 0; s < TEST_SERIES_MAX; s++) {
+    const double raw = (double)(sizeof(uint32_t) * (1U + TEST_VALS));
+    uint32_t blocks = 0;
+    double t_enc;
+    double t_dec;
+    double t0;
+
+    Test_Gen((Test_Series_t)s, TEST_RECS);
+    t0 = Test_Now();
+    for (uint32_t r = 0; r < TEST_ROUNDS; r++) {
+      blocks = Test_Encode(TEST_RECS, TEST_VALS, TEST_BLOCK);
+    }
+    t_enc = (Test_Now() - t0) / TEST_ROUNDS;
+    t0 = Test_Now();
+    for (uint32_t r = 0; r < TEST_ROUNDS; r++) {
+      test_sink += (int32_t)Test_Decode(blocks, TEST_VALS);
+    }
+    t_dec = (Test_Now() - t0) / TEST_ROUNDS;
+
+    printf("bench: %-18s %5.2f bytes per record, ratio %5.2f, encode %5.1f M records/s, decode %5.1f M records/s "
+           "(incl. compare)\n", test_name[s], (double)test_bytes / TEST_RECS, raw * TEST_RECS / test_bytes,
+           TEST_RECS / t_enc / 1e6, TEST_RECS / t_dec / 1e6);
+  }
+}
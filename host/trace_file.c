@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : trace_file
+ *  Description        : reads input trace files and expands the run length
+ *                       coded words into single samples
+ ******************************************************************************/
+
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace_file.h"
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/******************************************************************************/
+
+/**
+ * @brief Read a trace file, errors are printed
+ * @param pc_Path : file
+ * @param pst_File : trace, TraceFile_Free releases it
+ * @return false if the file can not be read or is no trace
+ */
+bool TraceFile_Load(const char *pc_Path, TraceFile_t *pst_File)
+{
+  uint32_t hdr[INPUT_TRACE_HDR_WORDS];
+  FILE *file = fopen(pc_Path, "rb");
+  bool ok = false;
+
+  pst_File->pu32_Words = NULL;
+  if (file == NULL) {
+    fprintf(stderr, "can not open %s\n", pc_Path);
+    return false;
+  }
+  /* the host is little endian like the file */
+  if ((fread(hdr, sizeof(uint32_t), INPUT_TRACE_HDR_WORDS, file) != INPUT_TRACE_HDR_WORDS) ||
+      (hdr[0] != INPUT_TRACE_MAGIC) || (hdr[1] != INPUT_TRACE_VERSION)) {
+    fprintf(stderr, "%s is not a version %u trace\n", pc_Path, INPUT_TRACE_VERSION);
+  } else {
+    pst_File->u32_Words = hdr[3];
+    pst_File->u32_FirstMs = hdr[2];
+    pst_File->pu32_Words = malloc(((size_t)hdr[3] + 1U) * sizeof(uint32_t));
+    ok = (pst_File->pu32_Words != NULL) &&
+         (fread(pst_File->pu32_Words, sizeof(uint32_t), hdr[3], file) == hdr[3]);
+    if (ok == false) {
+      fprintf(stderr, "%s is truncated\n", pc_Path);
+      free(pst_File->pu32_Words);
+      pst_File->pu32_Words = NULL;
+    }
+  }
+  (void)fclose(file);
+  return ok;
+}
+
+/**
+ * @brief Release a loaded trace
+ * @param pst_File : trace
+ */
+void TraceFile_Free(TraceFile_t *pst_File)
+{
+  free(pst_File->pu32_Words);
+  pst_File->pu32_Words = NULL;
+}
+
+/**
+ * @brief Start reading at the first sample
+ * @param pst_File : trace
+ * @param pst_It : position
+ */
+void TraceFile_Begin(const TraceFile_t *pst_File, TraceFile_Iter_t *pst_It)
+{
+  pst_It->pst_File = pst_File;
+  pst_It->u32_Word = 0;
+  pst_It->u32_Left = 0;
+  pst_It->u64_Ms = pst_File->u32_FirstMs;
+}
+
+/**
+ * @brief Next sample, gaps only move the time on
+ * @param pst_It : position
+ * @param pst_Sample : sample
+ * @return false at the end of the trace
+ */
+bool TraceFile_Next(TraceFile_Iter_t *pst_It, TraceFile_Sample_t *pst_Sample)
+{
+  const TraceFile_t *file = pst_It->pst_File;
+  uint32_t gap = 0;
+
+  while (pst_It->u32_Left == 0U) {
+    if (pst_It->u32_Word == file->u32_Words) {
+      return false;
+    }
+    const uint32_t word = file->pu32_Words[pst_It->u32_Word];
+    if (INPUT_TRACE_SRC(word) == (uint32_t)INPUT_TRACE_SRC_GAP) {
+      gap += INPUT_TRACE_GAP(word);
+      pst_It->u32_Word++;
+    } else {
+      pst_It->u32_Left = INPUT_TRACE_COUNT(word);
+    }
+  }
+
+  const uint32_t word = file->pu32_Words[pst_It->u32_Word];
+  pst_It->u64_Ms += gap + INPUT_TRACE_DT(word);
+  pst_Sample->u64_Ms = pst_It->u64_Ms;
+  pst_Sample->u32_DtMs = (gap != 0U) ? 0U : INPUT_TRACE_DT(word);
+  pst_Sample->e_Src = (InputTrace_Source_t)INPUT_TRACE_SRC(word);
+  pst_Sample->u32_Level = INPUT_TRACE_LEVEL(word);
+  if (--pst_It->u32_Left == 0U) {
+    pst_It->u32_Word++;
+  }
+  return true;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright (c) 2025 Bangalore,
+ *
+ *  All rights reserved. This program and the accompanying materials
+ *  are protected by international copyright laws.
+ *  Please contact copyright holder for licensing information.
+ *
+ *
+ *  @author Tanveer
+ *
+ *******************************************************************************
+ *  PROJECT              FROST
+ *  File Name          : trace_file
+ *  Description        : reads input trace files written by
+ *                       tools/trace_extract.py, see input_trace.h
+ ******************************************************************************/
+
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************/
+/* INCLUDES                                                                   */
+/******************************************************************************/
+#include <stdbool.h>
+#include "stdint.h"
+#include "input_trace.h"
+
+/******************************************************************************/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/******************************************************************************/
+typedef struct TraceFile_t
+{
+  uint32_t *pu32_Words;      // trace words after the header
+  uint32_t u32_Words;
+  uint32_t u32_FirstMs;      // time before the first word
+} TraceFile_t;
+
+/*
+ * @brief position in a trace, one sample at a time
+ */
+typedef struct TraceFile_Iter_t
+{
+  const TraceFile_t *pst_File;
+  uint32_t u32_Word;         // word of the next sample
+  uint32_t u32_Left;         // samples of that word not read yet
+  uint64_t u64_Ms;           // time of the last sample
+} TraceFile_Iter_t;
+
+typedef struct TraceFile_Sample_t
+{
+  uint64_t u64_Ms;           // since the start of the recording
+  uint32_t u32_DtMs;         // after the previous sample, 0 after a gap
+  InputTrace_Source_t e_Src;
+  uint32_t u32_Level;
+} TraceFile_Sample_t;
+
+/******************************************************************************/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/******************************************************************************/
+bool TraceFile_Load(const char *pc_Path, TraceFile_t *pst_File);
+void TraceFile_Free(TraceFile_t *pst_File);
+void TraceFile_Begin(const TraceFile_t *pst_File, TraceFile_Iter_t *pst_It);
+bool TraceFile_Next(TraceFile_Iter_t *pst_It, TraceFile_Sample_t *pst_Sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_FILE_H
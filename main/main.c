@@ -23,7 +23,13 @@
 #include "syssm.h"
 #include <inttypes.h>
 #include <stdio.h>
-#include "audio.h"
+#include "boot.h"
+#include "console.h"
+#include "dlog.h"
+#include "settings.h"
+#include "storage.h"
+#include "journal.h"
+#include "power.h"
 
 /******************************************************************************/
 /* PRIVATE FUNCTION DECLARATIONS AND PRIVATE MACRO FUNCTION DEFINITIONS       */
@@ -34,12 +40,21 @@ void SysSm_task(void *param);
  * @brief main function
  */
 void app_main(void) {
-  IR_Switch_Init();
-  SysSm_Init();
+  // journal and audio start on their first use, see Boot_Use
+  Boot_Mark("app_main");
+  BOOT_STEP("dlog", Dlog_Init());
+  BOOT_STEP("power", Power_Init());
+  BOOT_STEP("storage", Storage_Init());
+  BOOT_STEP("settings", Settings_Init());
+  BOOT_STEP("ir switch", IR_Switch_Init());
+  BOOT_STEP("syssm", SysSm_Init());
+  BOOT_STEP("console", Console_Init());
 
   // create task for the modules
-  xTaskCreate(SysSm_task, "syssmTask", 2048, NULL, 4, NULL);
-  xTaskCreate(Audio_task, "Audio_task", 2048, NULL, 4, NULL);
+  BOOT_STEP("syssm task", xTaskCreate(SysSm_task, "syssmTask", 2048, NULL, 4, NULL));
+  BOOT_STEP("dlog task", xTaskCreate(Dlog_task, "dlogTask", 2048, NULL, 1, NULL));
+  // flash commits deferred by timer callbacks, the priority of the timer daemon
+  BOOT_STEP("storage task", xTaskCreate(Storage_task, "storageTask", 3072, NULL, 1, NULL));
 }
 
 /******************************************************************************/
@@ -52,8 +67,7 @@ void app_main(void) {
  */
 void SysSm_task(void *param) {
   while (1) {
-    SysSm_Process();
-    vTaskDelay(10 / portTICK_PERIOD_MS);
+    SysSm_Process(); // blocks until the next event
   }
   vTaskDelete(NULL);
 }
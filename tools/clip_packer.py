@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : clip_packer.py
+#  Description        : packs WAV prompts into the IMA-ADPCM clip partition image
+#
+#  Input: mono 16 bit PCM WAV files at the output rate (16 kHz), clip ids
+#  follow the order on the command line.
+#
+#  Image layout (little endian), read by audio_clip.c:
+#    u32 magic "FCLP", u16 clip count, u16 reserved
+#    per clip: u32 offset, u32 size, u32 samples, u16 rate, u16 block size
+#    data: IMA-ADPCM blocks, each s16 first sample, u8 step index, u8 reserved,
+#          then two samples per byte, low nibble first. The last block of a
+#          clip is padded, the sample count tells where the clip ends.
+#
+#  Flash with: esptool.py write_flash <clips offset> clips.bin
+#  (offset of the "clips" entry in partitions.csv)
+
+import argparse
+import struct
+import sys
+import wave
+
+MAGIC = b'FCLP'
+HDR_SIZE = 8
+DIR_SIZE = 16
+BLOCK_HDR = 4
+ALIGN = 4
+
+INDEX_TAB = [-1, -1, -1, -1, 2, 4, 6, 8] * 2
+STEP_TAB = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+
+
+def encode_sample(sample, pred, index):
+    """Encode one sample, mirrors the decoder in audio_clip.c exactly."""
+    step = STEP_TAB[index]
+    diff = sample - pred
+    code = 0
+    if diff < 0:
+        code = 8
+        diff = -diff
+    if diff >= step:
+        code |= 4
+        diff -= step
+    if diff >= step >> 1:
+        code |= 2
+        diff -= step >> 1
+    if diff >= step >> 2:
+        code |= 1
+
+    delta = step >> 3
+    if code & 4:
+        delta += step
+    if code & 2:
+        delta += step >> 1
+    if code & 1:
+        delta += step >> 2
+    pred = pred - delta if code & 8 else pred + delta
+    pred = max(-32768, min(32767, pred))
+    index = max(0, min(88, index + INDEX_TAB[code]))
+    return code, pred, index
+
+
+def best_index(samples):
+    """Start the step index near the signal level to avoid a slow attack."""
+    if len(samples) < 2:
+        return 0
+    d = abs(samples[1] - samples[0])
+    index = 0
+    while index < 88 and STEP_TAB[index] < d:
+        index += 1
+    return index
+
+
+def encode(samples, block_size):
+    per_block = (block_size - BLOCK_HDR) * 2 + 1
+    out = bytearray()
+    index = best_index(samples)
+    for start in range(0, len(samples), per_block):
+        chunk = samples[start:start + per_block]
+        chunk += [chunk[-1]] * (per_block - len(chunk))
+        pred = chunk[0]
+        out += struct.pack('<hBB', pred, index, 0)
+        nibbles = []
+        for s in chunk[1:]:
+            code, pred, index = encode_sample(s, pred, index)
+            nibbles.append(code)
+        for i in range(0, len(nibbles), 2):
+            out.append(nibbles[i] | (nibbles[i + 1] << 4))
+    return out
+
+
+def read_wav(path, rate):
+    with wave.open(path, 'rb') as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit('%s: expected mono 16 bit PCM' % path)
+        if w.getframerate() != rate:
+            sys.exit('%s: expected %d Hz, got %d Hz' % (path, rate, w.getframerate()))
+        raw = w.readframes(w.getnframes())
+    return list(struct.unpack('<%dh' % (len(raw) // 2), raw))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('output', help='partition image to write')
+    ap.add_argument('wav', nargs='+', help='clips in id order')
+    ap.add_argument('--rate', type=int, default=16000)
+    ap.add_argument('--block', type=int, default=256, help='ADPCM block size in bytes')
+    ap.add_argument('--size', type=lambda v: int(v, 0), default=0,
+                    help='partition size, the image is checked and padded to it')
+    args = ap.parse_args()
+
+    if args.block <= BLOCK_HDR or args.block % ALIGN:
+        sys.exit('block size must be a multiple of %d' % ALIGN)
+
+    data = bytearray()
+    entries = []
+    base = HDR_SIZE + DIR_SIZE * len(args.wav)
+    base += -base % ALIGN
+    for path in args.wav:
+        samples = read_wav(path, args.rate)
+        if not samples:
+            sys.exit('%s: empty' % path)
+        blob = encode(samples, args.block)
+        entries.append((base + len(data), len(blob), len(samples)))
+        data += blob
+
+    image = bytearray(MAGIC + struct.pack('<HH', len(entries), 0))
+    for off, size, count in entries:
+        image += struct.pack('<IIIHH', off, size, count, args.rate, args.block)
+    image += b'\0' * (base - len(image))
+    image += data
+
+    if args.size:
+        if len(image) > args.size:
+            sys.exit('image is %d bytes, partition holds %d' % (len(image), args.size))
+        image += b'\xff' * (args.size - len(image))
+
+    with open(args.output, 'wb') as f:
+        f.write(image)
+    for i, (path, (off, size, count)) in enumerate(zip(args.wav, entries)):
+        print('clip %d: %s, %d samples, %d bytes' % (i, path, count, size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : dlog_extract.py
+#  Description        : format string dictionary and decoder for dlog
+#
+#  extract <dir|file>... -o dlog_dict.json
+#      collects every DLOG_E/W/I call of the sources that define DLOG_FILE_ID,
+#      keyed by file id and line, run at build time
+#
+#  decode dlog_dict.json [log]
+#      reads the console output (stdin when no file is given), turns the
+#      "~D<core>:<base64>" lines back into text and passes all other
+#      lines through unchanged, e.g.  idf.py monitor | dlog_extract.py decode ...
+#
+#  Record (little endian 32 bit words): header, timestamp in us, 0..4 arguments
+#    header bit 31..22 file id (0 = drop record), 21..20 level,
+#           19..17 argument count, 16..0 line
+
+import argparse
+import base64
+import json
+import os
+import re
+import sys
+
+FILE_ID = re.compile(r'^\s*#\s*define\s+DLOG_FILE_ID\s+(\d+)', re.M)
+CALL = re.compile(r'\bDLOG_([EWI])\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+STRING = re.compile(r'"((?:[^"\\]|\\.)*)"')
+CONV = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXc%])')
+BAD_CONV = re.compile(r'%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t)?[sfFeEgGpaA]')
+LEVEL_NAME = 'EWI'
+
+
+def sources(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, _, files in os.walk(path):
+            for name in sorted(files):
+                if name.endswith('.c'):
+                    yield os.path.join(root, name)
+
+
+def extract(paths):
+    table = {}
+    for path in sources(paths):
+        with open(path, encoding='utf-8', errors='replace') as f:
+            text = f.read()
+        m = FILE_ID.search(text)
+        if not m:
+            if CALL.search(text):
+                sys.exit('%s: DLOG call without DLOG_FILE_ID' % path)
+            continue
+        fid = m.group(1)
+        if fid in table:
+            sys.exit('%s: DLOG_FILE_ID %s already used by %s' % (path, fid, table[fid]['file']))
+        lines = {}
+        for call in CALL.finditer(text):
+            line = text.count('\n', 0, call.start()) + 1
+            fmt = ''.join(STRING.findall(call.group(2)))
+            fmt = bytes(fmt, 'utf-8').decode('unicode_escape')
+            if BAD_CONV.search(fmt):
+                sys.exit('%s:%d: dlog takes integer arguments only' % (path, line))
+            if str(line) in lines:
+                sys.exit('%s:%d: one DLOG call per line' % (path, line))
+            lines[str(line)] = {'level': LEVEL_NAME.index(call.group(1)), 'fmt': fmt}
+        table[fid] = {'file': os.path.basename(path), 'lines': lines}
+    return table
+
+
+def render(fmt, args):
+    args = list(args)
+
+    def conv(m):
+        flags, _, kind = m.groups()
+        if kind == '%':
+            return '%'
+        value = args.pop(0) if args else 0
+        if kind in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            kind = 'd'
+        return ('%' + flags + kind) % value
+
+    return CONV.sub(conv, fmt).rstrip('\n')
+
+
+def decode(table, stream, out):
+    pending = {}
+    for raw in stream:
+        if not raw.startswith('~D'):
+            out.write(raw)
+            continue
+        core, _, data = raw[2:].strip().partition(':')
+        data = base64.b64decode(data)
+        words = pending.setdefault(core, [])
+        words += [int.from_bytes(data[i:i + 4], 'little') for i in range(0, len(data) - 3, 4)]
+        while len(words) >= 2:
+            hdr = words[0]
+            nargs = (hdr >> 17) & 0x7
+            if len(words) < 2 + nargs:
+                break
+            ts, args = words[1], words[2:2 + nargs]
+            del words[:2 + nargs]
+            fid, level, line = hdr >> 22, (hdr >> 20) & 0x3, hdr & 0x1FFFF
+            if fid == 0:
+                out.write('-- core %s: %d dlog records dropped\n' % (core, args[0]))
+                continue
+            entry = table.get(str(fid), {})
+            rec = entry.get('lines', {}).get(str(line))
+            if rec is None:
+                text = '<unknown id %d:%d> %s' % (fid, line, ' '.join('0x%x' % a for a in args))
+            else:
+                text = render(rec['fmt'], args)
+            out.write('%s (%d) %s:%d: %s\n' % (LEVEL_NAME[level] if level < 3 else '?', ts // 1000,
+                                                 entry.get('file', '?'), line, text))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='dlog format dictionary and decoder')
+    sub = ap.add_subparsers(dest='cmd', required=True)
+    ex = sub.add_parser('extract')
+    ex.add_argument('paths', nargs='+')
+    ex.add_argument('-o', '--output', required=True)
+    de = sub.add_parser('decode')
+    de.add_argument('dict')
+    de.add_argument('log', nargs='?')
+    args = ap.parse_args()
+
+    if args.cmd == 'extract':
+        table = extract(args.paths)
+        with open(args.output, 'w') as f:
+            json.dump(table, f, indent=1, sort_keys=True)
+    else:
+        with open(args.dict) as f:
+            table = json.load(f)
+        stream = open(args.log) if args.log else sys.stdin
+        decode(table, stream, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : melody_compiler.py
+#  Description        : compiles the melody text notation into a flash blob
+#
+#  Notation (see app_modules/device_drivers/audio/melodies/melodies.txt):
+#
+#    melody <NAME> unit=<ms>      start a melody, one duration unit is <ms>
+#      <note>[/<units>][@<env>]   note C..B with optional # or b and octave
+#      R[/<units>]                rest
+#    end
+#
+#  Blob layout (little endian):
+#    u8  melody count
+#    u16 offset of every melody from the blob start
+#    per melody: u16 unit in ms, then 2 byte note records
+#      byte 0: bit 7..6 envelope, bit 5..0 pitch index (C3 = 0), 63 = rest
+#      byte 1: duration in units 1..255
+#    a melody ends with the record 0xFF 0x00, rests never carry an envelope
+
+import argparse
+import re
+import sys
+
+PITCH_BASE_MIDI = 48         # C3
+PITCH_REST = 63
+NOTE_OFFSET = {'C': 0, 'D': 2, 'E': 4, 'F': 5, 'G': 7, 'A': 9, 'B': 11}
+TOKEN = re.compile(r'^(?:(R)|([A-G])([#b]?)(\d))(?:/(\d+))?(?:@(\d))?$')
+
+
+def fail(path, line, msg):
+    sys.exit('%s:%d: %s' % (path, line, msg))
+
+
+def parse(path):
+    melodies = []
+    current = None
+    with open(path) as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.strip()
+            if not line or line.startswith('#'):
+                continue
+            words = line.split()
+            if words[0] == 'melody':
+                if current is not None:
+                    fail(path, lineno, 'missing end')
+                m = re.match(r'^unit=(\d+)$', words[2]) if len(words) == 3 else None
+                if not m or not re.match(r'^[A-Z][A-Z0-9_]*$', words[1]):
+                    fail(path, lineno, 'expected: melody <NAME> unit=<ms>')
+                current = {'name': words[1], 'unit': int(m.group(1)), 'notes': []}
+                continue
+            if words[0] == 'end':
+                if current is None:
+                    fail(path, lineno, 'end without melody')
+                melodies.append(current)
+                current = None
+                continue
+            if current is None:
+                fail(path, lineno, 'note outside melody')
+            for tok in words:
+                m = TOKEN.match(tok)
+                if not m:
+                    fail(path, lineno, 'bad note %r' % tok)
+                rest, name, acc, octave, units, env = m.groups()
+                if rest:
+                    pitch = PITCH_REST
+                    env = None              # keeps 0xFF free for the end record
+                else:
+                    midi = 12 * (int(octave) + 1) + NOTE_OFFSET[name] + {'': 0, '#': 1, 'b': -1}[acc]
+                    pitch = midi - PITCH_BASE_MIDI
+                    if not 0 <= pitch < PITCH_REST:
+                        fail(path, lineno, 'note %r out of range C3..D8' % tok)
+                units = int(units) if units else 1
+                env = int(env) if env else 0
+                if not 1 <= units <= 255 or not 0 <= env <= 3:
+                    fail(path, lineno, 'bad duration or envelope in %r' % tok)
+                current['notes'].append((pitch, units, env))
+    if current is not None:
+        fail(path, lineno, 'missing end')
+    return melodies
+
+
+def build_blob(melodies):
+    blob = bytearray([len(melodies)])
+    offsets_at = len(blob)
+    blob += bytes(2 * len(melodies))
+    for idx, mel in enumerate(melodies):
+        blob[offsets_at + 2 * idx:offsets_at + 2 * idx + 2] = len(blob).to_bytes(2, 'little')
+        blob += mel['unit'].to_bytes(2, 'little')
+        for pitch, units, env in mel['notes']:
+            blob += bytes([(env << 6) | pitch, units])
+        blob += bytes([0xFF, 0x00])
+    return blob
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument('input')
+    ap.add_argument('out_c')
+    ap.add_argument('out_h')
+    args = ap.parse_args()
+
+    melodies = parse(args.input)
+    blob = build_blob(melodies)
+
+    with open(args.out_h, 'w') as h:
+        h.write('/* generated by tools/melody_compiler.py from %s, do not edit */\n' % args.input.replace('\\', '/').split('/')[-1])
+        h.write('#ifndef MELODY_DATA_H\n#define MELODY_DATA_H\n\n#include <stdint.h>\n#include "sdkconfig.h"\n\n')
+        for idx, mel in enumerate(melodies):
+            h.write('#define MELODY_%-24s %d\n' % (mel['name'], idx))
+        h.write('#define MELODY_%-24s %d\n\n' % ('COUNT', len(melodies)))
+        h.write('extern const uint8_t melody_blob[%d];\n\n' % len(blob))
+        h.write('#if defined(CONFIG_IDF_TARGET_LINUX)\n')
+        h.write('extern const char *const melody_names[%d];\n' % len(melodies))
+        h.write('#endif\n\n#endif // MELODY_DATA_H\n')
+
+    with open(args.out_c, 'w') as c:
+        c.write('/* generated by tools/melody_compiler.py, do not edit */\n')
+        c.write('#include "melody_data.h"\n\n')
+        c.write('const uint8_t melody_blob[%d] = {\n' % len(blob))
+        for i in range(0, len(blob), 12):
+            c.write('  ' + ', '.join('0x%02x' % b for b in blob[i:i + 12]) + ',\n')
+        c.write('};\n')
+        # names only for host tools, they stay out of the firmware
+        c.write('\n#if defined(CONFIG_IDF_TARGET_LINUX)\n')
+        c.write('const char *const melody_names[%d] = {\n' % len(melodies))
+        for mel in melodies:
+            c.write('  "%s",\n' % mel['name'])
+        c.write('};\n#endif\n')
+
+
+if __name__ == '__main__':
+    main()
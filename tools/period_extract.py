@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : period_extract.py
+#  Description        : period monitor report from the console output
+#
+#  period_extract.py [log] [--hist]
+#      reads the console output (stdin when no file is given) and prints the
+#      last "period dump" in it: interval and execution time percentiles in
+#      us, deadline misses and overruns per monitor, e.g.
+#      idf.py monitor | tee monitor.log ... period_extract.py monitor.log --hist
+#
+#  Dump (32 bit words), see period.c:
+#    header   magic "FRPM", version, buckets, monitors
+#    monitor  name (16 bytes, NUL padded), period us, late us, misses,
+#             overruns, interval histogram, execution histogram
+#    histogram count, min, max, total low, total high, buckets: 0..15 us
+#             exact, then 8 buckets per power of 2
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x4D505246
+VERSION = 1
+NAME_WORDS = 4
+SUB_BITS = 3
+SUB_COUNT = 1 << SUB_BITS
+PERCENTILES = (50.0, 90.0, 99.0, 99.9, 99.99)
+
+
+def extract(stream):
+    dumps = []
+    words = None
+    for raw in stream:
+        if not raw.startswith('~M:'):
+            continue
+        hexwords = raw[3:].strip()
+        line = [int(hexwords[i:i + 8], 16) for i in range(0, len(hexwords) - 7, 8)]
+        if line and line[0] == MAGIC:
+            words = []
+            dumps.append(words)
+        if words is not None:
+            words += line
+    if not dumps:
+        raise SystemExit('no period dump found')
+    return dumps[-1]
+
+
+def bucket_range(b):
+    if b < 2 * SUB_COUNT:
+        return b, b
+    shift = (b - SUB_COUNT) // SUB_COUNT
+    low = (SUB_COUNT + (b - SUB_COUNT) % SUB_COUNT) << shift
+    return low, low + (1 << shift) - 1
+
+
+def hist(w, buckets):
+    return {'count': w[0], 'min': w[1], 'max': w[2], 'total': w[3] | (w[4] << 32), 'hist': w[5:5 + buckets]}
+
+
+def parse(words):
+    if len(words) < 4 or words[1] != VERSION:
+        raise SystemExit('period dump of an unknown version')
+    buckets, count = words[2], words[3]
+    hist_words = 5 + buckets
+    mon_words = NAME_WORDS + 4 + 2 * hist_words
+    if len(words) != 4 + count * mon_words:
+        raise SystemExit('period dump is incomplete')
+    monitors = []
+    for m in range(count):
+        w = words[4 + m * mon_words:4 + (m + 1) * mon_words]
+        name = struct.pack('<%dI' % NAME_WORDS, *w[:NAME_WORDS]).split(b'\0')[0].decode(errors='replace')
+        at = NAME_WORDS + 4
+        monitors.append({'name': name, 'period': w[NAME_WORDS], 'late': w[NAME_WORDS + 1],
+                         'misses': w[NAME_WORDS + 2], 'overruns': w[NAME_WORDS + 3],
+                         'interval': hist(w[at:at + hist_words], buckets),
+                         'exec': hist(w[at + hist_words:at + 2 * hist_words], buckets)})
+    return monitors
+
+
+def percentile(h, pct):
+    need = -(-h['count'] * pct // 100)
+    seen = 0
+    for b, n in enumerate(h['hist'][:-1]):
+        seen += n
+        if seen >= need:
+            return min(bucket_range(b)[1], h['max'])
+    return h['max']
+
+
+def show_hist(h, out):
+    top = max(h['hist']) if h['count'] else 0
+    for b, n in enumerate(h['hist']):
+        if n:
+            low, high = bucket_range(b)
+            out.write('    %9d..%-9d us %10d %s\n' % (low, high, n, '#' * max(1, 40 * n // top)))
+
+
+def show(monitors, with_hist, out):
+    for mon in monitors:
+        iv, ex = mon['interval'], mon['exec']
+        out.write('%s: period %d us, %d activations, %d later than %d us, %d ran longer than the period\n' %
+                  (mon['name'], mon['period'], ex['count'], mon['misses'], mon['late'], mon['overruns']))
+        for label, h in (('interval', iv), ('exec', ex)):
+            if h['count'] == 0:
+                continue
+            out.write('  %-8s min %d avg %d %s max %d us\n' %
+                      (label, h['min'], h['total'] // h['count'],
+                       ' '.join('p%g<=%d' % (p, percentile(h, p)) for p in PERCENTILES), h['max']))
+            if with_hist:
+                show_hist(h, out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='period monitor extractor')
+    ap.add_argument('log', nargs='?')
+    ap.add_argument('--hist', action='store_true', help='print the histograms')
+    args = ap.parse_args()
+
+    stream = open(args.log) if args.log else sys.stdin
+    show(parse(extract(stream)), args.hist, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
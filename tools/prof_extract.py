@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : prof_extract.py
+#  Description        : cycle profile from the console output
+#
+#  prof_extract.py [log] [--mhz 240] [--hist]
+#      reads the console output (stdin when no file is given) and prints the
+#      last "prof dump" in it, the hottest sites first, in cycles and us, e.g.
+#      idf.py monitor | tee monitor.log ... prof_extract.py monitor.log --hist
+#
+#  Dump (32 bit words), see prof.c:
+#    header  magic "FRPF", version, cores, buckets, sites
+#    site    name (24 bytes, NUL padded), migrated scopes,
+#            per core: count, min, max, total low, total high, histogram
+#            bucket b counts 2^b..2^(b+1)-1 cycles
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x46505246
+VERSION = 1
+NAME_WORDS = 6
+
+
+def extract(stream):
+    dumps = []
+    words = None
+    for raw in stream:
+        if not raw.startswith('~P:'):
+            continue
+        hexwords = raw[3:].strip()
+        line = [int(hexwords[i:i + 8], 16) for i in range(0, len(hexwords) - 7, 8)]
+        if line and line[0] == MAGIC:
+            words = []
+            dumps.append(words)
+        if words is not None:
+            words += line
+    if not dumps:
+        raise SystemExit('no profile dump found')
+    return dumps[-1]
+
+
+def parse(words):
+    if len(words) < 5 or words[1] != VERSION:
+        raise SystemExit('profile dump of an unknown version')
+    cores, buckets, nsites = words[2], words[3], words[4]
+    site_words = NAME_WORDS + 1 + cores * (5 + buckets)
+    if len(words) != 5 + nsites * site_words:
+        raise SystemExit('profile dump is incomplete')
+    sites = []
+    for s in range(nsites):
+        w = words[5 + s * site_words:5 + (s + 1) * site_words]
+        name = struct.pack('<%dI' % NAME_WORDS, *w[:NAME_WORDS]).split(b'\0')[0].decode(errors='replace')
+        per_core = []
+        at = NAME_WORDS + 1
+        for _ in range(cores):
+            count, lo, hi, tot_lo, tot_hi = w[at:at + 5]
+            per_core.append({'count': count, 'min': lo, 'max': hi, 'total': tot_lo | (tot_hi << 32),
+                             'hist': w[at + 5:at + 5 + buckets]})
+            at += 5 + buckets
+        sites.append({'name': name, 'migrated': w[NAME_WORDS], 'cores': per_core})
+    return sites
+
+
+def percentile(stat, pct):
+    need = (stat['count'] * pct + 99) // 100
+    seen = 0
+    for b, n in enumerate(stat['hist'][:-1]):
+        seen += n
+        if seen >= need:
+            return min((2 << b) - 1, stat['max'])
+    return stat['max']
+
+
+def show(sites, mhz, hist, out):
+    sites.sort(key=lambda s: sum(c['total'] for c in s['cores']), reverse=True)
+    out.write('%-24s core %9s %12s %10s %10s %10s %10s\n' %
+              ('site', 'count', 'total us', 'avg us', 'p50<= us', 'p99<= us', 'max us'))
+    for site in sites:
+        for core, stat in enumerate(site['cores']):
+            if stat['count'] == 0:
+                continue
+            out.write('%-24s %4d %9d %12.1f %10.2f %10.2f %10.2f %10.2f\n' %
+                      (site['name'], core, stat['count'], stat['total'] / mhz,
+                       stat['total'] / stat['count'] / mhz, percentile(stat, 50) / mhz,
+                       percentile(stat, 99) / mhz, stat['max'] / mhz))
+            if hist:
+                top = max(stat['hist'])
+                for b, n in enumerate(stat['hist']):
+                    if n:
+                        out.write('    %10d.. cycles %9d %s\n' % (1 << b, n, '#' * max(1, 40 * n // top)))
+        if site['migrated']:
+            out.write('%-24s      %9d migrated between cores, not counted\n' % (site['name'], site['migrated']))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='cycle profile extractor')
+    ap.add_argument('log', nargs='?')
+    ap.add_argument('--mhz', type=float, default=240.0, help='CPU clock, cycles per us')
+    ap.add_argument('--hist', action='store_true', help='print the histogram of every site')
+    args = ap.parse_args()
+
+    stream = open(args.log) if args.log else sys.stdin
+    show(parse(extract(stream)), args.mhz, args.hist, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
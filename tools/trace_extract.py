@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2025 Bangalore,
+#
+#  All rights reserved. This program and the accompanying materials
+#  are protected by international copyright laws.
+#  Please contact copyright holder for licensing information.
+#
+#  @author Tanveer
+#
+#  PROJECT              FROST
+#  File Name          : trace_extract.py
+#  Description        : input trace files from the console output
+#
+#  extract [log] -o trace.bin
+#      reads the console output (stdin when no file is given) and writes the
+#      last "trace dump" in it as a trace file, e.g.
+#      idf.py monitor | tee monitor.log ... trace_extract.py extract monitor.log -o field.bin
+#
+#  print trace.bin
+#      lists the runs of samples, one line per trace word
+#
+#  Trace (little endian 32 bit words), see input_trace.h:
+#    header  magic "FRTR", version, time of the first word in ms, word count
+#    sample  bit 31..28 source, 27 level, 26..16 dt in ms, 15..0 count
+#    gap     source 15, bit 27..0 ms without samples
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x52545246
+VERSION = 1
+SRC_GAP = 15
+SRC_NAME = {0: 'ir'}
+
+
+def extract(stream):
+    dumps = []
+    words = None
+    for raw in stream:
+        if not raw.startswith('~T:'):
+            continue
+        hexwords = raw[3:].strip()
+        line = [int(hexwords[i:i + 8], 16) for i in range(0, len(hexwords) - 7, 8)]
+        if line and line[0] == MAGIC:
+            words = []
+            dumps.append(words)
+        if words is not None:
+            words += line
+    if not dumps:
+        raise SystemExit('no trace dump found')
+    words = dumps[-1]
+    if len(words) < 4 or words[1] != VERSION or len(words) != 4 + words[3]:
+        raise SystemExit('trace dump is incomplete or of an unknown version')
+    return words
+
+
+def show(words, out):
+    at = words[2]
+    out.write('trace from %d ms, %d words\n' % (at, words[3]))
+    for w in words[4:]:
+        src = w >> 28
+        if src == SRC_GAP:
+            at += w & 0x0FFFFFFF
+            out.write('%10d ms  gap %d ms\n' % (at, w & 0x0FFFFFFF))
+            continue
+        dt, count = (w >> 16) & 0x7FF, w & 0xFFFF
+        out.write('%10d ms  %-3s level %d, %d samples every %d ms\n' %
+                  (at + dt, SRC_NAME.get(src, str(src)), (w >> 27) & 1, count, dt))
+        at += dt * count
+
+
+def main():
+    ap = argparse.ArgumentParser(description='input trace extractor')
+    sub = ap.add_subparsers(dest='cmd', required=True)
+    ex = sub.add_parser('extract')
+    ex.add_argument('log', nargs='?')
+    ex.add_argument('-o', '--output', required=True)
+    pr = sub.add_parser('print')
+    pr.add_argument('trace')
+    args = ap.parse_args()
+
+    if args.cmd == 'extract':
+        stream = open(args.log) if args.log else sys.stdin
+        words = extract(stream)
+        with open(args.output, 'wb') as f:
+            f.write(struct.pack('<%dI' % len(words), *words))
+    else:
+        with open(args.trace, 'rb') as f:
+            data = f.read()
+        words = list(struct.unpack('<%dI' % (len(data) // 4), data[:len(data) // 4 * 4]))
+        if len(words) < 4 or words[0] != MAGIC:
+            raise SystemExit('%s is not a trace file' % args.trace)
+        show(words, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()